@@ -3,7 +3,6 @@
 #include <memory>
 #include <string>
 #include <thread>
-#include <vector>
 
 #include "absl/flags/flag.h"
 #include "absl/flags/parse.h"
@@ -14,8 +13,8 @@
 #include "include/tiny_dds/publisher.h"
 #include "include/tiny_dds/subscriber.h"
 #include "include/tiny_dds/topic.h"
+#include "include/tiny_dds/typed_data.h"
 #include "include/tiny_dds/types.h"
-#include "src/serialization/protobuf_serializer.h"
 
 // Include the generated protobuf header
 #include "examples/example_message.pb.h"
@@ -52,45 +51,39 @@ int main(int argc, char* argv[]) {
   auto subscriber = subscriber_participant->CreateSubscriber();
 
   // Get the type name for the ExampleMessage
-  tiny_dds::examples::ExampleMessage example_message;
-  std::string type_name = tiny_dds::serialization::ProtobufSerializer::GetTypeName(example_message);
+  using tiny_dds::examples::ExampleMessage;
+  std::string type_name = tiny_dds::TopicType<ExampleMessage>::Name();
 
   // Create topics
   auto publisher_topic = publisher_participant->CreateTopic(topic_name, type_name);
   auto subscriber_topic = subscriber_participant->CreateTopic(topic_name, type_name);
 
-  // Create data writer and reader
-  auto data_writer = publisher->CreateDataWriter(publisher_topic);
-  auto data_reader = subscriber->CreateDataReader(subscriber_topic);
+  // Create typed data writer and reader, which serialize and deserialize the messages
+  auto data_writer = tiny_dds::TypedDataWriter<ExampleMessage>::Create(
+      publisher->CreateDataWriter(publisher_topic));
+  auto data_reader = tiny_dds::TypedDataReader<ExampleMessage>::Create(
+      subscriber->CreateDataReader(subscriber_topic));
 
   // Set up data received callback
   data_reader->SetDataReceivedCallback(
-      [](const void* data, size_t size, const tiny_dds::SampleInfo& info) {
-        std::cout << "Received data of size " << size << " bytes" << std::endl;
-
-        // Deserialize the message
-        tiny_dds::examples::ExampleMessage message;
-        if (tiny_dds::serialization::ProtobufSerializer::Deserialize(data, size, &message)) {
-          std::cout << "Deserialized message:" << std::endl;
-          std::cout << "  ID: " << message.id() << std::endl;
-          std::cout << "  Text: " << message.text() << std::endl;
-          std::cout << "  Value: " << message.value() << std::endl;
-          std::cout << "  Data: [";
-          for (int i = 0; i < message.data_size(); ++i) {
-            if (i > 0)
-              std::cout << ", ";
-            std::cout << message.data(i);
-          }
-          std::cout << "]" << std::endl;
-        } else {
-          std::cout << "Failed to deserialize message" << std::endl;
+      [](const ExampleMessage& message, const tiny_dds::SampleInfo& info) {
+        std::cout << "Received message:" << std::endl;
+        std::cout << "  ID: " << message.id() << std::endl;
+        std::cout << "  Text: " << message.text() << std::endl;
+        std::cout << "  Value: " << message.value() << std::endl;
+        std::cout << "  Data: [";
+        for (int i = 0; i < message.data_size(); ++i) {
+          if (i > 0)
+            std::cout << ", ";
+          std::cout << message.data(i);
         }
+        std::cout << "]" << std::endl;
       });
 
   // Publish messages
   for (int i = 0; i < num_messages; ++i) {
     // Create and populate a message
-    tiny_dds::examples::ExampleMessage message;
+    ExampleMessage message;
     message.set_id(i + 1);
     message.set_text("Message #" + std::to_string(i + 1));
     message.set_value(3.14159 * (i + 1));
@@ -100,13 +93,9 @@ int main(int argc, char* argv[]) {
       message.add_data((i + 1) * 10 + j);
     }
 
-    // Serialize the message
-    std::vector<uint8_t> serialized =
-        tiny_dds::serialization::ProtobufSerializer::Serialize(message);
-
     // Write the data
     std::cout << "Publishing message " << (i + 1) << " of " << num_messages << std::endl;
-    if (data_writer->Write(serialized.data(), serialized.size())) {
+    if (data_writer->Write(message)) {
       std::cout << "Published successfully" << std::endl;
     } else {
       std::cout << "Failed to publish" << std::endl;
@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "include/tiny_dds/data_writer.h"
+#include "include/tiny_dds/domain_participant.h"
+#include "include/tiny_dds/publisher.h"
+#include "include/tiny_dds/topic.h"
+#include "include/tiny_dds/transport_types.h"
+#include "include/tiny_dds/types.h"
+
+ABSL_FLAG(int, domain_id, 0, "Domain ID to use for the benchmark");
+ABSL_FLAG(std::string, transport, "UDP",
+          "Transport to write on: UDP, SHARED_MEMORY, TCP, UNIX_SOCKET, LOCAL_ONLY or AUTO");
+ABSL_FLAG(int, max_threads, 0, "Largest number of writing threads; 0 for one per core");
+ABSL_FLAG(int, writes_per_thread, 100000, "Number of samples each thread writes");
+ABSL_FLAG(int, sample_size, 256, "Size of each sample in bytes");
+ABSL_FLAG(bool, shared_writer, true,
+          "Whether all threads write through one DataWriter, or each through its own");
+ABSL_FLAG(std::string, durability, "VOLATILE",
+          "Durability of the writers: VOLATILE, TRANSIENT_LOCAL or PERSISTENT");
+ABSL_FLAG(std::string, persistence_directory, "/tmp/tiny_dds_write_benchmark",
+          "Directory of the topic logs of PERSISTENT writers");
+
+namespace {
+
+// Parses the durability flag; returns false for an unknown kind
+bool ParseDurability(const std::string& name, tiny_dds::DurabilityKind* kind) {
+  if (name == "VOLATILE") {
+    *kind = tiny_dds::DurabilityKind::VOLATILE;
+  } else if (name == "TRANSIENT_LOCAL") {
+    *kind = tiny_dds::DurabilityKind::TRANSIENT_LOCAL;
+  } else if (name == "PERSISTENT") {
+    *kind = tiny_dds::DurabilityKind::PERSISTENT;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+struct RunResult {
+  double seconds = 0;
+  int64_t writes = 0;
+  int64_t failures = 0;
+};
+
+// Writes from a number of threads at once, all started together
+RunResult Run(const std::vector<std::shared_ptr<tiny_dds::DataWriter>>& writers, int threads,
+              int writes_per_thread, int sample_size) {
+  std::atomic<bool> start{false};
+  std::atomic<int64_t> failures{0};
+  std::vector<std::thread> workers;
+  for (int i = 0; i < threads; ++i) {
+    workers.emplace_back([&, i]() {
+      tiny_dds::DataWriter& writer = *writers[static_cast<size_t>(i) % writers.size()];
+      std::vector<uint8_t> sample(static_cast<size_t>(sample_size), static_cast<uint8_t>(i));
+      while (!start.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+
+      int64_t failed = 0;
+      for (int n = 0; n < writes_per_thread; ++n) {
+        if (!writer.Write(sample.data(), sample.size())) {
+          ++failed;
+        }
+      }
+      failures.fetch_add(failed, std::memory_order_relaxed);
+    });
+  }
+
+  const auto begin = std::chrono::steady_clock::now();
+  start.store(true, std::memory_order_release);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  RunResult result;
+  result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+  result.writes = static_cast<int64_t>(threads) * writes_per_thread;
+  result.failures = failures.load();
+  return result;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  absl::ParseCommandLine(argc, argv);
+
+  const int domain_id = absl::GetFlag(FLAGS_domain_id);
+  const tiny_dds::TransportType transport =
+      tiny_dds::StringToTransportType(absl::GetFlag(FLAGS_transport));
+  int max_threads = absl::GetFlag(FLAGS_max_threads);
+  if (max_threads <= 0) {
+    max_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+  }
+  const int writes_per_thread = absl::GetFlag(FLAGS_writes_per_thread);
+  const int sample_size = absl::GetFlag(FLAGS_sample_size);
+  const bool shared_writer = absl::GetFlag(FLAGS_shared_writer);
+
+  // Durable writers order their writes to keep the history or log in sequence order
+  tiny_dds::DataWriterQos qos;
+  if (!ParseDurability(absl::GetFlag(FLAGS_durability), &qos.durability)) {
+    std::cerr << "Unknown durability: " << absl::GetFlag(FLAGS_durability) << std::endl;
+    return 1;
+  }
+  qos.persistence.directory = absl::GetFlag(FLAGS_persistence_directory);
+
+  std::cout << "Transport: " << tiny_dds::TransportTypeToString(transport) << std::endl;
+  std::cout << "Sample size: " << sample_size << " bytes" << std::endl;
+  std::cout << "Writers: " << (shared_writer ? "one shared by all threads" : "one per thread")
+            << std::endl;
+  std::cout << "Durability: " << absl::GetFlag(FLAGS_durability) << std::endl;
+
+  auto participant = tiny_dds::DomainParticipant::Create(domain_id, "write_benchmark");
+  if (!participant->SetTransportType(transport)) {
+    std::cerr << "Failed to set the transport" << std::endl;
+    return 1;
+  }
+  auto publisher = participant->CreatePublisher();
+
+  // Writers of separate topics, so that each thread can have its own
+  std::vector<std::shared_ptr<tiny_dds::DataWriter>> writers;
+  for (int i = 0; i < (shared_writer ? 1 : max_threads); ++i) {
+    auto topic = participant->CreateTopic("write_benchmark_" + std::to_string(i), "RawData");
+    writers.push_back(publisher->CreateDataWriter(topic, qos));
+  }
+
+  // Warm up the thread-local buffers and the transport
+  Run(writers, 1, std::min(writes_per_thread, 1000), sample_size);
+
+  std::cout << std::setw(8) << "threads" << std::setw(16) << "writes/s" << std::setw(20)
+            << "writes/s/thread" << std::setw(10) << "scaling" << std::setw(10) << "failed"
+            << std::endl;
+  double single_thread_rate = 0;
+  for (int threads = 1; threads <= max_threads; threads *= 2) {
+    const RunResult result = Run(writers, threads, writes_per_thread, sample_size);
+    const double rate = static_cast<double>(result.writes) / result.seconds;
+    if (threads == 1) {
+      single_thread_rate = rate;
+    }
+    std::cout << std::setw(8) << threads << std::setw(16) << std::fixed << std::setprecision(0)
+              << rate << std::setw(20) << rate / threads << std::setw(9) << std::setprecision(2)
+              << rate / single_thread_rate << "x" << std::setw(10) << result.failures
+              << std::endl;
+  }
+
+  return 0;
+}
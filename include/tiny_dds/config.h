@@ -18,6 +18,13 @@ namespace config {
 struct QosConfig {
   ReliabilityKind reliability = ReliabilityKind::BEST_EFFORT;
   DurabilityKind durability = DurabilityKind::VOLATILE;
+  HistoryQos history;
+  PersistenceQos persistence;            // For PERSISTENT publishers
+  TimeBasedFilterQos time_based_filter;  // For subscribers
+  DeadlineQos deadline;
+  LivelinessQos liveliness;
+  LatencyBudgetQos latency_budget;          // For publishers
+  TransportPriorityQos transport_priority;  // For publishers
   // Other QoS settings can be added here
 };
 
@@ -34,6 +41,14 @@ struct TransportConfig {
   // UDP specific configuration (can be expanded as needed)
   std::string address = "127.0.0.1";
   int port = 0;  // 0 means auto-assign
+
+  // Coalescing of small samples into shared datagrams (UDP publishers only)
+  bool coalescing_enabled = false;
+  CoalescingConfig coalescing;
+
+  // ASYNCHRONOUS publish mode (publishers only)
+  bool async_publishing_enabled = false;
+  AsyncPublishConfig async_publishing;
 };
 
 /**
@@ -42,6 +57,7 @@ struct TransportConfig {
 struct TopicConfig {
   std::string name;
   std::string type_name;
+  std::vector<int32_t> key_fields;  // Protobuf field numbers of the key, if the topic is keyed
   QosConfig qos;
 };
 
@@ -0,0 +1,333 @@
+#ifndef TINY_DDS_COROUTINE_H_
+#define TINY_DDS_COROUTINE_H_
+
+// Awaitable reads and writes for C++20 coroutines. The rest of the library is
+// C++17; this header is empty unless it is compiled with coroutine support.
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <utility>
+
+#include "include/tiny_dds/data_reader.h"
+#include "include/tiny_dds/data_writer.h"
+#include "include/tiny_dds/executor.h"
+#include "include/tiny_dds/types.h"
+
+#define TINY_DDS_HAS_COROUTINES 1
+
+namespace tiny_dds {
+
+/**
+ * @brief Return type of coroutines that run on their own once started.
+ *
+ * The coroutine starts right away, on the calling thread, and its frame is
+ * freed when it returns. Exceptions escaping it terminate the process.
+ */
+struct DetachedTask {
+  struct promise_type {
+    DetachedTask get_return_object() noexcept { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { std::terminate(); }
+  };
+};
+
+namespace coroutine_internal {
+
+// Suspends a coroutine until an operation completes, then resumes it on the
+// executor, or on the thread that completed the operation if there is none.
+// The operation may complete on another thread before await_suspend is done
+// with the coroutine; whichever of the two comes second resumes it, so an
+// operation completing right away continues the coroutine without suspending.
+class Suspension {
+ public:
+  explicit Suspension(Executor* executor) : executor_(executor) {}
+
+  Suspension(const Suspension&) = delete;
+  Suspension& operator=(const Suspension&) = delete;
+
+ protected:
+  // Records the coroutine; returns whether it stays suspended
+  bool Suspend(std::coroutine_handle<> handle) {
+    handle_ = handle;
+    return !completed_.exchange(true, std::memory_order_acq_rel);
+  }
+
+  // Records that the operation completed, and resumes the coroutine if it is suspended
+  void Complete() {
+    if (!completed_.exchange(true, std::memory_order_acq_rel)) {
+      return;
+    }
+    if (executor_ != nullptr) {
+      executor_->Post([handle = handle_]() { handle.resume(); });
+    } else {
+      handle_.resume();
+    }
+  }
+
+ private:
+  Executor* executor_;
+  std::coroutine_handle<> handle_;
+  std::atomic<bool> completed_{false};
+};
+
+}  // namespace coroutine_internal
+
+/**
+ * @brief Awaits the next sample of a reader, see AsyncDataReader::NextSample.
+ */
+class SampleAwaitable : private coroutine_internal::Suspension {
+ public:
+  SampleAwaitable(DataReader* reader, Executor* executor, void* buffer, size_t buffer_size,
+                  SampleInfo* info)
+      : Suspension(executor),
+        reader_(reader),
+        buffer_(buffer),
+        buffer_size_(buffer_size),
+        info_(info) {}
+
+  bool await_ready() {
+    result_ = reader_->Take(buffer_, buffer_size_, *info_);
+    return result_ >= 0;
+  }
+
+  bool await_suspend(std::coroutine_handle<> handle) {
+    reader_->NotifyDataAvailable([this]() {
+      result_ = reader_->Take(buffer_, buffer_size_, *info_);
+      Complete();
+    });
+    return Suspend(handle);
+  }
+
+  int32_t await_resume() const { return result_; }
+
+ private:
+  DataReader* reader_;
+  void* buffer_;
+  size_t buffer_size_;
+  SampleInfo* info_;
+  int32_t result_ = -1;
+};
+
+/**
+ * @brief Awaits a batch of samples of a reader, see AsyncDataReader::TakeBatch.
+ */
+class BatchAwaitable : private coroutine_internal::Suspension {
+ public:
+  BatchAwaitable(DataReader* reader, Executor* executor, SampleBuffer* buffers, SampleInfo* infos,
+                 size_t max_samples)
+      : Suspension(executor),
+        reader_(reader),
+        buffers_(buffers),
+        infos_(infos),
+        max_samples_(max_samples) {}
+
+  bool await_ready() {
+    result_ = reader_->TakeN(buffers_, infos_, max_samples_, ANY_SAMPLE_STATE);
+    return result_ > 0;
+  }
+
+  bool await_suspend(std::coroutine_handle<> handle) {
+    reader_->NotifyDataAvailable([this]() {
+      result_ = reader_->TakeN(buffers_, infos_, max_samples_, ANY_SAMPLE_STATE);
+      Complete();
+    });
+    return Suspend(handle);
+  }
+
+  int32_t await_resume() const { return result_; }
+
+ private:
+  DataReader* reader_;
+  SampleBuffer* buffers_;
+  SampleInfo* infos_;
+  size_t max_samples_;
+  int32_t result_ = 0;
+};
+
+/**
+ * @brief Awaits a write being sent, see AsyncDataWriter::WriteReliable.
+ */
+class WriteAwaitable : private coroutine_internal::Suspension {
+ public:
+  WriteAwaitable(DataWriter* writer, Executor* executor, const void* data, size_t size)
+      : Suspension(executor), writer_(writer), data_(data), size_(size) {}
+
+  bool await_ready() { return false; }
+
+  bool await_suspend(std::coroutine_handle<> handle) {
+    written_ = writer_->Write(data_, size_);
+    retried_ = written_;
+    writer_->NotifyWhenSent([this]() { OnSent(); });
+    return Suspend(handle);
+  }
+
+  bool await_resume() const { return written_; }
+
+ private:
+  // A write rejected by a full queue is retried once the queue has drained
+  void OnSent() {
+    if (!retried_) {
+      retried_ = true;
+      written_ = writer_->Write(data_, size_);
+      if (written_) {
+        writer_->NotifyWhenSent([this]() { OnSent(); });
+        return;
+      }
+    }
+    Complete();
+  }
+
+  DataWriter* writer_;
+  const void* data_;
+  size_t size_;
+  bool written_ = false;
+  bool retried_ = false;
+};
+
+/**
+ * @brief Awaitable takes from a DataReader, for coroutines.
+ *
+ * A coroutine awaiting a sample is suspended without a thread: the reader
+ * resumes it when a sample is queued, on the thread that queued it (the
+ * participant's receive thread, or the writer's thread for LOCAL_ONLY), or on
+ * the executor given at creation. Awaiting allocates nothing once the reader
+ * has notified a first awaiter, so many coroutines can each serve a reader on
+ * a few threads.
+ *
+ * The reader must have no data callback, since samples handed to callbacks
+ * are not queued. A suspended coroutine must not be destroyed before it is
+ * resumed, and the buffers it awaits into must stay valid until then.
+ */
+class AsyncDataReader {
+ public:
+  /**
+   * @brief Wraps a DataReader.
+   * @param reader The reader.
+   * @param executor Executor to resume awaiting coroutines on, or null to resume
+   * them on the thread that queued the sample.
+   * @return The asynchronous reader, or nullptr if reader is null.
+   */
+  static auto Create(std::shared_ptr<DataReader> reader,
+                     std::shared_ptr<Executor> executor = nullptr)
+      -> std::shared_ptr<AsyncDataReader> {
+    if (!reader) {
+      return nullptr;
+    }
+    return std::shared_ptr<AsyncDataReader>(
+        new AsyncDataReader(std::move(reader), std::move(executor)));
+  }
+
+  /**
+   * @brief Takes the oldest sample, once one is queued.
+   *
+   * Awaiting yields the sample's size, as Take returns it, or -1 if the
+   * sample is larger than the buffer or another consumer took it first.
+   *
+   * @param[out] buffer Storage for the sample.
+   * @param buffer_size Size of the buffer in bytes.
+   * @param[out] info Sample information.
+   * @return The awaitable.
+   */
+  auto NextSample(void* buffer, size_t buffer_size, SampleInfo& info) -> SampleAwaitable {
+    return SampleAwaitable(reader_.get(), executor_.get(), buffer, buffer_size, &info);
+  }
+
+  /**
+   * @brief Takes up to max_samples samples, once at least one is queued.
+   *
+   * Awaiting yields the number of samples taken, as TakeN returns it, or 0 if
+   * the oldest sample is larger than its buffer or another consumer took the
+   * samples first.
+   *
+   * @param[in,out] buffers Storage for the samples; each size is set to the sample's size.
+   * @param[out] infos Sample information, one per buffer.
+   * @param max_samples Number of entries in buffers and infos.
+   * @return The awaitable.
+   */
+  auto TakeBatch(SampleBuffer* buffers, SampleInfo* infos, size_t max_samples)
+      -> BatchAwaitable {
+    return BatchAwaitable(reader_.get(), executor_.get(), buffers, infos, max_samples);
+  }
+
+  /**
+   * @brief Gets the wrapped reader.
+   * @return The reader.
+   */
+  auto GetDataReader() const -> const std::shared_ptr<DataReader>& { return reader_; }
+
+ private:
+  AsyncDataReader(std::shared_ptr<DataReader> reader, std::shared_ptr<Executor> executor)
+      : reader_(std::move(reader)), executor_(std::move(executor)) {}
+
+  std::shared_ptr<DataReader> reader_;
+  std::shared_ptr<Executor> executor_;
+};
+
+/**
+ * @brief Awaitable writes to a DataWriter, for coroutines.
+ *
+ * WriteReliable completes once the sample has been sent. It is sent by the
+ * write itself unless the publisher publishes asynchronously; then the
+ * coroutine is resumed by the publisher's flusher thread, or on the executor
+ * given at creation, and a write rejected because the queue is full is
+ * retried once the queue has drained rather than failing.
+ */
+class AsyncDataWriter {
+ public:
+  /**
+   * @brief Wraps a DataWriter.
+   * @param writer The writer.
+   * @param executor Executor to resume awaiting coroutines on, or null to resume
+   * them on the thread that sent the sample.
+   * @return The asynchronous writer, or nullptr if writer is null.
+   */
+  static auto Create(std::shared_ptr<DataWriter> writer,
+                     std::shared_ptr<Executor> executor = nullptr)
+      -> std::shared_ptr<AsyncDataWriter> {
+    if (!writer) {
+      return nullptr;
+    }
+    return std::shared_ptr<AsyncDataWriter>(
+        new AsyncDataWriter(std::move(writer), std::move(executor)));
+  }
+
+  /**
+   * @brief Writes a sample and completes once it has been sent.
+   *
+   * Awaiting yields true if the sample was sent, false if it could not be
+   * written even after the publisher's queue drained.
+   *
+   * @param data The sample; it must stay valid until the write completes.
+   * @param size Size of the sample in bytes.
+   * @return The awaitable.
+   */
+  auto WriteReliable(const void* data, size_t size) -> WriteAwaitable {
+    return WriteAwaitable(writer_.get(), executor_.get(), data, size);
+  }
+
+  /**
+   * @brief Gets the wrapped writer.
+   * @return The writer.
+   */
+  auto GetDataWriter() const -> const std::shared_ptr<DataWriter>& { return writer_; }
+
+ private:
+  AsyncDataWriter(std::shared_ptr<DataWriter> writer, std::shared_ptr<Executor> executor)
+      : writer_(std::move(writer)), executor_(std::move(executor)) {}
+
+  std::shared_ptr<DataWriter> writer_;
+  std::shared_ptr<Executor> executor_;
+};
+
+}  // namespace tiny_dds
+
+#endif  // defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#endif  // TINY_DDS_COROUTINE_H_
@@ -1,15 +1,23 @@
 #ifndef TINY_DDS_DATA_READER_H_
 #define TINY_DDS_DATA_READER_H_
 
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "include/tiny_dds/executor.h"
 #include "include/tiny_dds/types.h"
 
 // Forward declarations
+namespace google::protobuf {
+class Message;
+}  // namespace google::protobuf
+
 namespace tiny_dds {
+class ReadCondition;
+class StatusCondition;
 class Topic;
 
 /**
@@ -33,6 +41,53 @@ using DataReaderCallback =
 using DataCallback = std::function<void(DomainId domain_id, const std::string& topic_name,
                                         const void* data, size_t size)>;
 
+/**
+ * @brief Callback function type for deadlines a reader missed.
+ *
+ * @param status The status, with the changes since it was last reported.
+ */
+using RequestedDeadlineMissedCallback =
+    std::function<void(const RequestedDeadlineMissedStatus& status)>;
+
+/**
+ * @brief Callback function type for writers becoming alive or not alive.
+ *
+ * @param status The status, with the changes since it was last reported.
+ */
+using LivelinessChangedCallback = std::function<void(const LivelinessChangedStatus& status)>;
+
+/**
+ * @brief A pooled Protocol Buffers arena lent out with a message allocated on it.
+ */
+class LoanedArena {
+ public:
+  virtual ~LoanedArena() = default;
+
+  /**
+   * @brief Destroys the messages on the arena and returns it to its pool.
+   */
+  virtual void Release() = 0;
+};
+
+/**
+ * @brief Deleter of messages taken with DataReader::TakeArenaMessage, releasing their arena.
+ */
+struct ArenaMessageDeleter {
+  LoanedArena* arena = nullptr;
+
+  void operator()(const google::protobuf::Message* /*message*/) const {
+    if (arena != nullptr) {
+      arena->Release();
+    }
+  }
+};
+
+/**
+ * @brief A message allocated on a pooled arena; the arena is released with the message.
+ */
+template <typename T = google::protobuf::Message>
+using ArenaMessagePtr = std::unique_ptr<T, ArenaMessageDeleter>;
+
 /**
  * @brief DataReader is the interface for reading data from a topic.
  *
@@ -43,7 +98,11 @@ class DataReader {
   virtual ~DataReader() = default;
 
   /**
-   * @brief Reads the next available data sample.
+   * @brief Reads the oldest sample not read yet, leaving it in the reader's history.
+   *
+   * The sample is marked READ; it stays available to Take and to reads
+   * selecting READ samples until it is taken or replaced by the history.
+   *
    * @param[out] buffer Buffer to store the data.
    * @param[in] buffer_size Size of the buffer.
    * @param[out] info Sample information.
@@ -52,7 +111,7 @@ class DataReader {
   virtual int32_t Read(void* buffer, size_t buffer_size, SampleInfo& info) = 0;
 
   /**
-   * @brief Takes the next available data sample (removes it from the reader's queue).
+   * @brief Takes the oldest available data sample (removes it from the reader's history).
    * @param[out] buffer Buffer to store the data.
    * @param[in] buffer_size Size of the buffer.
    * @param[out] info Sample information.
@@ -60,6 +119,114 @@ class DataReader {
    */
   virtual int32_t Take(void* buffer, size_t buffer_size, SampleInfo& info) = 0;
 
+  /**
+   * @brief Takes the next data sample, waiting up to a timeout for one to arrive.
+   * @param[out] buffer Buffer to store the data.
+   * @param[in] buffer_size Size of the buffer.
+   * @param[out] info Sample information.
+   * @param[in] timeout The maximum time to wait.
+   * @return Number of bytes read, or -1 if no data arrived before the timeout.
+   */
+  virtual int32_t Take(void* buffer, size_t buffer_size, SampleInfo& info,
+                       std::chrono::nanoseconds timeout) = 0;
+
+  /**
+   * @brief Reads up to max_samples samples in the given states under a single lock.
+   *
+   * Samples are copied oldest first into the caller's buffers and marked READ.
+   * The read stops early at a sample larger than its buffer.
+   *
+   * @param[in,out] buffers Storage for the samples; each size is set to the sample's size.
+   * @param[out] infos Sample information, one per buffer.
+   * @param[in] max_samples Number of entries in buffers and infos.
+   * @param[in] sample_states A combination of the *_SAMPLE_STATE constants.
+   * @return The number of samples read.
+   */
+  virtual int32_t ReadN(SampleBuffer* buffers, SampleInfo* infos, size_t max_samples,
+                        SampleStateMask sample_states) = 0;
+
+  /**
+   * @brief Takes up to max_samples samples in the given states under a single lock.
+   *
+   * Same as ReadN, but the samples are removed from the reader's history.
+   *
+   * @param[in,out] buffers Storage for the samples; each size is set to the sample's size.
+   * @param[out] infos Sample information, one per buffer.
+   * @param[in] max_samples Number of entries in buffers and infos.
+   * @param[in] sample_states A combination of the *_SAMPLE_STATE constants.
+   * @return The number of samples taken.
+   */
+  virtual int32_t TakeN(SampleBuffer* buffers, SampleInfo* infos, size_t max_samples,
+                        SampleStateMask sample_states) = 0;
+
+  /**
+   * @brief Takes the next available data sample as a Protocol Buffers message.
+   *
+   * Samples written with WriteMessage on a LOCAL_ONLY participant are copied
+   * from the writer's object without a serialization round trip.
+   *
+   * @param[out] message The message to fill in.
+   * @param[out] info Sample information.
+   * @return True if a sample was taken, false if no data is available.
+   */
+  virtual bool TakeMessage(google::protobuf::Message* message, SampleInfo& info) = 0;
+
+  /**
+   * @brief Takes the next available data sample as a message allocated on a pooled arena.
+   *
+   * The message's strings and repeated fields are allocated on the arena, in
+   * one block sized from the messages the reader has taken so far, so taking
+   * large messages does not allocate once the pool is warm. Releasing the
+   * message resets the arena and returns it to the reader's pool; messages may
+   * outlive the reader.
+   *
+   * @param[in] prototype A message of the topic's type, such as its default instance.
+   * @param[out] info Sample information.
+   * @return The message, or nullptr if no valid sample is available.
+   */
+  virtual ArenaMessagePtr<> TakeArenaMessage(const google::protobuf::Message& prototype,
+                                             SampleInfo& info) = 0;
+
+  /**
+   * @brief Gets the handle of the instance of a keyed topic with the key of a sample.
+   *
+   * Only the key fields of the sample are read, so a message with just the key
+   * fields set will do. Handles stay valid for the lifetime of the reader.
+   *
+   * @param key_holder Pointer to a serialized sample with the key.
+   * @param size Size of the serialized sample in bytes.
+   * @return The handle of the instance, or HANDLE_NIL if the topic is not keyed or the
+   *         reader has not received a sample of the instance.
+   */
+  virtual InstanceHandle LookupInstance(const void* key_holder, size_t size) = 0;
+
+  /**
+   * @brief Gets the handle of the instance of a keyed topic with the key of a message.
+   * @param key_holder A message of the topic's type with the key.
+   * @return The handle of the instance, or HANDLE_NIL if there is none.
+   */
+  virtual InstanceHandle LookupInstance(const google::protobuf::Message& key_holder) = 0;
+
+  /**
+   * @brief Reads the last sample of one instance, leaving it in the reader's history.
+   *
+   * Every instance keeps its last sample apart from the history, so it can be
+   * read after it was taken or replaced there, and the reader serves as a cache
+   * of the current state of every instance. The sample is found by the handle
+   * alone, and samples still waiting on the transport are not fetched; the
+   * reader's receive thread queues them. Unlike Read, the sample state is left
+   * unchanged.
+   *
+   * @param[in] handle The handle of the instance, from LookupInstance or SampleInfo.
+   * @param[out] buffer Buffer to store the data.
+   * @param[in] buffer_size Size of the buffer.
+   * @param[out] info Sample information.
+   * @return Number of bytes read, or -1 if the instance has no sample yet or the
+   *         buffer is too small.
+   */
+  virtual int32_t ReadInstance(InstanceHandle handle, void* buffer, size_t buffer_size,
+                               SampleInfo& info) = 0;
+
   /**
    * @brief Sets a callback function to be called when data is received.
    * @param callback The callback function.
@@ -84,6 +251,96 @@ class DataReader {
    * @return The current subscription matched status.
    */
   virtual SubscriptionMatchedStatus GetSubscriptionMatchedStatus() const = 0;
+
+  /**
+   * @brief Gets the deadlines missed by the writers of this reader's instances.
+   *
+   * The change count is reset, and REQUESTED_DEADLINE_MISSED_STATUS cleared.
+   *
+   * @return The requested deadline missed status.
+   */
+  virtual RequestedDeadlineMissedStatus GetRequestedDeadlineMissedStatus() = 0;
+
+  /**
+   * @brief Gets the liveliness of the writers this reader heard from.
+   *
+   * The change counts are reset, and LIVELINESS_CHANGED_STATUS cleared.
+   *
+   * @return The liveliness changed status.
+   */
+  virtual LivelinessChangedStatus GetLivelinessChangedStatus() = 0;
+
+  /**
+   * @brief Sets a callback called on every missed deadline, on the thread chosen for callbacks.
+   *
+   * The status passed to the callback counts as read by the application.
+   *
+   * @param callback The callback function, or null to remove it.
+   */
+  virtual void SetRequestedDeadlineMissedCallback(RequestedDeadlineMissedCallback callback) = 0;
+
+  /**
+   * @brief Sets a callback called when a writer becomes alive or not alive.
+   *
+   * The status passed to the callback counts as read by the application.
+   *
+   * @param callback The callback function, or null to remove it.
+   */
+  virtual void SetLivelinessChangedCallback(LivelinessChangedCallback callback) = 0;
+
+  /**
+   * @brief Runs this reader's callbacks on an executor instead of the participant's threading.
+   *
+   * Callbacks run on strands of the executor, so that those of one reader, or
+   * of one instance with PER_INSTANCE, run in the order the samples were
+   * received and never concurrently, while other readers' callbacks run in
+   * parallel on the other workers.
+   *
+   * @param executor The executor, or null to follow the participant's callback threading again.
+   * @param ordering Which callbacks keep their order.
+   */
+  virtual void SetCallbackExecutor(std::shared_ptr<Executor> executor,
+                                   CallbackOrdering ordering = CallbackOrdering::PER_READER) = 0;
+
+  /**
+   * @brief Runs a function once samples are queued in this reader's history.
+   *
+   * The function runs right away if samples are queued already, otherwise on
+   * the thread that queues the next sample. It runs once; register it again
+   * to be told about later samples. Readers with data callbacks queue no
+   * samples, so the function only runs for readers without them.
+   *
+   * @param listener The function; it must not block, and may Take from this reader.
+   */
+  virtual void NotifyDataAvailable(std::function<void()> listener) = 0;
+
+  /**
+   * @brief Creates a condition triggered while this reader has samples in its history.
+   * @return A shared pointer to the created ReadCondition.
+   */
+  virtual std::shared_ptr<ReadCondition> CreateReadCondition() = 0;
+
+  /**
+   * @brief Creates a condition triggered while this reader has samples in the given states.
+   *
+   * A condition on NOT_READ_SAMPLE_STATE suits consumers that Read rather than
+   * Take, since samples they have read stay in the history.
+   *
+   * @param sample_states A combination of the *_SAMPLE_STATE constants.
+   * @return A shared pointer to the created ReadCondition.
+   */
+  virtual std::shared_ptr<ReadCondition> CreateReadCondition(SampleStateMask sample_states) = 0;
+
+  /**
+   * @brief Gets the condition triggered by status changes of this reader.
+   *
+   * DATA_AVAILABLE_STATUS is enabled by default. It is set when a sample is
+   * queued and cleared by every read or take. REQUESTED_DEADLINE_MISSED_STATUS
+   * and LIVELINESS_CHANGED_STATUS are cleared by getting their status.
+   *
+   * @return A shared pointer to the reader's StatusCondition.
+   */
+  virtual std::shared_ptr<StatusCondition> GetStatusCondition() = 0;
 };
 
 }  // namespace tiny_dds
@@ -1,15 +1,35 @@
 #ifndef TINY_DDS_DATA_WRITER_H_
 #define TINY_DDS_DATA_WRITER_H_
 
+#include <functional>
 #include <memory>
 #include <string>
 
 #include "include/tiny_dds/types.h"
 
 // Forward declarations
+namespace google::protobuf {
+class Message;
+}  // namespace google::protobuf
+
 namespace tiny_dds {
 class Topic;
 
+/**
+ * @brief Callback function type for deadlines a writer missed.
+ *
+ * @param status The status, with the changes since it was last reported.
+ */
+using OfferedDeadlineMissedCallback =
+    std::function<void(const OfferedDeadlineMissedStatus& status)>;
+
+/**
+ * @brief Callback function type for a MANUAL_BY_TOPIC writer losing its liveliness.
+ *
+ * @param status The status, with the changes since it was last reported.
+ */
+using LivelinessLostCallback = std::function<void(const LivelinessLostStatus& status)>;
+
 /**
  * @brief DataWriter is the interface for writing data to a topic.
  *
@@ -27,6 +47,29 @@ class DataWriter {
    */
   virtual bool Write(const void* data, size_t size) = 0;
 
+  /**
+   * @brief Writes a data sample held in a reference-counted buffer.
+   *
+   * On LOCAL_ONLY participants the buffer is shared with every matched reader
+   * instead of being copied. The buffer must not be modified after the call.
+   *
+   * @param data The serialized message data.
+   * @param size Size of the serialized data in bytes.
+   * @return True if write was successful, false otherwise.
+   */
+  virtual bool WriteShared(std::shared_ptr<const void> data, size_t size) = 0;
+
+  /**
+   * @brief Writes a Protocol Buffers message.
+   *
+   * On LOCAL_ONLY participants the message object is handed to matched readers
+   * without being serialized; other transports serialize it once.
+   *
+   * @param message The message to write. It must not be modified after the call.
+   * @return True if write was successful, false otherwise.
+   */
+  virtual bool WriteMessage(std::shared_ptr<const google::protobuf::Message> message) = 0;
+
   /**
    * @brief Gets the topic associated with this DataWriter.
    * @return A shared pointer to the associated Topic.
@@ -38,6 +81,57 @@ class DataWriter {
    * @return The current publication matched status.
    */
   virtual PublicationMatchedStatus GetPublicationMatchedStatus() const = 0;
+
+  /**
+   * @brief Asserts the liveliness of this writer without writing a sample.
+   *
+   * Readers receive a heartbeat. Needed by MANUAL_BY_TOPIC writers that may
+   * not write within their lease duration.
+   *
+   * @return True if the heartbeat was sent, false otherwise.
+   */
+  virtual bool AssertLiveliness() = 0;
+
+  /**
+   * @brief Gets the deadlines this writer missed; the change count is reset.
+   * @return The offered deadline missed status.
+   */
+  virtual OfferedDeadlineMissedStatus GetOfferedDeadlineMissedStatus() = 0;
+
+  /**
+   * @brief Gets the times this writer lost its liveliness; the change count is reset.
+   * @return The liveliness lost status.
+   */
+  virtual LivelinessLostStatus GetLivelinessLostStatus() = 0;
+
+  /**
+   * @brief Sets a callback called on every missed deadline, on the thread chosen for callbacks.
+   *
+   * The status passed to the callback counts as read by the application.
+   *
+   * @param callback The callback function, or null to remove it.
+   */
+  virtual void SetOfferedDeadlineMissedCallback(OfferedDeadlineMissedCallback callback) = 0;
+
+  /**
+   * @brief Sets a callback called when this writer loses its liveliness.
+   *
+   * The status passed to the callback counts as read by the application.
+   *
+   * @param callback The callback function, or null to remove it.
+   */
+  virtual void SetLivelinessLostCallback(LivelinessLostCallback callback) = 0;
+
+  /**
+   * @brief Runs a function once every sample written so far has been sent.
+   *
+   * Samples are sent by Write itself unless the publisher publishes
+   * asynchronously, so the function runs right away unless samples are queued
+   * for the publisher's flusher thread, on which it runs once they are sent.
+   *
+   * @param listener The function; it must not block.
+   */
+  virtual void NotifyWhenSent(std::function<void()> listener) = 0;
 };
 
 }  // namespace tiny_dds
@@ -1,8 +1,11 @@
 #ifndef TINY_DDS_DOMAIN_PARTICIPANT_H_
 #define TINY_DDS_DOMAIN_PARTICIPANT_H_
 
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "include/tiny_dds/publisher.h"
 #include "include/tiny_dds/subscriber.h"
@@ -12,6 +15,21 @@
 
 namespace tiny_dds {
 
+/**
+ * @brief Threads on which DataReader callbacks are invoked.
+ */
+enum class CallbackThreading {
+  INLINE,    ///< On the thread that received the sample (the writer's thread for LOCAL_ONLY)
+  EXECUTOR,  ///< Handed to an executor, so slow callbacks do not hold up reception
+};
+
+/**
+ * @brief Executor for DataReader callbacks in EXECUTOR mode.
+ *
+ * @param task The callback invocation to run, on any thread.
+ */
+using CallbackExecutor = std::function<void(std::function<void()> task)>;
+
 /**
  * @brief Entry point for DDS communication.
  *
@@ -52,12 +70,37 @@ class DomainParticipant {
   /**
    * @brief Creates a Topic.
    *
+   * A keyed topic's type name must be the full name of a protobuf message type
+   * linked into the program, and its key fields singular scalar, string or enum
+   * fields of that type.
+   *
    * @param name The name of the topic.
    * @param type_name The name of the data type.
-   * @return A shared pointer to the created Topic.
+   * @param key_fields The protobuf field numbers of the key fields, if the topic is keyed.
+   * @return A shared pointer to the created Topic, or nullptr if a topic of that name has
+   *         another type or key, or the key fields are invalid.
    */
   virtual std::shared_ptr<Topic> CreateTopic(const std::string& name,
-                                             const std::string& type_name) = 0;
+                                             const std::string& type_name,
+                                             const std::vector<int32_t>& key_fields = {}) = 0;
+
+  /**
+   * @brief Creates a ContentFilteredTopic.
+   *
+   * The related topic's type name must be the full name of a protobuf message
+   * type linked into the program, such as "my_package.MyMessage".
+   *
+   * @param name The name of the filtered topic, distinct from other topics.
+   * @param related_topic The topic whose samples are filtered.
+   * @param filter_expression The SQL-like filter expression.
+   * @param expression_parameters Values of the %0, %1, ... parameters of the expression.
+   * @return A shared pointer to the created topic, or nullptr if the name is
+   *         taken, the type is unknown or the expression is invalid.
+   */
+  virtual std::shared_ptr<ContentFilteredTopic> CreateContentFilteredTopic(
+      const std::string& name, std::shared_ptr<Topic> related_topic,
+      const std::string& filter_expression,
+      const std::vector<std::string>& expression_parameters = {}) = 0;
 
   /**
    * @brief Gets the domain ID.
@@ -87,6 +130,20 @@ class DomainParticipant {
    * @return The transport type.
    */
   virtual TransportType GetTransportType() const = 0;
+
+  /**
+   * @brief Selects where the callbacks of this participant's DataReaders run.
+   *
+   * Samples from network transports are received by a background thread of the
+   * participant, started with its first DataReader. INLINE runs callbacks on that
+   * thread. EXECUTOR hands them to the given executor, or to a callback thread of
+   * the participant that preserves their order if no executor is given.
+   *
+   * @param threading The callback threading mode.
+   * @param executor The executor for EXECUTOR mode, or nullptr.
+   */
+  virtual void SetCallbackThreading(CallbackThreading threading,
+                                    CallbackExecutor executor = nullptr) = 0;
 };
 
 }  // namespace tiny_dds
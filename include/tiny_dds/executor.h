@@ -0,0 +1,92 @@
+#ifndef TINY_DDS_EXECUTOR_H_
+#define TINY_DDS_EXECUTOR_H_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace tiny_dds {
+
+/**
+ * @brief Configuration of an Executor.
+ */
+struct ExecutorConfig {
+  // Number of worker threads, or 0 for one per core
+  size_t workers = 0;
+
+  // CPUs the workers are pinned to, worker i to cpus[i % cpus.size()], or
+  // empty to leave them unpinned (Linux only)
+  std::vector<int> cpus;
+};
+
+/**
+ * @brief A sequence of tasks run one after the other, in the order they were posted.
+ *
+ * A strand runs on the workers of its executor, but never on two at once, so
+ * its tasks need no locking among themselves. Different strands run in parallel.
+ */
+class Strand {
+ public:
+  virtual ~Strand() = default;
+
+  /**
+   * @brief Runs a task after the tasks posted to this strand before it.
+   * @param task The task; it must own everything it refers to.
+   */
+  virtual void Post(std::function<void()> task) = 0;
+};
+
+/**
+ * @brief Pool of worker threads for DataReader callbacks and application tasks.
+ *
+ * Each worker has its own queue of tasks. Tasks posted from a worker go to its
+ * own queue, others are spread over the workers, and a worker whose queue is
+ * empty steals the oldest tasks of the others, so heavy tasks do not hold up
+ * the tasks queued behind them while other workers are idle.
+ *
+ * Tasks posted directly may run in any order and in parallel; tasks that must
+ * keep their order are posted to a strand. Queued tasks are still run when the
+ * executor is destroyed.
+ */
+class Executor {
+ public:
+  /**
+   * @brief Creates an executor and starts its workers.
+   * @param config The configuration.
+   * @return The executor.
+   */
+  static std::shared_ptr<Executor> Create(const ExecutorConfig& config = ExecutorConfig());
+
+  virtual ~Executor() = default;
+
+  /**
+   * @brief Runs a task on one of the workers.
+   * @param task The task; it must own everything it refers to.
+   */
+  virtual void Post(std::function<void()> task) = 0;
+
+  /**
+   * @brief Creates a strand running on this executor's workers.
+   * @return The strand; it may outlive the executor, whose destruction drops later tasks.
+   */
+  virtual std::shared_ptr<Strand> CreateStrand() = 0;
+
+  /**
+   * @brief Gets the number of worker threads.
+   * @return The number of workers.
+   */
+  virtual size_t WorkerCount() const = 0;
+};
+
+/**
+ * @brief How the callbacks of a DataReader are ordered on an executor.
+ */
+enum class CallbackOrdering {
+  PER_READER,    ///< All the reader's callbacks run one after the other, in order
+  PER_INSTANCE,  ///< Callbacks of one instance run in order, different instances in parallel
+};
+
+}  // namespace tiny_dds
+
+#endif  // TINY_DDS_EXECUTOR_H_
@@ -4,6 +4,9 @@
 #include <memory>
 #include <string>
 
+#include "include/tiny_dds/transport_types.h"
+#include "include/tiny_dds/types.h"
+
 // Forward declarations
 namespace tiny_dds {
 class DataWriter;
@@ -25,6 +28,57 @@ class Publisher {
    * @return A shared pointer to the created DataWriter.
    */
   virtual std::shared_ptr<DataWriter> CreateDataWriter(std::shared_ptr<Topic> topic) = 0;
+
+  /**
+   * @brief Creates a DataWriter for a specific topic with the given QoS.
+   *
+   * A TRANSIENT_LOCAL writer keeps its last samples and replays them, as one
+   * batch, to TRANSIENT_LOCAL readers that join after they were written. A
+   * PERSISTENT writer appends every sample to a log on disk and replays from
+   * the log, also after the process restarted.
+   *
+   * @param topic The topic to publish data on.
+   * @param qos The QoS of the DataWriter.
+   * @return A shared pointer to the created DataWriter.
+   */
+  virtual std::shared_ptr<DataWriter> CreateDataWriter(std::shared_ptr<Topic> topic,
+                                                       const DataWriterQos& qos) = 0;
+
+  /**
+   * @brief Sets the QoS of DataWriters later created without one.
+   * @param qos The default QoS.
+   */
+  virtual void SetDefaultDataWriterQos(const DataWriterQos& qos) = 0;
+
+  /**
+   * @brief Enables coalescing of small samples written by this publisher's DataWriters.
+   *
+   * Samples from all topics of this publisher are packed into shared datagrams
+   * and unpacked transparently by the readers.
+   *
+   * @param config The coalescing configuration.
+   * @return true if coalescing was enabled, false if the transport does not support it.
+   */
+  virtual bool EnableCoalescing(const CoalescingConfig& config) = 0;
+
+  /**
+   * @brief Switches this publisher's DataWriters to ASYNCHRONOUS publish mode.
+   *
+   * Writes only queue the sample; a flusher thread of the publisher sends it.
+   * Samples written by one DataWriter keep their order.
+   *
+   * @param config The asynchronous publishing configuration.
+   * @return true if the mode was enabled, false for LOCAL_ONLY participants,
+   *         which deliver without a transport.
+   */
+  virtual bool EnableAsynchronousPublishing(const AsyncPublishConfig& config) = 0;
+
+  /**
+   * @brief Waits until every sample queued in ASYNCHRONOUS mode has been sent.
+   *
+   * Returns immediately in the default synchronous mode.
+   */
+  virtual void Flush() = 0;
 };
 
 }  // namespace tiny_dds
@@ -4,6 +4,8 @@
 #include <memory>
 #include <string>
 
+#include "include/tiny_dds/types.h"
+
 // Forward declarations
 namespace tiny_dds {
 class DataReader;
@@ -25,6 +27,26 @@ class Subscriber {
    * @return A shared pointer to the created DataReader.
    */
   virtual std::shared_ptr<DataReader> CreateDataReader(std::shared_ptr<Topic> topic) = 0;
+
+  /**
+   * @brief Creates a DataReader for a specific topic with the given QoS.
+   *
+   * The reader preallocates its history from qos.history, so its memory use is
+   * bounded by the history depth and slot size. A TRANSIENT_LOCAL reader asks
+   * the topic's TRANSIENT_LOCAL writers for the samples they wrote before it joined.
+   *
+   * @param topic The topic to subscribe to.
+   * @param qos The QoS of the DataReader.
+   * @return A shared pointer to the created DataReader.
+   */
+  virtual std::shared_ptr<DataReader> CreateDataReader(std::shared_ptr<Topic> topic,
+                                                       const DataReaderQos& qos) = 0;
+
+  /**
+   * @brief Sets the QoS of DataReaders later created without one.
+   * @param qos The default QoS.
+   */
+  virtual void SetDefaultDataReaderQos(const DataReaderQos& qos) = 0;
 };
 
 }  // namespace tiny_dds
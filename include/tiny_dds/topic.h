@@ -1,8 +1,10 @@
 #ifndef TINY_DDS_TOPIC_H_
 #define TINY_DDS_TOPIC_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace tiny_dds {
 
@@ -28,6 +30,49 @@ class Topic {
    * @return The type name.
    */
   virtual std::string GetTypeName() const = 0;
+
+  /**
+   * @brief Gets the key fields of this topic.
+   *
+   * Samples of a keyed topic with the same values in their key fields are
+   * updates of one instance, such as one vehicle of a fleet. DataReaders keep
+   * a history per instance and can read the latest sample of one directly.
+   *
+   * @return The protobuf field numbers of the key fields, or an empty vector if the topic
+   *         is not keyed.
+   */
+  virtual std::vector<int32_t> GetKeyFields() const = 0;
+};
+
+/**
+ * @brief A Topic whose DataReaders receive only the samples of another topic
+ * that match a filter expression.
+ *
+ * The expression is SQL-like and compares the fields of the related topic's
+ * protobuf type, for example "priority > %0 AND header.source LIKE 'sensor%'".
+ * It is compiled once, when the topic is created. Samples are filtered before
+ * they are queued or passed to callbacks; in-process writers evaluate the
+ * filters of the readers they deliver to, so rejected samples are not copied.
+ */
+class ContentFilteredTopic : public Topic {
+ public:
+  /**
+   * @brief Gets the topic whose samples are filtered.
+   * @return The related topic.
+   */
+  virtual std::shared_ptr<Topic> GetRelatedTopic() const = 0;
+
+  /**
+   * @brief Gets the filter expression.
+   * @return The expression.
+   */
+  virtual std::string GetFilterExpression() const = 0;
+
+  /**
+   * @brief Gets the values of the %0, %1, ... parameters of the filter expression.
+   * @return The parameters.
+   */
+  virtual std::vector<std::string> GetExpressionParameters() const = 0;
 };
 
 }  // namespace tiny_dds
@@ -2,13 +2,18 @@
 #define TINY_DDS_TRANSPORT_H_
 
 #include <cstddef>
+#include <memory>
 #include <string>
+#include <utility>
 
 #include "include/tiny_dds/transport_types.h"
 #include "include/tiny_dds/types.h"
 
 namespace tiny_dds {
 
+// Forward declarations
+class TransportEndpoint;
+
 /**
  * @brief Abstract base class for DDS transport implementations.
  *
@@ -16,7 +21,7 @@ namespace tiny_dds {
  * It provides methods for sending and receiving data, as well as for managing
  * topic subscriptions and advertisements.
  */
-class Transport {
+class Transport : public std::enable_shared_from_this<Transport> {
  public:
   /**
    * @brief Virtual destructor.
@@ -40,13 +45,30 @@ class Transport {
    */
   virtual bool Send(const std::string& topic_name, const void* data, size_t size) = 0;
 
+  /**
+   * @brief Sends a datagram of coalesced samples that may span several topics.
+   *
+   * The datagram is produced by transport::SampleCoalescer and is unpacked by the
+   * receiving transport, so readers see the individual samples. Transports that do
+   * not carry coalesced datagrams keep the default implementation.
+   *
+   * @param data Pointer to the coalesced datagram.
+   * @param size Size of the datagram in bytes.
+   * @return true if the datagram was sent successfully, false otherwise.
+   */
+  virtual bool SendCoalesced(const void* /*data*/, size_t /*size*/) { return false; }
+
   /**
    * @brief Receives data from a topic.
    *
+   * A sample larger than the buffer is left queued, and its size is reported in
+   * bytes_received, so the caller can retry with a buffer large enough for it.
+   *
    * @param topic_name The name of the topic.
    * @param buffer Pointer to the buffer to store the received data.
    * @param buffer_size Size of the buffer in bytes.
-   * @param bytes_received Output parameter to store the number of bytes received.
+   * @param bytes_received Output parameter to store the number of bytes received, or
+   *        the size of the next sample if it does not fit the buffer.
    * @return true if data was received successfully, false otherwise.
    */
   virtual bool Receive(const std::string& topic_name, void* buffer, size_t buffer_size,
@@ -74,8 +96,104 @@ class Transport {
    * @return The transport type.
    */
   virtual TransportType GetType() const = 0;
+
+  /**
+   * @brief Opens an endpoint bound to a topic of this transport.
+   *
+   * The topic must already be advertised or subscribed. Transports can return an
+   * endpoint with the topic's state resolved up front; the default endpoint
+   * forwards to Send and Receive.
+   *
+   * @param topic_name The name of the topic.
+   * @return The endpoint for the topic.
+   */
+  virtual std::shared_ptr<TransportEndpoint> OpenEndpoint(const std::string& topic_name);
 };
 
+/**
+ * @brief A transport bound to a single topic.
+ *
+ * DataWriters and DataReaders open their endpoint once when they are created, so
+ * that sending or receiving a sample is a direct call on the transport without
+ * looking up the transport or copying the topic name again.
+ */
+class TransportEndpoint {
+ public:
+  /**
+   * @brief Constructor.
+   *
+   * @param transport The transport carrying the topic.
+   * @param topic_name The name of the topic.
+   */
+  TransportEndpoint(std::shared_ptr<Transport> transport, std::string topic_name)
+      : transport_(std::move(transport)), topic_name_(std::move(topic_name)) {}
+
+  /**
+   * @brief Virtual destructor.
+   */
+  virtual ~TransportEndpoint() = default;
+
+  /**
+   * @brief Sends data to the topic.
+   *
+   * @param data Pointer to the data to send.
+   * @param size Size of the data in bytes.
+   * @return true if the data was sent successfully, false otherwise.
+   */
+  virtual bool Send(const void* data, size_t size) {
+    return transport_->Send(topic_name_, data, size);
+  }
+
+  /**
+   * @brief Receives data from the topic, see Transport::Receive.
+   *
+   * @param buffer Pointer to the buffer to store the received data.
+   * @param buffer_size Size of the buffer in bytes.
+   * @param bytes_received Output parameter to store the number of bytes received, or
+   *        the size of the next sample if it does not fit the buffer.
+   * @return true if data was received successfully, false otherwise.
+   */
+  virtual bool Receive(void* buffer, size_t buffer_size, size_t* bytes_received) {
+    return transport_->Receive(topic_name_, buffer, buffer_size, bytes_received);
+  }
+
+  /**
+   * @brief Marks the data this endpoint sends with a transport priority.
+   *
+   * Called before the endpoint sends anything. Transports that cannot mark
+   * their traffic keep the default implementation.
+   *
+   * @param qos The transport priority of the writer using the endpoint.
+   * @return true if the data is marked, false otherwise.
+   */
+  virtual bool SetTransportPriority(const TransportPriorityQos& /*qos*/) { return false; }
+
+  /**
+   * @brief Gets the name of the topic this endpoint is bound to.
+   *
+   * @return The topic name.
+   */
+  const std::string& GetTopicName() const { return topic_name_; }
+
+  /**
+   * @brief Gets the transport carrying the topic.
+   *
+   * @return The transport.
+   */
+  const std::shared_ptr<Transport>& GetTransport() const { return transport_; }
+
+ protected:
+  // The transport carrying the topic, kept alive by the endpoint
+  std::shared_ptr<Transport> transport_;
+
+  // The name of the topic
+  std::string topic_name_;
+};
+
+inline std::shared_ptr<TransportEndpoint> Transport::OpenEndpoint(const std::string& topic_name) {
+  return std::make_shared<TransportEndpoint>(shared_from_this(), topic_name);
+}
+
 }  // namespace tiny_dds
 
 #endif  // TINY_DDS_TRANSPORT_H_
\ No newline at end of file
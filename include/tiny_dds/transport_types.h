@@ -1,6 +1,8 @@
 #ifndef TINY_DDS_TRANSPORT_TYPES_H_
 #define TINY_DDS_TRANSPORT_TYPES_H_
 
+#include <chrono>
+#include <cstddef>
 #include <string>
 
 namespace tiny_dds {
@@ -11,9 +13,53 @@ namespace tiny_dds {
 enum class TransportType {
   UDP,            ///< UDP transport (default)
   SHARED_MEMORY,  ///< Shared memory transport for local communication
+  TCP,            ///< TCP stream transport for large messages and lossy links
+  UNIX_SOCKET,    ///< Unix domain socket transport for same-host peers
+  LOCAL_ONLY,     ///< In-process delivery straight to matched DataReaders
+  AUTO,           ///< Shared memory to same-host readers, UDP multicast to remote hosts
                   // Add more transport types as needed
 };
 
+/**
+ * @brief Configuration for writer-side coalescing of small samples.
+ *
+ * When enabled on a Publisher, samples written by any of its DataWriters are
+ * packed into shared datagrams instead of being sent one per datagram. A
+ * datagram is flushed when it is full or when the oldest queued sample has
+ * waited for the latency budget.
+ */
+struct CoalescingConfig {
+  // Maximum datagram payload size (Ethernet MTU minus IPv4 and UDP headers)
+  size_t max_datagram_size = 1472;
+
+  // Maximum time a sample may wait in the coalescer before being flushed
+  std::chrono::microseconds latency_budget{1000};
+};
+
+/**
+ * @brief Configuration for a Publisher in ASYNCHRONOUS publish mode.
+ *
+ * Writes copy the sample into a bounded lock-free queue and return; a flusher
+ * thread of the publisher sends queued samples in batches. A write fails
+ * rather than blocks when the queue is full.
+ */
+struct AsyncPublishConfig {
+  // Maximum number of queued samples, rounded up to a power of two
+  size_t queue_capacity = 4096;
+
+  // Bytes stored inline per queued sample; larger samples use pooled buffers
+  size_t slot_size = 256;
+
+  // Maximum number of samples sent per batch
+  size_t max_batch_size = 64;
+
+  // Pacing: minimum time from the start of one batch to the next, or zero for none
+  std::chrono::microseconds batch_interval{0};
+
+  // CPU the flusher thread is pinned to, or -1 to leave it unpinned (Linux only)
+  int cpu = -1;
+};
+
 /**
  * @brief Convert a string to a transport type.
  *
@@ -23,6 +69,14 @@ enum class TransportType {
 inline TransportType StringToTransportType(const std::string& str) {
   if (str == "SHARED_MEMORY") {
     return TransportType::SHARED_MEMORY;
+  } else if (str == "TCP") {
+    return TransportType::TCP;
+  } else if (str == "UNIX_SOCKET") {
+    return TransportType::UNIX_SOCKET;
+  } else if (str == "LOCAL_ONLY") {
+    return TransportType::LOCAL_ONLY;
+  } else if (str == "AUTO") {
+    return TransportType::AUTO;
   } else {
     // Default to UDP for unknown strings
     return TransportType::UDP;
@@ -41,6 +95,14 @@ inline std::string TransportTypeToString(TransportType type) {
       return "UDP";
     case TransportType::SHARED_MEMORY:
       return "SHARED_MEMORY";
+    case TransportType::TCP:
+      return "TCP";
+    case TransportType::UNIX_SOCKET:
+      return "UNIX_SOCKET";
+    case TransportType::LOCAL_ONLY:
+      return "LOCAL_ONLY";
+    case TransportType::AUTO:
+      return "AUTO";
     default:
       return "UNKNOWN";
   }
@@ -0,0 +1,362 @@
+#ifndef TINY_DDS_TYPED_DATA_H_
+#define TINY_DDS_TYPED_DATA_H_
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "google/protobuf/message.h"
+#include "google/protobuf/message_lite.h"
+#include "include/tiny_dds/data_reader.h"
+#include "include/tiny_dds/data_writer.h"
+#include "include/tiny_dds/topic.h"
+#include "include/tiny_dds/types.h"
+
+namespace tiny_dds {
+
+/**
+ * @brief True for the Protocol Buffers message types, sent in their wire format.
+ */
+template <typename T>
+inline constexpr bool kIsMessageType = std::is_base_of_v<google::protobuf::MessageLite, T>;
+
+/**
+ * @brief True for the plain types, sent as their bytes.
+ *
+ * Their samples are copied with memcpy, so they must hold no pointers and have
+ * the same layout on every participant of the topic.
+ */
+template <typename T>
+inline constexpr bool kIsPlainType = !kIsMessageType<T> && std::is_trivially_copyable_v<T>;
+
+namespace typed_data_internal {
+
+template <typename T, typename = void>
+struct HasTypeNameMember : std::false_type {};
+
+template <typename T>
+struct HasTypeNameMember<T, std::void_t<decltype(std::string(T::kTypeName))>> : std::true_type {};
+
+}  // namespace typed_data_internal
+
+/**
+ * @brief Gives the type name topics of T are created with.
+ *
+ * Messages are named by their full Protocol Buffers name. Plain types are
+ * named by a static kTypeName member, or by a specialization of this template
+ * for types that cannot have one:
+ *
+ *   template <>
+ *   struct TopicType<Pose> {
+ *     static std::string Name() { return "robot.Pose"; }
+ *   };
+ */
+template <typename T>
+struct TopicType {
+  static_assert(kIsMessageType<T> || kIsPlainType<T>,
+                "topic types are Protocol Buffers messages or trivially copyable types");
+  static_assert(kIsMessageType<T> || typed_data_internal::HasTypeNameMember<T>::value,
+                "plain topic types need a static kTypeName member or a TopicType specialization");
+
+  static std::string Name() {
+    if constexpr (kIsMessageType<T>) {
+      return std::string(T::default_instance().GetTypeName());
+    } else {
+      return std::string(T::kTypeName);
+    }
+  }
+};
+
+namespace typed_data_internal {
+
+// Checks that a topic carries samples of type T
+template <typename T>
+bool MatchesTopic(const std::shared_ptr<Topic>& topic, const char* entity) {
+  if (!topic) {
+    std::cerr << "Typed" << entity << ": no topic" << std::endl;
+    return false;
+  }
+  const std::string type_name = TopicType<T>::Name();
+  if (topic->GetTypeName() != type_name) {
+    std::cerr << "Typed" << entity << ": topic " << topic->GetName() << " has type "
+              << topic->GetTypeName() << ", not " << type_name << std::endl;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace typed_data_internal
+
+/**
+ * @brief Writes samples of type T to a DataWriter, choosing their encoding at compile time.
+ *
+ * Plain types are written from the caller's object, with no intermediate
+ * buffer. Messages are serialized in place into a buffer of the calling thread
+ * that grows to the largest message written, so writes do not allocate once it
+ * has. Shared samples take the writer's zero-copy paths on LOCAL_ONLY
+ * participants.
+ *
+ * @tparam T A Protocol Buffers message or trivially copyable type.
+ */
+template <typename T>
+class TypedDataWriter {
+ public:
+  static_assert(kIsMessageType<T> || kIsPlainType<T>,
+                "topic types are Protocol Buffers messages or trivially copyable types");
+
+  /**
+   * @brief Wraps a DataWriter.
+   * @param writer The writer; its topic must have the type name of T.
+   * @return The typed writer, or nullptr if the topic has another type.
+   */
+  static auto Create(std::shared_ptr<DataWriter> writer) -> std::shared_ptr<TypedDataWriter> {
+    if (!writer || !typed_data_internal::MatchesTopic<T>(writer->GetTopic(), "DataWriter")) {
+      return nullptr;
+    }
+    return std::shared_ptr<TypedDataWriter>(new TypedDataWriter(std::move(writer)));
+  }
+
+  /**
+   * @brief Writes a sample.
+   * @param sample The sample.
+   * @return True if write was successful, false otherwise.
+   */
+  bool Write(const T& sample) {
+    if constexpr (kIsPlainType<T>) {
+      return writer_->Write(&sample, sizeof(T));
+    } else {
+      thread_local std::vector<uint8_t> buffer;
+      const size_t size = sample.ByteSizeLong();
+      if (buffer.size() < size) {
+        buffer.resize(size);
+      }
+      sample.SerializeWithCachedSizesToArray(buffer.data());
+      return writer_->Write(buffer.data(), size);
+    }
+  }
+
+  /**
+   * @brief Writes a sample without copying it on LOCAL_ONLY participants.
+   * @param sample The sample. It must not be modified after the call.
+   * @return True if write was successful, false otherwise.
+   */
+  bool Write(std::shared_ptr<const T> sample) {
+    if (!sample) {
+      return false;
+    }
+    if constexpr (kIsPlainType<T>) {
+      return writer_->WriteShared(std::move(sample), sizeof(T));
+    } else {
+      return writer_->WriteMessage(std::move(sample));
+    }
+  }
+
+  /**
+   * @brief Gets the wrapped writer.
+   * @return The untyped DataWriter.
+   */
+  auto GetDataWriter() const -> const std::shared_ptr<DataWriter>& { return writer_; }
+
+ private:
+  explicit TypedDataWriter(std::shared_ptr<DataWriter> writer) : writer_(std::move(writer)) {}
+
+  std::shared_ptr<DataWriter> writer_;
+};
+
+/**
+ * @brief Reads samples of type T from a DataReader, choosing their decoding at compile time.
+ *
+ * Plain samples are copied straight into the caller's object. Messages are
+ * taken with DataReader::TakeMessage, which skips the serialization round trip
+ * for messages written in this process, or parsed from a buffer of the
+ * calling thread.
+ *
+ * @tparam T A Protocol Buffers message or trivially copyable type.
+ */
+template <typename T>
+class TypedDataReader {
+ public:
+  static_assert(kIsMessageType<T> || kIsPlainType<T>,
+                "topic types are Protocol Buffers messages or trivially copyable types");
+
+  /**
+   * @brief Callback function type for typed data reception.
+   *
+   * @param sample The sample, valid for the duration of the call.
+   * @param info Sample information.
+   */
+  using Callback = std::function<void(const T& sample, const SampleInfo& info)>;
+
+  /**
+   * @brief Wraps a DataReader.
+   * @param reader The reader; its topic must have the type name of T.
+   * @return The typed reader, or nullptr if the topic has another type.
+   */
+  static auto Create(std::shared_ptr<DataReader> reader) -> std::shared_ptr<TypedDataReader> {
+    if (!reader || !typed_data_internal::MatchesTopic<T>(reader->GetTopic(), "DataReader")) {
+      return nullptr;
+    }
+    return std::shared_ptr<TypedDataReader>(new TypedDataReader(std::move(reader)));
+  }
+
+  /**
+   * @brief Takes the oldest available sample.
+   * @param[out] sample The sample.
+   * @param[out] info Sample information.
+   * @return True if a sample was taken, false if no valid sample is available.
+   */
+  bool Take(T* sample, SampleInfo& info) {
+    if constexpr (kIsPlainType<T>) {
+      return reader_->Take(sample, sizeof(T), info) == static_cast<int32_t>(sizeof(T));
+    } else {
+      return reader_->TakeMessage(sample, info);
+    }
+  }
+
+  /**
+   * @brief Takes the next sample, waiting up to a timeout for one to arrive.
+   * @param[out] sample The sample.
+   * @param[out] info Sample information.
+   * @param[in] timeout The maximum time to wait.
+   * @return True if a sample was taken, false if none arrived before the timeout.
+   */
+  bool Take(T* sample, SampleInfo& info, std::chrono::nanoseconds timeout) {
+    if constexpr (kIsPlainType<T>) {
+      return reader_->Take(sample, sizeof(T), info, timeout) == static_cast<int32_t>(sizeof(T));
+    } else {
+      // Samples larger than the buffer stay queued, and are taken as messages instead
+      thread_local std::vector<uint8_t> buffer(4096);
+      const int32_t size = reader_->Take(buffer.data(), buffer.size(), info, timeout);
+      if (size >= 0) {
+        return sample->ParseFromArray(buffer.data(), size);
+      }
+      return reader_->TakeMessage(sample, info);
+    }
+  }
+
+  /**
+   * @brief Takes the next available message, allocated on an arena of the reader's pool.
+   *
+   * Available for messages with descriptors only; see DataReader::TakeArenaMessage.
+   *
+   * @param[out] info Sample information.
+   * @return The message, or nullptr if no valid sample is available.
+   */
+  auto TakeArenaMessage(SampleInfo& info) -> ArenaMessagePtr<T> {
+    static_assert(std::is_base_of_v<google::protobuf::Message, T>,
+                  "arena messages are Protocol Buffers messages with descriptors");
+    ArenaMessagePtr<> message = reader_->TakeArenaMessage(T::default_instance(), info);
+    const ArenaMessageDeleter deleter = message.get_deleter();
+    return ArenaMessagePtr<T>(static_cast<T*>(message.release()), deleter);
+  }
+
+  /**
+   * @brief Reads the oldest sample not read yet, leaving it in the reader's history.
+   *
+   * Available for plain types only; messages are taken.
+   *
+   * @param[out] sample The sample.
+   * @param[out] info Sample information.
+   * @return True if a sample was read, false if no valid sample is available.
+   */
+  bool Read(T* sample, SampleInfo& info) {
+    static_assert(kIsPlainType<T>, "messages are read with Take");
+    return reader_->Read(sample, sizeof(T), info) == static_cast<int32_t>(sizeof(T));
+  }
+
+  /**
+   * @brief Looks up the instance of a keyed topic a sample belongs to.
+   * @param key_holder A sample with the key fields set.
+   * @return The instance's handle, or HANDLE_NIL if the reader has no sample of it.
+   */
+  auto LookupInstance(const T& key_holder) -> InstanceHandle {
+    if constexpr (kIsPlainType<T>) {
+      return reader_->LookupInstance(&key_holder, sizeof(T));
+    } else {
+      return reader_->LookupInstance(key_holder);
+    }
+  }
+
+  /**
+   * @brief Sets the callback for received samples, replacing the untyped one.
+   *
+   * Samples that do not decode as T are skipped.
+   *
+   * @param callback The callback, or nullptr to queue samples instead.
+   */
+  void SetDataReceivedCallback(Callback callback) {
+    if (!callback) {
+      reader_->SetDataReceivedCallback(nullptr);
+      return;
+    }
+    // Callbacks may run on several executor threads, or re-enter through an
+    // INLINE write, so every call decodes into a sample of its own
+    reader_->SetDataReceivedCallback([callback = std::move(callback), pool = message_pool_](
+                                         const void* data, size_t size, const SampleInfo& info) {
+      if constexpr (kIsPlainType<T>) {
+        if (size != sizeof(T)) {
+          return;
+        }
+        T sample;
+        std::memcpy(&sample, data, sizeof(T));
+        callback(sample, info);
+      } else {
+        std::unique_ptr<T> sample = pool->Acquire();
+        if (sample->ParseFromArray(data, static_cast<int>(size))) {
+          callback(*sample, info);
+        }
+        pool->Release(std::move(sample));
+      }
+    });
+  }
+
+  /**
+   * @brief Gets the wrapped reader.
+   * @return The untyped DataReader.
+   */
+  auto GetDataReader() const -> const std::shared_ptr<DataReader>& { return reader_; }
+
+ private:
+  // Messages the data callback decodes into, kept for the next samples so
+  // their fields' memory is reused
+  class MessagePool {
+   public:
+    auto Acquire() -> std::unique_ptr<T> {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (free_.empty()) {
+        return std::make_unique<T>();
+      }
+      std::unique_ptr<T> message = std::move(free_.back());
+      free_.pop_back();
+      return message;
+    }
+
+    void Release(std::unique_ptr<T> message) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      free_.push_back(std::move(message));
+    }
+
+   private:
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<T>> free_;
+  };
+
+  explicit TypedDataReader(std::shared_ptr<DataReader> reader) : reader_(std::move(reader)) {}
+
+  std::shared_ptr<DataReader> reader_;
+
+  // Shared with the data callback, which may outlive the wrapper
+  std::shared_ptr<MessagePool> message_pool_ = std::make_shared<MessagePool>();
+};
+
+}  // namespace tiny_dds
+
+#endif  // TINY_DDS_TYPED_DATA_H_
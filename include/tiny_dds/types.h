@@ -1,19 +1,168 @@
 #ifndef TINY_DDS_TYPES_H_
 #define TINY_DDS_TYPES_H_
 
+#include <array>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <utility>
 
 namespace tiny_dds {
 
 // Domain identifier type
 using DomainId = std::uint32_t;
 
+// Globally unique identifier of a DataWriter, used to tell samples of different writers apart
+struct Guid {
+  std::array<std::uint8_t, 16> value{};
+
+  bool operator==(const Guid& other) const { return value == other.value; }
+  bool operator!=(const Guid& other) const { return value != other.value; }
+
+  // Lets a Guid key absl hash containers
+  template <typename H>
+  friend H AbslHashValue(H h, const Guid& guid) {
+    return H::combine(std::move(h), guid.value);
+  }
+};
+
+// Handle of an instance of a keyed topic, unique within one DataReader
+using InstanceHandle = std::uint64_t;
+
+constexpr InstanceHandle HANDLE_NIL = 0;
+
 // Quality of Service related types
 enum class ReliabilityKind { BEST_EFFORT, RELIABLE };
 
 enum class DurabilityKind { VOLATILE, TRANSIENT_LOCAL, TRANSIENT, PERSISTENT };
 
+enum class HistoryKind { KEEP_LAST, KEEP_ALL };
+
+// Samples a DataReader keeps until they are taken. The reader preallocates a
+// slot of slot_size bytes per sample; larger samples are stored in pooled buffers.
+// On keyed topics, KEEP_LAST keeps the last depth samples of each instance, and
+// max_samples bounds the samples of all instances together.
+struct HistoryQos {
+  HistoryKind kind = HistoryKind::KEEP_LAST;
+  std::int32_t depth = 1024;        // KEEP_LAST: the oldest sample is replaced when full
+  std::int32_t max_samples = 4096;  // KEEP_ALL: new samples are rejected when full
+  std::size_t slot_size = 256;
+};
+
+// Readers with a minimum separation keep at most one sample per period of that
+// length from each instance (from the whole topic if it is not keyed): a sample
+// whose source timestamp is less than minimum_separation after the last one kept
+// is dropped on arrival. In-process writers skip such readers without copying.
+struct TimeBasedFilterQos {
+  std::chrono::nanoseconds minimum_separation{0};
+};
+
+// Readers with a deadline expect a sample of each instance (of the topic if it
+// is not keyed) at least once per period, starting with the instance's first
+// sample; writers offer to write at least once per period, starting when they
+// are created. Every period that passes without a sample is reported as a
+// missed deadline. A period of 0 is infinite.
+struct DeadlineQos {
+  std::chrono::nanoseconds period{0};
+};
+
+// Every sample asserts the liveliness of its writer. AUTOMATIC writers also
+// send a heartbeat when they have not written for half the lease duration;
+// MANUAL_BY_TOPIC writers that neither write nor call AssertLiveliness within
+// the lease duration lose their liveliness until they do. Readers consider a
+// writer alive while they hear from it at least once per lease duration of
+// their own QoS. A lease duration of 0 is infinite.
+enum class LivelinessKind { AUTOMATIC, MANUAL_BY_TOPIC };
+
+struct LivelinessQos {
+  LivelinessKind kind = LivelinessKind::AUTOMATIC;
+  std::chrono::nanoseconds lease_duration{0};
+};
+
+// Longest a sample of the writer may wait in its publisher before it is sent.
+// In ASYNCHRONOUS mode a sample held back by higher-priority writers is sent
+// ahead of them once it has waited this long; writers whose budget is shorter
+// than the publisher's coalescing budget are not coalesced. 0 means no budget.
+struct LatencyBudgetQos {
+  std::chrono::nanoseconds duration{0};
+};
+
+// In ASYNCHRONOUS mode, queued samples of writers with a higher value are sent
+// first, and a lower-priority writer is interrupted between two samples. On UDP,
+// writers with a positive value or a DSCP send from their own socket, marked with
+// the value as socket priority (SO_PRIORITY, limited to 6) and with the DSCP, or
+// the class selector of the value (CS1 to CS7) if dscp is -1. Such writers are
+// not coalesced, since coalesced datagrams are not marked.
+struct TransportPriorityQos {
+  std::int32_t value = 0;
+  std::int32_t dscp = -1;  // DiffServ code point (0 to 63), -1 to derive it from value
+};
+
+struct DataReaderQos {
+  HistoryQos history;
+  TimeBasedFilterQos time_based_filter;
+  DeadlineQos deadline;
+  LivelinessQos liveliness;
+
+  // TRANSIENT_LOCAL or PERSISTENT: receive the history of writers that
+  // published before this reader joined, from the given sequence number or
+  // source timestamp (nanoseconds since the Unix epoch) if either is set, or
+  // the writers' last history.depth samples otherwise
+  DurabilityKind durability = DurabilityKind::VOLATILE;
+  std::uint64_t replay_from_sequence_number = 0;
+  std::int64_t replay_from_timestamp = 0;
+};
+
+// PERSISTENT writers append every sample to a log of memory-mapped segment
+// files under directory/<domain>/<topic>, so their history survives restarts.
+// A new segment is started when the current one is full, and the oldest
+// segments beyond max_segments are deleted. Appended samples are flushed to
+// disk together, at most sync_interval after they were written.
+struct PersistenceQos {
+  std::string directory = "/tmp/tiny_dds";
+  std::size_t segment_size = 64 * 1024 * 1024;
+  std::size_t max_segments = 16;
+  std::chrono::milliseconds sync_interval{10};
+};
+
+// TRANSIENT_LOCAL writers keep their last samples in a history bounded by
+// history.depth (KEEP_LAST) or history.max_samples (KEEP_ALL), and replay it
+// to readers that join later. The history shares the written buffers, so
+// history.slot_size does not apply. Requests for a replay that arrive within
+// min_replay_interval of the previous replay are served together, once.
+// PERSISTENT writers replay from their log instead, configured by persistence.
+struct DataWriterQos {
+  DurabilityKind durability = DurabilityKind::VOLATILE;
+  HistoryQos history;
+  std::chrono::milliseconds min_replay_interval{100};
+  PersistenceQos persistence;
+  DeadlineQos deadline;
+  LivelinessQos liveliness;
+  LatencyBudgetQos latency_budget;
+  TransportPriorityQos transport_priority;
+};
+
+// Communication statuses, combined into a StatusMask (values follow the DDS specification)
+using StatusMask = std::uint32_t;
+
+constexpr StatusMask OFFERED_DEADLINE_MISSED_STATUS = 1u << 1;
+constexpr StatusMask REQUESTED_DEADLINE_MISSED_STATUS = 1u << 2;
+constexpr StatusMask DATA_AVAILABLE_STATUS = 1u << 10;
+constexpr StatusMask LIVELINESS_LOST_STATUS = 1u << 11;
+constexpr StatusMask LIVELINESS_CHANGED_STATUS = 1u << 12;
+constexpr StatusMask SUBSCRIPTION_MATCHED_STATUS = 1u << 14;
+
+// Whether the application has already read a sample, combined into a
+// SampleStateMask to select samples (values follow the DDS specification)
+enum class SampleStateKind { NOT_READ, READ };
+
+using SampleStateMask = std::uint32_t;
+
+constexpr SampleStateMask READ_SAMPLE_STATE = 1u << 0;
+constexpr SampleStateMask NOT_READ_SAMPLE_STATE = 1u << 1;
+constexpr SampleStateMask ANY_SAMPLE_STATE = READ_SAMPLE_STATE | NOT_READ_SAMPLE_STATE;
+
 // Common status types
 struct SubscriptionMatchedStatus {
   std::int32_t total_count = 0;
@@ -29,10 +178,62 @@ struct PublicationMatchedStatus {
   std::int32_t current_count_change = 0;
 };
 
+// The *_change counts are those since the application last got the status
+struct RequestedDeadlineMissedStatus {
+  std::int32_t total_count = 0;
+  std::int32_t total_count_change = 0;
+  InstanceHandle last_instance_handle = HANDLE_NIL;
+};
+
+struct OfferedDeadlineMissedStatus {
+  std::int32_t total_count = 0;
+  std::int32_t total_count_change = 0;
+};
+
+// Writers a reader heard from, alive or no longer alive
+struct LivelinessChangedStatus {
+  std::int32_t alive_count = 0;
+  std::int32_t not_alive_count = 0;
+  std::int32_t alive_count_change = 0;
+  std::int32_t not_alive_count_change = 0;
+  Guid last_publication_handle;
+};
+
+struct LivelinessLostStatus {
+  std::int32_t total_count = 0;
+  std::int32_t total_count_change = 0;
+};
+
 // Sample information
 struct SampleInfo {
   bool valid_data = false;
-  // Add other relevant fields like timestamp, sample state, etc.
+  SampleStateKind sample_state = SampleStateKind::NOT_READ;  // State before this access
+
+  // Timestamps in nanoseconds since the Unix epoch; the source timestamp is
+  // taken by the writer, the reception timestamp when the reader received the sample
+  std::int64_t source_timestamp = 0;
+  std::int64_t reception_timestamp = 0;
+
+  // Writer's sequence number for the sample, starting at 1 (0 for data sent
+  // without a DataWriter, which also has no source timestamp or publication handle)
+  std::uint64_t sequence_number = 0;
+
+  // GUID of the DataWriter that wrote the sample
+  Guid publication_handle;
+
+  // Samples of the same writer this reader missed so far, from gaps in sequence numbers;
+  // samples that arrive after a later one are taken back from the count
+  std::uint64_t lost_sample_count = 0;
+
+  // Instance of a keyed topic the sample belongs to, HANDLE_NIL on other topics
+  InstanceHandle instance_handle = HANDLE_NIL;
+};
+
+// Caller-provided storage for one sample of a bulk read or take
+struct SampleBuffer {
+  void* data = nullptr;
+  std::size_t capacity = 0;  // Size of data in bytes
+  std::size_t size = 0;      // Set to the size of the sample stored in data
 };
 
 }  // namespace tiny_dds
@@ -0,0 +1,136 @@
+#ifndef TINY_DDS_WAIT_SET_H_
+#define TINY_DDS_WAIT_SET_H_
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "include/tiny_dds/types.h"
+
+namespace tiny_dds {
+class DataReader;
+
+/**
+ * @brief A condition that a WaitSet can wait on.
+ */
+class Condition {
+ public:
+  virtual ~Condition() = default;
+
+  /**
+   * @brief Gets whether the condition is currently triggered.
+   * @return True if the condition is triggered.
+   */
+  virtual bool GetTriggerValue() const = 0;
+};
+
+/**
+ * @brief A condition triggered by the application, e.g. to wake a WaitSet for shutdown.
+ */
+class GuardCondition : public Condition {
+ public:
+  /**
+   * @brief Creates a GuardCondition that is not triggered.
+   * @return A shared pointer to the created GuardCondition.
+   */
+  static std::shared_ptr<GuardCondition> Create();
+
+  /**
+   * @brief Sets the trigger value, waking the attached WaitSets when set to true.
+   * @param value The new trigger value.
+   */
+  virtual void SetTriggerValue(bool value) = 0;
+};
+
+/**
+ * @brief A condition triggered while a DataReader has samples in given sample states.
+ *
+ * Samples are only queued for readers without data callbacks.
+ */
+class ReadCondition : public Condition {
+ public:
+  /**
+   * @brief Gets the sample states that trigger this condition.
+   * @return A combination of the *_SAMPLE_STATE constants.
+   */
+  virtual SampleStateMask GetSampleStateMask() const = 0;
+
+  /**
+   * @brief Gets the DataReader this condition belongs to.
+   * @return A shared pointer to the DataReader, or nullptr if it was destroyed.
+   */
+  virtual std::shared_ptr<DataReader> GetDataReader() const = 0;
+};
+
+/**
+ * @brief A condition triggered by changes of an entity's communication statuses.
+ *
+ * The condition is triggered while any of its enabled statuses has changed
+ * since the application last read it.
+ */
+class StatusCondition : public Condition {
+ public:
+  /**
+   * @brief Selects the statuses that trigger this condition.
+   * @param mask A combination of the *_STATUS constants.
+   */
+  virtual void SetEnabledStatuses(StatusMask mask) = 0;
+
+  /**
+   * @brief Gets the statuses that trigger this condition.
+   * @return A combination of the *_STATUS constants.
+   */
+  virtual StatusMask GetEnabledStatuses() const = 0;
+};
+
+/**
+ * @brief Blocks a thread until one of a set of conditions is triggered.
+ *
+ * A WaitSet lets one thread service many DataReaders: attach their
+ * ReadConditions or StatusConditions, call Wait, and handle the conditions it
+ * returns. The waiting thread sleeps until an attached condition signals a
+ * change; conditions are not polled.
+ */
+class WaitSet {
+ public:
+  /**
+   * @brief Creates an empty WaitSet.
+   * @return A shared pointer to the created WaitSet.
+   */
+  static std::shared_ptr<WaitSet> Create();
+
+  virtual ~WaitSet() = default;
+
+  /**
+   * @brief Attaches a condition.
+   * @param condition The condition to attach.
+   * @return True if the condition was attached, false if it is not supported or already attached.
+   */
+  virtual bool AttachCondition(std::shared_ptr<Condition> condition) = 0;
+
+  /**
+   * @brief Detaches a condition.
+   * @param condition The condition to detach.
+   * @return True if the condition was detached, false if it was not attached.
+   */
+  virtual bool DetachCondition(const std::shared_ptr<Condition>& condition) = 0;
+
+  /**
+   * @brief Waits until at least one attached condition is triggered.
+   * @param[out] active_conditions The attached conditions that are triggered.
+   * @param timeout The maximum time to wait.
+   * @return True if a condition was triggered, false on timeout.
+   */
+  virtual bool Wait(std::vector<std::shared_ptr<Condition>>& active_conditions,
+                    std::chrono::nanoseconds timeout) = 0;
+
+  /**
+   * @brief Gets the attached conditions.
+   * @return The attached conditions.
+   */
+  virtual std::vector<std::shared_ptr<Condition>> GetConditions() const = 0;
+};
+
+}  // namespace tiny_dds
+
+#endif  // TINY_DDS_WAIT_SET_H_
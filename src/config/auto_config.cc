@@ -136,6 +136,31 @@ bool AutoConfigLoader::CreateEntities(const config::Config& config) {
 
       publishers_[EntityKey(participant_config.name, publisher_config.name)] = publisher;
 
+      // Writers created without a QoS follow the publisher's
+      DataWriterQos writer_qos;
+      writer_qos.durability = publisher_config.qos.durability;
+      writer_qos.history = publisher_config.qos.history;
+      writer_qos.persistence = publisher_config.qos.persistence;
+      writer_qos.deadline = publisher_config.qos.deadline;
+      writer_qos.liveliness = publisher_config.qos.liveliness;
+      writer_qos.latency_budget = publisher_config.qos.latency_budget;
+      writer_qos.transport_priority = publisher_config.qos.transport_priority;
+      publisher->SetDefaultDataWriterQos(writer_qos);
+
+      // Enable small-sample coalescing if requested
+      if (publisher_config.transport.coalescing_enabled &&
+          !publisher->EnableCoalescing(publisher_config.transport.coalescing)) {
+        std::cerr << "Coalescing is not supported by the transport of publisher: "
+                  << publisher_config.name << std::endl;
+      }
+
+      // Move transport sends to a flusher thread if requested
+      if (publisher_config.transport.async_publishing_enabled &&
+          !publisher->EnableAsynchronousPublishing(publisher_config.transport.async_publishing)) {
+        std::cerr << "Asynchronous publishing is not supported by the transport of publisher: "
+                  << publisher_config.name << std::endl;
+      }
+
       // Associate topics with the publisher
       for (const auto& topic_name : publisher_config.topic_names) {
         auto topic_it = topics_.find(EntityKey(participant_config.name, topic_name));
@@ -156,6 +181,15 @@ bool AutoConfigLoader::CreateEntities(const config::Config& config) {
 
       subscribers_[EntityKey(participant_config.name, subscriber_config.name)] = subscriber;
 
+      // Readers created without a QoS follow the subscriber's
+      DataReaderQos reader_qos;
+      reader_qos.durability = subscriber_config.qos.durability;
+      reader_qos.history = subscriber_config.qos.history;
+      reader_qos.time_based_filter = subscriber_config.qos.time_based_filter;
+      reader_qos.deadline = subscriber_config.qos.deadline;
+      reader_qos.liveliness = subscriber_config.qos.liveliness;
+      subscriber->SetDefaultDataReaderQos(reader_qos);
+
       // Associate topics with the subscriber
       for (const auto& topic_name : subscriber_config.topic_names) {
         auto topic_it = topics_.find(EntityKey(participant_config.name, topic_name));
@@ -187,7 +221,7 @@ std::shared_ptr<Subscriber> AutoConfigLoader::CreateSubscriber(
 
 std::shared_ptr<Topic> AutoConfigLoader::CreateTopic(std::shared_ptr<DomainParticipant> participant,
                                                      const config::TopicConfig& config) {
-  return participant->CreateTopic(config.name, config.type_name);
+  return participant->CreateTopic(config.name, config.type_name, config.key_fields);
 }
 
 }  // namespace auto_config
@@ -48,6 +48,87 @@ static bool ParseQosConfig(const YAML::Node& node, QosConfig& qos) {
     qos.durability = StringToDurabilityKind(node["durability"].as<std::string>());
   }
 
+  if (node["history"] && node["history"].IsMap()) {
+    const YAML::Node& history = node["history"];
+    if (history["kind"] && history["kind"].IsScalar()) {
+      qos.history.kind = history["kind"].as<std::string>() == "KEEP_ALL" ? HistoryKind::KEEP_ALL
+                                                                          : HistoryKind::KEEP_LAST;
+    }
+    if (history["depth"] && history["depth"].IsScalar()) {
+      qos.history.depth = history["depth"].as<int32_t>();
+    }
+    if (history["max_samples"] && history["max_samples"].IsScalar()) {
+      qos.history.max_samples = history["max_samples"].as<int32_t>();
+    }
+    if (history["slot_size"] && history["slot_size"].IsScalar()) {
+      qos.history.slot_size = history["slot_size"].as<size_t>();
+    }
+  }
+
+  if (node["persistence"] && node["persistence"].IsMap()) {
+    const YAML::Node& persistence = node["persistence"];
+    if (persistence["directory"] && persistence["directory"].IsScalar()) {
+      qos.persistence.directory = persistence["directory"].as<std::string>();
+    }
+    if (persistence["segment_size"] && persistence["segment_size"].IsScalar()) {
+      qos.persistence.segment_size = persistence["segment_size"].as<size_t>();
+    }
+    if (persistence["max_segments"] && persistence["max_segments"].IsScalar()) {
+      qos.persistence.max_segments = persistence["max_segments"].as<size_t>();
+    }
+    if (persistence["sync_interval_ms"] && persistence["sync_interval_ms"].IsScalar()) {
+      qos.persistence.sync_interval =
+          std::chrono::milliseconds(persistence["sync_interval_ms"].as<int64_t>());
+    }
+  }
+
+  if (node["time_based_filter"] && node["time_based_filter"].IsMap()) {
+    const YAML::Node& time_based_filter = node["time_based_filter"];
+    if (time_based_filter["minimum_separation_ms"] &&
+        time_based_filter["minimum_separation_ms"].IsScalar()) {
+      qos.time_based_filter.minimum_separation = std::chrono::milliseconds(
+          time_based_filter["minimum_separation_ms"].as<int64_t>());
+    }
+  }
+
+  if (node["deadline"] && node["deadline"].IsMap()) {
+    const YAML::Node& deadline = node["deadline"];
+    if (deadline["period_ms"] && deadline["period_ms"].IsScalar()) {
+      qos.deadline.period = std::chrono::milliseconds(deadline["period_ms"].as<int64_t>());
+    }
+  }
+
+  if (node["liveliness"] && node["liveliness"].IsMap()) {
+    const YAML::Node& liveliness = node["liveliness"];
+    if (liveliness["kind"] && liveliness["kind"].IsScalar()) {
+      qos.liveliness.kind = liveliness["kind"].as<std::string>() == "MANUAL_BY_TOPIC"
+                                ? LivelinessKind::MANUAL_BY_TOPIC
+                                : LivelinessKind::AUTOMATIC;
+    }
+    if (liveliness["lease_duration_ms"] && liveliness["lease_duration_ms"].IsScalar()) {
+      qos.liveliness.lease_duration =
+          std::chrono::milliseconds(liveliness["lease_duration_ms"].as<int64_t>());
+    }
+  }
+
+  if (node["latency_budget"] && node["latency_budget"].IsMap()) {
+    const YAML::Node& latency_budget = node["latency_budget"];
+    if (latency_budget["duration_us"] && latency_budget["duration_us"].IsScalar()) {
+      qos.latency_budget.duration =
+          std::chrono::microseconds(latency_budget["duration_us"].as<int64_t>());
+    }
+  }
+
+  if (node["transport_priority"] && node["transport_priority"].IsMap()) {
+    const YAML::Node& transport_priority = node["transport_priority"];
+    if (transport_priority["value"] && transport_priority["value"].IsScalar()) {
+      qos.transport_priority.value = transport_priority["value"].as<int32_t>();
+    }
+    if (transport_priority["dscp"] && transport_priority["dscp"].IsScalar()) {
+      qos.transport_priority.dscp = transport_priority["dscp"].as<int32_t>();
+    }
+  }
+
   return true;
 }
 
@@ -73,6 +154,47 @@ static bool ParseTransportConfig(const YAML::Node& node, TransportConfig& transp
     transport.port = node["port"].as<int>();
   }
 
+  const YAML::Node& coalescing = node["coalescing"];
+  if (coalescing && coalescing.IsMap()) {
+    transport.coalescing_enabled = true;
+
+    if (coalescing["max_datagram_size"] && coalescing["max_datagram_size"].IsScalar()) {
+      transport.coalescing.max_datagram_size = coalescing["max_datagram_size"].as<size_t>();
+    }
+
+    if (coalescing["latency_budget_us"] && coalescing["latency_budget_us"].IsScalar()) {
+      transport.coalescing.latency_budget =
+          std::chrono::microseconds(coalescing["latency_budget_us"].as<int64_t>());
+    }
+  }
+
+  const YAML::Node& async_publishing = node["asynchronous_publishing"];
+  if (async_publishing && async_publishing.IsMap()) {
+    transport.async_publishing_enabled = true;
+
+    if (async_publishing["queue_capacity"] && async_publishing["queue_capacity"].IsScalar()) {
+      transport.async_publishing.queue_capacity = async_publishing["queue_capacity"].as<size_t>();
+    }
+
+    if (async_publishing["slot_size"] && async_publishing["slot_size"].IsScalar()) {
+      transport.async_publishing.slot_size = async_publishing["slot_size"].as<size_t>();
+    }
+
+    if (async_publishing["max_batch_size"] && async_publishing["max_batch_size"].IsScalar()) {
+      transport.async_publishing.max_batch_size = async_publishing["max_batch_size"].as<size_t>();
+    }
+
+    if (async_publishing["batch_interval_us"] &&
+        async_publishing["batch_interval_us"].IsScalar()) {
+      transport.async_publishing.batch_interval =
+          std::chrono::microseconds(async_publishing["batch_interval_us"].as<int64_t>());
+    }
+
+    if (async_publishing["cpu"] && async_publishing["cpu"].IsScalar()) {
+      transport.async_publishing.cpu = async_publishing["cpu"].as<int>();
+    }
+  }
+
   return true;
 }
 
@@ -92,6 +214,17 @@ static bool ParseTopicConfig(const YAML::Node& node, TopicConfig& topic) {
     return false;
   }
 
+  if (node["key_fields"]) {
+    if (!node["key_fields"].IsSequence()) {
+      std::cerr << "Error: key_fields of topic '" << topic.name
+                << "' must be a list of field numbers." << std::endl;
+      return false;
+    }
+    for (const auto& key_field_node : node["key_fields"]) {
+      topic.key_fields.push_back(key_field_node.as<int32_t>());
+    }
+  }
+
   if (node["qos"]) {
     if (!ParseQosConfig(node["qos"], topic.qos)) {
       return false;
@@ -0,0 +1,82 @@
+#include "src/core/arena_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "src/core/buffer_pool.h"
+
+namespace tiny_dds::core {
+
+ArenaPool::PooledArena::PooledArena(size_t block_size)
+    : block_(BufferPool::Instance().Allocate(block_size)),
+      block_size_(BufferPool::Capacity(block_size)) {
+  google::protobuf::ArenaOptions options;
+  options.initial_block = reinterpret_cast<char*>(block_);
+  options.initial_block_size = block_size_;
+  arena_ = std::make_unique<google::protobuf::Arena>(options);
+}
+
+ArenaPool::PooledArena::~PooledArena() {
+  // The arena may hand its blocks back until it is destroyed
+  arena_.reset();
+  BufferPool::Instance().Release(block_, block_size_);
+}
+
+void ArenaPool::PooledArena::Release() {
+  const uint64_t space_allocated = arena_->Reset();
+
+  // The pool may be destroyed with this arena once it lets go of it
+  std::shared_ptr<ArenaPool> pool = std::move(pool_);
+  pool->Return(std::unique_ptr<PooledArena>(this), space_allocated);
+}
+
+auto ArenaPool::Create() -> std::shared_ptr<ArenaPool> {
+  return std::shared_ptr<ArenaPool>(new ArenaPool());
+}
+
+auto ArenaPool::Acquire() -> PooledArena* {
+  std::unique_ptr<PooledArena> arena;
+  {
+    absl::MutexLock lock(&mutex_);
+    if (!free_arenas_.empty()) {
+      arena = std::move(free_arenas_.back());
+      free_arenas_.pop_back();
+    }
+  }
+
+  // Free arenas with blocks smaller than other arenas have needed since are replaced
+  const size_t block_size = BlockSize();
+  if (!arena || arena->block_size_ < block_size) {
+    arena.reset(new PooledArena(block_size));
+  }
+  arena->pool_ = shared_from_this();
+  return arena.release();
+}
+
+auto ArenaPool::FreeCount() const -> size_t {
+  absl::MutexLock lock(&mutex_);
+  return free_arenas_.size();
+}
+
+void ArenaPool::Return(std::unique_ptr<PooledArena> arena, uint64_t space_allocated) {
+  // An arena that needed more than its block grows the blocks of later arenas
+  if (space_allocated > arena->block_size_) {
+    const size_t needed =
+        std::min(BufferPool::Capacity(static_cast<size_t>(space_allocated)), kMaxBlockSize);
+    size_t current = block_size_.load(std::memory_order_relaxed);
+    while (current < needed &&
+           !block_size_.compare_exchange_weak(current, needed, std::memory_order_relaxed)) {
+    }
+  }
+
+  // Arenas with too small a block, or beyond kMaxFreeArenas, are freed outside the lock
+  if (arena->block_size_ < BlockSize()) {
+    return;
+  }
+  absl::MutexLock lock(&mutex_);
+  if (free_arenas_.size() < kMaxFreeArenas) {
+    free_arenas_.push_back(std::move(arena));
+  }
+}
+
+}  // namespace tiny_dds::core
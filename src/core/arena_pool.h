@@ -0,0 +1,124 @@
+#ifndef TINY_DDS_CORE_ARENA_POOL_H_
+#define TINY_DDS_CORE_ARENA_POOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "google/protobuf/arena.h"
+#include "include/tiny_dds/data_reader.h"
+
+namespace tiny_dds {
+namespace core {
+
+/**
+ * @brief Pool of Protocol Buffers arenas that messages are parsed into.
+ *
+ * Each arena starts with one block from the BufferPool, which it keeps when it
+ * is reset. Blocks are sized from the space the arenas lent out so far needed:
+ * an arena that outgrew its block gets a larger one when it comes back, so in
+ * steady state a message of any size is parsed into a single block allocated
+ * once.
+ *
+ * Arenas are lent out and released from any thread. Lent arenas keep the pool
+ * alive, so they may be released after its owner is gone.
+ */
+class ArenaPool : public std::enable_shared_from_this<ArenaPool> {
+ public:
+  /**
+   * @brief An arena of the pool.
+   */
+  class PooledArena : public LoanedArena {
+   public:
+    /**
+     * @brief Gets the arena to allocate messages on.
+     * @return The arena.
+     */
+    auto arena() -> google::protobuf::Arena* { return arena_.get(); }
+
+    /**
+     * @brief Resets the arena and returns it to its pool.
+     */
+    void Release() override;
+
+    ~PooledArena() override;
+
+   private:
+    friend class ArenaPool;
+
+    explicit PooledArena(size_t block_size);
+
+    // The arena's first block, from the BufferPool, and its size
+    uint8_t* block_ = nullptr;
+    size_t block_size_ = 0;
+
+    std::unique_ptr<google::protobuf::Arena> arena_;
+
+    // The pool the arena is lent from, set while it is lent
+    std::shared_ptr<ArenaPool> pool_;
+  };
+
+  /**
+   * @brief Creates a pool.
+   * @return The pool.
+   */
+  static auto Create() -> std::shared_ptr<ArenaPool>;
+
+  ArenaPool(const ArenaPool&) = delete;
+  ArenaPool& operator=(const ArenaPool&) = delete;
+
+  /**
+   * @brief Lends an arena; it is returned by its Release.
+   * @return The arena, empty.
+   */
+  auto Acquire() -> PooledArena*;
+
+  /**
+   * @brief Gets the size of the first block of new arenas.
+   * @return The block size in bytes.
+   */
+  auto BlockSize() const -> size_t { return block_size_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Gets the number of arenas waiting to be lent.
+   * @return The number of free arenas.
+   */
+  auto FreeCount() const -> size_t;
+
+  /**
+   * @brief Size of the first blocks before any arena came back.
+   */
+  static constexpr size_t kInitialBlockSize = 4096;
+
+  /**
+   * @brief Largest first block; arenas needing more allocate further blocks.
+   */
+  static constexpr size_t kMaxBlockSize = 16 * 1024 * 1024;
+
+  /**
+   * @brief Maximum number of free arenas kept.
+   */
+  static constexpr size_t kMaxFreeArenas = 64;
+
+ private:
+  ArenaPool() = default;
+
+  // Takes back a released arena, replacing its block if it is too small
+  void Return(std::unique_ptr<PooledArena> arena, uint64_t space_allocated);
+
+  // Size of the first block of new and replaced arenas
+  std::atomic<size_t> block_size_{kInitialBlockSize};
+
+  std::vector<std::unique_ptr<PooledArena>> free_arenas_;
+
+  // Mutex for thread safety
+  mutable absl::Mutex mutex_;
+};
+
+}  // namespace core
+}  // namespace tiny_dds
+
+#endif  // TINY_DDS_CORE_ARENA_POOL_H_
@@ -0,0 +1,121 @@
+#include "src/core/buffer_pool.h"
+
+#include <cstddef>
+
+namespace tiny_dds::core {
+
+namespace {
+
+// Allocator that places the control block of a shared buffer in the header of
+// the pooled buffer holding the bytes. The control block is freed after the
+// bytes are no longer used, so freeing it returns the whole buffer to the pool.
+template <typename T>
+class SharedHeaderAllocator {
+ public:
+  using value_type = T;
+
+  SharedHeaderAllocator(uint8_t* buffer, size_t size) : buffer_(buffer), size_(size) {}
+
+  template <typename U>
+  SharedHeaderAllocator(const SharedHeaderAllocator<U>& other)  // NOLINT(runtime/explicit)
+      : buffer_(other.buffer_), size_(other.size_) {}
+
+  auto allocate(size_t /*count*/) -> T* {
+    static_assert(sizeof(T) <= BufferPool::kSharedHeaderSize &&
+                      alignof(T) <= alignof(std::max_align_t),
+                  "The control block must fit the header of a shared buffer");
+    return reinterpret_cast<T*>(buffer_);
+  }
+
+  void deallocate(T* /*pointer*/, size_t /*count*/) {
+    BufferPool::Instance().Release(buffer_, size_);
+  }
+
+  template <typename U>
+  auto operator==(const SharedHeaderAllocator<U>& other) const -> bool {
+    return buffer_ == other.buffer_;
+  }
+
+  template <typename U>
+  auto operator!=(const SharedHeaderAllocator<U>& other) const -> bool {
+    return buffer_ != other.buffer_;
+  }
+
+ private:
+  template <typename U>
+  friend class SharedHeaderAllocator;
+
+  // Pooled buffer holding the header and the bytes
+  uint8_t* buffer_;
+
+  // Size the buffer was allocated for
+  size_t size_;
+};
+
+}  // namespace
+
+auto BufferPool::Instance() -> BufferPool& {
+  static auto* pool = new BufferPool();
+  return *pool;
+}
+
+auto BufferPool::Allocate(size_t size) -> uint8_t* {
+  if (size > kMaxBufferSize) {
+    return new uint8_t[size];
+  }
+
+  SizeClass& size_class = classes_[ClassIndex(size)];
+  {
+    absl::MutexLock lock(&size_class.mutex);
+    if (!size_class.free_buffers.empty()) {
+      uint8_t* buffer = size_class.free_buffers.back();
+      size_class.free_buffers.pop_back();
+      return buffer;
+    }
+  }
+
+  return new uint8_t[Capacity(size)];
+}
+
+void BufferPool::Release(uint8_t* buffer, size_t size) {
+  if (buffer == nullptr) {
+    return;
+  }
+
+  if (size <= kMaxBufferSize) {
+    SizeClass& size_class = classes_[ClassIndex(size)];
+    absl::MutexLock lock(&size_class.mutex);
+    if (size_class.free_buffers.size() < kMaxFreeBuffers) {
+      size_class.free_buffers.push_back(buffer);
+      return;
+    }
+  }
+
+  delete[] buffer;
+}
+
+auto BufferPool::AllocateShared(size_t size) -> std::shared_ptr<uint8_t> {
+  const size_t buffer_size = kSharedHeaderSize + size;
+  uint8_t* buffer = Allocate(buffer_size);
+
+  // The bytes need no cleanup of their own; the allocator releases the buffer
+  return std::shared_ptr<uint8_t>(buffer + kSharedHeaderSize, [](uint8_t*) {},
+                                  SharedHeaderAllocator<uint8_t>(buffer, buffer_size));
+}
+
+auto BufferPool::Capacity(size_t size) -> size_t {
+  if (size > kMaxBufferSize) {
+    return size;
+  }
+  return kMinBufferSize << ClassIndex(size);
+}
+
+auto BufferPool::ClassIndex(size_t size) -> size_t {
+  size_t index = 0;
+  while ((kMinBufferSize << index) < size) {
+    ++index;
+  }
+  return index;
+}
+
+}  // namespace tiny_dds::core
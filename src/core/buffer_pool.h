@@ -0,0 +1,107 @@
+#ifndef TINY_DDS_CORE_BUFFER_POOL_H_
+#define TINY_DDS_CORE_BUFFER_POOL_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+
+namespace tiny_dds {
+namespace core {
+
+/**
+ * @brief Process-wide pool of sample buffers in power-of-two size classes.
+ *
+ * Released buffers are kept on a free list per size class and handed out again,
+ * so a steady stream of samples of similar sizes does not allocate. Each class
+ * keeps a bounded number of free buffers; buffers above the largest class are
+ * allocated and freed directly.
+ *
+ * Shared buffers hold one received or written sample for several readers. Their
+ * reference count lives in the same pooled buffer as the bytes, so handing one
+ * out does not allocate either, and the buffer returns to the pool once the
+ * last reader has taken or dropped the sample.
+ */
+class BufferPool {
+ public:
+  /**
+   * @brief Gets the pool shared by all readers in this process.
+   * @return The process-wide pool.
+   */
+  static auto Instance() -> BufferPool&;
+
+  /**
+   * @brief Gets a buffer of at least the given size.
+   * @param size The number of bytes needed.
+   * @return The buffer; it holds Capacity(size) bytes.
+   */
+  auto Allocate(size_t size) -> uint8_t*;
+
+  /**
+   * @brief Returns a buffer to the pool.
+   * @param buffer A buffer from Allocate.
+   * @param size The size it was allocated for.
+   */
+  void Release(uint8_t* buffer, size_t size);
+
+  /**
+   * @brief Gets a reference-counted buffer of at least the given size.
+   * @param size The number of bytes needed.
+   * @return The buffer; it goes back to the pool when the last copy of the pointer is dropped.
+   */
+  auto AllocateShared(size_t size) -> std::shared_ptr<uint8_t>;
+
+  /**
+   * @brief Gets the capacity of buffers allocated for a size.
+   * @param size The number of bytes needed.
+   * @return The size rounded up to its size class.
+   */
+  static auto Capacity(size_t size) -> size_t;
+
+  /**
+   * @brief Smallest and largest pooled buffer sizes.
+   */
+  static constexpr size_t kMinBufferSize = 512;
+  static constexpr size_t kMaxBufferSize = 1024 * 1024;
+
+  /**
+   * @brief Maximum number of free buffers kept per size class.
+   */
+  static constexpr size_t kMaxFreeBuffers = 256;
+
+  /**
+   * @brief Bytes in front of every shared buffer that hold its reference count.
+   */
+  static constexpr size_t kSharedHeaderSize = 64;
+
+ private:
+  /**
+   * @brief Constructor.
+   */
+  BufferPool() = default;
+
+  // Free buffers of one size
+  struct SizeClass {
+    std::vector<uint8_t*> free_buffers;
+    absl::Mutex mutex;
+  };
+
+  // Returns the index of the size class for a size, which must not exceed kMaxBufferSize
+  static auto ClassIndex(size_t size) -> size_t;
+
+  // Number of size classes from kMinBufferSize to kMaxBufferSize
+  static constexpr size_t kClassCount = 12;
+  static_assert((kMinBufferSize << (kClassCount - 1)) == kMaxBufferSize,
+                "Size classes must cover kMinBufferSize to kMaxBufferSize");
+
+  // Size classes, smallest first
+  std::array<SizeClass, kClassCount> classes_;
+};
+
+}  // namespace core
+}  // namespace tiny_dds
+
+#endif  // TINY_DDS_CORE_BUFFER_POOL_H_
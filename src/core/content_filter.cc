@@ -0,0 +1,909 @@
+#include "src/core/content_filter.h"
+
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/wire_format_lite.h"
+
+namespace tiny_dds::core {
+
+using google::protobuf::Descriptor;
+using google::protobuf::FieldDescriptor;
+using google::protobuf::internal::WireFormatLite;
+
+namespace {
+
+// A token of a filter expression
+struct Token {
+  enum class Kind { END, IDENTIFIER, NUMBER, STRING, PARAMETER, SYMBOL, INVALID };
+  Kind kind = Kind::END;
+  std::string text;
+};
+
+// Splits filter expressions, and parameters, into tokens
+class Lexer {
+ public:
+  explicit Lexer(const std::string& text) : text_(text) {}
+
+  auto Next() -> Token {
+    while (position_ < text_.size() && isspace(static_cast<unsigned char>(text_[position_]))) {
+      ++position_;
+    }
+    if (position_ == text_.size()) {
+      return {Token::Kind::END, ""};
+    }
+
+    const size_t start = position_;
+    const char c = text_[position_];
+    auto at = [this](size_t index) -> char { return index < text_.size() ? text_[index] : '\0'; };
+    auto is_digit = [](char value) { return isdigit(static_cast<unsigned char>(value)) != 0; };
+
+    if (isalpha(static_cast<unsigned char>(c)) != 0 || c == '_') {
+      while (isalnum(static_cast<unsigned char>(at(position_))) != 0 || at(position_) == '_' ||
+             at(position_) == '.') {
+        ++position_;
+      }
+      return {Token::Kind::IDENTIFIER, text_.substr(start, position_ - start)};
+    }
+
+    if (is_digit(c) || ((c == '-' || c == '+' || c == '.') &&
+                        (is_digit(at(position_ + 1)) || at(position_ + 1) == '.'))) {
+      ++position_;
+      while (is_digit(at(position_)) || at(position_) == '.' ||
+             ((at(position_) == 'e' || at(position_) == 'E') &&
+              (is_digit(at(position_ + 1)) || at(position_ + 1) == '-' ||
+               at(position_ + 1) == '+'))) {
+        position_ += at(position_) == 'e' || at(position_) == 'E' ? 2 : 1;
+      }
+      return {Token::Kind::NUMBER, text_.substr(start, position_ - start)};
+    }
+
+    if (c == '\'') {
+      // Quotes inside strings are doubled
+      std::string value;
+      ++position_;
+      while (position_ < text_.size()) {
+        if (text_[position_] == '\'') {
+          if (at(position_ + 1) != '\'') {
+            ++position_;
+            return {Token::Kind::STRING, value};
+          }
+          ++position_;
+        }
+        value += text_[position_++];
+      }
+      return {Token::Kind::INVALID, "unterminated string"};
+    }
+
+    if (c == '%' && is_digit(at(position_ + 1))) {
+      ++position_;
+      while (is_digit(at(position_))) {
+        ++position_;
+      }
+      return {Token::Kind::PARAMETER, text_.substr(start + 1, position_ - start - 1)};
+    }
+
+    for (const char* symbol : {"<=", ">=", "<>", "!=", "=", "<", ">", "(", ")"}) {
+      const size_t length = strlen(symbol);
+      if (text_.compare(position_, length, symbol) == 0) {
+        position_ += length;
+        return {Token::Kind::SYMBOL, symbol};
+      }
+    }
+
+    return {Token::Kind::INVALID, std::string("unexpected character '") + c + "'"};
+  }
+
+ private:
+  const std::string& text_;
+  size_t position_ = 0;
+};
+
+auto IsKeyword(const Token& token, const char* keyword) -> bool {
+  if (token.kind != Token::Kind::IDENTIFIER || token.text.size() != strlen(keyword)) {
+    return false;
+  }
+  for (size_t i = 0; i < token.text.size(); ++i) {
+    if (toupper(static_cast<unsigned char>(token.text[i])) != keyword[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+auto IsReserved(const Token& token) -> bool {
+  for (const char* keyword : {"AND", "OR", "NOT", "LIKE", "BETWEEN"}) {
+    if (IsKeyword(token, keyword)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// SQL LIKE: % matches any run of characters, _ any one character
+auto Like(std::string_view text, std::string_view pattern) -> bool {
+  size_t t = 0;
+  size_t p = 0;
+  size_t star = std::string_view::npos;
+  size_t mark = 0;
+  while (t < text.size()) {
+    if (p < pattern.size() && (pattern[p] == '_' || pattern[p] == text[t])) {
+      ++t;
+      ++p;
+    } else if (p < pattern.size() && pattern[p] == '%') {
+      star = p++;
+      mark = t;
+    } else if (star != std::string_view::npos) {
+      p = star + 1;
+      t = ++mark;
+    } else {
+      return false;
+    }
+  }
+  while (p < pattern.size() && pattern[p] == '%') {
+    ++p;
+  }
+  return p == pattern.size();
+}
+
+}  // namespace
+
+// Recursive descent parser that emits the postfix program as it goes
+class ContentFilter::Parser {
+ public:
+  Parser(ContentFilter* filter, const std::string& expression,
+         const std::vector<std::string>& parameters)
+      : filter_(filter), lexer_(expression), parameters_(parameters) {
+    token_ = lexer_.Next();
+  }
+
+  auto Parse() -> bool {
+    if (token_.kind == Token::Kind::END) {
+      return true;
+    }
+    if (!ParseOr()) {
+      return false;
+    }
+    if (token_.kind != Token::Kind::END) {
+      return Fail("unexpected '" + token_.text + "'");
+    }
+    return true;
+  }
+
+  auto GetError() const -> const std::string& { return error_; }
+
+ private:
+  // An operand before its type is checked against the other side
+  struct ParsedOperand {
+    Operand operand;
+    const FieldDescriptor* field = nullptr;
+
+    // Names that are not fields of the type: enum value names, or the error
+    std::string identifier;
+    std::string error;
+  };
+
+  void Advance() { token_ = lexer_.Next(); }
+
+  auto Fail(std::string message) -> bool {
+    if (error_.empty()) {
+      error_ = std::move(message);
+    }
+    return false;
+  }
+
+  auto IsSymbol(const char* symbol) const -> bool {
+    return token_.kind == Token::Kind::SYMBOL && token_.text == symbol;
+  }
+
+  auto ParseOr() -> bool {
+    if (!ParseAnd()) {
+      return false;
+    }
+    while (IsKeyword(token_, "OR")) {
+      Advance();
+      if (!ParseAnd()) {
+        return false;
+      }
+      Emit(Instruction::Opcode::OR);
+    }
+    return true;
+  }
+
+  auto ParseAnd() -> bool {
+    if (!ParseNot()) {
+      return false;
+    }
+    while (IsKeyword(token_, "AND")) {
+      Advance();
+      if (!ParseNot()) {
+        return false;
+      }
+      Emit(Instruction::Opcode::AND);
+    }
+    return true;
+  }
+
+  auto ParseNot() -> bool {
+    if (IsKeyword(token_, "NOT")) {
+      Advance();
+      if (!ParseNot()) {
+        return false;
+      }
+      Emit(Instruction::Opcode::NOT);
+      return true;
+    }
+
+    if (IsSymbol("(")) {
+      Advance();
+      if (!ParseOr()) {
+        return false;
+      }
+      if (!IsSymbol(")")) {
+        return Fail("expected ')'");
+      }
+      Advance();
+      return true;
+    }
+
+    return ParsePredicate();
+  }
+
+  auto ParsePredicate() -> bool {
+    ParsedOperand left;
+    if (!ParseOperand(&left)) {
+      return false;
+    }
+
+    bool negate = false;
+    if (IsKeyword(token_, "NOT")) {
+      negate = true;
+      Advance();
+      if (!IsKeyword(token_, "BETWEEN") && !IsKeyword(token_, "LIKE")) {
+        return Fail("expected BETWEEN or LIKE after NOT");
+      }
+    }
+
+    if (IsKeyword(token_, "BETWEEN")) {
+      ParsedOperand low;
+      ParsedOperand high;
+      Advance();
+      if (!ParseOperand(&low)) {
+        return false;
+      }
+      if (!IsKeyword(token_, "AND")) {
+        return Fail("expected AND in BETWEEN");
+      }
+      Advance();
+      if (!ParseOperand(&high) || !EmitComparison(Comparison::GREATER_EQUAL, left, low) ||
+          !EmitComparison(Comparison::LESS_EQUAL, left, high)) {
+        return false;
+      }
+      Emit(Instruction::Opcode::AND);
+    } else {
+      Comparison comparison;
+      if (IsKeyword(token_, "LIKE")) {
+        comparison = Comparison::LIKE;
+      } else if (IsSymbol("=")) {
+        comparison = Comparison::EQUAL;
+      } else if (IsSymbol("<>") || IsSymbol("!=")) {
+        comparison = Comparison::NOT_EQUAL;
+      } else if (IsSymbol("<")) {
+        comparison = Comparison::LESS;
+      } else if (IsSymbol("<=")) {
+        comparison = Comparison::LESS_EQUAL;
+      } else if (IsSymbol(">")) {
+        comparison = Comparison::GREATER;
+      } else if (IsSymbol(">=")) {
+        comparison = Comparison::GREATER_EQUAL;
+      } else if (!negate && left.field != nullptr &&
+                 left.field->cpp_type() == FieldDescriptor::CPPTYPE_BOOL) {
+        // A boolean field on its own is true when set to true
+        ParsedOperand right;
+        right.operand.constant.int_value = 1;
+        return EmitComparison(Comparison::EQUAL, left, right);
+      } else {
+        return Fail(token_.kind == Token::Kind::INVALID ? token_.text
+                                                        : "expected a comparison operator");
+      }
+
+      ParsedOperand right;
+      Advance();
+      if (!ParseOperand(&right) || !EmitComparison(comparison, left, right)) {
+        return false;
+      }
+    }
+
+    if (negate) {
+      Emit(Instruction::Opcode::NOT);
+    }
+    return true;
+  }
+
+  auto ParseOperand(ParsedOperand* operand) -> bool {
+    Token token = token_;
+    if (token.kind == Token::Kind::INVALID) {
+      return Fail(token.text);
+    }
+    Advance();
+
+    // Parameters are literals given as text
+    bool parameter = false;
+    if (token.kind == Token::Kind::PARAMETER) {
+      const size_t index = std::strtoul(token.text.c_str(), nullptr, 10);
+      if (index >= parameters_.size()) {
+        return Fail("missing parameter %" + token.text);
+      }
+      Lexer lexer(parameters_[index]);
+      token = lexer.Next();
+      if (lexer.Next().kind != Token::Kind::END || token.kind == Token::Kind::PARAMETER ||
+          token.kind == Token::Kind::SYMBOL || token.kind == Token::Kind::INVALID) {
+        token = {Token::Kind::STRING, parameters_[index]};
+      }
+      parameter = true;
+    }
+
+    switch (token.kind) {
+      case Token::Kind::IDENTIFIER:
+        if (IsKeyword(token, "TRUE") || IsKeyword(token, "FALSE")) {
+          operand->operand.constant.int_value = IsKeyword(token, "TRUE") ? 1 : 0;
+          return true;
+        }
+        if (IsReserved(token)) {
+          return Fail("expected a field or value before " + token.text);
+        }
+        operand->identifier = token.text;
+        if (!parameter) {
+          ResolveField(token.text, operand);
+        }
+        return true;
+
+      case Token::Kind::NUMBER:
+        return ParseNumber(token.text, &operand->operand.constant);
+
+      case Token::Kind::STRING:
+        operand->operand.constant.kind = ValueKind::STRING;
+        operand->operand.constant.string_value = filter_->AddString(token.text);
+        return true;
+
+      default:
+        return Fail("expected a field or value");
+    }
+  }
+
+  auto ParseNumber(const std::string& text, Value* value) -> bool {
+    char* end = nullptr;
+    errno = 0;
+    if (text.find_first_of(".eE") != std::string::npos) {
+      value->kind = ValueKind::DOUBLE;
+      value->double_value = std::strtod(text.c_str(), &end);
+    } else if (text[0] == '-') {
+      value->int_value = std::strtoll(text.c_str(), &end, 10);
+    } else {
+      value->kind = ValueKind::UINT;
+      value->uint_value = std::strtoull(text.c_str(), &end, 10);
+    }
+    if (errno != 0 || *end != '\0') {
+      return Fail("invalid number " + text);
+    }
+    return true;
+  }
+
+  // Resolves a field path; on failure the operand stays an identifier
+  void ResolveField(const std::string& path, ParsedOperand* operand) {
+    std::vector<const FieldDescriptor*> fields;
+    const Descriptor* descriptor = filter_->descriptor_;
+    size_t start = 0;
+    while (true) {
+      const size_t end = path.find('.', start);
+      const std::string name = path.substr(start, end - start);
+      const FieldDescriptor* field = descriptor ? descriptor->FindFieldByName(name) : nullptr;
+      if (field == nullptr) {
+        operand->error = "unknown field " + path;
+        return;
+      }
+      if (field->is_repeated()) {
+        operand->error = "repeated field " + path + " cannot be filtered";
+        return;
+      }
+      fields.push_back(field);
+
+      if (end == std::string::npos) {
+        break;
+      }
+      descriptor = field->message_type();
+      start = end + 1;
+    }
+
+    if (fields.back()->cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE) {
+      operand->error = "message field " + path + " cannot be compared";
+      return;
+    }
+
+    operand->field = fields.back();
+    operand->operand.slot = filter_->AddField(fields);
+    operand->operand.constant = filter_->fields_[operand->operand.slot].default_value;
+    operand->identifier.clear();
+  }
+
+  // Enum value names compare with enum fields; other names must be fields
+  auto ResolveIdentifier(ParsedOperand* operand, const ParsedOperand& other) -> bool {
+    if (operand->identifier.empty()) {
+      return true;
+    }
+    if (other.field != nullptr && other.field->cpp_type() == FieldDescriptor::CPPTYPE_ENUM) {
+      const auto* value = other.field->enum_type()->FindValueByName(operand->identifier);
+      if (value != nullptr) {
+        operand->operand.constant = Value();
+        operand->operand.constant.int_value = value->number();
+        return true;
+      }
+      return Fail(operand->identifier + " is not a value of " + other.field->enum_type()->name());
+    }
+    if (operand->error.empty()) {
+      // A parameter that is neither a number nor a quoted string
+      operand->operand.constant.kind = ValueKind::STRING;
+      operand->operand.constant.string_value = filter_->AddString(operand->identifier);
+      return true;
+    }
+    return Fail(operand->error);
+  }
+
+  auto EmitComparison(Comparison comparison, ParsedOperand left, ParsedOperand right) -> bool {
+    if (!ResolveIdentifier(&left, right) || !ResolveIdentifier(&right, left)) {
+      return false;
+    }
+
+    const Value& left_value = left.operand.constant;
+    const Value& right_value = right.operand.constant;
+    if ((left_value.kind == ValueKind::STRING) != (right_value.kind == ValueKind::STRING)) {
+      return Fail("cannot compare a string with a number");
+    }
+    if (comparison == Comparison::LIKE &&
+        (left_value.kind != ValueKind::STRING || right.operand.slot >= 0)) {
+      return Fail("LIKE needs a string field and a pattern");
+    }
+
+    Instruction instruction;
+    instruction.opcode = Instruction::Opcode::COMPARE;
+    instruction.comparison = comparison;
+    instruction.left = left.operand;
+    instruction.right = right.operand;
+    filter_->program_.push_back(instruction);
+
+    if (++depth_ > kMaxStackDepth) {
+      return Fail("expression nested too deeply");
+    }
+    return true;
+  }
+
+  void Emit(Instruction::Opcode opcode) {
+    Instruction instruction;
+    instruction.opcode = opcode;
+    filter_->program_.push_back(instruction);
+    if (opcode != Instruction::Opcode::NOT) {
+      --depth_;
+    }
+  }
+
+  ContentFilter* filter_;
+  Lexer lexer_;
+  const std::vector<std::string>& parameters_;
+  Token token_;
+
+  // Results on the evaluation stack at the current point of the program
+  size_t depth_ = 0;
+
+  std::string error_;
+};
+
+auto ContentFilter::Compile(const Descriptor* descriptor, const std::string& expression,
+                            const std::vector<std::string>& parameters)
+    -> std::shared_ptr<const ContentFilter> {
+  if (descriptor == nullptr) {
+    std::cerr << "Filter expressions need a protobuf message type" << std::endl;
+    return nullptr;
+  }
+
+  std::shared_ptr<ContentFilter> filter(new ContentFilter());
+  filter->descriptor_ = descriptor;
+
+  Parser parser(filter.get(), expression, parameters);
+  if (!parser.Parse()) {
+    std::cerr << "Invalid filter expression \"" << expression << "\": " << parser.GetError()
+              << std::endl;
+    return nullptr;
+  }
+  return filter;
+}
+
+auto ContentFilter::AddField(const std::vector<const FieldDescriptor*>& path) -> int {
+  for (size_t i = 0; i < fields_.size(); ++i) {
+    if (fields_[i].path == path) {
+      return static_cast<int>(i);
+    }
+  }
+
+  const FieldDescriptor* leaf = path.back();
+  Field field;
+  field.path = path;
+  switch (leaf->cpp_type()) {
+    case FieldDescriptor::CPPTYPE_INT32:
+      field.default_value.int_value = leaf->default_value_int32();
+      break;
+    case FieldDescriptor::CPPTYPE_INT64:
+      field.default_value.int_value = leaf->default_value_int64();
+      break;
+    case FieldDescriptor::CPPTYPE_UINT32:
+      field.default_value.kind = ValueKind::UINT;
+      field.default_value.uint_value = leaf->default_value_uint32();
+      break;
+    case FieldDescriptor::CPPTYPE_UINT64:
+      field.default_value.kind = ValueKind::UINT;
+      field.default_value.uint_value = leaf->default_value_uint64();
+      break;
+    case FieldDescriptor::CPPTYPE_FLOAT:
+      field.default_value.kind = ValueKind::DOUBLE;
+      field.default_value.double_value = leaf->default_value_float();
+      break;
+    case FieldDescriptor::CPPTYPE_DOUBLE:
+      field.default_value.kind = ValueKind::DOUBLE;
+      field.default_value.double_value = leaf->default_value_double();
+      break;
+    case FieldDescriptor::CPPTYPE_BOOL:
+      field.default_value.int_value = leaf->default_value_bool() ? 1 : 0;
+      break;
+    case FieldDescriptor::CPPTYPE_ENUM:
+      field.default_value.int_value = leaf->default_value_enum()->number();
+      break;
+    case FieldDescriptor::CPPTYPE_STRING:
+      field.default_value.kind = ValueKind::STRING;
+      field.default_value.string_value = AddString(leaf->default_value_string());
+      break;
+    default:
+      break;
+  }
+
+  const int slot = static_cast<int>(fields_.size());
+  fields_.push_back(std::move(field));
+
+  // Add the path to the wire format tree, sharing the nodes of common prefixes
+  if (nodes_.empty()) {
+    nodes_.emplace_back();
+  }
+  int node = 0;
+  for (size_t i = 0; i < path.size(); ++i) {
+    const bool is_leaf = i + 1 == path.size();
+    int child = -1;
+    for (const auto& entry : nodes_[node].entries) {
+      if (entry.number == path[i]->number()) {
+        child = entry.child;
+      }
+    }
+    if (child < 0) {
+      child = is_leaf ? -1 : static_cast<int>(nodes_.size());
+      nodes_[node].entries.push_back({path[i]->number(), path[i], is_leaf ? slot : -1, child});
+      if (!is_leaf) {
+        nodes_.emplace_back();
+      }
+    }
+    node = child;
+  }
+  return slot;
+}
+
+auto ContentFilter::AddString(std::string value) -> std::string_view {
+  strings_.push_back(std::move(value));
+  return strings_.back();
+}
+
+auto ContentFilter::Evaluate(const void* data, size_t size) const -> bool {
+  if (program_.empty()) {
+    return true;
+  }
+
+  thread_local std::vector<Value> slots;
+  slots.resize(fields_.size());
+  for (size_t i = 0; i < fields_.size(); ++i) {
+    slots[i] = fields_[i].default_value;
+  }
+
+  if (!nodes_.empty() && !Scan(0, static_cast<const uint8_t*>(data), size, slots.data())) {
+    return false;
+  }
+  return Run(slots.data());
+}
+
+auto ContentFilter::Evaluate(const google::protobuf::Message& message) const -> bool {
+  if (program_.empty() || message.GetDescriptor() != descriptor_) {
+    return true;
+  }
+
+  thread_local std::vector<Value> slots;
+  thread_local std::vector<std::string> scratch;
+  slots.resize(fields_.size());
+  scratch.resize(fields_.size());
+
+  for (size_t i = 0; i < fields_.size(); ++i) {
+    const auto& path = fields_[i].path;
+    Value& value = slots[i];
+    value = fields_[i].default_value;
+
+    // Fields of unset messages keep their defaults
+    const google::protobuf::Message* current = &message;
+    for (size_t j = 0; j + 1 < path.size() && current != nullptr; ++j) {
+      const auto* reflection = current->GetReflection();
+      current = reflection->HasField(*current, path[j]) ? &reflection->GetMessage(*current, path[j])
+                                                        : nullptr;
+    }
+    if (current == nullptr) {
+      continue;
+    }
+
+    const auto* reflection = current->GetReflection();
+    const FieldDescriptor* field = path.back();
+    switch (field->cpp_type()) {
+      case FieldDescriptor::CPPTYPE_INT32:
+        value.int_value = reflection->GetInt32(*current, field);
+        break;
+      case FieldDescriptor::CPPTYPE_INT64:
+        value.int_value = reflection->GetInt64(*current, field);
+        break;
+      case FieldDescriptor::CPPTYPE_UINT32:
+        value.uint_value = reflection->GetUInt32(*current, field);
+        break;
+      case FieldDescriptor::CPPTYPE_UINT64:
+        value.uint_value = reflection->GetUInt64(*current, field);
+        break;
+      case FieldDescriptor::CPPTYPE_FLOAT:
+        value.double_value = reflection->GetFloat(*current, field);
+        break;
+      case FieldDescriptor::CPPTYPE_DOUBLE:
+        value.double_value = reflection->GetDouble(*current, field);
+        break;
+      case FieldDescriptor::CPPTYPE_BOOL:
+        value.int_value = reflection->GetBool(*current, field) ? 1 : 0;
+        break;
+      case FieldDescriptor::CPPTYPE_ENUM:
+        value.int_value = reflection->GetEnumValue(*current, field);
+        break;
+      case FieldDescriptor::CPPTYPE_STRING:
+        value.string_value = reflection->GetStringReference(*current, field, &scratch[i]);
+        break;
+      default:
+        break;
+    }
+  }
+
+  return Run(slots.data());
+}
+
+auto ContentFilter::Evaluate(const LocalSample& sample) const -> bool {
+  if (sample.data || !sample.message) {
+    return Evaluate(sample.data.get(), sample.size);
+  }
+  return Evaluate(*sample.message);
+}
+
+auto ContentFilter::Scan(int node, const uint8_t* data, size_t size, Value* slots) const -> bool {
+  if (size > static_cast<size_t>(std::numeric_limits<int>::max())) {
+    return false;
+  }
+  google::protobuf::io::CodedInputStream input(data, static_cast<int>(size));
+
+  while (true) {
+    const uint32_t tag = input.ReadTag();
+    if (tag == 0) {
+      return input.ConsumedEntireMessage();
+    }
+
+    const Node::Entry* entry = nullptr;
+    for (const auto& candidate : nodes_[node].entries) {
+      if (candidate.number == WireFormatLite::GetTagFieldNumber(tag)) {
+        entry = &candidate;
+        break;
+      }
+    }
+    const auto wire_type = WireFormatLite::GetTagWireType(tag);
+    if (entry == nullptr ||
+        (entry->slot < 0 && wire_type != WireFormatLite::WIRETYPE_LENGTH_DELIMITED)) {
+      if (!WireFormatLite::SkipField(&input, tag)) {
+        return false;
+      }
+      continue;
+    }
+
+    const FieldDescriptor* field = entry->field;
+    switch (wire_type) {
+      case WireFormatLite::WIRETYPE_VARINT: {
+        uint64_t raw = 0;
+        if (!input.ReadVarint64(&raw)) {
+          return false;
+        }
+        Value& value = slots[entry->slot];
+        switch (field->type()) {
+          case FieldDescriptor::TYPE_INT32:
+          case FieldDescriptor::TYPE_ENUM:
+            value.int_value = static_cast<int32_t>(raw);
+            break;
+          case FieldDescriptor::TYPE_INT64:
+            value.int_value = static_cast<int64_t>(raw);
+            break;
+          case FieldDescriptor::TYPE_UINT32:
+            value.uint_value = static_cast<uint32_t>(raw);
+            break;
+          case FieldDescriptor::TYPE_UINT64:
+            value.uint_value = raw;
+            break;
+          case FieldDescriptor::TYPE_BOOL:
+            value.int_value = raw != 0 ? 1 : 0;
+            break;
+          case FieldDescriptor::TYPE_SINT32:
+            value.int_value = WireFormatLite::ZigZagDecode32(static_cast<uint32_t>(raw));
+            break;
+          case FieldDescriptor::TYPE_SINT64:
+            value.int_value = WireFormatLite::ZigZagDecode64(raw);
+            break;
+          default:
+            break;
+        }
+        break;
+      }
+
+      case WireFormatLite::WIRETYPE_FIXED32: {
+        uint32_t raw = 0;
+        if (!input.ReadLittleEndian32(&raw)) {
+          return false;
+        }
+        Value& value = slots[entry->slot];
+        if (field->type() == FieldDescriptor::TYPE_FIXED32) {
+          value.uint_value = raw;
+        } else if (field->type() == FieldDescriptor::TYPE_SFIXED32) {
+          value.int_value = static_cast<int32_t>(raw);
+        } else if (field->type() == FieldDescriptor::TYPE_FLOAT) {
+          float number = 0;
+          std::memcpy(&number, &raw, sizeof(number));
+          value.double_value = number;
+        }
+        break;
+      }
+
+      case WireFormatLite::WIRETYPE_FIXED64: {
+        uint64_t raw = 0;
+        if (!input.ReadLittleEndian64(&raw)) {
+          return false;
+        }
+        Value& value = slots[entry->slot];
+        if (field->type() == FieldDescriptor::TYPE_FIXED64) {
+          value.uint_value = raw;
+        } else if (field->type() == FieldDescriptor::TYPE_SFIXED64) {
+          value.int_value = static_cast<int64_t>(raw);
+        } else if (field->type() == FieldDescriptor::TYPE_DOUBLE) {
+          std::memcpy(&value.double_value, &raw, sizeof(raw));
+        }
+        break;
+      }
+
+      case WireFormatLite::WIRETYPE_LENGTH_DELIMITED: {
+        // Strings and nested messages are read in place
+        uint32_t length = 0;
+        if (!input.ReadVarint32(&length)) {
+          return false;
+        }
+        const int offset = input.CurrentPosition();
+        if (length > size - static_cast<size_t>(offset)) {
+          return false;
+        }
+        const uint8_t* contents = data + offset;
+        if (entry->child >= 0) {
+          if (!Scan(entry->child, contents, length, slots)) {
+            return false;
+          }
+        } else if (field->cpp_type() == FieldDescriptor::CPPTYPE_STRING) {
+          slots[entry->slot].string_value =
+              std::string_view(reinterpret_cast<const char*>(contents), length);
+        }
+        if (!input.Skip(static_cast<int>(length))) {
+          return false;
+        }
+        break;
+      }
+
+      default:
+        if (!WireFormatLite::SkipField(&input, tag)) {
+          return false;
+        }
+        break;
+    }
+  }
+}
+
+auto ContentFilter::Run(const Value* slots) const -> bool {
+  bool stack[kMaxStackDepth];
+  size_t top = 0;
+
+  for (const auto& instruction : program_) {
+    switch (instruction.opcode) {
+      case Instruction::Opcode::COMPARE: {
+        const Value& left = instruction.left.slot >= 0 ? slots[instruction.left.slot]
+                                                       : instruction.left.constant;
+        const Value& right = instruction.right.slot >= 0 ? slots[instruction.right.slot]
+                                                         : instruction.right.constant;
+        stack[top++] = Compare(instruction.comparison, left, right);
+        break;
+      }
+      case Instruction::Opcode::AND:
+        --top;
+        stack[top - 1] = stack[top - 1] && stack[top];
+        break;
+      case Instruction::Opcode::OR:
+        --top;
+        stack[top - 1] = stack[top - 1] || stack[top];
+        break;
+      case Instruction::Opcode::NOT:
+        stack[top - 1] = !stack[top - 1];
+        break;
+    }
+  }
+
+  return stack[0];
+}
+
+auto ContentFilter::Compare(Comparison comparison, const Value& left, const Value& right)
+    -> bool {
+  int order = 0;
+  if (left.kind == ValueKind::STRING) {
+    if (comparison == Comparison::LIKE) {
+      return Like(left.string_value, right.string_value);
+    }
+    order = left.string_value.compare(right.string_value);
+  } else if (left.kind == ValueKind::DOUBLE || right.kind == ValueKind::DOUBLE) {
+    auto to_double = [](const Value& value) -> double {
+      switch (value.kind) {
+        case ValueKind::INT:
+          return static_cast<double>(value.int_value);
+        case ValueKind::UINT:
+          return static_cast<double>(value.uint_value);
+        default:
+          return value.double_value;
+      }
+    };
+    const double x = to_double(left);
+    const double y = to_double(right);
+    order = (x > y) - (x < y);
+  } else if (left.kind == right.kind) {
+    order = left.kind == ValueKind::INT
+                ? (left.int_value > right.int_value) - (left.int_value < right.int_value)
+                : (left.uint_value > right.uint_value) - (left.uint_value < right.uint_value);
+  } else if (left.kind == ValueKind::INT) {
+    const auto x = static_cast<uint64_t>(left.int_value);
+    order = left.int_value < 0 ? -1 : (x > right.uint_value) - (x < right.uint_value);
+  } else {
+    const auto y = static_cast<uint64_t>(right.int_value);
+    order = right.int_value < 0 ? 1 : (left.uint_value > y) - (left.uint_value < y);
+  }
+
+  switch (comparison) {
+    case Comparison::EQUAL:
+      return order == 0;
+    case Comparison::NOT_EQUAL:
+      return order != 0;
+    case Comparison::LESS:
+      return order < 0;
+    case Comparison::LESS_EQUAL:
+      return order <= 0;
+    case Comparison::GREATER:
+      return order > 0;
+    case Comparison::GREATER_EQUAL:
+      return order >= 0;
+    default:
+      return false;
+  }
+}
+
+}  // namespace tiny_dds::core
@@ -0,0 +1,169 @@
+#ifndef TINY_DDS_CORE_CONTENT_FILTER_H_
+#define TINY_DDS_CORE_CONTENT_FILTER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "google/protobuf/descriptor.h"
+#include "google/protobuf/message.h"
+#include "src/core/intra_process_bus.h"
+
+namespace tiny_dds {
+namespace core {
+
+/**
+ * @brief Filter expression of a ContentFilteredTopic, compiled for one protobuf type.
+ *
+ * Expressions use the SQL-like syntax of DDS filters: comparisons (=, <>,
+ * !=, <, <=, >, >=, LIKE with % and _ wildcards, BETWEEN ... AND ...) of
+ * fields, literals and %n parameters, combined with AND, OR, NOT and
+ * parentheses. Fields are named by their path from the message, such as
+ * "header.priority"; only singular scalar, string and enum fields can be
+ * compared, enum fields compare with the names of their values, and a
+ * boolean field on its own is a condition.
+ *
+ * Compilation resolves every field path to its field numbers and turns the
+ * expression into a postfix program of comparisons, so evaluation never
+ * parses text or looks up names. Serialized samples are evaluated straight
+ * from the wire format: one pass decodes the referenced fields, skipping the
+ * others, without deserializing the message. Fields missing from a sample
+ * compare as their default value. Evaluation is thread-safe.
+ */
+class ContentFilter {
+ public:
+  /**
+   * @brief Compiles a filter expression.
+   * @param descriptor The descriptor of the topic's message type.
+   * @param expression The filter expression; an empty expression accepts every sample.
+   * @param parameters Values of the %0, %1, ... parameters of the expression.
+   * @return The compiled filter, or nullptr if the expression is invalid for the type.
+   */
+  static auto Compile(const google::protobuf::Descriptor* descriptor,
+                      const std::string& expression, const std::vector<std::string>& parameters)
+      -> std::shared_ptr<const ContentFilter>;
+
+  ContentFilter(const ContentFilter&) = delete;
+  ContentFilter& operator=(const ContentFilter&) = delete;
+
+  /**
+   * @brief Evaluates the filter on a serialized sample.
+   * @param data Pointer to the serialized message.
+   * @param size Size of the serialized message in bytes.
+   * @return True if the sample passes the filter, false if it does not or cannot be parsed.
+   */
+  auto Evaluate(const void* data, size_t size) const -> bool;
+
+  /**
+   * @brief Evaluates the filter on a message object.
+   * @param message The message; messages of other types pass.
+   * @return True if the message passes the filter.
+   */
+  auto Evaluate(const google::protobuf::Message& message) const -> bool;
+
+  /**
+   * @brief Evaluates the filter on a sample of the intra-process bus.
+   * @param sample The sample, serialized or held as a message object.
+   * @return True if the sample passes the filter.
+   */
+  auto Evaluate(const LocalSample& sample) const -> bool;
+
+ private:
+  // Kinds of values; booleans and enums are integers
+  enum class ValueKind : uint8_t { INT, UINT, DOUBLE, STRING };
+
+  // A field value or literal
+  struct Value {
+    ValueKind kind = ValueKind::INT;
+    int64_t int_value = 0;
+    uint64_t uint_value = 0;
+    double double_value = 0;
+    std::string_view string_value;
+  };
+
+  // A field read by the expression: its path of fields from the message
+  struct Field {
+    std::vector<const google::protobuf::FieldDescriptor*> path;
+    Value default_value;
+  };
+
+  // Fields of one message level of the wire format, by field number; an
+  // entry either fills a slot or descends into a nested message
+  struct Node {
+    struct Entry {
+      int number;
+      const google::protobuf::FieldDescriptor* field;
+      int slot;   // Index in fields_, or -1
+      int child;  // Index in nodes_, or -1
+    };
+    std::vector<Entry> entries;
+  };
+
+  enum class Comparison : uint8_t {
+    EQUAL,
+    NOT_EQUAL,
+    LESS,
+    LESS_EQUAL,
+    GREATER,
+    GREATER_EQUAL,
+    LIKE
+  };
+
+  // An operand of a comparison: a field slot, or a constant if slot is -1
+  struct Operand {
+    int slot = -1;
+    Value constant;
+  };
+
+  // One step of the postfix program
+  struct Instruction {
+    enum class Opcode : uint8_t { COMPARE, AND, OR, NOT };
+    Opcode opcode;
+    Comparison comparison = Comparison::EQUAL;
+    Operand left;
+    Operand right;
+  };
+
+  // Deepest stack of intermediate results a program may use
+  static constexpr size_t kMaxStackDepth = 32;
+
+  class Parser;
+
+  ContentFilter() = default;
+
+  // Gets the slot of a field path, adding it to fields_ and nodes_ on first use
+  auto AddField(const std::vector<const google::protobuf::FieldDescriptor*>& path) -> int;
+
+  // Keeps a string constant alive for the filter's lifetime
+  auto AddString(std::string value) -> std::string_view;
+
+  // Decodes the fields of a wire format node into slots
+  auto Scan(int node, const uint8_t* data, size_t size, Value* slots) const -> bool;
+
+  // Runs the program on the slot values
+  auto Run(const Value* slots) const -> bool;
+
+  static auto Compare(Comparison comparison, const Value& left, const Value& right) -> bool;
+
+  // The message type the filter was compiled for
+  const google::protobuf::Descriptor* descriptor_ = nullptr;
+
+  // Fields read by the expression, and the wire format tree that locates them
+  std::vector<Field> fields_;
+  std::vector<Node> nodes_;
+
+  // The expression in postfix order
+  std::vector<Instruction> program_;
+
+  // Storage of string constants
+  std::deque<std::string> strings_;
+};
+
+}  // namespace core
+}  // namespace tiny_dds
+
+#endif  // TINY_DDS_CORE_CONTENT_FILTER_H_
@@ -3,7 +3,9 @@
 #include <algorithm>
 #include <cstring>
 
+#include "absl/time/time.h"
 #include "src/core/domain_participant_impl.h"
+#include "src/core/read_condition_impl.h"
 #include "src/core/subscriber_impl.h"
 #include "src/core/topic_impl.h"
 #include "src/transport/transport_manager.h"
@@ -14,62 +16,398 @@ namespace tiny_dds::core {
 constexpr size_t kDefaultBufferSize = 1024 * 1024;    // 1MB buffer size
 constexpr size_t kDefaultMaxMessageSize = 64 * 1024;  // 64KB max message size
 
+// Strands per executor worker for callbacks ordered PER_INSTANCE; instances
+// share strands, so more strands than workers keep the workers busy
+constexpr size_t kInstanceStrandsPerWorker = 4;
+
+// Sequence numbers counted as lost that each writer's late samples can still
+// take back from the count
+constexpr uint64_t kMaxMissingTracked = 256;
+
+namespace {
+
+// Keyed readers apply history.depth to each instance, and max_samples to the whole history
+auto ReaderHistory(const Topic& topic, const HistoryQos& qos) -> HistoryQos {
+  HistoryQos history = qos;
+  if (qos.kind == HistoryKind::KEEP_LAST && !topic.GetKeyFields().empty()) {
+    history.depth = std::max(qos.depth, qos.max_samples);
+  }
+  return history;
+}
+
+// Refers to the payload of a sample other readers share, without copying it
+auto SharedPayload(const SharedReceiver::Frame& frame, const void* payload, size_t size)
+    -> LocalSample {
+  LocalSample sample;
+  sample.data = std::shared_ptr<const void>(frame.buffer, payload);
+  sample.size = size;
+  return sample;
+}
+
+}  // namespace
+
 DataReaderImpl::DataReaderImpl(std::shared_ptr<Topic> topic,
-                               std::shared_ptr<SubscriberImpl> subscriber)
+                               std::shared_ptr<SubscriberImpl> subscriber,
+                               const DataReaderQos& qos)
     : topic_(std::move(topic)),
       subscriber_(std::move(subscriber)),
-      data_received_callback_(nullptr) {
-  // Initialize any resources needed for the data reader
+      durability_(qos.durability),
+      history_request_{qos.replay_from_sequence_number, qos.replay_from_timestamp},
+      history_(ReaderHistory(*topic_, qos.history)),
+      minimum_separation_(qos.time_based_filter.minimum_separation.count()),
+      deadline_period_(qos.deadline.period),
+      lease_duration_(qos.liveliness.lease_duration) {
+  auto participant = subscriber_->GetParticipant();
+  domain_id_ = participant->GetDomainId();
+
+  // Readers of a content-filtered topic receive the samples of the related topic
+  std::shared_ptr<Topic> sample_topic = topic_;
+  if (auto filtered_topic = std::dynamic_pointer_cast<ContentFilteredTopicImpl>(topic_)) {
+    sample_topic = filtered_topic->GetRelatedTopic();
+    filter_ = filtered_topic->GetFilter();
+  }
+  topic_name_ = sample_topic->GetName();
+
+  // Readers of a keyed topic keep the samples of each instance apart
+  if (auto keyed_topic = std::dynamic_pointer_cast<TopicImpl>(sample_topic)) {
+    instance_key_ = keyed_topic->GetInstanceKey();
+  }
+  if (instance_key_ && qos.history.kind == HistoryKind::KEEP_LAST) {
+    instance_depth_ = static_cast<size_t>(std::max(qos.history.depth, 1));
+  }
+  transport_type_ = participant->GetTransportType();
+  dispatcher_ = participant->GetReceiveDispatcher();
+
+  // LOCAL_ONLY readers are fed by the intra-process bus and need no transport
+  if (transport_type_ == TransportType::LOCAL_ONLY) {
+    return;
+  }
 
   // Get the transport manager
-  auto transport_manager = transport::TransportManager::Create();
+  auto transport_manager = transport::TransportManager::GetInstance();
 
-  // Create the transport for this topic
-  transport_manager->CreateTransport(subscriber_->GetParticipant()->GetDomainId(),
-                                     subscriber_->GetParticipant()->GetName(), topic_->GetName(),
-                                     kDefaultBufferSize, kDefaultMaxMessageSize,
-                                     subscriber_->GetParticipant()->GetTransportType());
+  // Create the transport for this topic and subscribe to it
+  if (!transport_manager->CreateTransport(domain_id_, participant->GetName(), topic_name_,
+                                          kDefaultBufferSize, kDefaultMaxMessageSize,
+                                          transport_type_) ||
+      !transport_manager->Subscribe(domain_id_, topic_name_, transport_type_)) {
+    return;
+  }
 
-  // Subscribe to the topic
-  transport_manager->Subscribe(subscriber_->GetParticipant()->GetDomainId(), topic_->GetName(),
-                               subscriber_->GetParticipant()->GetTransportType());
+  auto endpoint = transport_manager->OpenEndpoint(domain_id_, topic_name_, transport_type_);
+  if (endpoint) {
+    receiver_ = SharedReceiver::Join(endpoint, &receiver_id_);
+  }
+  receive_buffer_.resize(kDefaultMaxMessageSize);
+  poll_buffer_.resize(kDefaultMaxMessageSize);
 }
 
-DataReaderImpl::~DataReaderImpl() = default;
+DataReaderImpl::~DataReaderImpl() {
+  if (receiver_) {
+    receiver_->Leave(receiver_id_);
+  }
+
+  // Timers that fire meanwhile find the reader gone
+  dispatcher_->RemoveTimer(deadline_.timer);
+  for (const Instance& instance : instances_) {
+    dispatcher_->RemoveTimer(instance.deadline.timer);
+  }
+  for (const auto& [guid, progress] : writers_) {
+    dispatcher_->RemoveTimer(progress.liveliness_timer);
+  }
+}
 
 auto DataReaderImpl::Read(void* buffer, size_t buffer_size, SampleInfo& info) -> int32_t {
   absl::MutexLock lock(&mutex_);
 
-  // Get the transport manager
-  auto transport_manager = transport::TransportManager::Create();
+  status_changes_ &= ~DATA_AVAILABLE_STATUS;
 
-  // Use the transport manager to receive data
-  size_t bytes_received = 0;
-  bool result = transport_manager->Receive(subscriber_->GetParticipant()->GetDomainId(),
-                                           topic_->GetName(), buffer, buffer_size, &bytes_received,
-                                           subscriber_->GetParticipant()->GetTransportType());
+  // Read samples form a prefix of the history, so the first unread one follows them
+  if (history_.ReadCount() == history_.Size() && FetchFromTransportLocked(1) == 0) {
+    return -1;
+  }
 
-  if (result) {
-    // Update sample info
-    info.valid_data = true;
+  const size_t index = history_.ReadCount();
+  int32_t size = history_.CopyTo(index, buffer, buffer_size);
+  if (size >= 0) {
+    history_.MarkRead(index + 1);
   }
 
-  return result ? static_cast<int32_t>(bytes_received) : -1;
+  info = history_.Info(index);
+  info.valid_data = size >= 0;
+  info.sample_state = SampleStateKind::NOT_READ;
+  return size;
 }
 
 int32_t DataReaderImpl::Take(void* buffer, size_t buffer_size, SampleInfo& info) {
-  // For now, Take is the same as Read
-  return Read(buffer, buffer_size, info);
+  absl::MutexLock lock(&mutex_);
+  return TakeLocked(buffer, buffer_size, info);
+}
+
+int32_t DataReaderImpl::ReadN(SampleBuffer* buffers, SampleInfo* infos, size_t max_samples,
+                              SampleStateMask sample_states) {
+  absl::MutexLock lock(&mutex_);
+  return CopySamplesLocked(buffers, infos, max_samples, sample_states, false);
+}
+
+int32_t DataReaderImpl::TakeN(SampleBuffer* buffers, SampleInfo* infos, size_t max_samples,
+                              SampleStateMask sample_states) {
+  absl::MutexLock lock(&mutex_);
+  return CopySamplesLocked(buffers, infos, max_samples, sample_states, true);
+}
+
+int32_t DataReaderImpl::Take(void* buffer, size_t buffer_size, SampleInfo& info,
+                             std::chrono::nanoseconds timeout) {
+  absl::MutexLock lock(&mutex_);
+
+  int32_t result = TakeLocked(buffer, buffer_size, info);
+  if (result >= 0) {
+    return result;
+  }
+
+  // Samples are queued under mutex_, which re-evaluates the condition when it
+  // is released, so a sample queued at any point after the check above wakes us
+  auto has_samples = [this]() { return !history_.Empty(); };
+  if (!mutex_.AwaitWithTimeout(absl::Condition(&has_samples), absl::FromChrono(timeout))) {
+    return -1;
+  }
+
+  return TakeLocked(buffer, buffer_size, info);
+}
+
+auto DataReaderImpl::TakeLocked(void* buffer, size_t buffer_size, SampleInfo& info) -> int32_t {
+  status_changes_ &= ~DATA_AVAILABLE_STATUS;
+
+  // Samples from writers in this process or the receive thread are already
+  // queued; others are fetched so that their header is stripped
+  if (history_.Empty() && FetchFromTransportLocked(1) == 0) {
+    return -1;
+  }
+
+  info = history_.Info(0);
+  info.sample_state =
+      history_.ReadCount() > 0 ? SampleStateKind::READ : SampleStateKind::NOT_READ;
+  int32_t size = history_.TakeInto(buffer, buffer_size);
+  info.valid_data = size >= 0;
+  return size;
+}
+
+auto DataReaderImpl::CopySamplesLocked(SampleBuffer* buffers, SampleInfo* infos,
+                                       size_t max_samples, SampleStateMask sample_states,
+                                       bool take) -> int32_t {
+  status_changes_ &= ~DATA_AVAILABLE_STATUS;
+
+  if ((sample_states & NOT_READ_SAMPLE_STATE) != 0) {
+    const size_t not_read = history_.Size() - history_.ReadCount();
+    if (not_read < max_samples) {
+      FetchFromTransportLocked(max_samples - not_read);
+    }
+  }
+
+  size_t begin = 0;
+  size_t end = 0;
+  history_.Select(sample_states, &begin, &end);
+
+  const size_t read_count = history_.ReadCount();
+  size_t count = 0;
+  for (; count < max_samples && begin + count < end; ++count) {
+    const size_t index = begin + count;
+    int32_t size = history_.CopyTo(index, buffers[count].data, buffers[count].capacity);
+    if (size < 0) {
+      break;
+    }
+
+    buffers[count].size = static_cast<size_t>(size);
+    infos[count] = history_.Info(index);
+    infos[count].valid_data = true;
+    infos[count].sample_state =
+        index < read_count ? SampleStateKind::READ : SampleStateKind::NOT_READ;
+  }
+
+  if (take) {
+    history_.Remove(begin, count);
+  } else {
+    history_.MarkRead(begin + count);
+  }
+  return static_cast<int32_t>(count);
+}
+
+auto DataReaderImpl::FetchFromTransportLocked(size_t max_samples) -> size_t {
+  size_t fetched = 0;
+  SharedReceiver::Frame frame;
+  while (fetched < max_samples && ReceiveFromTransport(&receive_buffer_, &frame)) {
+    SampleInfo info;
+    const void* payload = nullptr;
+    size_t payload_size = 0;
+    if (!UnframeLocked(frame.data, frame.size, &info, &payload, &payload_size) ||
+        !AssignInstanceLocked(payload, payload_size, &info) || !PassesTimeFilterLocked(info)) {
+      continue;
+    }
+    RenewDeadlineLocked(info.instance_handle);
+    const bool pushed = frame.buffer
+                            ? PushLocked(SharedPayload(frame, payload, payload_size), info)
+                            : PushCopyLocked(payload, payload_size, info);
+    if (pushed) {
+      ++fetched;
+    }
+  }
+  return fetched;
+}
+
+bool DataReaderImpl::TakeMessage(google::protobuf::Message* message, SampleInfo& info) {
+  absl::MutexLock lock(&mutex_);
+  return TakeMessageLocked(message, info);
+}
+
+auto DataReaderImpl::TakeArenaMessage(const google::protobuf::Message& prototype,
+                                      SampleInfo& info) -> ArenaMessagePtr<> {
+  absl::MutexLock lock(&mutex_);
+
+  status_changes_ &= ~DATA_AVAILABLE_STATUS;
+
+  // Arenas are only lent for samples there are
+  if (history_.Empty() && FetchFromTransportLocked(1) == 0) {
+    return nullptr;
+  }
+
+  if (!arena_pool_) {
+    arena_pool_ = ArenaPool::Create();
+  }
+  ArenaPool::PooledArena* arena = arena_pool_->Acquire();
+  ArenaMessagePtr<> message(prototype.New(arena->arena()), ArenaMessageDeleter{arena});
+  if (!TakeMessageLocked(message.get(), info)) {
+    return nullptr;
+  }
+  return message;
+}
+
+auto DataReaderImpl::TakeMessageLocked(google::protobuf::Message* message, SampleInfo& info)
+    -> bool {
+  status_changes_ &= ~DATA_AVAILABLE_STATUS;
+
+  if (history_.Empty() && FetchFromTransportLocked(1) == 0) {
+    return false;
+  }
+
+  SampleHistory::SampleView sample = history_.Front();
+  info = history_.Info(0);
+  info.sample_state =
+      history_.ReadCount() > 0 ? SampleStateKind::READ : SampleStateKind::NOT_READ;
+
+  bool parsed = false;
+  if (sample.message && sample.message->GetDescriptor() == message->GetDescriptor()) {
+    // Same type as the writer's object, no serialization round trip needed
+    message->CopyFrom(*sample.message);
+    parsed = true;
+  } else if (sample.data) {
+    parsed = message->ParseFromArray(sample.data, static_cast<int>(sample.size));
+  } else {
+    parsed = message->ParseFromString(sample.message->SerializeAsString());
+  }
+  history_.Pop();
+
+  info.valid_data = parsed;
+  return parsed;
+}
+
+InstanceHandle DataReaderImpl::LookupInstance(const void* key_holder, size_t size) {
+  absl::MutexLock lock(&mutex_);
+
+  if (!instance_key_ || !instance_key_->Extract(key_holder, size, &key_buffer_)) {
+    return HANDLE_NIL;
+  }
+  return FindInstanceLocked(false);
+}
+
+InstanceHandle DataReaderImpl::LookupInstance(const google::protobuf::Message& key_holder) {
+  absl::MutexLock lock(&mutex_);
+
+  if (!instance_key_ || !instance_key_->Extract(key_holder, &key_buffer_)) {
+    return HANDLE_NIL;
+  }
+  return FindInstanceLocked(false);
+}
+
+int32_t DataReaderImpl::ReadInstance(InstanceHandle handle, void* buffer, size_t buffer_size,
+                                     SampleInfo& info) {
+  absl::MutexLock lock(&mutex_);
+
+  status_changes_ &= ~DATA_AVAILABLE_STATUS;
+
+  if (handle == HANDLE_NIL || handle > instances_.size()) {
+    return -1;
+  }
+  const Instance& instance = instances_[handle - 1];
+  if (instance.last_serial == 0) {
+    return -1;
+  }
+
+  // Samples from typed LOCAL_ONLY writes are serialized on demand
+  const LocalSample& sample = instance.last_sample;
+  const bool serialize = sample.data == nullptr && sample.message != nullptr;
+  const size_t size = serialize ? sample.message->ByteSizeLong() : sample.size;
+  info = instance.last_info;
+  info.valid_data = size <= buffer_size;
+  if (!info.valid_data) {
+    return -1;
+  }
+  if (serialize) {
+    sample.message->SerializeToArray(buffer, static_cast<int>(size));
+  } else if (size > 0) {
+    std::memcpy(buffer, sample.data.get(), size);
+  }
+
+  // NOT_READ while the sample waits unread in the history
+  const size_t index = history_.Find(instance.last_serial);
+  info.sample_state = index < history_.Size() && index >= history_.ReadCount()
+                          ? SampleStateKind::NOT_READ
+                          : SampleStateKind::READ;
+  return static_cast<int32_t>(size);
 }
 
 void DataReaderImpl::SetDataReceivedCallback(tiny_dds::DataReaderCallback callback) {
   absl::MutexLock lock(&mutex_);
-  data_received_callback_ = callback;
+
+  Callbacks updated = callbacks_ ? *callbacks_ : Callbacks{};
+  updated.data_received_callback = std::move(callback);
+  SetCallbacksLocked(std::move(updated));
 }
 
 void DataReaderImpl::SetDataCallback(tiny_dds::DataCallback callback) {
   absl::MutexLock lock(&mutex_);
-  data_callback_ = callback;
+
+  Callbacks updated = callbacks_ ? *callbacks_ : Callbacks{};
+  updated.data_callback = std::move(callback);
+  SetCallbacksLocked(std::move(updated));
+}
+
+void DataReaderImpl::SetCallbackExecutor(std::shared_ptr<tiny_dds::Executor> executor,
+                                         tiny_dds::CallbackOrdering ordering) {
+  std::vector<std::shared_ptr<Strand>> strands;
+  if (executor) {
+    const size_t count = ordering == CallbackOrdering::PER_INSTANCE
+                             ? executor->WorkerCount() * kInstanceStrandsPerWorker
+                             : 1;
+    for (size_t i = 0; i < count; ++i) {
+      strands.push_back(executor->CreateStrand());
+    }
+  }
+
+  absl::MutexLock lock(&mutex_);
+  callback_executor_ = std::move(executor);
+  callback_strands_ = std::move(strands);
+  if (callbacks_) {
+    SetCallbacksLocked(*callbacks_);
+  }
+}
+
+void DataReaderImpl::SetCallbacksLocked(Callbacks callbacks) {
+  if (!callbacks.data_received_callback && !callbacks.data_callback) {
+    callbacks_.reset();
+    return;
+  }
+  callbacks.strands = callback_strands_;
+  callbacks_ = std::make_shared<const Callbacks>(std::move(callbacks));
 }
 
 std::shared_ptr<Topic> DataReaderImpl::GetTopic() const {
@@ -82,9 +420,720 @@ SubscriptionMatchedStatus DataReaderImpl::GetSubscriptionMatchedStatus() const {
   return subscription_matched_status_;
 }
 
+RequestedDeadlineMissedStatus DataReaderImpl::GetRequestedDeadlineMissedStatus() {
+  absl::MutexLock lock(&mutex_);
+  status_changes_ &= ~REQUESTED_DEADLINE_MISSED_STATUS;
+  RequestedDeadlineMissedStatus status = requested_deadline_missed_status_;
+  requested_deadline_missed_status_.total_count_change = 0;
+  return status;
+}
+
+LivelinessChangedStatus DataReaderImpl::GetLivelinessChangedStatus() {
+  absl::MutexLock lock(&mutex_);
+  status_changes_ &= ~LIVELINESS_CHANGED_STATUS;
+  LivelinessChangedStatus status = liveliness_changed_status_;
+  liveliness_changed_status_.alive_count_change = 0;
+  liveliness_changed_status_.not_alive_count_change = 0;
+  return status;
+}
+
+void DataReaderImpl::SetRequestedDeadlineMissedCallback(RequestedDeadlineMissedCallback callback) {
+  absl::MutexLock lock(&mutex_);
+  requested_deadline_missed_callback_ = std::move(callback);
+}
+
+void DataReaderImpl::SetLivelinessChangedCallback(LivelinessChangedCallback callback) {
+  absl::MutexLock lock(&mutex_);
+  liveliness_changed_callback_ = std::move(callback);
+}
+
+std::shared_ptr<ReadCondition> DataReaderImpl::CreateReadCondition() {
+  return CreateReadCondition(ANY_SAMPLE_STATE);
+}
+
+std::shared_ptr<ReadCondition> DataReaderImpl::CreateReadCondition(SampleStateMask sample_states) {
+  auto condition = std::make_shared<ReadConditionImpl>(weak_from_this(), sample_states);
+  AddCondition(condition);
+  return condition;
+}
+
+std::shared_ptr<StatusCondition> DataReaderImpl::GetStatusCondition() {
+  {
+    absl::MutexLock lock(&mutex_);
+    if (status_condition_) {
+      return status_condition_;
+    }
+    status_condition_ = std::make_shared<StatusConditionImpl>(weak_from_this());
+  }
+
+  AddCondition(status_condition_);
+  return status_condition_;
+}
+
+void DataReaderImpl::NotifyDataAvailable(std::function<void()> listener) {
+  std::shared_ptr<ConditionImpl> condition;
+  {
+    // Created and added under one lock, so that no sample is queued between
+    absl::MutexLock lock(&mutex_);
+    if (!data_available_condition_) {
+      data_available_condition_ =
+          std::make_shared<ReadConditionImpl>(weak_from_this(), ANY_SAMPLE_STATE);
+      AddConditionLocked(data_available_condition_);
+    }
+    condition = data_available_condition_;
+  }
+
+  // Samples queued before the listener was registered did not notify it
+  condition->NotifyOnce(std::move(listener));
+  if (HasSamples(ANY_SAMPLE_STATE)) {
+    condition->NotifyWaitSets();
+  }
+}
+
+bool DataReaderImpl::HasSamples(SampleStateMask sample_states) const {
+  absl::MutexLock lock(&mutex_);
+
+  size_t begin = 0;
+  size_t end = 0;
+  history_.Select(sample_states, &begin, &end);
+  return begin < end;
+}
+
+StatusMask DataReaderImpl::GetStatusChanges() const {
+  absl::MutexLock lock(&mutex_);
+  return status_changes_;
+}
+
 std::shared_ptr<SubscriberImpl> DataReaderImpl::GetSubscriber() const {
   absl::MutexLock lock(&mutex_);
   return subscriber_;
 }
 
-}  // namespace tiny_dds::core
\ No newline at end of file
+void DataReaderImpl::OnDataReceived(const void* data, size_t size) {
+  std::shared_ptr<const Callbacks> callbacks;
+  std::shared_ptr<const ConditionList> conditions;
+  SampleInfo info;
+  const void* payload = nullptr;
+  size_t payload_size = 0;
+  {
+    absl::MutexLock lock(&mutex_);
+    if (!UnframeLocked(data, size, &info, &payload, &payload_size)) {
+      return;
+    }
+    callbacks = QueueCopyLocked(payload, payload_size, &info, &conditions);
+  }
+
+  if (callbacks) {
+    DispatchCallbacks(std::move(callbacks), payload, payload_size, info);
+  }
+  if (conditions) {
+    NotifyConditions(*conditions);
+  }
+}
+
+void DataReaderImpl::OnLocalSample(const LocalSample& sample) {
+  std::shared_ptr<const Callbacks> callbacks;
+  std::shared_ptr<const ConditionList> conditions;
+  SampleInfo info;
+  {
+    absl::MutexLock lock(&mutex_);
+    if (!AcceptLocked(sample.metadata)) {
+      return;
+    }
+    info = StampLocked(sample.metadata);
+    callbacks = QueueLocked(sample, &info, &conditions);
+  }
+
+  if (callbacks) {
+    DispatchCallbacks(std::move(callbacks), sample, info);
+  }
+  if (conditions) {
+    NotifyConditions(*conditions);
+  }
+}
+
+void DataReaderImpl::OnFilteredSample(const SampleMetadata& metadata) {
+  absl::MutexLock lock(&mutex_);
+  if (AcceptLocked(metadata)) {
+    StampLocked(metadata);
+  }
+}
+
+void DataReaderImpl::OnLocalSamples(const std::vector<LocalSample>& samples) {
+  std::shared_ptr<const Callbacks> callbacks;
+  std::shared_ptr<const ConditionList> conditions;
+  std::vector<std::pair<const LocalSample*, SampleInfo>> dispatched;
+  {
+    absl::MutexLock lock(&mutex_);
+    for (const LocalSample& sample : samples) {
+      if (!AcceptLocked(sample.metadata)) {
+        continue;
+      }
+      SampleInfo info = StampLocked(sample.metadata);
+      if (filter_ && !filter_->Evaluate(sample)) {
+        continue;
+      }
+      callbacks = QueueLocked(sample, &info, &conditions);
+      if (callbacks) {
+        dispatched.emplace_back(&sample, info);
+      }
+    }
+  }
+
+  for (const auto& [sample, info] : dispatched) {
+    DispatchCallbacks(callbacks, *sample, info);
+  }
+  if (conditions) {
+    NotifyConditions(*conditions);
+  }
+}
+
+auto DataReaderImpl::PollTransport(size_t max_samples) -> size_t {
+  size_t received = 0;
+
+  while (received < max_samples) {
+    SharedReceiver::Frame frame;
+    LocalSample shared;
+    std::shared_ptr<const Callbacks> callbacks;
+    std::shared_ptr<const ConditionList> conditions;
+    SampleInfo info;
+    const void* payload = nullptr;
+    size_t payload_size = 0;
+    {
+      // Receiving and queueing under one lock keeps samples in order with a
+      // concurrent Read, which may also receive from the endpoint
+      absl::MutexLock lock(&mutex_);
+
+      if (!ReceiveFromTransport(&poll_buffer_, &frame)) {
+        break;
+      }
+      if (UnframeLocked(frame.data, frame.size, &info, &payload, &payload_size)) {
+        if (frame.buffer) {
+          shared = SharedPayload(frame, payload, payload_size);
+          callbacks = QueueLocked(shared, &info, &conditions);
+        } else {
+          callbacks = QueueCopyLocked(payload, payload_size, &info, &conditions);
+        }
+      }
+    }
+
+    ++received;
+
+    // Only the receive thread uses poll_buffer_, so it stays valid without the lock
+    if (callbacks && shared.data) {
+      DispatchCallbacks(std::move(callbacks), shared, info);
+    } else if (callbacks) {
+      DispatchCallbacks(std::move(callbacks), payload, payload_size, info);
+    }
+    if (conditions) {
+      NotifyConditions(*conditions);
+    }
+  }
+
+  return received;
+}
+
+auto DataReaderImpl::QueueLocked(const LocalSample& sample, SampleInfo* info,
+                                 std::shared_ptr<const ConditionList>* conditions)
+    -> std::shared_ptr<const Callbacks> {
+  if (!AssignInstanceLocked(sample, info) || !PassesTimeFilterLocked(*info)) {
+    return nullptr;
+  }
+  RenewDeadlineLocked(info->instance_handle);
+  if (callbacks_) {
+    return callbacks_;
+  }
+
+  if (PushLocked(sample, *info)) {
+    MarkDataAvailableLocked(conditions);
+  }
+  return nullptr;
+}
+
+auto DataReaderImpl::QueueCopyLocked(const void* data, size_t size, SampleInfo* info,
+                                     std::shared_ptr<const ConditionList>* conditions)
+    -> std::shared_ptr<const Callbacks> {
+  if (!AssignInstanceLocked(data, size, info) || !PassesTimeFilterLocked(*info)) {
+    return nullptr;
+  }
+  RenewDeadlineLocked(info->instance_handle);
+  if (callbacks_) {
+    return callbacks_;
+  }
+
+  if (PushCopyLocked(data, size, *info)) {
+    MarkDataAvailableLocked(conditions);
+  }
+  return nullptr;
+}
+
+auto DataReaderImpl::AssignInstanceLocked(const LocalSample& sample, SampleInfo* info) -> bool {
+  if (!instance_key_) {
+    return true;
+  }
+  if (!instance_key_->Extract(sample, &key_buffer_)) {
+    return false;
+  }
+  info->instance_handle = FindInstanceLocked(true);
+  return true;
+}
+
+auto DataReaderImpl::AssignInstanceLocked(const void* data, size_t size, SampleInfo* info)
+    -> bool {
+  if (!instance_key_) {
+    return true;
+  }
+  if (!instance_key_->Extract(data, size, &key_buffer_)) {
+    return false;
+  }
+  info->instance_handle = FindInstanceLocked(true);
+  return true;
+}
+
+auto DataReaderImpl::FindInstanceLocked(bool register_new) -> InstanceHandle {
+  auto it = instance_handles_.find(key_buffer_);
+  if (it != instance_handles_.end()) {
+    return it->second;
+  }
+  if (!register_new) {
+    return HANDLE_NIL;
+  }
+
+  instances_.emplace_back();
+  const auto handle = static_cast<InstanceHandle>(instances_.size());
+  instance_handles_.emplace(key_buffer_, handle);
+  return handle;
+}
+
+auto DataReaderImpl::PassesTimeFilterLocked(const SampleInfo& info) -> bool {
+  if (minimum_separation_ <= 0) {
+    return true;
+  }
+
+  // Samples sent without a DataWriter have no source timestamp
+  const int64_t timestamp =
+      info.source_timestamp != 0 ? info.source_timestamp : info.reception_timestamp;
+  if (info.instance_handle != HANDLE_NIL) {
+    int64_t& next_timestamp = instances_[info.instance_handle - 1].next_timestamp;
+    if (timestamp < next_timestamp) {
+      return false;
+    }
+    next_timestamp = timestamp + minimum_separation_;
+    return true;
+  }
+
+  if (timestamp < next_timestamp_.load(std::memory_order_relaxed)) {
+    return false;
+  }
+  next_timestamp_.store(timestamp + minimum_separation_, std::memory_order_relaxed);
+  return true;
+}
+
+void DataReaderImpl::RenewDeadlineLocked(InstanceHandle handle) {
+  if (deadline_period_.count() <= 0) {
+    return;
+  }
+
+  // The timer is armed once per period rather than once per sample; when it
+  // fires, it moves to the end of the period started by the last sample
+  Deadline& deadline = handle != HANDLE_NIL ? instances_[handle - 1].deadline : deadline_;
+  deadline.start = std::chrono::steady_clock::now();
+  if (deadline.timer == TimingWheel::kNoTimer) {
+    std::weak_ptr<DataReaderImpl> weak_self = weak_from_this();
+    deadline.timer = dispatcher_->AddTimer([weak_self, handle]() {
+      if (auto self = weak_self.lock()) {
+        self->OnDeadlineTimer(handle);
+      }
+    });
+    dispatcher_->ArmTimer(deadline.timer, deadline.start + deadline_period_);
+  }
+}
+
+void DataReaderImpl::OnDeadlineTimer(InstanceHandle handle) {
+  std::shared_ptr<const ConditionList> conditions;
+  std::function<void()> callback;
+  {
+    absl::MutexLock lock(&mutex_);
+
+    Deadline& deadline = handle != HANDLE_NIL ? instances_[handle - 1].deadline : deadline_;
+    const auto now = std::chrono::steady_clock::now();
+    if (now < deadline.start + deadline_period_) {
+      dispatcher_->ArmTimer(deadline.timer, deadline.start + deadline_period_);
+      return;
+    }
+
+    // Each period without a sample is one more missed deadline
+    deadline.start = now;
+    dispatcher_->ArmTimer(deadline.timer, now + deadline_period_);
+
+    RequestedDeadlineMissedStatus& status = requested_deadline_missed_status_;
+    ++status.total_count;
+    ++status.total_count_change;
+    status.last_instance_handle = handle;
+    status_changes_ |= REQUESTED_DEADLINE_MISSED_STATUS;
+    conditions = conditions_;
+
+    if (requested_deadline_missed_callback_) {
+      callback = [listener = requested_deadline_missed_callback_, status]() { listener(status); };
+      status.total_count_change = 0;
+      status_changes_ &= ~REQUESTED_DEADLINE_MISSED_STATUS;
+    }
+  }
+
+  ReportStatusChange(conditions, std::move(callback));
+}
+
+void DataReaderImpl::AssertLivelinessLocked(const Guid& guid, WriterProgress* progress) {
+  if (lease_duration_.count() <= 0) {
+    return;
+  }
+
+  // Writers that are alive stay so until their timer finds the lease expired;
+  // others are reported alive by their timer, on the next tick
+  progress->last_asserted = std::chrono::steady_clock::now();
+  if (progress->liveliness_armed) {
+    return;
+  }
+  if (progress->liveliness_timer == TimingWheel::kNoTimer) {
+    std::weak_ptr<DataReaderImpl> weak_self = weak_from_this();
+    progress->liveliness_timer = dispatcher_->AddTimer([weak_self, guid]() {
+      if (auto self = weak_self.lock()) {
+        self->OnLivelinessTimer(guid);
+      }
+    });
+  }
+  progress->liveliness_armed = true;
+  dispatcher_->ArmTimer(progress->liveliness_timer, progress->last_asserted);
+}
+
+void DataReaderImpl::OnLivelinessTimer(const Guid& guid) {
+  std::shared_ptr<const ConditionList> conditions;
+  std::function<void()> callback;
+  {
+    absl::MutexLock lock(&mutex_);
+
+    auto it = writers_.find(guid);
+    if (it == writers_.end()) {
+      return;
+    }
+    WriterProgress& progress = it->second;
+    const auto expiry = progress.last_asserted + lease_duration_;
+    const bool alive = std::chrono::steady_clock::now() < expiry;
+    if (alive) {
+      dispatcher_->ArmTimer(progress.liveliness_timer, expiry);
+    } else {
+      progress.liveliness_armed = false;
+    }
+
+    const WriterLiveliness liveliness =
+        alive ? WriterLiveliness::ALIVE : WriterLiveliness::NOT_ALIVE;
+    if (liveliness == progress.liveliness) {
+      return;
+    }
+
+    LivelinessChangedStatus& status = liveliness_changed_status_;
+    if (progress.liveliness == WriterLiveliness::ALIVE) {
+      --status.alive_count;
+      --status.alive_count_change;
+    } else if (progress.liveliness == WriterLiveliness::NOT_ALIVE) {
+      --status.not_alive_count;
+      --status.not_alive_count_change;
+    }
+    if (alive) {
+      ++status.alive_count;
+      ++status.alive_count_change;
+    } else {
+      ++status.not_alive_count;
+      ++status.not_alive_count_change;
+    }
+    status.last_publication_handle = guid;
+    progress.liveliness = liveliness;
+    status_changes_ |= LIVELINESS_CHANGED_STATUS;
+    conditions = conditions_;
+
+    if (liveliness_changed_callback_) {
+      callback = [listener = liveliness_changed_callback_, status]() { listener(status); };
+      status.alive_count_change = 0;
+      status.not_alive_count_change = 0;
+      status_changes_ &= ~LIVELINESS_CHANGED_STATUS;
+    }
+  }
+
+  ReportStatusChange(conditions, std::move(callback));
+}
+
+void DataReaderImpl::ReportStatusChange(const std::shared_ptr<const ConditionList>& conditions,
+                                        std::function<void()> callback) {
+  if (callback) {
+    std::shared_ptr<Strand> strand;
+    {
+      absl::MutexLock lock(&mutex_);
+      if (!callback_strands_.empty()) {
+        strand = callback_strands_.front();
+      }
+    }
+    if (strand) {
+      strand->Post(std::move(callback));
+    } else {
+      dispatcher_->Dispatch(std::move(callback));
+    }
+  }
+  if (conditions) {
+    NotifyConditions(*conditions);
+  }
+}
+
+auto DataReaderImpl::PushLocked(const LocalSample& sample, const SampleInfo& info) -> bool {
+  Instance* instance = ReserveInstanceLocked(info.instance_handle);
+  if (!history_.PushShared(sample, info)) {
+    return false;
+  }
+  if (instance != nullptr) {
+    instance->last_serial = history_.Serial(history_.Size() - 1);
+    instance->serials.push_back(instance->last_serial);
+    instance->last_sample = sample;
+    instance->last_info = info;
+  }
+  return true;
+}
+
+auto DataReaderImpl::PushCopyLocked(const void* data, size_t size, const SampleInfo& info)
+    -> bool {
+  // A sample of an instance is copied once, into a buffer its last value shares
+  if (info.instance_handle != HANDLE_NIL) {
+    return PushLocked(CopyToLocalSample(data, size), info);
+  }
+  return history_.PushCopy(data, size, info);
+}
+
+auto DataReaderImpl::ReserveInstanceLocked(InstanceHandle handle) -> Instance* {
+  if (handle == HANDLE_NIL) {
+    return nullptr;
+  }
+
+  // Takes and a full history remove samples without telling their instance
+  Instance& instance = instances_[handle - 1];
+  auto& serials = instance.serials;
+  serials.erase(std::remove_if(serials.begin(), serials.end(),
+                               [this](uint64_t serial) {
+                                 return history_.Find(serial) == history_.Size();
+                               }),
+                serials.end());
+
+  if (instance_depth_ > 0 && serials.size() >= instance_depth_) {
+    history_.Remove(history_.Find(serials.front()), 1);
+    serials.erase(serials.begin());
+  }
+  return &instance;
+}
+
+auto DataReaderImpl::StampLocked(const SampleMetadata& metadata) -> SampleInfo {
+  SampleInfo info;
+  info.valid_data = true;
+  info.source_timestamp = metadata.source_timestamp;
+  info.reception_timestamp = NowNanoseconds();
+  info.sequence_number = metadata.sequence_number;
+  info.publication_handle = metadata.writer_guid;
+
+  // Samples from writers that send no header cannot be tracked
+  if (metadata.sequence_number == 0) {
+    return info;
+  }
+
+  // Gaps in a writer's sequence numbers are samples this reader never got; a
+  // reader that joins late starts counting at the first sample it receives
+  WriterProgress& progress = writers_[metadata.writer_guid];
+  if (progress.lowest_sequence_number == 0 ||
+      metadata.sequence_number < progress.lowest_sequence_number) {
+    progress.lowest_sequence_number = metadata.sequence_number;
+  }
+  if (progress.highest_sequence_number != 0 &&
+      metadata.sequence_number > progress.highest_sequence_number + 1) {
+    const uint64_t gap = metadata.sequence_number - progress.highest_sequence_number - 1;
+    progress.lost_sample_count += gap;
+    for (uint64_t missing = metadata.sequence_number - std::min(gap, kMaxMissingTracked);
+         missing < metadata.sequence_number; ++missing) {
+      progress.missing.push_back(missing);
+    }
+    while (progress.missing.size() > kMaxMissingTracked) {
+      progress.missing.pop_front();
+    }
+  } else if (metadata.sequence_number < progress.highest_sequence_number) {
+    // A sample counted as lost that arrives late was only reordered
+    auto it = std::lower_bound(progress.missing.begin(), progress.missing.end(),
+                               metadata.sequence_number);
+    if (it != progress.missing.end() && *it == metadata.sequence_number) {
+      progress.missing.erase(it);
+      --progress.lost_sample_count;
+    }
+  }
+  progress.highest_sequence_number =
+      std::max(progress.highest_sequence_number, metadata.sequence_number);
+
+  info.lost_sample_count = progress.lost_sample_count;
+  AssertLivelinessLocked(metadata.writer_guid, &progress);
+  return info;
+}
+
+auto DataReaderImpl::AcceptLocked(const SampleMetadata& metadata) -> bool {
+  // Heartbeats only tell that their writer is alive
+  if ((metadata.flags & SampleMetadata::LIVELINESS) != 0) {
+    if (lease_duration_.count() > 0) {
+      AssertLivelinessLocked(metadata.writer_guid, &writers_[metadata.writer_guid]);
+    }
+    return false;
+  }
+
+  const uint64_t sequence_number = metadata.sequence_number;
+  if (sequence_number == 0) {
+    return true;
+  }
+
+  // Live samples are new unless a replay already delivered them
+  if ((metadata.flags & SampleMetadata::REPLAYED) == 0) {
+    auto it = writers_.find(metadata.writer_guid);
+    return it == writers_.end() || sequence_number < it->second.first_replayed ||
+           sequence_number > it->second.last_replayed;
+  }
+
+  // Replays on network topics reach every reader, including those that did
+  // not ask for one or already have the samples
+  if (durability_ == DurabilityKind::VOLATILE) {
+    return false;
+  }
+
+  // A replay answering several readers may start before this reader's starting point
+  WriterProgress& progress = writers_[metadata.writer_guid];
+  const bool accepted = !progress.replay_complete &&
+                        sequence_number >= history_request_.from_sequence_number &&
+                        metadata.source_timestamp >= history_request_.from_timestamp &&
+                        (progress.highest_sequence_number == 0 ||
+                         sequence_number < progress.lowest_sequence_number ||
+                         sequence_number > progress.highest_sequence_number);
+  if (accepted) {
+    if (progress.first_replayed == 0 || sequence_number < progress.first_replayed) {
+      progress.first_replayed = sequence_number;
+    }
+    progress.last_replayed = std::max(progress.last_replayed, sequence_number);
+  }
+  if ((metadata.flags & SampleMetadata::END_OF_REPLAY) != 0) {
+    progress.replay_complete = true;
+  }
+  return accepted;
+}
+
+auto DataReaderImpl::UnframeLocked(const void* data, size_t size, SampleInfo* info,
+                                   const void** payload, size_t* payload_size) -> bool {
+  SampleMetadata metadata;
+  const size_t header_size = DecodeSampleHeader(data, size, &metadata) ? sizeof(SampleHeader) : 0;
+  if (!AcceptLocked(metadata)) {
+    return false;
+  }
+
+  *info = StampLocked(metadata);
+  *payload = static_cast<const uint8_t*>(data) + header_size;
+  *payload_size = size - header_size;
+
+  // Samples from writers that do not know the filter are checked here, before
+  // they are copied, without deserializing them
+  return !filter_ || filter_->Evaluate(*payload, *payload_size);
+}
+
+void DataReaderImpl::MarkDataAvailableLocked(std::shared_ptr<const ConditionList>* conditions) {
+  status_changes_ |= DATA_AVAILABLE_STATUS;
+  *conditions = conditions_;
+}
+
+void DataReaderImpl::AddCondition(const std::shared_ptr<ConditionImpl>& condition) {
+  absl::MutexLock lock(&mutex_);
+  AddConditionLocked(condition);
+}
+
+void DataReaderImpl::AddConditionLocked(const std::shared_ptr<ConditionImpl>& condition) {
+  auto updated = std::make_shared<ConditionList>();
+  if (conditions_) {
+    for (const auto& existing : *conditions_) {
+      if (!existing.expired()) {
+        updated->push_back(existing);
+      }
+    }
+  }
+  updated->push_back(condition);
+  conditions_ = std::move(updated);
+}
+
+void DataReaderImpl::NotifyConditions(const ConditionList& conditions) {
+  for (const auto& weak_condition : conditions) {
+    if (auto condition = weak_condition.lock()) {
+      condition->NotifyWaitSets();
+    }
+  }
+}
+
+void DataReaderImpl::DispatchCallbacks(std::shared_ptr<const Callbacks> callbacks,
+                                       const LocalSample& sample, const SampleInfo& info) {
+  // Callbacks run without the lock so they can use this reader or write to other topics
+  if (callbacks->strands.empty() && dispatcher_->IsInline()) {
+    InvokeCallbacks(*callbacks, sample, info);
+    return;
+  }
+
+  // Samples of one instance always go to the same strand
+  Strand* strand = nullptr;
+  if (!callbacks->strands.empty()) {
+    strand = callbacks->strands[info.instance_handle % callbacks->strands.size()].get();
+  }
+
+  // Queued invocations keep the reader, the callbacks with their strands, and
+  // the sample alive until they run
+  auto invocation = [self = shared_from_this(), callbacks = std::move(callbacks), sample,
+                     info]() { self->InvokeCallbacks(*callbacks, sample, info); };
+  if (strand != nullptr) {
+    strand->Post(std::move(invocation));
+  } else {
+    dispatcher_->Dispatch(std::move(invocation));
+  }
+}
+
+void DataReaderImpl::DispatchCallbacks(std::shared_ptr<const Callbacks> callbacks,
+                                       const void* data, size_t size, const SampleInfo& info) {
+  // Inline callbacks read the receive buffer directly; queued ones need their own copy
+  if (callbacks->strands.empty() && dispatcher_->IsInline()) {
+    InvokeCallbacks(*callbacks, data, size, info);
+    return;
+  }
+
+  DispatchCallbacks(std::move(callbacks), CopyToLocalSample(data, size), info);
+}
+
+void DataReaderImpl::InvokeCallbacks(const Callbacks& callbacks, const LocalSample& sample,
+                                     const SampleInfo& info) const {
+  if (sample.data || !sample.message) {
+    InvokeCallbacks(callbacks, sample.data.get(), sample.size, info);
+    return;
+  }
+
+  std::string serialized = sample.message->SerializeAsString();
+  InvokeCallbacks(callbacks, serialized.data(), serialized.size(), info);
+}
+
+void DataReaderImpl::InvokeCallbacks(const Callbacks& callbacks, const void* data, size_t size,
+                                     const SampleInfo& info) const {
+  if (callbacks.data_received_callback) {
+    callbacks.data_received_callback(data, size, info);
+  }
+  if (callbacks.data_callback) {
+    callbacks.data_callback(domain_id_, topic_name_, data, size);
+  }
+}
+
+auto DataReaderImpl::ReceiveFromTransport(std::vector<uint8_t>* buffer,
+                                          SharedReceiver::Frame* frame) -> bool {
+  if (!receiver_) {
+    return false;
+  }
+
+  return receiver_->Receive(receiver_id_, buffer, frame);
+}
+
+}  // namespace tiny_dds::core
@@ -1,21 +1,39 @@
 #ifndef TINY_DDS_CORE_DATA_READER_IMPL_H_
 #define TINY_DDS_CORE_DATA_READER_IMPL_H_
 
+#include <atomic>
+#include <chrono>
 #include <deque>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/synchronization/mutex.h"
-#include "absl/synchronization/notification.h"
 #include "include/tiny_dds/data_reader.h"
+#include "include/tiny_dds/executor.h"
+#include "include/tiny_dds/transport.h"
+#include "include/tiny_dds/transport_types.h"
 #include "include/tiny_dds/types.h"
+#include "include/tiny_dds/wait_set.h"
+#include "src/core/arena_pool.h"
+#include "src/core/content_filter.h"
+#include "src/core/instance_key.h"
+#include "src/core/intra_process_bus.h"
+#include "src/core/receive_dispatcher.h"
+#include "src/core/sample_header.h"
+#include "src/core/sample_history.h"
+#include "src/core/shared_receiver.h"
+#include "src/core/writer_history.h"
 
 namespace tiny_dds {
 namespace core {
 
 // Forward declarations
+class ConditionImpl;
+class StatusConditionImpl;
 class SubscriberImpl;
 
 /**
@@ -28,9 +46,11 @@ class DataReaderImpl : public tiny_dds::DataReader,
    * @brief Constructor for DataReaderImpl.
    * @param topic The topic to subscribe to.
    * @param subscriber The subscriber that created this data reader.
+   * @param qos The QoS of this data reader.
    */
   DataReaderImpl(std::shared_ptr<tiny_dds::Topic> topic,
-                 std::shared_ptr<SubscriberImpl> subscriber);
+                 std::shared_ptr<SubscriberImpl> subscriber,
+                 const tiny_dds::DataReaderQos& qos = tiny_dds::DataReaderQos());
 
   /**
    * @brief Destructor for DataReaderImpl.
@@ -38,7 +58,7 @@ class DataReaderImpl : public tiny_dds::DataReader,
   ~DataReaderImpl() override;
 
   /**
-   * @brief Reads the next available data sample.
+   * @brief Reads the oldest sample not read yet, leaving it in the history marked READ.
    * @param[out] buffer Buffer to store the data.
    * @param[in] buffer_size Size of the buffer.
    * @param[out] info Sample information.
@@ -47,7 +67,7 @@ class DataReaderImpl : public tiny_dds::DataReader,
   int32_t Read(void* buffer, size_t buffer_size, tiny_dds::SampleInfo& info) override;
 
   /**
-   * @brief Takes the next available data sample (removes it from the reader's queue).
+   * @brief Takes the oldest available data sample (removes it from the reader's history).
    * @param[out] buffer Buffer to store the data.
    * @param[in] buffer_size Size of the buffer.
    * @param[out] info Sample information.
@@ -55,6 +75,82 @@ class DataReaderImpl : public tiny_dds::DataReader,
    */
   int32_t Take(void* buffer, size_t buffer_size, tiny_dds::SampleInfo& info) override;
 
+  /**
+   * @brief Takes the next data sample, waiting up to a timeout for one to be queued.
+   * @param[out] buffer Buffer to store the data.
+   * @param[in] buffer_size Size of the buffer.
+   * @param[out] info Sample information.
+   * @param[in] timeout The maximum time to wait.
+   * @return Number of bytes read, or -1 if no data arrived before the timeout.
+   */
+  int32_t Take(void* buffer, size_t buffer_size, tiny_dds::SampleInfo& info,
+               std::chrono::nanoseconds timeout) override;
+
+  /**
+   * @brief Reads up to max_samples samples in the given states under a single lock.
+   * @param[in,out] buffers Storage for the samples; each size is set to the sample's size.
+   * @param[out] infos Sample information, one per buffer.
+   * @param[in] max_samples Number of entries in buffers and infos.
+   * @param[in] sample_states A combination of the *_SAMPLE_STATE constants.
+   * @return The number of samples read.
+   */
+  int32_t ReadN(tiny_dds::SampleBuffer* buffers, tiny_dds::SampleInfo* infos, size_t max_samples,
+                SampleStateMask sample_states) override;
+
+  /**
+   * @brief Takes up to max_samples samples in the given states under a single lock.
+   * @param[in,out] buffers Storage for the samples; each size is set to the sample's size.
+   * @param[out] infos Sample information, one per buffer.
+   * @param[in] max_samples Number of entries in buffers and infos.
+   * @param[in] sample_states A combination of the *_SAMPLE_STATE constants.
+   * @return The number of samples taken.
+   */
+  int32_t TakeN(tiny_dds::SampleBuffer* buffers, tiny_dds::SampleInfo* infos, size_t max_samples,
+                SampleStateMask sample_states) override;
+
+  /**
+   * @brief Takes the next available data sample as a Protocol Buffers message.
+   * @param[out] message The message to fill in.
+   * @param[out] info Sample information.
+   * @return True if a sample was taken, false if no data is available.
+   */
+  bool TakeMessage(google::protobuf::Message* message, tiny_dds::SampleInfo& info) override;
+
+  /**
+   * @brief Takes the next available data sample as a message allocated on a pooled arena.
+   * @param[in] prototype A message of the topic's type.
+   * @param[out] info Sample information.
+   * @return The message, or nullptr if no valid sample is available.
+   */
+  ArenaMessagePtr<> TakeArenaMessage(const google::protobuf::Message& prototype,
+                                     tiny_dds::SampleInfo& info) override;
+
+  /**
+   * @brief Gets the handle of the instance with the key of a serialized sample.
+   * @param key_holder Pointer to a serialized sample with the key.
+   * @param size Size of the serialized sample in bytes.
+   * @return The handle of the instance, or HANDLE_NIL if there is none.
+   */
+  InstanceHandle LookupInstance(const void* key_holder, size_t size) override;
+
+  /**
+   * @brief Gets the handle of the instance with the key of a message.
+   * @param key_holder A message of the topic's type with the key.
+   * @return The handle of the instance, or HANDLE_NIL if there is none.
+   */
+  InstanceHandle LookupInstance(const google::protobuf::Message& key_holder) override;
+
+  /**
+   * @brief Reads the last sample of one instance, leaving its state unchanged.
+   * @param[in] handle The handle of the instance.
+   * @param[out] buffer Buffer to store the data.
+   * @param[in] buffer_size Size of the buffer.
+   * @param[out] info Sample information.
+   * @return Number of bytes read, or -1 if the instance has no sample yet.
+   */
+  int32_t ReadInstance(InstanceHandle handle, void* buffer, size_t buffer_size,
+                       tiny_dds::SampleInfo& info) override;
+
   /**
    * @brief Sets a callback function to be called when data is received.
    * @param callback The callback function.
@@ -80,47 +176,443 @@ class DataReaderImpl : public tiny_dds::DataReader,
    */
   tiny_dds::SubscriptionMatchedStatus GetSubscriptionMatchedStatus() const override;
 
+  /**
+   * @brief Gets the deadlines missed by the writers of this reader's instances.
+   * @return The requested deadline missed status; its change count is reset.
+   */
+  tiny_dds::RequestedDeadlineMissedStatus GetRequestedDeadlineMissedStatus() override;
+
+  /**
+   * @brief Gets the liveliness of the writers this reader heard from.
+   * @return The liveliness changed status; its change counts are reset.
+   */
+  tiny_dds::LivelinessChangedStatus GetLivelinessChangedStatus() override;
+
+  /**
+   * @brief Sets a callback called on every missed deadline.
+   * @param callback The callback function, or null to remove it.
+   */
+  void SetRequestedDeadlineMissedCallback(
+      tiny_dds::RequestedDeadlineMissedCallback callback) override;
+
+  /**
+   * @brief Sets a callback called when a writer becomes alive or not alive.
+   * @param callback The callback function, or null to remove it.
+   */
+  void SetLivelinessChangedCallback(tiny_dds::LivelinessChangedCallback callback) override;
+
+  /**
+   * @brief Runs this reader's callbacks on strands of an executor.
+   * @param executor The executor, or null to dispatch through the participant again.
+   * @param ordering One strand for the reader, or strands shared by instances.
+   */
+  void SetCallbackExecutor(std::shared_ptr<tiny_dds::Executor> executor,
+                           tiny_dds::CallbackOrdering ordering) override;
+
+  /**
+   * @brief Runs a function once samples are queued, through an internal read condition.
+   * @param listener The function.
+   */
+  void NotifyDataAvailable(std::function<void()> listener) override;
+
+  /**
+   * @brief Creates a condition triggered while this reader has samples in its history.
+   * @return A shared pointer to the created ReadCondition.
+   */
+  std::shared_ptr<tiny_dds::ReadCondition> CreateReadCondition() override;
+
+  /**
+   * @brief Creates a condition triggered while this reader has samples in the given states.
+   * @param sample_states A combination of the *_SAMPLE_STATE constants.
+   * @return A shared pointer to the created ReadCondition.
+   */
+  std::shared_ptr<tiny_dds::ReadCondition> CreateReadCondition(
+      SampleStateMask sample_states) override;
+
+  /**
+   * @brief Gets the condition triggered by status changes of this reader.
+   * @return A shared pointer to the reader's StatusCondition.
+   */
+  std::shared_ptr<tiny_dds::StatusCondition> GetStatusCondition() override;
+
+  /**
+   * @brief Checks whether the history holds samples in the given states.
+   * @param sample_states A combination of the *_SAMPLE_STATE constants.
+   * @return True if at least one sample matches.
+   */
+  bool HasSamples(SampleStateMask sample_states) const;
+
+  /**
+   * @brief Gets the statuses that changed since the application last read them.
+   * @return A combination of the *_STATUS constants.
+   */
+  StatusMask GetStatusChanges() const;
+
   /**
    * @brief Gets the subscriber that created this data reader.
    * @return A shared pointer to the subscriber.
    */
   std::shared_ptr<SubscriberImpl> GetSubscriber() const;
 
+  /**
+   * @brief Gets the durability of this data reader.
+   * @return VOLATILE, or TRANSIENT_LOCAL or PERSISTENT if the reader receives writers' histories.
+   */
+  DurabilityKind GetDurability() const { return durability_; }
+
+  /**
+   * @brief Gets the point in writers' histories this data reader wants replayed from.
+   * @return The request to send to writers.
+   */
+  HistoryRequest GetHistoryRequest() const { return history_request_; }
+
+  /**
+   * @brief Gets the filter of the content-filtered topic this data reader was created for.
+   * @return The filter, or null if the reader receives every sample of its topic.
+   */
+  const ContentFilter* GetContentFilter() const { return filter_.get(); }
+
+  /**
+   * @brief Checks, without locking, whether the time-based filter drops a sample.
+   *
+   * Only samples of topics that are not keyed are checked; the filter of keyed
+   * topics needs the sample's instance, and is applied when the sample is queued.
+   *
+   * @param metadata The writer's metadata for the sample.
+   * @return True if the sample came too soon after the last one kept.
+   */
+  bool IsTimeFiltered(const SampleMetadata& metadata) const {
+    return metadata.source_timestamp != 0 &&
+           metadata.source_timestamp < next_timestamp_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Called by the intra-process bus for a sample the reader's filter rejected.
+   *
+   * The sample is not queued, but counts as received rather than lost.
+   *
+   * @param metadata The writer's metadata for the sample.
+   */
+  void OnFilteredSample(const SampleMetadata& metadata);
+
   /**
    * @brief Called when data is received from a publisher.
-   * @param data Pointer to the serialized message data.
-   * @param size Size of the serialized data in bytes.
+   *
+   * The sample header is stripped and the payload copied, then handled like OnLocalSample.
+   *
+   * @param data Pointer to the received data, starting with the sample header.
+   * @param size Size of the received data in bytes.
    */
   void OnDataReceived(const void* data, size_t size);
 
+  /**
+   * @brief Called by the intra-process bus when a LOCAL_ONLY writer publishes.
+   *
+   * The sample is passed to the data callbacks if any are set, and queued for
+   * Read/Take otherwise.
+   *
+   * @param sample The shared sample.
+   */
+  void OnLocalSample(const LocalSample& sample);
+
+  /**
+   * @brief Called by the intra-process bus with the history of a durable writer.
+   *
+   * The samples are filtered and queued under a single lock, so reads see
+   * all of them or none.
+   *
+   * @param samples The replayed samples, oldest first.
+   */
+  void OnLocalSamples(const std::vector<LocalSample>& samples);
+
+  /**
+   * @brief Moves samples waiting on the transport endpoint into the queue or to the callbacks.
+   *
+   * Called by the participant's receive thread.
+   *
+   * @param max_samples Maximum number of samples to receive.
+   * @return The number of samples received.
+   */
+  auto PollTransport(size_t max_samples) -> size_t;
+
  private:
+  // Callbacks set by the application; replaced as a whole so that samples can
+  // be dispatched from a snapshot without holding the lock
+  struct Callbacks {
+    tiny_dds::DataReaderCallback data_received_callback;
+    tiny_dds::DataCallback data_callback;
+
+    // Strands of the reader's executor, by instance handle, or empty to
+    // dispatch through the participant
+    std::vector<std::shared_ptr<tiny_dds::Strand>> strands;
+  };
+
+  using ConditionList = std::vector<std::weak_ptr<ConditionImpl>>;
+
+  // Liveliness of a writer as last reported to the application
+  enum class WriterLiveliness { UNKNOWN, ALIVE, NOT_ALIVE };
+
+  // Progress of one writer, used to count lost samples and to drop samples
+  // received both live and in a replay of the writer's history
+  struct WriterProgress {
+    uint64_t lowest_sequence_number = 0;
+    uint64_t highest_sequence_number = 0;
+    uint64_t lost_sample_count = 0;
+
+    // The newest sequence numbers counted as lost, in order; concurrent writes
+    // on one writer may still deliver them late
+    std::deque<uint64_t> missing;
+
+    // Range of sequence numbers accepted from replays, empty if both are 0
+    uint64_t first_replayed = 0;
+    uint64_t last_replayed = 0;
+
+    // Set once a replay of the writer's history ended; later replays are for other readers
+    bool replay_complete = false;
+
+    // Liveliness of the writer, tracked by readers with a lease duration: the
+    // last time it was heard from, and whether it was reported alive. The
+    // timer is armed while the writer is alive or about to be reported so.
+    std::chrono::steady_clock::time_point last_asserted;
+    WriterLiveliness liveliness = WriterLiveliness::UNKNOWN;
+    bool liveliness_armed = false;
+    TimingWheel::TimerId liveliness_timer = TimingWheel::kNoTimer;
+  };
+
+  // Deadline of an instance, or of the topic if it is not keyed: the start of
+  // the current period, and the timer checking it, added with the first sample
+  struct Deadline {
+    std::chrono::steady_clock::time_point start;
+    TimingWheel::TimerId timer = TimingWheel::kNoTimer;
+  };
+
+  // An instance of a keyed topic, registered with its first sample
+  struct Instance {
+    // History serials of the instance's samples, oldest first; serials of
+    // samples taken since are pruned when the instance gets a new sample
+    std::vector<uint64_t> serials;
+
+    // Last sample of the instance, its information and history serial, or 0
+    // before the first; kept when the sample is taken or replaced
+    LocalSample last_sample;
+    tiny_dds::SampleInfo last_info;
+    uint64_t last_serial = 0;
+
+    // Earliest source timestamp the time-based filter keeps next
+    int64_t next_timestamp = 0;
+
+    // Deadline of the instance
+    Deadline deadline;
+  };
+
+  // Queues a sample for Read/Take, or returns the callbacks to pass it to
+  // instead. Sets info to the sample's information and conditions to the
+  // conditions to notify once the lock is released. The caller holds mutex_.
+  auto QueueLocked(const LocalSample& sample, tiny_dds::SampleInfo* info,
+                   std::shared_ptr<const ConditionList>* conditions)
+      -> std::shared_ptr<const Callbacks>;
+
+  // Same as QueueLocked for received data, whose payload is copied into the history
+  auto QueueCopyLocked(const void* data, size_t size, tiny_dds::SampleInfo* info,
+                       std::shared_ptr<const ConditionList>* conditions)
+      -> std::shared_ptr<const Callbacks>;
+
+  // Sets the instance of a sample of a keyed topic in its information,
+  // registering new instances; returns false if the sample's key cannot be
+  // read. Samples of other topics pass. The caller holds mutex_
+  auto AssignInstanceLocked(const LocalSample& sample, tiny_dds::SampleInfo* info) -> bool;
+  auto AssignInstanceLocked(const void* data, size_t size, tiny_dds::SampleInfo* info) -> bool;
+
+  // Gets the handle of the instance whose key is in key_buffer_, registering
+  // it if register_new is set; the caller holds mutex_
+  auto FindInstanceLocked(bool register_new) -> InstanceHandle;
+
+  // Stores a sample in the history; a sample of an instance that holds
+  // history.depth samples replaces its oldest. The caller holds mutex_
+  auto PushLocked(const LocalSample& sample, const tiny_dds::SampleInfo& info) -> bool;
+  auto PushCopyLocked(const void* data, size_t size, const tiny_dds::SampleInfo& info) -> bool;
+
+  // Applies the time-based filter to a sample, after its instance is
+  // assigned; returns false if the sample is dropped. The caller holds mutex_
+  auto PassesTimeFilterLocked(const tiny_dds::SampleInfo& info) -> bool;
+
+  // Starts a new deadline period for the instance of a sample that passed the
+  // filters; the caller holds mutex_
+  void RenewDeadlineLocked(InstanceHandle handle);
+
+  // Called by the deadline timer of an instance, or of the topic with HANDLE_NIL
+  void OnDeadlineTimer(InstanceHandle handle);
+
+  // Records that a writer was heard from; the caller holds mutex_
+  void AssertLivelinessLocked(const Guid& guid, WriterProgress* progress);
+
+  // Called by the liveliness timer of a writer
+  void OnLivelinessTimer(const Guid& guid);
+
+  // Wakes the conditions and runs the callback of a status changed by a timer
+  void ReportStatusChange(const std::shared_ptr<const ConditionList>& conditions,
+                          std::function<void()> callback);
+
+  // Makes room for a new sample of an instance; returns the instance, or
+  // null for samples of topics that are not keyed. The caller holds mutex_
+  auto ReserveInstanceLocked(InstanceHandle handle) -> Instance*;
+
+  // Builds the information of a sample received now; the caller holds mutex_
+  auto StampLocked(const SampleMetadata& metadata) -> tiny_dds::SampleInfo;
+
+  // Checks whether a sample is new to this reader, rather than a replayed
+  // sample it already has or does not want; the caller holds mutex_
+  auto AcceptLocked(const SampleMetadata& metadata) -> bool;
+
+  // Splits received data into its information and payload, or returns false
+  // if the sample is not accepted; the caller holds mutex_
+  auto UnframeLocked(const void* data, size_t size, tiny_dds::SampleInfo* info,
+                     const void** payload, size_t* payload_size) -> bool;
+
+  // Records that a sample was queued; the caller holds mutex_
+  void MarkDataAvailableLocked(std::shared_ptr<const ConditionList>* conditions);
+
+  // Replaces the callbacks with ones that dispatch to the reader's strands,
+  // or with null if no data callback is set; the caller holds mutex_
+  void SetCallbacksLocked(Callbacks callbacks);
+
+  // Runs the callbacks for a sample on the reader's strand, or on the thread
+  // chosen by the dispatcher
+  void DispatchCallbacks(std::shared_ptr<const Callbacks> callbacks, const LocalSample& sample,
+                         const tiny_dds::SampleInfo& info);
+  void DispatchCallbacks(std::shared_ptr<const Callbacks> callbacks, const void* data,
+                         size_t size, const tiny_dds::SampleInfo& info);
+
+  // Invokes the callbacks for a sample on the calling thread
+  void InvokeCallbacks(const Callbacks& callbacks, const LocalSample& sample,
+                       const tiny_dds::SampleInfo& info) const;
+  void InvokeCallbacks(const Callbacks& callbacks, const void* data, size_t size,
+                       const tiny_dds::SampleInfo& info) const;
+
+  // Body of Take; the caller holds mutex_
+  auto TakeLocked(void* buffer, size_t buffer_size, tiny_dds::SampleInfo& info) -> int32_t;
+
+  // Body of TakeMessage and TakeArenaMessage; the caller holds mutex_
+  auto TakeMessageLocked(google::protobuf::Message* message, tiny_dds::SampleInfo& info) -> bool;
+
+  // Body of ReadN and TakeN; the caller holds mutex_
+  auto CopySamplesLocked(tiny_dds::SampleBuffer* buffers, tiny_dds::SampleInfo* infos,
+                         size_t max_samples, SampleStateMask sample_states, bool take)
+      -> int32_t;
+
+  // Moves up to max_samples samples waiting on the endpoint into the history,
+  // so that reads see them; the caller holds mutex_
+  auto FetchFromTransportLocked(size_t max_samples) -> size_t;
+
+  // Adds a condition to be notified when a sample is queued
+  void AddCondition(const std::shared_ptr<ConditionImpl>& condition);
+  void AddConditionLocked(const std::shared_ptr<ConditionImpl>& condition);
+
+  // Wakes the WaitSets of the given conditions
+  static void NotifyConditions(const ConditionList& conditions);
+
+  // Receives the next sample of the topic, into buffer unless other readers of
+  // the process share it; buffer grows to fit the sample. The caller holds mutex_
+  auto ReceiveFromTransport(std::vector<uint8_t>* buffer, SharedReceiver::Frame* frame) -> bool;
   // The topic this data reader is associated with
   std::shared_ptr<tiny_dds::Topic> topic_;
 
   // The subscriber that created this data reader
   std::shared_ptr<SubscriberImpl> subscriber_;
 
-  // Queue of received data samples
-  struct DataSample {
-    std::vector<uint8_t> data;
-    tiny_dds::SampleInfo info;
-  };
-  std::deque<DataSample> samples_;
+  // Resolved at construction so that reads need no lookups
+  DomainId domain_id_;
+  std::string topic_name_;
+  TransportType transport_type_;
+
+  // Receiver of the topic shared with the process's other readers of it, and
+  // this reader's identifier in it, or null for LOCAL_ONLY
+  std::shared_ptr<SharedReceiver> receiver_;
+  uint64_t receiver_id_ = 0;
+
+  // Receive engine of the participant, which also decides where callbacks run
+  std::shared_ptr<ReceiveDispatcher> dispatcher_;
+
+  // Whether the reader receives the histories of durable writers, and from where
+  DurabilityKind durability_;
+  HistoryRequest history_request_;
+
+  // Filter of the content-filtered topic the reader was created for, or null
+  std::shared_ptr<const ContentFilter> filter_;
 
-  // Callback function for data reception
-  tiny_dds::DataReaderCallback data_received_callback_;
+  // Key fields of a keyed topic, or null
+  std::shared_ptr<const InstanceKey> instance_key_;
 
-  // Callback function for data reception with domain and topic information
-  tiny_dds::DataCallback data_callback_;
+  // Samples delivered by LOCAL_ONLY writers or the receive thread, until taken
+  SampleHistory history_;
+
+  // Samples kept per instance of a keyed topic, or 0 for no limit
+  size_t instance_depth_ = 0;
+
+  // Minimum separation of the time-based filter in nanoseconds, or 0
+  int64_t minimum_separation_;
+
+  // Earliest source timestamp the time-based filter keeps next, for topics
+  // that are not keyed; written under mutex_, read by the intra-process bus
+  std::atomic<int64_t> next_timestamp_{0};
+
+  // Deadline period, and the deadline of a topic that is not keyed
+  std::chrono::nanoseconds deadline_period_;
+  Deadline deadline_;
+
+  // Lease duration within which writers must be heard from to be alive
+  std::chrono::nanoseconds lease_duration_;
+
+  // Instances of a keyed topic by handle - 1, and their handles by key
+  std::vector<Instance> instances_;
+  absl::flat_hash_map<std::string, InstanceHandle> instance_handles_;
+
+  // Scratch buffer for the key of a sample
+  std::string key_buffer_;
+
+  // Arenas messages are taken into by TakeArenaMessage, created with the first
+  std::shared_ptr<ArenaPool> arena_pool_;
+
+  // Scratch buffer for samples fetched from network transports by reads and
+  // takes; it starts at 64KB and grows to the largest sample received
+  std::vector<uint8_t> receive_buffer_;
+
+  // Scratch buffer of the receive thread, see PollTransport
+  std::vector<uint8_t> poll_buffer_;
+
+  // Callback functions for data reception, or null if none is set
+  std::shared_ptr<const Callbacks> callbacks_;
+
+  // Executor chosen for the callbacks and its strands, or null and empty
+  std::shared_ptr<tiny_dds::Executor> callback_executor_;
+  std::vector<std::shared_ptr<tiny_dds::Strand>> callback_strands_;
 
   // Subscription matched status
   tiny_dds::SubscriptionMatchedStatus subscription_matched_status_;
 
-  // Mutex for thread safety
-  mutable absl::Mutex mutex_;
+  // Statuses reported by the deadline and liveliness timers, and their callbacks
+  tiny_dds::RequestedDeadlineMissedStatus requested_deadline_missed_status_;
+  tiny_dds::LivelinessChangedStatus liveliness_changed_status_;
+  tiny_dds::RequestedDeadlineMissedCallback requested_deadline_missed_callback_;
+  tiny_dds::LivelinessChangedCallback liveliness_changed_callback_;
+
+  // Statuses that changed since the application last read them
+  StatusMask status_changes_ = 0;
+
+  // Progress of every writer heard from, by GUID
+  absl::flat_hash_map<Guid, WriterProgress> writers_;
 
-  // Notification for waiting on data
-  absl::Notification data_available_;
+  // Conditions notified when a sample is queued, or null if there are none
+  std::shared_ptr<const ConditionList> conditions_;
+
+  // Condition triggered by status changes, created on first use
+  std::shared_ptr<StatusConditionImpl> status_condition_;
+
+  // Condition whose notifications run the NotifyDataAvailable listeners, created on first use
+  std::shared_ptr<ConditionImpl> data_available_condition_;
+
+  // Mutex for thread safety; Take with a timeout waits on it for samples to be queued
+  mutable absl::Mutex mutex_;
 };
 
 }  // namespace core
@@ -1,8 +1,17 @@
 #include "src/core/data_writer_impl.h"
 
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "src/core/data_reader_impl.h"
 #include "src/core/domain_participant_impl.h"
+#include "src/core/intra_process_bus.h"
 #include "src/core/publisher_impl.h"
 #include "src/core/topic_impl.h"
+#include "src/transport/routing_transport.h"
 #include "src/transport/transport_manager.h"
 
 namespace tiny_dds::core {
@@ -12,41 +21,167 @@ constexpr size_t kDefaultBufferSize = 1024 * 1024;    // 1MB buffer size
 constexpr size_t kDefaultMaxMessageSize = 64 * 1024;  // 64KB max message size
 
 DataWriterImpl::DataWriterImpl(std::shared_ptr<tiny_dds::Topic> topic,
-                               std::shared_ptr<PublisherImpl> publisher)
-    : topic_(std::move(topic)), publisher_(std::move(publisher)) {
-  // Initialize any resources needed for the data writer
+                               std::shared_ptr<PublisherImpl> publisher,
+                               const DataWriterQos& qos)
+    : topic_(std::move(topic)),
+      publisher_(std::move(publisher)),
+      transport_priority_(qos.transport_priority.value),
+      latency_budget_(qos.latency_budget.duration),
+      guid_(transport::RoutingTransport::GenerateGuid()),
+      durability_(qos.durability),
+      replay_depth_(static_cast<size_t>(std::max(
+          qos.history.kind == HistoryKind::KEEP_LAST ? qos.history.depth : qos.history.max_samples,
+          1))),
+      min_replay_interval_(qos.min_replay_interval),
+      deadline_period_(qos.deadline.period),
+      liveliness_kind_(qos.liveliness.kind),
+      lease_duration_(qos.liveliness.lease_duration),
+      timed_writes_(deadline_period_.count() > 0 || lease_duration_.count() > 0) {
+  auto participant = publisher_->GetParticipant();
+  domain_id_ = participant->GetDomainId();
+  topic_name_ = topic_->GetName();
+  transport_type_ = participant->GetTransportType();
+  dispatcher_ = participant->GetReceiveDispatcher();
+
+  if (durability_ == DurabilityKind::TRANSIENT_LOCAL || durability_ == DurabilityKind::TRANSIENT) {
+    history_ = std::make_unique<WriterHistory>(qos.history);
+  } else if (durability_ == DurabilityKind::PERSISTENT) {
+    // Sequence numbers continue from the samples logged before a restart
+    log_ = TopicLog::Open(TopicLogDirectory(qos.persistence, domain_id_, topic_name_),
+                          qos.persistence);
+    if (log_) {
+      sequence_number_.store(log_->LastSequenceNumber(), std::memory_order_relaxed);
+    } else {
+      std::cerr << "Failed to open the log of persistent topic: " << topic_name_ << std::endl;
+    }
+  }
+
+  // LOCAL_ONLY writers hand samples to the intra-process bus and need no transport
+  if (transport_type_ == TransportType::LOCAL_ONLY) {
+    return;
+  }
 
   // Get the transport manager
-  auto transport_manager = transport::TransportManager::Create();
+  auto transport_manager = transport::TransportManager::GetInstance();
+
+  // Create the transport for this topic and advertise it
+  if (!transport_manager->CreateTransport(domain_id_, participant->GetName(), topic_name_,
+                                          kDefaultBufferSize, kDefaultMaxMessageSize,
+                                          transport_type_) ||
+      !transport_manager->Advertise(domain_id_, topic_name_, transport_type_)) {
+    return;
+  }
 
-  // Create the transport for this topic
-  transport_manager->CreateTransport(publisher_->GetParticipant()->GetDomainId(),
-                                     publisher_->GetParticipant()->GetName(), topic_->GetName(),
-                                     kDefaultBufferSize, kDefaultMaxMessageSize,
-                                     publisher_->GetParticipant()->GetTransportType());
+  endpoint_ = transport_manager->OpenEndpoint(domain_id_, topic_name_, transport_type_);
 
-  // Advertise the topic
-  transport_manager->Advertise(publisher_->GetParticipant()->GetDomainId(), topic_->GetName(),
-                               publisher_->GetParticipant()->GetTransportType());
+  // Transports that cannot mark the samples send them unmarked
+  const TransportPriorityQos& priority = qos.transport_priority;
+  if (endpoint_ && (priority.value > 0 || priority.dscp >= 0)) {
+    marked_ = endpoint_->SetTransportPriority(priority);
+  }
 }
 
 DataWriterImpl::~DataWriterImpl() {
-  // Clean up resources
+  dispatcher_->RemoveTimer(deadline_timer_);
+  dispatcher_->RemoveTimer(liveliness_timer_);
+}
+
+namespace {
+
+// Steady clock time points are kept in atomics as tick counts
+auto SteadyTicks(std::chrono::steady_clock::time_point time) -> int64_t {
+  return time.time_since_epoch().count();
 }
 
+auto SteadyTime(int64_t ticks) -> std::chrono::steady_clock::time_point {
+  return std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(ticks));
+}
+
+// Buffer in which the sending thread assembles a sample header and payload,
+// since transports take one contiguous buffer
+thread_local std::vector<uint8_t> packet_buffer;
+
+}  // namespace
+
 bool DataWriterImpl::Write(const void* data, size_t size) {
-  absl::MutexLock lock(&mutex_);
+  // The history keeps the copy that local readers share
+  if (history_) {
+    return WriteSample(CopyToLocalSample(data, size));
+  }
 
-  // Get the transport manager
-  auto transport_manager = transport::TransportManager::Create();
+  LocalSample sample;
+  if (!Record(&sample, data, size)) {
+    return false;
+  }
+
+  // Readers in this process get one shared copy of the sample, without a syscall
+  if (transport_type_ == TransportType::LOCAL_ONLY) {
+    IntraProcessBus::Instance().Publish(domain_id_, topic_name_, data, size, sample.metadata);
+    return true;
+  }
 
-  // Use the transport manager to publish the data
-  return transport_manager->Send(publisher_->GetParticipant()->GetDomainId(), topic_->GetName(),
-                                 data, size, publisher_->GetParticipant()->GetTransportType());
+  return SendSample(data, size, sample.metadata);
+}
+
+bool DataWriterImpl::WriteShared(std::shared_ptr<const void> data, size_t size) {
+  if (!data) {
+    return false;
+  }
+
+  LocalSample sample;
+  sample.data = std::move(data);
+  sample.size = size;
+  return WriteSample(std::move(sample));
+}
+
+bool DataWriterImpl::WriteMessage(std::shared_ptr<const google::protobuf::Message> message) {
+  if (!message) {
+    return false;
+  }
+
+  // Local readers get the object itself and skip serialization entirely
+  LocalSample sample;
+  sample.message = std::move(message);
+
+  const bool local_only = transport_type_ == TransportType::LOCAL_ONLY;
+  if (local_only && !log_) {
+    if (!Record(&sample, nullptr, 0)) {
+      return false;
+    }
+    IntraProcessBus::Instance().Publish(domain_id_, topic_name_, sample);
+    return true;
+  }
+
+  // The message is serialized straight behind its header, which is encoded
+  // once the sample has its sequence number
+  const auto& message_ref = *sample.message;
+  const size_t size = message_ref.ByteSizeLong();
+  packet_buffer.resize(sizeof(SampleHeader) + size);
+  if (!message_ref.SerializeToArray(packet_buffer.data() + sizeof(SampleHeader),
+                                    static_cast<int>(size))) {
+    return false;
+  }
+
+  // The log takes the serialized message, once it exists
+  if (!Record(&sample, packet_buffer.data() + sizeof(SampleHeader), size)) {
+    return false;
+  }
+  EncodeSampleHeader(sample.metadata, packet_buffer.data());
+
+  if (local_only) {
+    IntraProcessBus::Instance().Publish(domain_id_, topic_name_, sample);
+    return true;
+  }
+
+  auto publish_queue = publisher_->GetPublishQueue();
+  if (publish_queue) {
+    return publish_queue->Push(shared_from_this(), packet_buffer.data(), packet_buffer.size(),
+                               nullptr, 0);
+  }
+  return SendPacket(packet_buffer.data(), packet_buffer.size());
 }
 
 std::shared_ptr<tiny_dds::Topic> DataWriterImpl::GetTopic() const {
-  absl::MutexLock lock(&mutex_);
   return topic_;
 }
 
@@ -55,9 +190,419 @@ tiny_dds::PublicationMatchedStatus DataWriterImpl::GetPublicationMatchedStatus()
   return publication_matched_status_;
 }
 
-std::shared_ptr<PublisherImpl> DataWriterImpl::GetPublisher() const {
+bool DataWriterImpl::AssertLiveliness() {
+  MarkAsserted(false);
+  return SendHeartbeat();
+}
+
+OfferedDeadlineMissedStatus DataWriterImpl::GetOfferedDeadlineMissedStatus() {
+  absl::MutexLock lock(&mutex_);
+  OfferedDeadlineMissedStatus status = offered_deadline_missed_status_;
+  offered_deadline_missed_status_.total_count_change = 0;
+  return status;
+}
+
+LivelinessLostStatus DataWriterImpl::GetLivelinessLostStatus() {
+  absl::MutexLock lock(&mutex_);
+  LivelinessLostStatus status = liveliness_lost_status_;
+  liveliness_lost_status_.total_count_change = 0;
+  return status;
+}
+
+void DataWriterImpl::SetOfferedDeadlineMissedCallback(OfferedDeadlineMissedCallback callback) {
+  absl::MutexLock lock(&mutex_);
+  offered_deadline_missed_callback_ = std::move(callback);
+}
+
+void DataWriterImpl::SetLivelinessLostCallback(LivelinessLostCallback callback) {
   absl::MutexLock lock(&mutex_);
+  liveliness_lost_callback_ = std::move(callback);
+}
+
+void DataWriterImpl::NotifyWhenSent(std::function<void()> listener) {
+  // Without a publish queue, Write has sent the samples already
+  auto publish_queue = publisher_->GetPublishQueue();
+  if (!publish_queue) {
+    listener();
+    return;
+  }
+  publish_queue->NotifyWhenFlushed(std::move(listener));
+}
+
+std::shared_ptr<PublisherImpl> DataWriterImpl::GetPublisher() const {
   return publisher_;
 }
 
+void DataWriterImpl::StartTimers() {
+  std::weak_ptr<DataWriterImpl> weak_self = weak_from_this();
+  const auto now = std::chrono::steady_clock::now();
+  last_asserted_.store(SteadyTicks(now));
+
+  if (deadline_period_.count() > 0) {
+    {
+      absl::MutexLock lock(&mutex_);
+      deadline_start_ = now;
+    }
+    deadline_timer_ = dispatcher_->AddTimer([weak_self]() {
+      if (auto self = weak_self.lock()) {
+        self->OnDeadlineTimer();
+      }
+    });
+    dispatcher_->ArmTimer(deadline_timer_, now + deadline_period_);
+  }
+
+  if (lease_duration_.count() > 0) {
+    liveliness_timer_ = dispatcher_->AddTimer([weak_self]() {
+      if (auto self = weak_self.lock()) {
+        self->OnLivelinessTimer();
+      }
+    });
+    dispatcher_->ArmTimer(liveliness_timer_,
+                          now + (liveliness_kind_ == LivelinessKind::AUTOMATIC
+                                     ? lease_duration_ / 2
+                                     : lease_duration_));
+  }
+}
+
+void DataWriterImpl::MarkAsserted(bool write) {
+  const auto now = std::chrono::steady_clock::now();
+  if (write) {
+    last_write_.store(SteadyTicks(now), std::memory_order_relaxed);
+  }
+
+  // Sequentially consistent with OnLivelinessTimer, so that a writer is
+  // never left without liveliness and without an armed timer
+  last_asserted_.store(SteadyTicks(now));
+  if (liveliness_lost_.load() && liveliness_lost_.exchange(false)) {
+    dispatcher_->ArmTimer(liveliness_timer_, now + lease_duration_);
+  }
+}
+
+auto DataWriterImpl::SendHeartbeat() -> bool {
+  LocalSample heartbeat;
+  heartbeat.metadata.writer_guid = guid_;
+  heartbeat.metadata.sequence_number = sequence_number_.load(std::memory_order_relaxed);
+  heartbeat.metadata.source_timestamp = NowNanoseconds();
+  heartbeat.metadata.flags = SampleMetadata::LIVELINESS;
+
+  if (transport_type_ == TransportType::LOCAL_ONLY) {
+    IntraProcessBus::Instance().Publish(domain_id_, topic_name_, heartbeat);
+    return true;
+  }
+  return SendSample(nullptr, 0, heartbeat.metadata);
+}
+
+void DataWriterImpl::OnDeadlineTimer() {
+  std::function<void()> callback;
+  {
+    absl::MutexLock lock(&mutex_);
+
+    // The last write, if any since the timer was armed, started the current period
+    const auto now = std::chrono::steady_clock::now();
+    deadline_start_ =
+        std::max(deadline_start_, SteadyTime(last_write_.load(std::memory_order_relaxed)));
+    if (now < deadline_start_ + deadline_period_) {
+      dispatcher_->ArmTimer(deadline_timer_, deadline_start_ + deadline_period_);
+      return;
+    }
+
+    deadline_start_ = now;
+    dispatcher_->ArmTimer(deadline_timer_, now + deadline_period_);
+
+    OfferedDeadlineMissedStatus& status = offered_deadline_missed_status_;
+    ++status.total_count;
+    ++status.total_count_change;
+    if (offered_deadline_missed_callback_) {
+      callback = [listener = offered_deadline_missed_callback_, status]() { listener(status); };
+      status.total_count_change = 0;
+    }
+  }
+
+  if (callback) {
+    dispatcher_->Dispatch(std::move(callback));
+  }
+}
+
+void DataWriterImpl::OnLivelinessTimer() {
+  const auto now = std::chrono::steady_clock::now();
+  const int64_t last_asserted = last_asserted_.load();
+
+  // AUTOMATIC writers assert their liveliness twice per lease when idle
+  if (liveliness_kind_ == LivelinessKind::AUTOMATIC) {
+    const auto interval = lease_duration_ / 2;
+    if (now < SteadyTime(last_asserted) + interval) {
+      dispatcher_->ArmTimer(liveliness_timer_, SteadyTime(last_asserted) + interval);
+      return;
+    }
+    last_asserted_.store(SteadyTicks(now));
+    SendHeartbeat();
+    dispatcher_->ArmTimer(liveliness_timer_, now + interval);
+    return;
+  }
+
+  if (now < SteadyTime(last_asserted) + lease_duration_) {
+    dispatcher_->ArmTimer(liveliness_timer_, SteadyTime(last_asserted) + lease_duration_);
+    return;
+  }
+
+  // The timer stays disarmed until the writer asserts its liveliness again,
+  // unless it just did
+  liveliness_lost_.store(true);
+  if (last_asserted_.load() != last_asserted && liveliness_lost_.exchange(false)) {
+    dispatcher_->ArmTimer(liveliness_timer_, now + lease_duration_);
+    return;
+  }
+
+  std::function<void()> callback;
+  {
+    absl::MutexLock lock(&mutex_);
+    LivelinessLostStatus& status = liveliness_lost_status_;
+    ++status.total_count;
+    ++status.total_count_change;
+    if (liveliness_lost_callback_) {
+      callback = [listener = liveliness_lost_callback_, status]() { listener(status); };
+      status.total_count_change = 0;
+    }
+  }
+
+  if (callback) {
+    dispatcher_->Dispatch(std::move(callback));
+  }
+}
+
+auto DataWriterImpl::NextMetadata() -> SampleMetadata {
+  if (timed_writes_) {
+    MarkAsserted(true);
+  }
+
+  SampleMetadata metadata;
+  metadata.writer_guid = guid_;
+  metadata.sequence_number = sequence_number_.fetch_add(1, std::memory_order_relaxed) + 1;
+  metadata.source_timestamp = NowNanoseconds();
+  return metadata;
+}
+
+auto DataWriterImpl::Record(LocalSample* sample, const void* payload, size_t size) -> bool {
+  if (!history_ && !log_) {
+    sample->metadata = NextMetadata();
+    return true;
+  }
+
+  // Replays and the log take samples in sequence order, so concurrent writes
+  // reserve their sequence number and store the sample under one lock
+  absl::MutexLock lock(&record_mutex_);
+  sample->metadata = NextMetadata();
+  if (history_) {
+    history_->Push(*sample);
+  }
+  return !log_ || log_->Append(sample->metadata, payload, size);
+}
+
+auto DataWriterImpl::WriteSample(LocalSample sample) -> bool {
+  if (!Record(&sample, sample.data.get(), sample.size)) {
+    return false;
+  }
+
+  if (transport_type_ == TransportType::LOCAL_ONLY) {
+    IntraProcessBus::Instance().Publish(domain_id_, topic_name_, sample);
+    return true;
+  }
+
+  return SendSample(sample.data.get(), sample.size, sample.metadata);
+}
+
+auto DataWriterImpl::SendSample(const void* data, size_t size, const SampleMetadata& metadata)
+    -> bool {
+  // In ASYNCHRONOUS mode the header and payload are copied straight into the queue
+  auto publish_queue = publisher_->GetPublishQueue();
+  if (publish_queue) {
+    uint8_t header[sizeof(SampleHeader)];
+    EncodeSampleHeader(metadata, header);
+    return publish_queue->Push(shared_from_this(), header, sizeof(header), data, size);
+  }
+
+  packet_buffer.resize(sizeof(SampleHeader) + size);
+  EncodeSampleHeader(metadata, packet_buffer.data());
+  if (size > 0) {
+    std::memcpy(packet_buffer.data() + sizeof(SampleHeader), data, size);
+  }
+  return SendPacket(packet_buffer.data(), packet_buffer.size());
+}
+
+auto DataWriterImpl::SendPacket(const void* packet, size_t size) -> bool {
+  // Small samples are packed with those of the publisher's other writers,
+  // unless they are marked or cannot wait for the coalescer's latency budget
+  auto coalescer = publisher_->GetCoalescer();
+  if (coalescer && !marked_ &&
+      (latency_budget_.count() == 0 || latency_budget_ >= coalescer->GetLatencyBudget())) {
+    return coalescer->Add(topic_name_, packet, size);
+  }
+
+  if (!endpoint_) {
+    return false;
+  }
+
+  return endpoint_->Send(packet, size);
+}
+
+void DataWriterImpl::ReplayHistoryTo(DataReaderImpl* reader) {
+  std::vector<LocalSample> samples = GetHistorySamples(reader->GetHistoryRequest());
+  if (samples.empty()) {
+    return;
+  }
+
+  for (LocalSample& sample : samples) {
+    sample.metadata.flags |= SampleMetadata::REPLAYED;
+  }
+  samples.back().metadata.flags |= SampleMetadata::END_OF_REPLAY;
+  reader->OnLocalSamples(samples);
+}
+
+void DataWriterImpl::ListenForHistoryRequests() {
+  auto participant = publisher_->GetParticipant();
+  auto request_topic =
+      participant->CreateTopic(HistoryRequestTopicName(topic_name_), kHistoryRequestTypeName);
+  if (!request_topic) {
+    std::cerr << "Failed to create the history request topic of: " << topic_name_ << std::endl;
+    return;
+  }
+
+  // Requests are handled on the participant's receive thread
+  auto request_reader = participant->CreateSubscriber()->CreateDataReader(request_topic);
+  std::weak_ptr<DataWriterImpl> weak_self = weak_from_this();
+  request_reader->SetDataReceivedCallback(
+      [weak_self](const void* data, size_t size, const SampleInfo& /*info*/) {
+        HistoryRequest request;
+        if (size >= sizeof(request)) {
+          std::memcpy(&request, data, sizeof(request));
+        }
+        if (auto self = weak_self.lock()) {
+          self->OnHistoryRequest(request);
+        }
+      });
+
+  absl::MutexLock lock(&mutex_);
+  history_request_reader_ = std::move(request_reader);
+}
+
+void DataWriterImpl::OnHistoryRequest(const HistoryRequest& request) {
+  std::chrono::steady_clock::time_point due;
+  bool schedule = false;
+  {
+    absl::MutexLock lock(&mutex_);
+
+    // The scheduled replay also answers this request
+    if (!pending_requests_.empty()) {
+      pending_requests_.push_back(request);
+      return;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    due = last_replay_ + min_replay_interval_;
+    if (now >= due) {
+      last_replay_ = now;
+    } else {
+      pending_requests_.push_back(request);
+      schedule = true;
+    }
+  }
+
+  if (!schedule) {
+    ReplayHistory({request});
+    return;
+  }
+
+  std::weak_ptr<DataWriterImpl> weak_self = weak_from_this();
+  dispatcher_->Schedule(due, [weak_self]() {
+    auto self = weak_self.lock();
+    if (!self) {
+      return;
+    }
+    std::vector<HistoryRequest> requests;
+    {
+      absl::MutexLock lock(&self->mutex_);
+      requests.swap(self->pending_requests_);
+      self->last_replay_ = std::chrono::steady_clock::now();
+    }
+    self->ReplayHistory(requests);
+  });
+}
+
+auto DataWriterImpl::GetHistorySamples(const HistoryRequest& request) const
+    -> std::vector<LocalSample> {
+  constexpr size_t kUnbounded = std::numeric_limits<size_t>::max();
+
+  if (log_) {
+    if (request.from_sequence_number != 0) {
+      return log_->ReadFromSequenceNumber(request.from_sequence_number, kUnbounded);
+    }
+    if (request.from_timestamp != 0) {
+      return log_->ReadFromTimestamp(request.from_timestamp, kUnbounded);
+    }
+    return log_->ReadLast(replay_depth_);
+  }
+
+  if (!history_) {
+    return {};
+  }
+
+  std::vector<LocalSample> samples = history_->Snapshot();
+  auto first = std::find_if(samples.begin(), samples.end(), [&request](const LocalSample& sample) {
+    return sample.metadata.sequence_number >= request.from_sequence_number &&
+           sample.metadata.source_timestamp >= request.from_timestamp;
+  });
+  samples.erase(samples.begin(), first);
+  return samples;
+}
+
+void DataWriterImpl::ReplayHistory(const std::vector<HistoryRequest>& requests) {
+  // Every answer is a suffix of the history, so the one reaching furthest
+  // back answers all the requests; readers drop what they did not ask for
+  std::vector<LocalSample> samples;
+  for (const auto& request : requests) {
+    std::vector<LocalSample> answer = GetHistorySamples(request);
+    if (samples.empty() || (!answer.empty() && answer.front().metadata.sequence_number <
+                                                   samples.front().metadata.sequence_number)) {
+      samples = std::move(answer);
+    }
+  }
+
+  for (size_t i = 0; i < samples.size(); ++i) {
+    const LocalSample& sample = samples[i];
+    SampleMetadata metadata = sample.metadata;
+    metadata.flags |= SampleMetadata::REPLAYED;
+    if (i + 1 == samples.size()) {
+      metadata.flags |= SampleMetadata::END_OF_REPLAY;
+    }
+
+    // Samples written as messages are serialized again
+    const bool serialize = !sample.data && sample.message;
+    const size_t size = serialize ? sample.message->ByteSizeLong() : sample.size;
+    packet_buffer.resize(sizeof(SampleHeader) + size);
+    EncodeSampleHeader(metadata, packet_buffer.data());
+    if (serialize) {
+      if (!sample.message->SerializeToArray(packet_buffer.data() + sizeof(SampleHeader),
+                                            static_cast<int>(size))) {
+        std::cerr << "Failed to serialize a replayed sample of: " << topic_name_ << std::endl;
+        break;
+      }
+    } else if (size > 0) {
+      std::memcpy(packet_buffer.data() + sizeof(SampleHeader), sample.data.get(), size);
+    }
+
+    // The rest of the replay would fail alike; readers take a replay without
+    // its end as a partial one and accept the next
+    if (!SendPacket(packet_buffer.data(), packet_buffer.size())) {
+      std::cerr << "Failed to send a replayed sample of: " << topic_name_ << std::endl;
+      break;
+    }
+  }
+
+  // The batch leaves at once instead of waiting out the coalescer's latency budget
+  auto coalescer = publisher_->GetCoalescer();
+  if (coalescer) {
+    coalescer->Flush();
+  }
+}
+
 }  // namespace tiny_dds::core
\ No newline at end of file
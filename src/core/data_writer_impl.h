@@ -1,18 +1,31 @@
 #ifndef TINY_DDS_CORE_DATA_WRITER_IMPL_H_
 #define TINY_DDS_CORE_DATA_WRITER_IMPL_H_
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "absl/synchronization/mutex.h"
+#include "include/tiny_dds/data_reader.h"
 #include "include/tiny_dds/data_writer.h"
+#include "include/tiny_dds/transport.h"
+#include "include/tiny_dds/transport_types.h"
 #include "include/tiny_dds/types.h"
+#include "src/core/receive_dispatcher.h"
+#include "src/core/sample_header.h"
+#include "src/core/topic_log.h"
+#include "src/core/writer_history.h"
 
 namespace tiny_dds {
 namespace core {
 
 // Forward declarations
+class DataReaderImpl;
 class PublisherImpl;
 class TopicImpl;
 
@@ -26,8 +39,10 @@ class DataWriterImpl : public tiny_dds::DataWriter,
    * @brief Constructor for DataWriterImpl.
    * @param topic The topic to publish data on.
    * @param publisher The publisher that created this data writer.
+   * @param qos The QoS of this data writer.
    */
-  DataWriterImpl(std::shared_ptr<tiny_dds::Topic> topic, std::shared_ptr<PublisherImpl> publisher);
+  DataWriterImpl(std::shared_ptr<tiny_dds::Topic> topic, std::shared_ptr<PublisherImpl> publisher,
+                 const tiny_dds::DataWriterQos& qos = tiny_dds::DataWriterQos());
 
   /**
    * @brief Destructor for DataWriterImpl.
@@ -42,6 +57,21 @@ class DataWriterImpl : public tiny_dds::DataWriter,
    */
   bool Write(const void* data, size_t size) override;
 
+  /**
+   * @brief Writes a data sample held in a reference-counted buffer.
+   * @param data The serialized message data.
+   * @param size Size of the serialized data in bytes.
+   * @return True if write was successful, false otherwise.
+   */
+  bool WriteShared(std::shared_ptr<const void> data, size_t size) override;
+
+  /**
+   * @brief Writes a Protocol Buffers message.
+   * @param message The message to write.
+   * @return True if write was successful, false otherwise.
+   */
+  bool WriteMessage(std::shared_ptr<const google::protobuf::Message> message) override;
+
   /**
    * @brief Gets the topic associated with this DataWriter.
    * @return A shared pointer to the associated Topic.
@@ -54,22 +84,233 @@ class DataWriterImpl : public tiny_dds::DataWriter,
    */
   tiny_dds::PublicationMatchedStatus GetPublicationMatchedStatus() const override;
 
+  /**
+   * @brief Asserts the liveliness of this writer with a heartbeat.
+   * @return True if the heartbeat was sent, false otherwise.
+   */
+  bool AssertLiveliness() override;
+
+  /**
+   * @brief Gets the deadlines this writer missed.
+   * @return The offered deadline missed status; its change count is reset.
+   */
+  tiny_dds::OfferedDeadlineMissedStatus GetOfferedDeadlineMissedStatus() override;
+
+  /**
+   * @brief Gets the times this writer lost its liveliness.
+   * @return The liveliness lost status; its change count is reset.
+   */
+  tiny_dds::LivelinessLostStatus GetLivelinessLostStatus() override;
+
+  /**
+   * @brief Sets a callback called on every missed deadline.
+   * @param callback The callback function, or null to remove it.
+   */
+  void SetOfferedDeadlineMissedCallback(tiny_dds::OfferedDeadlineMissedCallback callback) override;
+
+  /**
+   * @brief Sets a callback called when this writer loses its liveliness.
+   * @param callback The callback function, or null to remove it.
+   */
+  void SetLivelinessLostCallback(tiny_dds::LivelinessLostCallback callback) override;
+
+  /**
+   * @brief Runs a function once the samples written so far have left the publisher's queue.
+   * @param listener The function.
+   */
+  void NotifyWhenSent(std::function<void()> listener) override;
+
   /**
    * @brief Gets the publisher that created this data writer.
    * @return A shared pointer to the publisher.
    */
   std::shared_ptr<PublisherImpl> GetPublisher() const;
 
+  /**
+   * @brief Sends a sample framed with its header through the coalescer or the endpoint.
+   *
+   * Called by Write, or by the publisher's flusher thread in ASYNCHRONOUS mode.
+   *
+   * @param packet Pointer to the header followed by the payload.
+   * @param size Size of the packet in bytes.
+   * @return True if the sample was sent, false otherwise.
+   */
+  auto SendPacket(const void* packet, size_t size) -> bool;
+
+  /**
+   * @brief Gets the durability of this data writer.
+   * @return VOLATILE, TRANSIENT_LOCAL if the writer keeps its last samples for
+   *         late joiners, or PERSISTENT if it keeps them in a log on disk.
+   */
+  DurabilityKind GetDurability() const { return durability_; }
+
+  /**
+   * @brief Gets the transport priority of this data writer.
+   * @return The priority of its samples in the publisher's queue.
+   */
+  int32_t GetTransportPriority() const { return transport_priority_; }
+
+  /**
+   * @brief Gets the latency budget of this data writer.
+   * @return The longest its samples may wait in the publisher, or 0 for no budget.
+   */
+  std::chrono::nanoseconds GetLatencyBudget() const { return latency_budget_; }
+
+  /**
+   * @brief Delivers the history of the writer to a LOCAL_ONLY reader that joined.
+   *
+   * Called by the intra-process bus. The samples are delivered in one batch,
+   * from the point in the history the reader's QoS asks for; samples of a
+   * PERSISTENT writer point into its log and are not copied.
+   *
+   * @param reader The reader that joined the topic.
+   */
+  void ReplayHistoryTo(DataReaderImpl* reader);
+
+  /**
+   * @brief Subscribes a durable network writer to the requests of late-joining readers.
+   *
+   * Called by the publisher once the writer is created. Each request is
+   * answered by replaying the history on the topic, at most once per
+   * min_replay_interval; requests within the interval share the next replay.
+   */
+  void ListenForHistoryRequests();
+
+  /**
+   * @brief Starts the deadline and liveliness timers of the writer, if its QoS has any.
+   *
+   * Called by the publisher once the writer is created. The timers run on the
+   * participant's timing wheel; writes only record their time, and the timers
+   * check it once per period.
+   */
+  void StartTimers();
+
  private:
-  // The topic this data writer is associated with
-  std::shared_ptr<tiny_dds::Topic> topic_;
+  // Stamps the next sample with this writer's GUID, sequence number and the current time
+  auto NextMetadata() -> SampleMetadata;
+
+  // Stamps a sample with NextMetadata and keeps it in the history and the log;
+  // payload is the serialized sample the log takes. Returns false if the log
+  // cannot take it
+  auto Record(LocalSample* sample, const void* payload, size_t size) -> bool;
+
+  // Records that the writer wrote or asserted its liveliness
+  void MarkAsserted(bool write);
+
+  // Sends a heartbeat asserting the writer's liveliness
+  auto SendHeartbeat() -> bool;
+
+  // Called by the deadline timer
+  void OnDeadlineTimer();
+
+  // Called by the liveliness timer: AUTOMATIC writers send a heartbeat when
+  // idle, MANUAL_BY_TOPIC writers lose their liveliness
+  void OnLivelinessTimer();
+
+  // Stamps a sample held in a shared buffer, keeps it in the history and delivers it
+  auto WriteSample(LocalSample sample) -> bool;
+
+  // Frames a sample and queues it in ASYNCHRONOUS mode or sends it
+  auto SendSample(const void* data, size_t size, const SampleMetadata& metadata) -> bool;
+
+  // Handles a history request of a reader, replaying now or scheduling a replay
+  void OnHistoryRequest(const HistoryRequest& request);
+
+  // Gets the samples of the history a request asks for, oldest first
+  auto GetHistorySamples(const HistoryRequest& request) const -> std::vector<LocalSample>;
+
+  // Sends the history on the topic, flagged as a replay, in one batch that
+  // answers all the requests
+  void ReplayHistory(const std::vector<HistoryRequest>& requests);
+
+  // The topic this data writer is associated with, never changed after construction
+  const std::shared_ptr<tiny_dds::Topic> topic_;
+
+  // The publisher that created this data writer, never changed after construction
+  const std::shared_ptr<PublisherImpl> publisher_;
+
+  // Resolved at construction so that writes need no lookups or locks
+  DomainId domain_id_;
+  std::string topic_name_;
+  TransportType transport_type_;
 
-  // The publisher that created this data writer
-  std::shared_ptr<PublisherImpl> publisher_;
+  // Endpoint of the topic on the participant's transport, or null for LOCAL_ONLY
+  std::shared_ptr<TransportEndpoint> endpoint_;
+
+  // Transport priority and latency budget, never changed after construction
+  int32_t transport_priority_;
+  std::chrono::nanoseconds latency_budget_;
+
+  // Whether the endpoint marks the samples with the transport priority
+  bool marked_ = false;
+
+  // GUID identifying this writer to readers
+  Guid guid_;
+
+  // Last sequence number written
+  std::atomic<uint64_t> sequence_number_{0};
+
+  // Durability of this data writer
+  DurabilityKind durability_;
+
+  // Samples kept for late joiners by TRANSIENT_LOCAL writers, or null
+  std::unique_ptr<WriterHistory> history_;
+
+  // Log of every sample of PERSISTENT writers, or null
+  std::shared_ptr<TopicLog> log_;
+
+  // Held while a sample of a durable writer gets its sequence number and is
+  // stored in the history or the log; volatile writers do not take it
+  absl::Mutex record_mutex_;
+
+  // Number of samples replayed for requests without a starting point
+  size_t replay_depth_;
+
+  // Minimum time between two replays of the history
+  std::chrono::milliseconds min_replay_interval_;
+
+  // Start of the last replay, and the requests the scheduled replay answers
+  std::chrono::steady_clock::time_point last_replay_;
+  std::vector<HistoryRequest> pending_requests_;
+
+  // Receive engine of the participant, which delivers history requests and runs scheduled replays
+  std::shared_ptr<ReceiveDispatcher> dispatcher_;
+
+  // Reader of the history requests of late joiners, or null
+  std::shared_ptr<tiny_dds::DataReader> history_request_reader_;
+
+  // Deadline period, and the start of the current period
+  std::chrono::nanoseconds deadline_period_;
+  std::chrono::steady_clock::time_point deadline_start_;
+
+  // Liveliness kind and lease duration
+  LivelinessKind liveliness_kind_;
+  std::chrono::nanoseconds lease_duration_;
+
+  // Whether writes are timed, for the deadline or the liveliness
+  bool timed_writes_;
+
+  // Last write, and last write or heartbeat, in steady clock ticks; written
+  // without locking by every write
+  std::atomic<int64_t> last_write_{0};
+  std::atomic<int64_t> last_asserted_{0};
+
+  // Set while a MANUAL_BY_TOPIC writer has lost its liveliness and its timer is not armed
+  std::atomic<bool> liveliness_lost_{false};
+
+  // Timers on the participant's timing wheel, or kNoTimer
+  TimingWheel::TimerId deadline_timer_ = TimingWheel::kNoTimer;
+  TimingWheel::TimerId liveliness_timer_ = TimingWheel::kNoTimer;
 
   // Publication matched status
   tiny_dds::PublicationMatchedStatus publication_matched_status_;
 
+  // Statuses reported by the deadline and liveliness timers, and their callbacks
+  tiny_dds::OfferedDeadlineMissedStatus offered_deadline_missed_status_;
+  tiny_dds::LivelinessLostStatus liveliness_lost_status_;
+  tiny_dds::OfferedDeadlineMissedCallback offered_deadline_missed_callback_;
+  tiny_dds::LivelinessLostCallback liveliness_lost_callback_;
+
   // Mutex for thread safety
   mutable absl::Mutex mutex_;
 };
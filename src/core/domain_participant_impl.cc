@@ -1,6 +1,12 @@
 #include "src/core/domain_participant_impl.h"
 
+#include <iostream>
+
+#include "google/protobuf/descriptor.h"
+#include "src/core/content_filter.h"
+#include "src/core/instance_key.h"
 #include "src/core/publisher_impl.h"
+#include "src/core/receive_dispatcher.h"
 #include "src/core/subscriber_impl.h"
 #include "src/core/topic_impl.h"
 
@@ -18,7 +24,8 @@ DomainParticipantImpl::DomainParticipantImpl(DomainId domain_id,
                                              const std::string& participant_name)
     : domain_id_(domain_id),
       participant_name_(participant_name),
-      transport_type_(TransportType::UDP) {
+      transport_type_(TransportType::UDP),
+      receive_dispatcher_(ReceiveDispatcher::Create()) {
   // Initialize any resources needed for the domain participant
 }
 
@@ -49,27 +56,80 @@ std::shared_ptr<Subscriber> DomainParticipantImpl::CreateSubscriber() {
 }
 
 std::shared_ptr<Topic> DomainParticipantImpl::CreateTopic(const std::string& topic_name,
-                                                          const std::string& type_name) {
+                                                          const std::string& type_name,
+                                                          const std::vector<int32_t>& key_fields) {
+  // Key fields are compiled against the protobuf type of the topic
+  std::shared_ptr<const InstanceKey> instance_key;
+  if (!key_fields.empty()) {
+    const auto* descriptor =
+        google::protobuf::DescriptorPool::generated_pool()->FindMessageTypeByName(type_name);
+    if (descriptor == nullptr) {
+      std::cerr << "Cannot key topic " << topic_name << ": unknown protobuf type " << type_name
+                << std::endl;
+      return nullptr;
+    }
+    instance_key = InstanceKey::Compile(descriptor, key_fields);
+    if (!instance_key) {
+      return nullptr;
+    }
+  }
+
   absl::MutexLock lock(&mutex_);
 
   // Check if topic already exists
   auto it = topics_.find(topic_name);
   if (it != topics_.end()) {
-    // Topic exists, check if type name matches
-    if (it->second->GetTypeName() == type_name) {
+    // Topic exists, check if type name and key match
+    if (it->second->GetTypeName() == type_name && it->second->GetKeyFields() == key_fields) {
       return it->second;
     } else {
       // Type mismatch, return nullptr
       return nullptr;
     }
   }
+  if (content_filtered_topics_.contains(topic_name)) {
+    return nullptr;
+  }
 
   // Create a new topic
-  auto topic = std::make_shared<TopicImpl>(topic_name, type_name, shared_from_this());
+  auto topic = std::make_shared<TopicImpl>(topic_name, type_name, shared_from_this(), key_fields,
+                                           std::move(instance_key));
   topics_[topic_name] = topic;
   return topic;
 }
 
+std::shared_ptr<ContentFilteredTopic> DomainParticipantImpl::CreateContentFilteredTopic(
+    const std::string& name, std::shared_ptr<Topic> related_topic,
+    const std::string& filter_expression, const std::vector<std::string>& expression_parameters) {
+  if (!related_topic) {
+    return nullptr;
+  }
+
+  // The expression is compiled against the protobuf type of the topic
+  const auto* descriptor = google::protobuf::DescriptorPool::generated_pool()->FindMessageTypeByName(
+      related_topic->GetTypeName());
+  if (descriptor == nullptr) {
+    std::cerr << "Cannot filter topic " << related_topic->GetName()
+              << ": unknown protobuf type " << related_topic->GetTypeName() << std::endl;
+    return nullptr;
+  }
+  auto filter = ContentFilter::Compile(descriptor, filter_expression, expression_parameters);
+  if (!filter) {
+    return nullptr;
+  }
+
+  absl::MutexLock lock(&mutex_);
+
+  if (topics_.contains(name) || content_filtered_topics_.contains(name)) {
+    return nullptr;
+  }
+
+  auto topic = std::make_shared<ContentFilteredTopicImpl>(
+      name, std::move(related_topic), filter_expression, expression_parameters, std::move(filter));
+  content_filtered_topics_[name] = topic;
+  return topic;
+}
+
 DomainId DomainParticipantImpl::GetDomainId() const { return domain_id_; }
 
 const std::string& DomainParticipantImpl::GetName() const { return participant_name_; }
@@ -92,5 +152,14 @@ TransportType DomainParticipantImpl::GetTransportType() const {
   return transport_type_;
 }
 
+void DomainParticipantImpl::SetCallbackThreading(CallbackThreading threading,
+                                                 CallbackExecutor executor) {
+  receive_dispatcher_->SetCallbackThreading(threading, std::move(executor));
+}
+
+std::shared_ptr<ReceiveDispatcher> DomainParticipantImpl::GetReceiveDispatcher() const {
+  return receive_dispatcher_;
+}
+
 }  // namespace core
 }  // namespace tiny_dds
\ No newline at end of file
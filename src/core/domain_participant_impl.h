@@ -16,7 +16,9 @@ namespace tiny_dds {
 namespace core {
 
 // Forward declarations
+class ContentFilteredTopicImpl;
 class PublisherImpl;
+class ReceiveDispatcher;
 class SubscriberImpl;
 class TopicImpl;
 
@@ -51,13 +53,27 @@ class DomainParticipantImpl : public DomainParticipant,
   std::shared_ptr<Subscriber> CreateSubscriber() override;
 
   /**
-   * @brief Creates a Topic with the given name and type.
+   * @brief Creates a Topic with the given name and type, compiling its key fields.
    * @param topic_name The name of the topic.
    * @param type_name The name of the data type.
-   * @return A shared pointer to the created Topic.
+   * @param key_fields The protobuf field numbers of the key fields, if the topic is keyed.
+   * @return A shared pointer to the created Topic, or nullptr on a mismatch or invalid key.
    */
-  std::shared_ptr<Topic> CreateTopic(const std::string& topic_name,
-                                     const std::string& type_name) override;
+  std::shared_ptr<Topic> CreateTopic(const std::string& topic_name, const std::string& type_name,
+                                     const std::vector<int32_t>& key_fields = {}) override;
+
+  /**
+   * @brief Creates a ContentFilteredTopic, compiling its filter expression.
+   * @param name The name of the filtered topic.
+   * @param related_topic The topic whose samples are filtered.
+   * @param filter_expression The SQL-like filter expression.
+   * @param expression_parameters Values of the parameters of the expression.
+   * @return A shared pointer to the created topic, or nullptr on error.
+   */
+  std::shared_ptr<ContentFilteredTopic> CreateContentFilteredTopic(
+      const std::string& name, std::shared_ptr<Topic> related_topic,
+      const std::string& filter_expression,
+      const std::vector<std::string>& expression_parameters = {}) override;
 
   /**
    * @brief Gets the domain ID of this participant.
@@ -86,6 +102,20 @@ class DomainParticipantImpl : public DomainParticipant,
    */
   TransportType GetTransportType() const override;
 
+  /**
+   * @brief Selects where the callbacks of this participant's DataReaders run.
+   *
+   * @param threading The callback threading mode.
+   * @param executor The executor for EXECUTOR mode, or nullptr.
+   */
+  void SetCallbackThreading(CallbackThreading threading, CallbackExecutor executor) override;
+
+  /**
+   * @brief Gets the receive engine shared by this participant's DataReaders.
+   * @return A shared pointer to the dispatcher.
+   */
+  std::shared_ptr<ReceiveDispatcher> GetReceiveDispatcher() const;
+
  private:
   // Domain ID for this participant
   DomainId domain_id_;
@@ -102,11 +132,18 @@ class DomainParticipantImpl : public DomainParticipant,
   // Map of topics by name
   absl::flat_hash_map<std::string, std::shared_ptr<TopicImpl>> topics_;
 
+  // Map of content-filtered topics by name
+  absl::flat_hash_map<std::string, std::shared_ptr<ContentFilteredTopicImpl>>
+      content_filtered_topics_;
+
   // List of publishers created by this participant
   std::vector<std::shared_ptr<PublisherImpl>> publishers_;
 
   // List of subscribers created by this participant
   std::vector<std::shared_ptr<SubscriberImpl>> subscribers_;
+
+  // Receives samples for the data readers and runs their callbacks
+  std::shared_ptr<ReceiveDispatcher> receive_dispatcher_;
 };
 
 }  // namespace core
@@ -0,0 +1,293 @@
+#include "src/core/instance_key.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/wire_format_lite.h"
+
+namespace tiny_dds::core {
+
+using google::protobuf::Descriptor;
+using google::protobuf::FieldDescriptor;
+using google::protobuf::internal::WireFormatLite;
+
+namespace {
+
+auto DoubleBits(double value) -> uint64_t {
+  uint64_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+}  // namespace
+
+auto InstanceKey::Compile(const Descriptor* descriptor, const std::vector<int32_t>& key_fields)
+    -> std::shared_ptr<const InstanceKey> {
+  if (descriptor == nullptr) {
+    std::cerr << "Key fields need a protobuf message type" << std::endl;
+    return nullptr;
+  }
+
+  std::shared_ptr<InstanceKey> key(new InstanceKey());
+  key->descriptor_ = descriptor;
+  for (int32_t number : key_fields) {
+    const FieldDescriptor* field = descriptor->FindFieldByNumber(number);
+    const char* error = nullptr;
+    if (field == nullptr) {
+      error = "no such field";
+    } else if (field->is_repeated() || field->cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE) {
+      error = "only singular scalar, string and enum fields can be keys";
+    } else if (std::find(key->fields_.begin(), key->fields_.end(), field) != key->fields_.end()) {
+      error = "listed twice";
+    }
+    if (error != nullptr) {
+      std::cerr << "Invalid key field " << number << " of " << descriptor->full_name() << ": "
+                << error << std::endl;
+      return nullptr;
+    }
+    key->fields_.push_back(field);
+  }
+  return key;
+}
+
+auto InstanceKey::Extract(const void* data, size_t size, std::string* key) const -> bool {
+  if (size > static_cast<size_t>(std::numeric_limits<int>::max())) {
+    return false;
+  }
+
+  thread_local std::vector<Value> values;
+  values.resize(fields_.size());
+  for (size_t i = 0; i < fields_.size(); ++i) {
+    values[i] = DefaultValue(fields_[i]);
+  }
+
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  google::protobuf::io::CodedInputStream input(bytes, static_cast<int>(size));
+  while (true) {
+    const uint32_t tag = input.ReadTag();
+    if (tag == 0) {
+      if (!input.ConsumedEntireMessage()) {
+        return false;
+      }
+      break;
+    }
+
+    // Keys have few fields, so a linear search beats a map; like the parser,
+    // the last occurrence of a field wins
+    size_t index = 0;
+    while (index < fields_.size() &&
+           fields_[index]->number() != WireFormatLite::GetTagFieldNumber(tag)) {
+      ++index;
+    }
+    if (index == fields_.size()) {
+      if (!WireFormatLite::SkipField(&input, tag)) {
+        return false;
+      }
+      continue;
+    }
+
+    const FieldDescriptor* field = fields_[index];
+    Value& value = values[index];
+    switch (WireFormatLite::GetTagWireType(tag)) {
+      case WireFormatLite::WIRETYPE_VARINT: {
+        uint64_t raw = 0;
+        if (!input.ReadVarint64(&raw)) {
+          return false;
+        }
+        switch (field->type()) {
+          case FieldDescriptor::TYPE_INT32:
+          case FieldDescriptor::TYPE_ENUM:
+            value.bits = static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(raw)));
+            break;
+          case FieldDescriptor::TYPE_UINT32:
+            value.bits = static_cast<uint32_t>(raw);
+            break;
+          case FieldDescriptor::TYPE_BOOL:
+            value.bits = raw != 0 ? 1 : 0;
+            break;
+          case FieldDescriptor::TYPE_SINT32:
+            value.bits = static_cast<uint64_t>(static_cast<int64_t>(
+                WireFormatLite::ZigZagDecode32(static_cast<uint32_t>(raw))));
+            break;
+          case FieldDescriptor::TYPE_SINT64:
+            value.bits = static_cast<uint64_t>(WireFormatLite::ZigZagDecode64(raw));
+            break;
+          default:
+            value.bits = raw;
+            break;
+        }
+        break;
+      }
+
+      case WireFormatLite::WIRETYPE_FIXED32: {
+        uint32_t raw = 0;
+        if (!input.ReadLittleEndian32(&raw)) {
+          return false;
+        }
+        if (field->type() == FieldDescriptor::TYPE_FLOAT) {
+          float number = 0;
+          std::memcpy(&number, &raw, sizeof(number));
+          value.bits = DoubleBits(number);
+        } else if (field->type() == FieldDescriptor::TYPE_SFIXED32) {
+          value.bits = static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(raw)));
+        } else {
+          value.bits = raw;
+        }
+        break;
+      }
+
+      case WireFormatLite::WIRETYPE_FIXED64: {
+        if (!input.ReadLittleEndian64(&value.bits)) {
+          return false;
+        }
+        break;
+      }
+
+      case WireFormatLite::WIRETYPE_LENGTH_DELIMITED: {
+        // Strings are read in place
+        uint32_t length = 0;
+        if (!input.ReadVarint32(&length)) {
+          return false;
+        }
+        const int offset = input.CurrentPosition();
+        if (length > size - static_cast<size_t>(offset) || !input.Skip(static_cast<int>(length))) {
+          return false;
+        }
+        if (value.is_string) {
+          value.text = std::string_view(reinterpret_cast<const char*>(bytes + offset), length);
+        }
+        break;
+      }
+
+      default:
+        if (!WireFormatLite::SkipField(&input, tag)) {
+          return false;
+        }
+        break;
+    }
+  }
+
+  key->clear();
+  Encode(values, key);
+  return true;
+}
+
+auto InstanceKey::Extract(const google::protobuf::Message& message, std::string* key) const
+    -> bool {
+  if (message.GetDescriptor() != descriptor_) {
+    return false;
+  }
+
+  thread_local std::vector<Value> values;
+  thread_local std::vector<std::string> scratch;
+  values.resize(fields_.size());
+  scratch.resize(fields_.size());
+
+  const auto* reflection = message.GetReflection();
+  for (size_t i = 0; i < fields_.size(); ++i) {
+    const FieldDescriptor* field = fields_[i];
+    Value& value = values[i];
+    value = DefaultValue(field);
+    switch (field->cpp_type()) {
+      case FieldDescriptor::CPPTYPE_INT32:
+        value.bits = static_cast<uint64_t>(
+            static_cast<int64_t>(reflection->GetInt32(message, field)));
+        break;
+      case FieldDescriptor::CPPTYPE_INT64:
+        value.bits = static_cast<uint64_t>(reflection->GetInt64(message, field));
+        break;
+      case FieldDescriptor::CPPTYPE_UINT32:
+        value.bits = reflection->GetUInt32(message, field);
+        break;
+      case FieldDescriptor::CPPTYPE_UINT64:
+        value.bits = reflection->GetUInt64(message, field);
+        break;
+      case FieldDescriptor::CPPTYPE_FLOAT:
+        value.bits = DoubleBits(reflection->GetFloat(message, field));
+        break;
+      case FieldDescriptor::CPPTYPE_DOUBLE:
+        value.bits = DoubleBits(reflection->GetDouble(message, field));
+        break;
+      case FieldDescriptor::CPPTYPE_BOOL:
+        value.bits = reflection->GetBool(message, field) ? 1 : 0;
+        break;
+      case FieldDescriptor::CPPTYPE_ENUM:
+        value.bits = static_cast<uint64_t>(
+            static_cast<int64_t>(reflection->GetEnumValue(message, field)));
+        break;
+      case FieldDescriptor::CPPTYPE_STRING:
+        value.text = reflection->GetStringReference(message, field, &scratch[i]);
+        break;
+      default:
+        break;
+    }
+  }
+
+  key->clear();
+  Encode(values, key);
+  return true;
+}
+
+auto InstanceKey::Extract(const LocalSample& sample, std::string* key) const -> bool {
+  if (sample.data || !sample.message) {
+    return Extract(sample.data.get(), sample.size, key);
+  }
+  return Extract(*sample.message, key);
+}
+
+auto InstanceKey::DefaultValue(const FieldDescriptor* field) -> Value {
+  Value value;
+  switch (field->cpp_type()) {
+    case FieldDescriptor::CPPTYPE_INT32:
+      value.bits = static_cast<uint64_t>(static_cast<int64_t>(field->default_value_int32()));
+      break;
+    case FieldDescriptor::CPPTYPE_INT64:
+      value.bits = static_cast<uint64_t>(field->default_value_int64());
+      break;
+    case FieldDescriptor::CPPTYPE_UINT32:
+      value.bits = field->default_value_uint32();
+      break;
+    case FieldDescriptor::CPPTYPE_UINT64:
+      value.bits = field->default_value_uint64();
+      break;
+    case FieldDescriptor::CPPTYPE_FLOAT:
+      value.bits = DoubleBits(field->default_value_float());
+      break;
+    case FieldDescriptor::CPPTYPE_DOUBLE:
+      value.bits = DoubleBits(field->default_value_double());
+      break;
+    case FieldDescriptor::CPPTYPE_BOOL:
+      value.bits = field->default_value_bool() ? 1 : 0;
+      break;
+    case FieldDescriptor::CPPTYPE_ENUM:
+      value.bits = static_cast<uint64_t>(
+          static_cast<int64_t>(field->default_value_enum()->number()));
+      break;
+    case FieldDescriptor::CPPTYPE_STRING:
+      value.is_string = true;
+      value.text = field->default_value_string();
+      break;
+    default:
+      break;
+  }
+  return value;
+}
+
+void InstanceKey::Encode(const std::vector<Value>& values, std::string* key) {
+  // Numbers take 8 bytes and strings are prefixed with their length, so
+  // distinct values never encode to the same key
+  for (const Value& value : values) {
+    if (value.is_string) {
+      const auto length = static_cast<uint32_t>(value.text.size());
+      key->append(reinterpret_cast<const char*>(&length), sizeof(length));
+      key->append(value.text.data(), value.text.size());
+    } else {
+      key->append(reinterpret_cast<const char*>(&value.bits), sizeof(value.bits));
+    }
+  }
+}
+
+}  // namespace tiny_dds::core
@@ -0,0 +1,96 @@
+#ifndef TINY_DDS_CORE_INSTANCE_KEY_H_
+#define TINY_DDS_CORE_INSTANCE_KEY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "google/protobuf/descriptor.h"
+#include "google/protobuf/message.h"
+#include "src/core/intra_process_bus.h"
+
+namespace tiny_dds {
+namespace core {
+
+/**
+ * @brief Key fields of a keyed topic, compiled for one protobuf type.
+ *
+ * Key fields are singular scalar, string or enum fields of the message,
+ * named by their field numbers. The key of a sample is the values of those
+ * fields, encoded into a canonical byte string: a serialized sample and the
+ * message object it was serialized from give the same string, however the
+ * writer encoded it. Serialized samples are decoded straight from the wire
+ * format, skipping the other fields. Fields missing from a sample take their
+ * default value. Extraction is thread-safe.
+ */
+class InstanceKey {
+ public:
+  /**
+   * @brief Compiles the key fields of a message type.
+   * @param descriptor The descriptor of the topic's message type.
+   * @param key_fields The numbers of the key fields, in key order.
+   * @return The compiled key, or nullptr if a number is not a valid key field of the type.
+   */
+  static auto Compile(const google::protobuf::Descriptor* descriptor,
+                      const std::vector<int32_t>& key_fields)
+      -> std::shared_ptr<const InstanceKey>;
+
+  InstanceKey(const InstanceKey&) = delete;
+  InstanceKey& operator=(const InstanceKey&) = delete;
+
+  /**
+   * @brief Extracts the key of a serialized sample.
+   * @param data Pointer to the serialized message.
+   * @param size Size of the serialized message in bytes.
+   * @param[out] key The canonical key.
+   * @return True if the key was extracted, false if the sample cannot be parsed.
+   */
+  auto Extract(const void* data, size_t size, std::string* key) const -> bool;
+
+  /**
+   * @brief Extracts the key of a message object.
+   * @param message The message.
+   * @param[out] key The canonical key.
+   * @return True if the key was extracted, false if the message is of another type.
+   */
+  auto Extract(const google::protobuf::Message& message, std::string* key) const -> bool;
+
+  /**
+   * @brief Extracts the key of a sample of the intra-process bus.
+   * @param sample The sample, serialized or held as a message object.
+   * @param[out] key The canonical key.
+   * @return True if the key was extracted.
+   */
+  auto Extract(const LocalSample& sample, std::string* key) const -> bool;
+
+ private:
+  // The value of one key field: integers, booleans and enums as 64-bit
+  // integers, floating point numbers as the bits of a double
+  struct Value {
+    uint64_t bits = 0;
+    std::string_view text;
+    bool is_string = false;
+  };
+
+  InstanceKey() = default;
+
+  // Gets the default value of a key field
+  static auto DefaultValue(const google::protobuf::FieldDescriptor* field) -> Value;
+
+  // Appends the canonical encoding of the values to key
+  static void Encode(const std::vector<Value>& values, std::string* key);
+
+  // The message type the key was compiled for
+  const google::protobuf::Descriptor* descriptor_ = nullptr;
+
+  // The key fields, in key order
+  std::vector<const google::protobuf::FieldDescriptor*> fields_;
+};
+
+}  // namespace core
+}  // namespace tiny_dds
+
+#endif  // TINY_DDS_CORE_INSTANCE_KEY_H_
@@ -0,0 +1,193 @@
+#include "src/core/intra_process_bus.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include "src/core/buffer_pool.h"
+#include "src/core/data_reader_impl.h"
+#include "src/core/data_writer_impl.h"
+
+namespace tiny_dds::core {
+
+auto CopyToLocalSample(const void* data, size_t size) -> LocalSample {
+  std::shared_ptr<uint8_t> buffer = BufferPool::Instance().AllocateShared(size);
+  std::memcpy(buffer.get(), data, size);
+
+  LocalSample sample;
+  sample.data = std::move(buffer);
+  sample.size = size;
+  return sample;
+}
+
+auto IntraProcessBus::Instance() -> IntraProcessBus& {
+  static auto* bus = new IntraProcessBus();
+  return *bus;
+}
+
+void IntraProcessBus::AddReader(DomainId domain_id, const std::string& topic_name,
+                                const std::shared_ptr<DataReaderImpl>& reader) {
+  WriterList writers;
+  {
+    absl::MutexLock lock(&mutex_);
+
+    auto& readers = readers_[domain_id][topic_name];
+    auto updated = std::make_shared<ReaderList>();
+    if (readers) {
+      for (const auto& existing : *readers) {
+        if (!existing.expired()) {
+          updated->push_back(existing);
+        }
+      }
+    }
+    updated->push_back(reader);
+    readers = std::move(updated);
+
+    if (reader->GetDurability() != DurabilityKind::VOLATILE) {
+      writers = writers_[domain_id][topic_name];
+    }
+  }
+
+  // The reader is registered first, so a sample written meanwhile reaches it
+  // live, as part of the replay, or both; the reader drops the second copy
+  for (const auto& weak_writer : writers) {
+    if (auto writer = weak_writer.lock()) {
+      writer->ReplayHistoryTo(reader.get());
+    }
+  }
+}
+
+void IntraProcessBus::AddWriter(DomainId domain_id, const std::string& topic_name,
+                                const std::shared_ptr<DataWriterImpl>& writer) {
+  absl::MutexLock lock(&mutex_);
+
+  auto& writers = writers_[domain_id][topic_name];
+  writers.erase(std::remove_if(writers.begin(), writers.end(),
+                               [](const auto& existing) { return existing.expired(); }),
+                writers.end());
+  writers.push_back(writer);
+}
+
+auto IntraProcessBus::Publish(DomainId domain_id, const std::string& topic_name, const void* data,
+                              size_t size, const SampleMetadata& metadata) -> size_t {
+  auto readers = GetReaders(domain_id, topic_name);
+  if (!readers) {
+    return 0;
+  }
+
+  // One copy for all readers instead of one per reader
+  LocalSample sample;
+  sample.size = size;
+  sample.metadata = metadata;
+  return Deliver(domain_id, topic_name, *readers, sample, true, data);
+}
+
+auto IntraProcessBus::Publish(DomainId domain_id, const std::string& topic_name,
+                              const LocalSample& sample) -> size_t {
+  auto readers = GetReaders(domain_id, topic_name);
+  if (!readers) {
+    return 0;
+  }
+
+  return Deliver(domain_id, topic_name, *readers, sample);
+}
+
+auto IntraProcessBus::GetReaders(DomainId domain_id, const std::string& topic_name) const
+    -> std::shared_ptr<const ReaderList> {
+  absl::ReaderMutexLock lock(&mutex_);
+
+  auto domain_it = readers_.find(domain_id);
+  if (domain_it == readers_.end()) {
+    return nullptr;
+  }
+
+  auto topic_it = domain_it->second.find(topic_name);
+  if (topic_it == domain_it->second.end()) {
+    return nullptr;
+  }
+
+  return topic_it->second;
+}
+
+auto IntraProcessBus::Deliver(DomainId domain_id, const std::string& topic_name,
+                              const ReaderList& readers, const LocalSample& sample, bool copy,
+                              const void* data) -> size_t {
+  size_t delivered = 0;
+  bool found_expired = false;
+  LocalSample copied;
+  const LocalSample* shared = copy ? nullptr : &sample;
+
+  // Readers of one content-filtered topic share its filter, evaluated once
+  const ContentFilter* last_filter = nullptr;
+  bool last_accepted = true;
+
+  for (const auto& weak_reader : readers) {
+    auto reader = weak_reader.lock();
+    if (!reader) {
+      found_expired = true;
+      continue;
+    }
+
+    // Readers that keep one sample per period skip the others without a copy
+    if (reader->IsTimeFiltered(sample.metadata)) {
+      reader->OnFilteredSample(sample.metadata);
+      continue;
+    }
+
+    const ContentFilter* filter = reader->GetContentFilter();
+    if (filter != nullptr) {
+      if (filter != last_filter) {
+        last_filter = filter;
+        last_accepted = shared ? filter->Evaluate(*shared) : filter->Evaluate(data, sample.size);
+      }
+      if (!last_accepted) {
+        reader->OnFilteredSample(sample.metadata);
+        continue;
+      }
+    }
+
+    if (shared == nullptr) {
+      copied = CopyToLocalSample(data, sample.size);
+      copied.metadata = sample.metadata;
+      shared = &copied;
+    }
+    reader->OnLocalSample(*shared);
+    ++delivered;
+  }
+
+  if (found_expired) {
+    RemoveExpiredReaders(domain_id, topic_name);
+  }
+
+  return delivered;
+}
+
+void IntraProcessBus::RemoveExpiredReaders(DomainId domain_id, const std::string& topic_name) {
+  absl::MutexLock lock(&mutex_);
+
+  auto domain_it = readers_.find(domain_id);
+  if (domain_it == readers_.end()) {
+    return;
+  }
+
+  auto topic_it = domain_it->second.find(topic_name);
+  if (topic_it == domain_it->second.end()) {
+    return;
+  }
+
+  auto updated = std::make_shared<ReaderList>();
+  for (const auto& reader : *topic_it->second) {
+    if (!reader.expired()) {
+      updated->push_back(reader);
+    }
+  }
+
+  if (updated->empty()) {
+    domain_it->second.erase(topic_it);
+  } else {
+    topic_it->second = std::move(updated);
+  }
+}
+
+}  // namespace tiny_dds::core
@@ -0,0 +1,158 @@
+#ifndef TINY_DDS_CORE_INTRA_PROCESS_BUS_H_
+#define TINY_DDS_CORE_INTRA_PROCESS_BUS_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "google/protobuf/message.h"
+#include "include/tiny_dds/types.h"
+#include "src/core/sample_header.h"
+
+namespace tiny_dds {
+namespace core {
+
+// Forward declarations
+class DataReaderImpl;
+class DataWriterImpl;
+
+/**
+ * @brief A sample handed from a DataWriter to DataReaders in the same process.
+ *
+ * The payload is reference counted and shared by every matched reader, so a
+ * sample is never copied per reader. Typed writes pass the message object
+ * itself and leave the payload empty; readers only serialize it if they are
+ * asked for bytes.
+ */
+struct LocalSample {
+  // Serialized payload, or null if the sample only carries a message object
+  std::shared_ptr<const void> data;
+
+  // Size of the serialized payload in bytes
+  size_t size = 0;
+
+  // Message object from a typed write, or null for byte writes
+  std::shared_ptr<const google::protobuf::Message> message;
+
+  // Writer, sequence number and source timestamp of the sample
+  SampleMetadata metadata;
+};
+
+/**
+ * @brief Copies a serialized sample into a reference-counted buffer from the BufferPool.
+ * @param data Pointer to the serialized sample.
+ * @param size Size of the serialized sample in bytes.
+ * @return A sample owning the copy.
+ */
+auto CopyToLocalSample(const void* data, size_t size) -> LocalSample;
+
+/**
+ * @brief Process-wide registry that delivers LOCAL_ONLY samples to matched DataReaders.
+ *
+ * Readers of LOCAL_ONLY participants register here by domain and topic. A write
+ * takes a snapshot of the matched readers and pushes the sample straight into
+ * their queues (or callbacks) on the writing thread, without serialization,
+ * sockets or shared memory.
+ *
+ * TRANSIENT_LOCAL writers register here too; a TRANSIENT_LOCAL reader that
+ * joins a topic gets the history of the topic's writers replayed to it alone.
+ */
+class IntraProcessBus {
+ public:
+  /**
+   * @brief Gets the bus shared by all participants in this process.
+   * @return The process-wide bus.
+   */
+  static auto Instance() -> IntraProcessBus&;
+
+  /**
+   * @brief Registers a DataReader for a topic.
+   *
+   * A TRANSIENT_LOCAL reader receives the history of the topic's registered
+   * writers before this returns.
+   *
+   * @param domain_id The domain the reader belongs to.
+   * @param topic_name The topic the reader subscribes to.
+   * @param reader The reader; it is held weakly and dropped once destroyed.
+   */
+  void AddReader(DomainId domain_id, const std::string& topic_name,
+                 const std::shared_ptr<DataReaderImpl>& reader);
+
+  /**
+   * @brief Registers a TRANSIENT_LOCAL DataWriter whose history late readers receive.
+   * @param domain_id The domain the writer belongs to.
+   * @param topic_name The topic the writer publishes on.
+   * @param writer The writer; it is held weakly and dropped once destroyed.
+   */
+  void AddWriter(DomainId domain_id, const std::string& topic_name,
+                 const std::shared_ptr<DataWriterImpl>& writer);
+
+  /**
+   * @brief Delivers a byte sample, copying it once into a buffer shared by all readers.
+   *
+   * The sample is not copied at all if the content or time-based filters of all
+   * readers reject it.
+   *
+   * @param domain_id The domain to publish on.
+   * @param topic_name The topic to publish on.
+   * @param data Pointer to the serialized sample.
+   * @param size Size of the serialized sample in bytes.
+   * @param metadata The writer's metadata for the sample.
+   * @return The number of readers the sample was delivered to.
+   */
+  auto Publish(DomainId domain_id, const std::string& topic_name, const void* data, size_t size,
+               const SampleMetadata& metadata) -> size_t;
+
+  /**
+   * @brief Delivers a sample whose payload or message is already reference counted.
+   * @param domain_id The domain to publish on.
+   * @param topic_name The topic to publish on.
+   * @param sample The sample to share with every matched reader.
+   * @return The number of readers the sample was delivered to.
+   */
+  auto Publish(DomainId domain_id, const std::string& topic_name, const LocalSample& sample)
+      -> size_t;
+
+ private:
+  /**
+   * @brief Constructor.
+   */
+  IntraProcessBus() = default;
+
+  using ReaderList = std::vector<std::weak_ptr<DataReaderImpl>>;
+  using WriterList = std::vector<std::weak_ptr<DataWriterImpl>>;
+
+  // Returns the readers matched to a topic, or null if there are none
+  auto GetReaders(DomainId domain_id, const std::string& topic_name) const
+      -> std::shared_ptr<const ReaderList>;
+
+  // Delivers a sample to a snapshot of readers, pruning readers that are gone.
+  // Readers whose content or time-based filter rejects the sample are only
+  // told it was written. With copy set, the sample carries just the metadata
+  // and size, and data is copied for the first reader that accepts it.
+  auto Deliver(DomainId domain_id, const std::string& topic_name, const ReaderList& readers,
+               const LocalSample& sample, bool copy = false, const void* data = nullptr)
+      -> size_t;
+
+  // Drops destroyed readers from a topic's list
+  void RemoveExpiredReaders(DomainId domain_id, const std::string& topic_name);
+
+  // Matched readers by domain and topic name. Lists are replaced rather than
+  // modified, so writers can deliver from a snapshot without holding the lock.
+  absl::flat_hash_map<DomainId, absl::flat_hash_map<std::string, std::shared_ptr<const ReaderList>>>
+      readers_;
+
+  // Registered TRANSIENT_LOCAL writers by domain and topic name
+  absl::flat_hash_map<DomainId, absl::flat_hash_map<std::string, WriterList>> writers_;
+
+  // Mutex for thread safety
+  mutable absl::Mutex mutex_;
+};
+
+}  // namespace core
+}  // namespace tiny_dds
+
+#endif  // TINY_DDS_CORE_INTRA_PROCESS_BUS_H_
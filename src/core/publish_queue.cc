@@ -0,0 +1,406 @@
+#include "src/core/publish_queue.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <limits>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "absl/time/time.h"
+#include "src/core/buffer_pool.h"
+#include "src/core/data_writer_impl.h"
+
+namespace tiny_dds::core {
+
+// Empty polls after the last sample before the flusher goes to sleep
+constexpr int kSpinRounds = 64;
+
+// Values of wake_priority_ while the flusher sleeps and while it sends
+constexpr int64_t kWakeOnAny = std::numeric_limits<int64_t>::min();
+constexpr int64_t kWakeOnNone = std::numeric_limits<int64_t>::max();
+
+namespace {
+
+auto RoundUpToPowerOfTwo(size_t value) -> size_t {
+  size_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+auto SteadyNanoseconds(std::chrono::steady_clock::time_point time) -> int64_t {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+}  // namespace
+
+PublishQueue::Lane::Lane(int32_t priority, size_t capacity, size_t slot_size)
+    : priority(priority),
+      cells(RoundUpToPowerOfTwo(std::max<size_t>(capacity, 2))),
+      mask(cells.size() - 1) {
+  if (slot_size > 0) {
+    slab.reset(new uint8_t[cells.size() * slot_size]);
+  }
+  for (size_t i = 0; i < cells.size(); ++i) {
+    cells[i].sequence.store(i, std::memory_order_relaxed);
+    if (slab) {
+      cells[i].storage = slab.get() + i * slot_size;
+    }
+  }
+}
+
+auto PublishQueue::Create(const AsyncPublishConfig& config) -> std::shared_ptr<PublishQueue> {
+  std::shared_ptr<PublishQueue> queue(new PublishQueue(config));
+  queue->flush_thread_ = std::thread([queue]() { queue->FlushLoop(); });
+
+#ifdef __linux__
+  if (config.cpu >= 0) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(config.cpu, &cpus);
+    if (pthread_setaffinity_np(queue->flush_thread_.native_handle(), sizeof(cpus), &cpus) != 0) {
+      std::cerr << "Failed to pin the publisher's flusher thread to CPU " << config.cpu
+                << std::endl;
+    }
+  }
+#endif
+
+  // The owners' references share a count of their own, which stops the flusher
+  // when it drops to zero
+  PublishQueue* raw = queue.get();
+  return std::shared_ptr<PublishQueue>(raw, [queue = std::move(queue)](PublishQueue*) mutable {
+    queue->Stop();
+    queue.reset();
+  });
+}
+
+PublishQueue::PublishQueue(const AsyncPublishConfig& config)
+    : config_(config), wake_priority_(kWakeOnNone) {
+  config_.max_batch_size = std::max<size_t>(config_.max_batch_size, 1);
+}
+
+PublishQueue::~PublishQueue() {
+  // Only stopped from the flusher thread itself, which frees the queue as it exits
+  if (flush_thread_.joinable()) {
+    flush_thread_.detach();
+  }
+}
+
+void PublishQueue::Stop() {
+  {
+    absl::MutexLock lock(&mutex_);
+    stop_ = true;
+  }
+
+  // The last owner may be dropped by a writer released on the flusher thread
+  if (flush_thread_.get_id() != std::this_thread::get_id()) {
+    flush_thread_.join();
+  }
+}
+
+auto PublishQueue::Push(std::shared_ptr<DataWriterImpl> writer, const void* header,
+                        size_t header_size, const void* payload, size_t payload_size) -> bool {
+  Lane* lane = GetLane(writer->GetTransportPriority());
+
+  // Claim a cell: it is free when its sequence equals the position
+  Cell* cell = nullptr;
+  size_t position = lane->enqueue_position.load(std::memory_order_relaxed);
+  while (true) {
+    cell = &lane->cells[position & lane->mask];
+    const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+    const auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+    if (difference == 0) {
+      if (lane->enqueue_position.compare_exchange_weak(position, position + 1,
+                                                       std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (difference < 0) {
+      dropped_count_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    } else {
+      position = lane->enqueue_position.load(std::memory_order_relaxed);
+    }
+  }
+
+  const size_t size = header_size + payload_size;
+  uint8_t* storage = cell->storage;
+  if (size > config_.slot_size) {
+    cell->spilled = BufferPool::Instance().Allocate(size);
+    storage = cell->spilled;
+  }
+  if (header_size > 0) {
+    std::memcpy(storage, header, header_size);
+  }
+  if (payload_size > 0) {
+    std::memcpy(storage + header_size, payload, payload_size);
+  }
+  cell->size = size;
+  const std::chrono::nanoseconds latency_budget = writer->GetLatencyBudget();
+  cell->due = latency_budget.count() > 0
+                  ? SteadyNanoseconds(std::chrono::steady_clock::now() + latency_budget)
+                  : 0;
+  cell->writer = std::move(writer);
+
+  // Publish the cell to the flusher
+  cell->sequence.store(position + 1, std::memory_order_release);
+
+  // Pairs with the fences in FlushLoop and Pace: either the flusher sees this
+  // sample before sleeping, or this thread sees that it waits for it and wakes it
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (lane->priority >= wake_priority_.load(std::memory_order_relaxed)) {
+    absl::MutexLock lock(&mutex_);
+    wake_ = true;
+  }
+  return true;
+}
+
+void PublishQueue::Flush() {
+  const LanePositions target = EnqueuePositions();
+
+  // Sequentially consistent with the flusher's progress, so that either it
+  // sees this waiter after sending or the waiter sees the progress
+  flush_waiters_.fetch_add(1);
+  {
+    absl::MutexLock lock(&mutex_);
+    auto flushed = [this, &target]() { return Reached(target); };
+    mutex_.Await(absl::Condition(&flushed));
+  }
+  flush_waiters_.fetch_sub(1);
+}
+
+void PublishQueue::NotifyWhenFlushed(std::function<void()> listener) {
+  const LanePositions target = EnqueuePositions();
+
+  // Counted before checking the progress, like a Flush waiter, so that either
+  // the flusher finds the listener after sending or the check sees the progress
+  flush_waiters_.fetch_add(1);
+  {
+    absl::MutexLock lock(&mutex_);
+    if (!Reached(target)) {
+      flush_listeners_.push_back(FlushListener{target, std::move(listener)});
+      return;
+    }
+  }
+  flush_waiters_.fetch_sub(1);
+  listener();
+}
+
+void PublishQueue::RunFlushListeners() {
+  {
+    absl::MutexLock lock(&mutex_);
+    auto due = std::partition(
+        flush_listeners_.begin(), flush_listeners_.end(),
+        [this](const FlushListener& waiting) { return !Reached(waiting.positions); });
+    std::move(due, flush_listeners_.end(), std::back_inserter(due_listeners_));
+    flush_listeners_.erase(due, flush_listeners_.end());
+  }
+
+  // Listeners may write again, so they run without the lock
+  for (FlushListener& due : due_listeners_) {
+    due.listener();
+  }
+  flush_waiters_.fetch_sub(static_cast<int>(due_listeners_.size()));
+  due_listeners_.clear();
+}
+
+auto PublishQueue::GetLane(int32_t priority) -> Lane* {
+  size_t count = lane_count_.load(std::memory_order_acquire);
+  for (size_t i = 0; i < count; ++i) {
+    if (lanes_[i]->priority == priority) {
+      return lanes_[i].get();
+    }
+  }
+
+  // The first write of a priority adds its lane
+  if (count < kMaxLanes) {
+    absl::MutexLock lock(&mutex_);
+    count = lane_count_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+      if (lanes_[i]->priority == priority) {
+        return lanes_[i].get();
+      }
+    }
+    if (count < kMaxLanes) {
+      lanes_[count] = std::make_unique<Lane>(priority, config_.queue_capacity, config_.slot_size);
+      lane_count_.store(count + 1, std::memory_order_release);
+      return lanes_[count].get();
+    }
+  }
+
+  // Once every lane is taken, further priorities share the nearest one
+  Lane* nearest = lanes_[0].get();
+  for (size_t i = 1; i < count; ++i) {
+    if (std::abs(int64_t{lanes_[i]->priority} - priority) <
+        std::abs(int64_t{nearest->priority} - priority)) {
+      nearest = lanes_[i].get();
+    }
+  }
+  return nearest;
+}
+
+auto PublishQueue::EnqueuePositions() const -> LanePositions {
+  LanePositions positions{};
+  const size_t count = lane_count_.load(std::memory_order_acquire);
+  for (size_t i = 0; i < count; ++i) {
+    positions[i] = lanes_[i]->enqueue_position.load(std::memory_order_acquire);
+  }
+  return positions;
+}
+
+auto PublishQueue::Reached(const LanePositions& positions) const -> bool {
+  const size_t count = lane_count_.load(std::memory_order_acquire);
+  for (size_t i = 0; i < count; ++i) {
+    if (lanes_[i]->dequeue_position.load() < positions[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+auto PublishQueue::NextLane(int64_t above_priority) const -> Lane* {
+  Lane* highest = nullptr;
+  Lane* earliest = nullptr;
+  int64_t earliest_due = 0;
+
+  const size_t count = lane_count_.load(std::memory_order_acquire);
+  for (size_t i = 0; i < count; ++i) {
+    Lane* lane = lanes_[i].get();
+    if (lane->priority <= above_priority) {
+      continue;
+    }
+    const size_t position = lane->dequeue_position.load(std::memory_order_relaxed);
+    const Cell& cell = lane->cells[position & lane->mask];
+    if (cell.sequence.load(std::memory_order_acquire) != position + 1) {
+      continue;
+    }
+
+    if (highest == nullptr || lane->priority > highest->priority) {
+      highest = lane;
+    }
+    if (cell.due != 0 && (earliest == nullptr || cell.due < earliest_due)) {
+      earliest = lane;
+      earliest_due = cell.due;
+    }
+  }
+
+  // A sample that has waited for its writer's latency budget goes first
+  if (earliest != nullptr && earliest != highest &&
+      earliest_due <= SteadyNanoseconds(std::chrono::steady_clock::now())) {
+    return earliest;
+  }
+  return highest;
+}
+
+void PublishQueue::SendNext(Lane* lane) {
+  const size_t position = lane->dequeue_position.load(std::memory_order_relaxed);
+  Cell& cell = lane->cells[position & lane->mask];
+
+  uint8_t* data = cell.spilled != nullptr ? cell.spilled : cell.storage;
+  cell.writer->SendPacket(data, cell.size);
+
+  if (cell.spilled != nullptr) {
+    BufferPool::Instance().Release(cell.spilled, cell.size);
+    cell.spilled = nullptr;
+  }
+  cell.writer.reset();
+
+  // Hand the cell back to producers one lap later
+  cell.sequence.store(position + lane->cells.size(), std::memory_order_release);
+  lane->dequeue_position.store(position + 1);
+}
+
+void PublishQueue::Pace(std::chrono::steady_clock::time_point deadline, int64_t above_priority) {
+  auto woken = [this]() { return wake_; };
+
+  while (true) {
+    size_t sent = 0;
+    while (Lane* lane = NextLane(above_priority)) {
+      SendNext(lane);
+      ++sent;
+    }
+    if (sent > 0 && flush_waiters_.load() > 0) {
+      RunFlushListeners();
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now >= deadline) {
+      return;
+    }
+
+    // Only writers of the higher lanes wake the flusher before the deadline
+    absl::MutexLock lock(&mutex_);
+    wake_priority_.store(above_priority + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (NextLane(above_priority) == nullptr) {
+      mutex_.AwaitWithTimeout(absl::Condition(&woken), absl::FromChrono(deadline - now));
+    }
+    wake_ = false;
+    wake_priority_.store(kWakeOnNone, std::memory_order_relaxed);
+  }
+}
+
+void PublishQueue::FlushLoop() {
+  auto woken = [this]() { return wake_ || stop_; };
+  int idle_rounds = 0;
+
+  while (true) {
+    // The lane is picked again before every sample, so that a higher-priority
+    // sample queued meanwhile interrupts a batch of lower-priority ones
+    const auto batch_start = std::chrono::steady_clock::now();
+    int64_t lowest_priority = kWakeOnNone;
+    size_t sent = 0;
+    while (sent < config_.max_batch_size) {
+      Lane* lane = NextLane(kWakeOnAny);
+      if (lane == nullptr) {
+        break;
+      }
+      SendNext(lane);
+      lowest_priority = std::min<int64_t>(lowest_priority, lane->priority);
+      ++sent;
+    }
+
+    if (sent > 0) {
+      idle_rounds = 0;
+
+      // Flush re-checks its condition when the mutex is released
+      if (flush_waiters_.load() > 0) {
+        RunFlushListeners();
+      }
+
+      // Lanes above the lowest one in the batch are not paced
+      if (config_.batch_interval.count() > 0) {
+        Pace(batch_start + config_.batch_interval, lowest_priority);
+      }
+      continue;
+    }
+
+    if (++idle_rounds < kSpinRounds) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    absl::MutexLock lock(&mutex_);
+    wake_priority_.store(kWakeOnAny, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (NextLane(kWakeOnAny) == nullptr) {
+      if (stop_) {
+        wake_priority_.store(kWakeOnNone, std::memory_order_relaxed);
+        return;
+      }
+      mutex_.Await(absl::Condition(&woken));
+    }
+    wake_ = false;
+    wake_priority_.store(kWakeOnNone, std::memory_order_relaxed);
+    idle_rounds = 0;
+  }
+}
+
+}  // namespace tiny_dds::core
@@ -0,0 +1,217 @@
+#ifndef TINY_DDS_CORE_PUBLISH_QUEUE_H_
+#define TINY_DDS_CORE_PUBLISH_QUEUE_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "include/tiny_dds/transport_types.h"
+
+namespace tiny_dds {
+namespace core {
+
+// Forward declarations
+class DataWriterImpl;
+
+/**
+ * @brief Queue and flusher thread of a publisher in ASYNCHRONOUS publish mode.
+ *
+ * DataWriters copy each framed sample into a bounded lock-free ring (multiple
+ * producers, one consumer) and return. A flusher thread owned by the queue
+ * sends the samples through their writer in batches, optionally pacing the
+ * batches and pinned to a CPU. Samples of one writer are sent in the order
+ * they were written.
+ *
+ * Writers of each transport priority have their own ring, a lane. Before
+ * every sample the flusher picks the highest-priority lane with a sample, so
+ * a control writer waits for at most one sample of a bulk writer. A sample
+ * that has waited for its writer's latency budget goes ahead of higher lanes.
+ * Pacing only holds back the lanes of the batch's priority and below.
+ *
+ * Cells hold up to slot_size bytes inline, allocated with their lane when its
+ * first writer writes; larger samples are copied into a buffer from the
+ * BufferPool. The flusher spins briefly when the queue runs empty, then sleeps
+ * until a writer wakes it.
+ */
+class PublishQueue {
+ public:
+  /**
+   * @brief Creates a queue and starts its flusher thread.
+   *
+   * Dropping the last returned reference sends the queued samples and stops the
+   * flusher thread. The flusher holds a reference of its own, so when that
+   * happens on the flusher thread, through a writer it releases, the queue is
+   * freed only once the flusher has returned.
+   *
+   * @param config The asynchronous publishing configuration.
+   * @return The queue.
+   */
+  static auto Create(const AsyncPublishConfig& config) -> std::shared_ptr<PublishQueue>;
+
+  /**
+   * @brief Destructor.
+   */
+  ~PublishQueue();
+
+  PublishQueue(const PublishQueue&) = delete;
+  PublishQueue& operator=(const PublishQueue&) = delete;
+
+  /**
+   * @brief Queues a sample made of a header and a payload in its writer's lane.
+   * @param writer The writer that sends the sample.
+   * @param header Pointer to the sample header.
+   * @param header_size Size of the header in bytes.
+   * @param payload Pointer to the payload.
+   * @param payload_size Size of the payload in bytes.
+   * @return True if the sample was queued, false if the writer's lane is full.
+   */
+  auto Push(std::shared_ptr<DataWriterImpl> writer, const void* header, size_t header_size,
+            const void* payload, size_t payload_size) -> bool;
+
+  /**
+   * @brief Waits until every sample queued before the call has been sent.
+   */
+  void Flush();
+
+  /**
+   * @brief Runs a function once every sample queued before the call has been sent.
+   * @param listener The function; it runs on the calling thread if nothing is queued,
+   * otherwise on the flusher thread.
+   */
+  void NotifyWhenFlushed(std::function<void()> listener);
+
+  /**
+   * @brief Gets the number of samples rejected because the queue was full.
+   * @return The number of rejected samples.
+   */
+  auto GetDroppedCount() const -> uint64_t {
+    return dropped_count_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Maximum number of lanes; writers of further priorities share the nearest lane.
+   */
+  static constexpr size_t kMaxLanes = 8;
+
+ private:
+  // One queued sample. The sequence number tells producers and the consumer
+  // whose turn the cell is; each cell sits on its own cache line.
+  struct alignas(64) Cell {
+    std::atomic<size_t> sequence{0};
+    std::shared_ptr<DataWriterImpl> writer;
+    uint8_t* storage = nullptr;
+    uint8_t* spilled = nullptr;
+    size_t size = 0;
+
+    // Steady clock ticks after which the sample goes ahead of higher lanes, or 0
+    int64_t due = 0;
+  };
+
+  // Ring of the samples of the writers of one transport priority
+  struct Lane {
+    Lane(int32_t priority, size_t capacity, size_t slot_size);
+
+    const int32_t priority;
+
+    // Ring of cells; its size is a power of two
+    std::vector<Cell> cells;
+    size_t mask;
+
+    // Inline storage of all cells
+    std::unique_ptr<uint8_t[]> slab;
+
+    // Next position producers claim
+    alignas(64) std::atomic<size_t> enqueue_position{0};
+
+    // Next position the flusher sends; written by the flusher only
+    alignas(64) std::atomic<size_t> dequeue_position{0};
+  };
+
+  // Position of every lane to reach, lanes beyond the ones that existed being at 0
+  using LanePositions = std::array<size_t, kMaxLanes>;
+
+  // A function waiting for the flusher to reach positions
+  struct FlushListener {
+    LanePositions positions;
+    std::function<void()> listener;
+  };
+
+  explicit PublishQueue(const AsyncPublishConfig& config);
+
+  // Sends the queued samples and stops the flusher thread, without waiting for
+  // it when called on the flusher thread
+  void Stop();
+
+  // Gets the lane of a priority, adding it if there is room
+  auto GetLane(int32_t priority) -> Lane*;
+
+  // Gets the lanes' enqueue positions
+  auto EnqueuePositions() const -> LanePositions;
+
+  // Whether the flusher has sent every sample before the positions
+  auto Reached(const LanePositions& positions) const -> bool;
+
+  // Picks the lane to send from next among those above a priority, or null
+  // if none of them has a sample ready
+  auto NextLane(int64_t above_priority) const -> Lane*;
+
+  // Sends the oldest sample of a lane that has one ready
+  void SendNext(Lane* lane);
+
+  // Sends the samples of the lanes above a priority until they are empty or
+  // the deadline has passed, sleeping in between
+  void Pace(std::chrono::steady_clock::time_point deadline, int64_t above_priority);
+
+  // Runs the listeners whose samples have been sent; called by the flusher
+  void RunFlushListeners();
+
+  // Flusher thread body
+  void FlushLoop();
+
+  // Asynchronous publishing configuration
+  AsyncPublishConfig config_;
+
+  // Lanes in the order they were added; the first lane_count_ are set and not changed again
+  std::array<std::unique_ptr<Lane>, kMaxLanes> lanes_;
+  std::atomic<size_t> lane_count_{0};
+
+  // Producers of lanes at or above this priority wake the flusher: any
+  // priority while it sleeps, and none while it sends
+  std::atomic<int64_t> wake_priority_;
+
+  // Number of threads waiting in Flush, plus the listeners waiting in flush_listeners_
+  std::atomic<int> flush_waiters_{0};
+
+  // Listeners waiting for their samples to be sent, guarded by mutex_
+  std::vector<FlushListener> flush_listeners_;
+
+  // Listeners due to run, kept by the flusher to reuse their storage
+  std::vector<FlushListener> due_listeners_;
+
+  // Number of samples rejected because the queue was full
+  std::atomic<uint64_t> dropped_count_{0};
+
+  // Set by a producer to wake the flusher
+  bool wake_ = false;
+
+  // Flag to stop the flusher thread
+  bool stop_ = false;
+
+  // Mutex the flusher sleeps on, also guarding the addition of lanes
+  absl::Mutex mutex_;
+
+  // Thread sending the queued samples
+  std::thread flush_thread_;
+};
+
+}  // namespace core
+}  // namespace tiny_dds
+
+#endif  // TINY_DDS_CORE_PUBLISH_QUEUE_H_
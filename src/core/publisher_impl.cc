@@ -2,7 +2,9 @@
 
 #include "src/core/data_writer_impl.h"
 #include "src/core/domain_participant_impl.h"
+#include "src/core/intra_process_bus.h"
 #include "src/core/topic_impl.h"
+#include "src/transport/transport_manager.h"
 
 namespace tiny_dds::core {
 
@@ -18,6 +20,16 @@ PublisherImpl::~PublisherImpl() {
 }
 
 auto PublisherImpl::CreateDataWriter(std::shared_ptr<Topic> topic) -> std::shared_ptr<DataWriter> {
+  DataWriterQos qos;
+  {
+    absl::MutexLock lock(&mutex_);
+    qos = default_data_writer_qos_;
+  }
+  return CreateDataWriter(std::move(topic), qos);
+}
+
+auto PublisherImpl::CreateDataWriter(std::shared_ptr<Topic> topic, const DataWriterQos& qos)
+    -> std::shared_ptr<DataWriter> {
   // Store the participant pointer locally to avoid locking during DataWriterImpl construction
   std::shared_ptr<DomainParticipantImpl> participant;
   {
@@ -26,17 +38,90 @@ auto PublisherImpl::CreateDataWriter(std::shared_ptr<Topic> topic) -> std::share
   }
 
   // Create a new data writer
-  auto data_writer = std::make_shared<DataWriterImpl>(std::move(topic), shared_from_this());
+  const std::string topic_name = topic->GetName();
+  auto data_writer = std::make_shared<DataWriterImpl>(std::move(topic), shared_from_this(), qos);
 
   // Add it to our map
   {
     absl::MutexLock lock(&mutex_);
-    data_writers_[topic->GetName()] = data_writer;
+    data_writers_[topic_name] = data_writer;
+  }
+  data_writer->StartTimers();
+
+  // Durable writers learn about late joiners from the intra-process
+  // bus, or from the requests those readers send over the transport
+  if (data_writer->GetDurability() != DurabilityKind::VOLATILE) {
+    if (participant->GetTransportType() == TransportType::LOCAL_ONLY) {
+      IntraProcessBus::Instance().AddWriter(participant->GetDomainId(), topic_name, data_writer);
+    } else {
+      data_writer->ListenForHistoryRequests();
+    }
   }
 
   return data_writer;
 }
 
+void PublisherImpl::SetDefaultDataWriterQos(const DataWriterQos& qos) {
+  absl::MutexLock lock(&mutex_);
+  default_data_writer_qos_ = qos;
+}
+
+auto PublisherImpl::EnableCoalescing(const CoalescingConfig& config) -> bool {
+  const DomainId domain_id = participant_->GetDomainId();
+  const TransportType transport_type = participant_->GetTransportType();
+
+  // Only datagram transports benefit from packing samples together
+  if (transport_type != TransportType::UDP) {
+    return false;
+  }
+
+  auto coalescer = transport::SampleCoalescer::Create(
+      config, [domain_id, transport_type](const void* data, size_t size) {
+        auto transport_manager = transport::TransportManager::GetInstance();
+        return transport_manager->SendCoalesced(domain_id, data, size, transport_type);
+      });
+
+  // A previous coalescer sends what it holds, and stays alive for the writes still using it
+  transport::SampleCoalescer* previous = nullptr;
+  {
+    absl::MutexLock lock(&mutex_);
+    previous = coalescer_.exchange(coalescer.get(), std::memory_order_acq_rel);
+    coalescers_.push_back(std::move(coalescer));
+  }
+  if (previous != nullptr) {
+    previous->Flush();
+  }
+  return true;
+}
+
+auto PublisherImpl::EnableAsynchronousPublishing(const AsyncPublishConfig& config) -> bool {
+  // LOCAL_ONLY writes hand the sample to readers without a transport send to defer
+  if (participant_->GetTransportType() == TransportType::LOCAL_ONLY) {
+    return false;
+  }
+
+  auto publish_queue = PublishQueue::Create(config);
+
+  // A previous queue sends what it holds, and stays alive for the writes still using it
+  PublishQueue* previous = nullptr;
+  {
+    absl::MutexLock lock(&mutex_);
+    previous = publish_queue_.exchange(publish_queue.get(), std::memory_order_acq_rel);
+    publish_queues_.push_back(std::move(publish_queue));
+  }
+  if (previous != nullptr) {
+    previous->Flush();
+  }
+  return true;
+}
+
+void PublisherImpl::Flush() {
+  PublishQueue* publish_queue = GetPublishQueue();
+  if (publish_queue != nullptr) {
+    publish_queue->Flush();
+  }
+}
+
 auto PublisherImpl::GetParticipant() const -> std::shared_ptr<DomainParticipantImpl> {
   absl::MutexLock lock(&mutex_);
   return participant_;
@@ -1,6 +1,7 @@
 #ifndef TINY_DDS_CORE_PUBLISHER_IMPL_H_
 #define TINY_DDS_CORE_PUBLISHER_IMPL_H_
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
@@ -9,6 +10,9 @@
 #include "absl/container/flat_hash_map.h"
 #include "absl/synchronization/mutex.h"
 #include "include/tiny_dds/publisher.h"
+#include "include/tiny_dds/transport_types.h"
+#include "src/core/publish_queue.h"
+#include "src/transport/sample_coalescer.h"
 
 namespace tiny_dds {
 namespace core {
@@ -42,6 +46,62 @@ class PublisherImpl : public tiny_dds::Publisher,
   std::shared_ptr<tiny_dds::DataWriter> CreateDataWriter(
       std::shared_ptr<tiny_dds::Topic> topic) override;
 
+  /**
+   * @brief Creates a DataWriter for a specific topic with the given QoS.
+   * @param topic The topic to publish data on.
+   * @param qos The QoS of the DataWriter.
+   * @return A shared pointer to the created DataWriter.
+   */
+  std::shared_ptr<tiny_dds::DataWriter> CreateDataWriter(
+      std::shared_ptr<tiny_dds::Topic> topic, const tiny_dds::DataWriterQos& qos) override;
+
+  /**
+   * @brief Sets the QoS of DataWriters later created without one.
+   * @param qos The default QoS.
+   */
+  void SetDefaultDataWriterQos(const tiny_dds::DataWriterQos& qos) override;
+
+  /**
+   * @brief Enables coalescing of small samples written by this publisher's DataWriters.
+   * @param config The coalescing configuration.
+   * @return True if coalescing was enabled, false if the transport does not support it.
+   */
+  bool EnableCoalescing(const CoalescingConfig& config) override;
+
+  /**
+   * @brief Switches this publisher's DataWriters to ASYNCHRONOUS publish mode.
+   * @param config The asynchronous publishing configuration.
+   * @return True if the mode was enabled, false for LOCAL_ONLY participants.
+   */
+  bool EnableAsynchronousPublishing(const AsyncPublishConfig& config) override;
+
+  /**
+   * @brief Waits until every sample queued in ASYNCHRONOUS mode has been sent.
+   */
+  void Flush() override;
+
+  /**
+   * @brief Gets the queue of this publisher's DataWriters in ASYNCHRONOUS mode.
+   *
+   * Called on every write, without locking. The queue stays valid as long as
+   * the publisher, even once replaced.
+   *
+   * @return The queue, or nullptr in synchronous mode.
+   */
+  PublishQueue* GetPublishQueue() const { return publish_queue_.load(std::memory_order_acquire); }
+
+  /**
+   * @brief Gets the coalescer shared by this publisher's DataWriters.
+   *
+   * Called on every send, without locking. The coalescer stays valid as long
+   * as the publisher, even once replaced.
+   *
+   * @return The coalescer, or nullptr if coalescing is disabled.
+   */
+  transport::SampleCoalescer* GetCoalescer() const {
+    return coalescer_.load(std::memory_order_acquire);
+  }
+
   /**
    * @brief Gets the domain participant that created this publisher.
    * @return A shared pointer to the domain participant.
@@ -55,6 +115,21 @@ class PublisherImpl : public tiny_dds::Publisher,
   // Map of data writers by topic name
   absl::flat_hash_map<std::string, std::shared_ptr<DataWriterImpl>> data_writers_;
 
+  // QoS of data writers created without one
+  tiny_dds::DataWriterQos default_data_writer_qos_;
+
+  // Coalescer shared by all data writers, nullptr when coalescing is disabled
+  std::atomic<transport::SampleCoalescer*> coalescer_{nullptr};
+
+  // Queue and flusher thread of all data writers, nullptr in synchronous mode
+  std::atomic<PublishQueue*> publish_queue_{nullptr};
+
+  // Owners of the coalescers and queues above. Writes use them without
+  // locking, so replaced ones are only flushed, and kept until the publisher
+  // is destroyed
+  std::vector<std::shared_ptr<transport::SampleCoalescer>> coalescers_;
+  std::vector<std::shared_ptr<PublishQueue>> publish_queues_;
+
   // Mutex for thread safety
   mutable absl::Mutex mutex_;
 };
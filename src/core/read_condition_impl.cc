@@ -0,0 +1,41 @@
+#include "src/core/read_condition_impl.h"
+
+#include "src/core/data_reader_impl.h"
+
+namespace tiny_dds {
+namespace core {
+
+ReadConditionImpl::ReadConditionImpl(std::weak_ptr<DataReaderImpl> reader,
+                                     SampleStateMask sample_states)
+    : reader_(std::move(reader)), sample_states_(sample_states) {}
+
+bool ReadConditionImpl::GetTriggerValue() const {
+  auto reader = reader_.lock();
+  return reader && reader->HasSamples(sample_states_);
+}
+
+SampleStateMask ReadConditionImpl::GetSampleStateMask() const { return sample_states_; }
+
+std::shared_ptr<DataReader> ReadConditionImpl::GetDataReader() const { return reader_.lock(); }
+
+StatusConditionImpl::StatusConditionImpl(std::weak_ptr<DataReaderImpl> reader)
+    : reader_(std::move(reader)), enabled_statuses_(DATA_AVAILABLE_STATUS) {}
+
+bool StatusConditionImpl::GetTriggerValue() const {
+  auto reader = reader_.lock();
+  return reader && (reader->GetStatusChanges() & GetEnabledStatuses()) != 0;
+}
+
+void StatusConditionImpl::SetEnabledStatuses(StatusMask mask) {
+  enabled_statuses_.store(mask, std::memory_order_release);
+
+  // A status that already changed may trigger the condition now
+  NotifyWaitSets();
+}
+
+StatusMask StatusConditionImpl::GetEnabledStatuses() const {
+  return enabled_statuses_.load(std::memory_order_acquire);
+}
+
+}  // namespace core
+}  // namespace tiny_dds
@@ -0,0 +1,94 @@
+#ifndef TINY_DDS_CORE_READ_CONDITION_IMPL_H_
+#define TINY_DDS_CORE_READ_CONDITION_IMPL_H_
+
+#include <atomic>
+#include <memory>
+
+#include "include/tiny_dds/wait_set.h"
+#include "src/core/wait_set_impl.h"
+
+namespace tiny_dds {
+namespace core {
+
+// Forward declarations
+class DataReaderImpl;
+
+/**
+ * @brief Implementation of the ReadCondition interface.
+ */
+class ReadConditionImpl : public tiny_dds::ReadCondition, public ConditionImpl {
+ public:
+  /**
+   * @brief Constructor for ReadConditionImpl.
+   * @param reader The data reader whose history triggers this condition.
+   * @param sample_states The sample states that trigger this condition.
+   */
+  ReadConditionImpl(std::weak_ptr<DataReaderImpl> reader, SampleStateMask sample_states);
+
+  /**
+   * @brief Gets whether the reader has samples in the selected states.
+   * @return True if the condition is triggered.
+   */
+  bool GetTriggerValue() const override;
+
+  /**
+   * @brief Gets the sample states that trigger this condition.
+   * @return A combination of the *_SAMPLE_STATE constants.
+   */
+  SampleStateMask GetSampleStateMask() const override;
+
+  /**
+   * @brief Gets the DataReader this condition belongs to.
+   * @return A shared pointer to the DataReader, or nullptr if it was destroyed.
+   */
+  std::shared_ptr<tiny_dds::DataReader> GetDataReader() const override;
+
+ private:
+  // The data reader this condition belongs to
+  std::weak_ptr<DataReaderImpl> reader_;
+
+  // Sample states that trigger this condition
+  SampleStateMask sample_states_;
+};
+
+/**
+ * @brief Implementation of the StatusCondition interface for a DataReader.
+ */
+class StatusConditionImpl : public tiny_dds::StatusCondition, public ConditionImpl {
+ public:
+  /**
+   * @brief Constructor for StatusConditionImpl.
+   * @param reader The data reader whose status changes trigger this condition.
+   */
+  explicit StatusConditionImpl(std::weak_ptr<DataReaderImpl> reader);
+
+  /**
+   * @brief Gets whether any enabled status of the reader has changed.
+   * @return True if the condition is triggered.
+   */
+  bool GetTriggerValue() const override;
+
+  /**
+   * @brief Selects the statuses that trigger this condition.
+   * @param mask A combination of the *_STATUS constants.
+   */
+  void SetEnabledStatuses(StatusMask mask) override;
+
+  /**
+   * @brief Gets the statuses that trigger this condition.
+   * @return A combination of the *_STATUS constants.
+   */
+  StatusMask GetEnabledStatuses() const override;
+
+ private:
+  // The data reader this condition belongs to
+  std::weak_ptr<DataReaderImpl> reader_;
+
+  // Statuses that trigger this condition
+  std::atomic<StatusMask> enabled_statuses_;
+};
+
+}  // namespace core
+}  // namespace tiny_dds
+
+#endif  // TINY_DDS_CORE_READ_CONDITION_IMPL_H_
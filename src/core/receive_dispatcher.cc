@@ -0,0 +1,197 @@
+#include "src/core/receive_dispatcher.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "src/core/data_reader_impl.h"
+
+namespace tiny_dds::core {
+
+// Polling rounds without data before the receive thread starts to sleep
+constexpr int kSpinRounds = 64;
+
+// Bounds of the receive thread's sleep while no data arrives
+constexpr std::chrono::microseconds kMinIdleSleep{20};
+constexpr std::chrono::microseconds kMaxIdleSleep{1000};
+
+auto ReceiveDispatcher::Create() -> std::shared_ptr<ReceiveDispatcher> {
+  std::shared_ptr<ReceiveDispatcher> dispatcher(new ReceiveDispatcher());
+  dispatcher->self_ = dispatcher;
+
+  // The owners' references share a count of their own, which stops the
+  // threads when it drops to zero
+  ReceiveDispatcher* raw = dispatcher.get();
+  return std::shared_ptr<ReceiveDispatcher>(
+      raw, [dispatcher = std::move(dispatcher)](ReceiveDispatcher*) mutable {
+        dispatcher->Stop();
+        dispatcher.reset();
+      });
+}
+
+ReceiveDispatcher::ReceiveDispatcher()
+    : readers_(std::make_shared<ReaderList>()),
+      threading_(CallbackThreading::INLINE),
+      stop_(false),
+      receiving_(true) {}
+
+ReceiveDispatcher::~ReceiveDispatcher() {
+  // Only a thread that stopped the dispatcher itself is left, it frees the dispatcher as it exits
+  for (std::thread* thread : {&receive_thread_, &callback_thread_}) {
+    if (thread->joinable()) {
+      thread->detach();
+    }
+  }
+}
+
+void ReceiveDispatcher::Stop() {
+  {
+    absl::MutexLock lock(&mutex_);
+    stop_ = true;
+  }
+  receiving_.store(false, std::memory_order_release);
+
+  // The last owner may be dropped by a reader or sample released on one of the threads
+  for (std::thread* thread : {&receive_thread_, &callback_thread_}) {
+    if (thread->joinable() && thread->get_id() != std::this_thread::get_id()) {
+      thread->join();
+    }
+  }
+}
+
+void ReceiveDispatcher::AddReader(const std::shared_ptr<DataReaderImpl>& reader) {
+  absl::MutexLock lock(&mutex_);
+
+  auto updated = std::make_shared<ReaderList>(*readers_);
+  updated->push_back(reader);
+  readers_ = std::move(updated);
+
+  StartReceivingLocked();
+}
+
+void ReceiveDispatcher::Schedule(std::chrono::steady_clock::time_point due,
+                                 std::function<void()> task) {
+  timers_.Schedule(due, std::move(task));
+
+  absl::MutexLock lock(&mutex_);
+  StartReceivingLocked();
+}
+
+auto ReceiveDispatcher::AddTimer(std::function<void()> callback) -> TimingWheel::TimerId {
+  const TimingWheel::TimerId timer = timers_.Add(std::move(callback));
+
+  absl::MutexLock lock(&mutex_);
+  StartReceivingLocked();
+  return timer;
+}
+
+void ReceiveDispatcher::StartReceivingLocked() {
+  if (!receive_thread_.joinable() && !stop_) {
+    receive_thread_ = std::thread([self = self_.lock()]() { self->ReceiveLoop(); });
+  }
+}
+
+void ReceiveDispatcher::SetCallbackThreading(CallbackThreading threading,
+                                             CallbackExecutor executor) {
+  absl::MutexLock lock(&mutex_);
+  executor_ = std::move(executor);
+  threading_.store(threading, std::memory_order_release);
+}
+
+void ReceiveDispatcher::Post(std::function<void()> task) {
+  CallbackExecutor executor;
+  {
+    absl::MutexLock lock(&mutex_);
+
+    if (!executor_) {
+      tasks_.push_back(std::move(task));
+      if (!callback_thread_.joinable() && !stop_) {
+        callback_thread_ = std::thread([self = self_.lock()]() { self->CallbackLoop(); });
+      }
+      return;
+    }
+
+    executor = executor_;
+  }
+
+  // The executor may run the task inline, so it is called without the lock
+  executor(std::move(task));
+}
+
+void ReceiveDispatcher::ReceiveLoop() {
+  int idle_rounds = 0;
+  auto idle_sleep = kMinIdleSleep;
+
+  while (receiving_.load(std::memory_order_acquire)) {
+    std::shared_ptr<const ReaderList> readers;
+    {
+      absl::MutexLock lock(&mutex_);
+      readers = readers_;
+    }
+
+    size_t received = 0;
+    bool found_expired = false;
+    for (const auto& weak_reader : *readers) {
+      auto reader = weak_reader.lock();
+      if (!reader) {
+        found_expired = true;
+        continue;
+      }
+      received += reader->PollTransport(kMaxSamplesPerPoll);
+    }
+
+    if (found_expired) {
+      RemoveExpiredReaders();
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (timers_.IsDue(now)) {
+      timers_.Advance(now);
+    }
+
+    if (received > 0) {
+      idle_rounds = 0;
+      idle_sleep = kMinIdleSleep;
+      continue;
+    }
+
+    // Stay hot for a short while after the last sample, then back off
+    if (++idle_rounds < kSpinRounds) {
+      std::this_thread::yield();
+      continue;
+    }
+    std::this_thread::sleep_for(idle_sleep);
+    idle_sleep = std::min(idle_sleep * 2, kMaxIdleSleep);
+  }
+}
+
+void ReceiveDispatcher::CallbackLoop() {
+  auto has_work = [this]() { return stop_ || !tasks_.empty(); };
+
+  while (true) {
+    std::function<void()> task;
+    {
+      absl::MutexLock lock(&mutex_);
+      mutex_.Await(absl::Condition(&has_work));
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+void ReceiveDispatcher::RemoveExpiredReaders() {
+  absl::MutexLock lock(&mutex_);
+
+  auto updated = std::make_shared<ReaderList>();
+  for (const auto& reader : *readers_) {
+    if (!reader.expired()) {
+      updated->push_back(reader);
+    }
+  }
+  readers_ = std::move(updated);
+}
+
+}  // namespace tiny_dds::core
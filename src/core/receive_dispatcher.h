@@ -0,0 +1,192 @@
+#ifndef TINY_DDS_CORE_RECEIVE_DISPATCHER_H_
+#define TINY_DDS_CORE_RECEIVE_DISPATCHER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "include/tiny_dds/domain_participant.h"
+#include "src/core/timing_wheel.h"
+
+namespace tiny_dds {
+namespace core {
+
+// Forward declarations
+class DataReaderImpl;
+
+/**
+ * @brief Receive engine of a domain participant.
+ *
+ * A background thread, started with the first registered DataReader, polls the
+ * transport endpoints of all the participant's readers and pushes the samples
+ * into the readers' queues, or to their callbacks. Transports are non-blocking,
+ * so the thread backs off from spinning to short sleeps while nothing arrives.
+ *
+ * Callbacks run on the receive thread (INLINE) or are handed to an executor
+ * (EXECUTOR). Without an application executor, a callback thread owned by the
+ * dispatcher runs them in the order they were received.
+ *
+ * The receive thread also turns the participant's timing wheel, which runs
+ * scheduled tasks and the timers of deadlines and liveliness leases, with the
+ * precision of its longest idle sleep.
+ */
+class ReceiveDispatcher {
+ public:
+  /**
+   * @brief Creates a dispatcher; no thread is started until a reader is added.
+   *
+   * Dropping the last returned reference stops the receive and callback
+   * threads. Each thread holds a reference of its own, so when that happens
+   * on one of them, through a reader or sample it releases, the dispatcher is
+   * freed only once that thread has returned.
+   *
+   * @return The dispatcher.
+   */
+  static auto Create() -> std::shared_ptr<ReceiveDispatcher>;
+
+  /**
+   * @brief Destructor.
+   */
+  ~ReceiveDispatcher();
+
+  ReceiveDispatcher(const ReceiveDispatcher&) = delete;
+  ReceiveDispatcher& operator=(const ReceiveDispatcher&) = delete;
+
+  /**
+   * @brief Registers a DataReader whose transport endpoint is drained by the receive thread.
+   * @param reader The reader; it is held weakly and dropped once destroyed.
+   */
+  void AddReader(const std::shared_ptr<DataReaderImpl>& reader);
+
+  /**
+   * @brief Selects where callbacks run.
+   * @param threading INLINE or EXECUTOR.
+   * @param executor Executor for EXECUTOR mode, or null for the dispatcher's own callback thread.
+   */
+  void SetCallbackThreading(CallbackThreading threading, CallbackExecutor executor);
+
+  /**
+   * @brief Runs a task on the receive thread once a point in time has passed.
+   * @param due When to run the task.
+   * @param task The task; it must own everything it refers to.
+   */
+  void Schedule(std::chrono::steady_clock::time_point due, std::function<void()> task);
+
+  /**
+   * @brief Adds a timer to the participant's timing wheel, run by the receive thread.
+   * @param callback Called each time the timer fires; it must own everything it refers to.
+   * @return The timer's identifier, to arm and remove it.
+   */
+  auto AddTimer(std::function<void()> callback) -> TimingWheel::TimerId;
+
+  /**
+   * @brief Arms a timer, replacing its due time if it is already armed.
+   * @param timer The timer.
+   * @param due When the timer fires.
+   */
+  void ArmTimer(TimingWheel::TimerId timer, std::chrono::steady_clock::time_point due) {
+    timers_.Arm(timer, due);
+  }
+
+  /**
+   * @brief Removes a timer.
+   * @param timer The timer.
+   */
+  void RemoveTimer(TimingWheel::TimerId timer) { timers_.Remove(timer); }
+
+  /**
+   * @brief Checks whether callbacks run on the thread that received the sample.
+   * @return True in INLINE mode.
+   */
+  auto IsInline() const -> bool {
+    return threading_.load(std::memory_order_acquire) == CallbackThreading::INLINE;
+  }
+
+  /**
+   * @brief Runs a callback invocation according to the configured threading.
+   * @param callback The invocation; it must own everything it refers to in EXECUTOR mode.
+   */
+  template <typename Callback>
+  void Dispatch(Callback&& callback) {
+    if (IsInline()) {
+      callback();
+      return;
+    }
+    Post(std::function<void()>(std::forward<Callback>(callback)));
+  }
+
+  /**
+   * @brief Maximum number of samples taken from one reader before moving to the next.
+   */
+  static constexpr size_t kMaxSamplesPerPoll = 64;
+
+ private:
+  using ReaderList = std::vector<std::weak_ptr<DataReaderImpl>>;
+
+  ReceiveDispatcher();
+
+  // Stops both threads, without waiting for the calling one
+  void Stop();
+
+  // Hands a task to the executor or the callback thread
+  void Post(std::function<void()> task);
+
+  // Receive thread body
+  void ReceiveLoop();
+
+  // Callback thread body, used in EXECUTOR mode without an application executor
+  void CallbackLoop();
+
+  // Drops destroyed readers from the list
+  void RemoveExpiredReaders();
+
+  // Starts the receive thread if it is not running; the caller holds mutex_
+  void StartReceivingLocked();
+
+  // Reference the threads hold while they run, distinct from the owners' references
+  std::weak_ptr<ReceiveDispatcher> self_;
+
+  // Registered readers; the list is replaced rather than modified so that the
+  // receive thread can poll a snapshot without holding the lock
+  std::shared_ptr<const ReaderList> readers_;
+
+  // Current callback threading, read on every dispatched sample
+  std::atomic<CallbackThreading> threading_;
+
+  // Application executor for EXECUTOR mode, or null
+  CallbackExecutor executor_;
+
+  // Tasks waiting for the callback thread
+  std::deque<std::function<void()>> tasks_;
+
+  // Scheduled tasks and timers, run by the receive thread
+  TimingWheel timers_;
+
+  // Flag to stop both threads
+  bool stop_;
+
+  // Read by the receive thread without taking the lock
+  std::atomic<bool> receiving_;
+
+  // Mutex for thread safety
+  mutable absl::Mutex mutex_;
+
+  // Thread draining the readers' transport endpoints
+  std::thread receive_thread_;
+
+  // Thread running callbacks in EXECUTOR mode without an application executor
+  std::thread callback_thread_;
+};
+
+}  // namespace core
+}  // namespace tiny_dds
+
+#endif  // TINY_DDS_CORE_RECEIVE_DISPATCHER_H_
@@ -0,0 +1,43 @@
+#include "src/core/sample_header.h"
+
+#include <chrono>
+#include <cstring>
+
+namespace tiny_dds::core {
+
+void EncodeSampleHeader(const SampleMetadata& metadata, void* buffer) {
+  SampleHeader header{};
+  header.magic = SampleHeader::MAGIC_NUMBER;
+  header.flags = metadata.flags;
+  header.writer_guid = metadata.writer_guid;
+  header.sequence_number = metadata.sequence_number;
+  header.source_timestamp = metadata.source_timestamp;
+  std::memcpy(buffer, &header, sizeof(header));
+}
+
+auto DecodeSampleHeader(const void* data, size_t size, SampleMetadata* metadata) -> bool {
+  if (size < sizeof(SampleHeader)) {
+    return false;
+  }
+
+  // Received data has no alignment guarantee
+  SampleHeader header{};
+  std::memcpy(&header, data, sizeof(header));
+  if (header.magic != SampleHeader::MAGIC_NUMBER) {
+    return false;
+  }
+
+  metadata->writer_guid = header.writer_guid;
+  metadata->sequence_number = header.sequence_number;
+  metadata->source_timestamp = header.source_timestamp;
+  metadata->flags = header.flags;
+  return true;
+}
+
+auto NowNanoseconds() -> int64_t {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace tiny_dds::core
@@ -0,0 +1,85 @@
+#ifndef TINY_DDS_CORE_SAMPLE_HEADER_H_
+#define TINY_DDS_CORE_SAMPLE_HEADER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "include/tiny_dds/types.h"
+
+namespace tiny_dds {
+namespace core {
+
+/**
+ * @brief What a reader learns about a sample from its writer.
+ */
+struct SampleMetadata {
+  // Writer that produced the sample, all zero if unknown
+  Guid writer_guid;
+
+  // Writer's sequence number for the sample, starting at 1, or 0 if unknown
+  uint64_t sequence_number = 0;
+
+  // Time of the write in nanoseconds since the Unix epoch, or 0 if unknown
+  int64_t source_timestamp = 0;
+
+  // Combination of the flags below
+  uint32_t flags = 0;
+
+  // The sample is resent from a durable writer's history for late joiners
+  static constexpr uint32_t REPLAYED = 1u << 0;
+
+  // Last sample of a replay
+  static constexpr uint32_t END_OF_REPLAY = 1u << 1;
+
+  // Heartbeat without payload asserting the writer's liveliness; never queued
+  static constexpr uint32_t LIVELINESS = 1u << 2;
+};
+
+/**
+ * @brief Header a DataWriter puts in front of every sample it sends over a transport.
+ *
+ * The header travels inside the transport's payload, so every transport and the
+ * sample coalescer carry it unchanged. Layout (host byte order, like the
+ * transport headers), 40 bytes:
+ *   magic | flags | writer_guid | sequence_number | source_timestamp
+ */
+struct SampleHeader {
+  uint32_t magic;            // Identifies samples written by a DataWriter
+  uint32_t flags;            // SampleMetadata flags
+  Guid writer_guid;          // Writer that produced the sample
+  uint64_t sequence_number;  // Writer's sequence number for the sample
+  int64_t source_timestamp;  // Time of the write in nanoseconds since the Unix epoch
+
+  // Magic number for sample headers
+  static constexpr uint32_t MAGIC_NUMBER = 0x48534454;  // "TDSH" in ASCII
+};
+
+static_assert(sizeof(SampleHeader) == 40, "SampleHeader is part of the wire format");
+
+/**
+ * @brief Writes the header for a sample.
+ * @param metadata The metadata to encode.
+ * @param buffer Destination of at least sizeof(SampleHeader) bytes.
+ */
+void EncodeSampleHeader(const SampleMetadata& metadata, void* buffer);
+
+/**
+ * @brief Reads the header in front of a received sample.
+ * @param data Pointer to the received data.
+ * @param size Size of the received data in bytes.
+ * @param[out] metadata The decoded metadata.
+ * @return True if the data starts with a sample header, false if it was sent
+ *         without one, in which case the whole data is the payload.
+ */
+auto DecodeSampleHeader(const void* data, size_t size, SampleMetadata* metadata) -> bool;
+
+/**
+ * @brief Gets the current time as stored in sample timestamps.
+ * @return Nanoseconds since the Unix epoch.
+ */
+auto NowNanoseconds() -> int64_t;
+
+}  // namespace core
+}  // namespace tiny_dds
+
+#endif  // TINY_DDS_CORE_SAMPLE_HEADER_H_
@@ -0,0 +1,174 @@
+#include "src/core/sample_history.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "src/core/buffer_pool.h"
+
+namespace tiny_dds::core {
+
+SampleHistory::SampleHistory(const HistoryQos& qos)
+    : keep_last_(qos.kind == HistoryKind::KEEP_LAST), slot_size_(qos.slot_size) {
+  const int32_t capacity = keep_last_ ? qos.depth : qos.max_samples;
+  slots_.resize(static_cast<size_t>(std::max(capacity, 1)));
+  if (slot_size_ > 0) {
+    slab_.reset(new uint8_t[slots_.size() * slot_size_]);
+    for (size_t i = 0; i < slots_.size(); ++i) {
+      slots_[i].storage = slab_.get() + i * slot_size_;
+    }
+  }
+}
+
+SampleHistory::~SampleHistory() {
+  for (auto& slot : slots_) {
+    Clear(slot);
+  }
+}
+
+auto SampleHistory::PushCopy(const void* data, size_t size, const SampleInfo& info) -> bool {
+  Slot* slot = Reserve();
+  if (slot == nullptr) {
+    return false;
+  }
+
+  uint8_t* storage = slot->storage;
+  if (size > slot_size_) {
+    slot->spilled = BufferPool::Instance().Allocate(size);
+    storage = slot->spilled;
+  }
+
+  if (size > 0) {
+    std::memcpy(storage, data, size);
+  }
+  slot->size = size;
+  slot->info = info;
+  return true;
+}
+
+auto SampleHistory::PushShared(const LocalSample& sample, const SampleInfo& info) -> bool {
+  Slot* slot = Reserve();
+  if (slot == nullptr) {
+    return false;
+  }
+
+  slot->shared_data = sample.data;
+  slot->message = sample.message;
+  slot->size = sample.size;
+  slot->info = info;
+  return true;
+}
+
+auto SampleHistory::At(size_t index) const -> SampleView {
+  const Slot& slot = SlotAt(index);
+
+  SampleView view;
+  view.message = slot.message.get();
+  view.size = slot.size;
+  if (slot.shared_data) {
+    view.data = slot.shared_data.get();
+  } else if (slot.spilled != nullptr) {
+    view.data = slot.spilled;
+  } else if (!slot.message) {
+    view.data = slot.storage;
+  }
+  return view;
+}
+
+auto SampleHistory::CopyTo(size_t index, void* buffer, size_t buffer_size) const -> int32_t {
+  SampleView sample = At(index);
+
+  // Samples from typed LOCAL_ONLY writes are serialized on demand
+  const bool serialize = sample.data == nullptr && sample.message != nullptr;
+  const size_t size = serialize ? sample.message->ByteSizeLong() : sample.size;
+  if (size > buffer_size) {
+    return -1;
+  }
+
+  if (serialize) {
+    sample.message->SerializeToArray(buffer, static_cast<int>(size));
+  } else if (size > 0) {
+    std::memcpy(buffer, sample.data, size);
+  }
+  return static_cast<int32_t>(size);
+}
+
+auto SampleHistory::Find(uint64_t serial) const -> size_t {
+  // Samples are stored in serial order and removing some keeps the order
+  size_t low = 0;
+  size_t high = count_;
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    if (SlotAt(middle).serial < serial) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low < count_ && SlotAt(low).serial == serial ? low : count_;
+}
+
+void SampleHistory::MarkRead(size_t end) { read_count_ = std::max(read_count_, end); }
+
+void SampleHistory::Remove(size_t first, size_t count) {
+  for (size_t i = first; i < first + count; ++i) {
+    Clear(SlotAt(i));
+  }
+
+  // Slide the samples in front of the range up to close the gap; slots carry
+  // their inline storage, so this swaps pointers rather than payloads
+  for (size_t i = first; i > 0; --i) {
+    std::swap(SlotAt(i - 1), SlotAt(i - 1 + count));
+  }
+
+  const size_t removed_read = first < read_count_ ? std::min(count, read_count_ - first) : 0;
+  read_count_ -= removed_read;
+  head_ = (head_ + count) % slots_.size();
+  count_ -= count;
+}
+
+auto SampleHistory::TakeInto(void* buffer, size_t buffer_size) -> int32_t {
+  if (Empty()) {
+    return -1;
+  }
+
+  int32_t size = CopyTo(0, buffer, buffer_size);
+  if (size >= 0) {
+    Pop();
+  }
+  return size;
+}
+
+void SampleHistory::Select(SampleStateMask sample_states, size_t* begin, size_t* end) const {
+  *begin = (sample_states & READ_SAMPLE_STATE) != 0 ? 0 : read_count_;
+  *end = (sample_states & NOT_READ_SAMPLE_STATE) != 0 ? count_ : read_count_;
+  if (*end < *begin) {
+    *end = *begin;
+  }
+}
+
+auto SampleHistory::Reserve() -> Slot* {
+  if (count_ == slots_.size()) {
+    ++dropped_count_;
+    if (!keep_last_) {
+      return nullptr;
+    }
+    Pop();
+  }
+
+  Slot& slot = slots_[(head_ + count_) % slots_.size()];
+  slot.serial = next_serial_++;
+  ++count_;
+  return &slot;
+}
+
+void SampleHistory::Clear(Slot& slot) {
+  if (slot.spilled != nullptr) {
+    BufferPool::Instance().Release(slot.spilled, slot.size);
+    slot.spilled = nullptr;
+  }
+  slot.shared_data.reset();
+  slot.message.reset();
+  slot.size = 0;
+}
+
+}  // namespace tiny_dds::core
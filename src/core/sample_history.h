@@ -0,0 +1,257 @@
+#ifndef TINY_DDS_CORE_SAMPLE_HISTORY_H_
+#define TINY_DDS_CORE_SAMPLE_HISTORY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "google/protobuf/message.h"
+#include "include/tiny_dds/types.h"
+#include "src/core/intra_process_bus.h"
+
+namespace tiny_dds {
+namespace core {
+
+/**
+ * @brief Bounded queue of the samples a DataReader keeps until they are taken.
+ *
+ * The history is a ring of slots allocated once, at construction, from the
+ * reader's HistoryQos. Each slot owns slot_size bytes of one contiguous slab;
+ * samples that fit are copied there, larger ones into a buffer from the
+ * BufferPool that is returned when the sample is taken. Samples shared by
+ * LOCAL_ONLY writers are referenced, not copied. Once warm, storing and taking
+ * samples does not allocate.
+ *
+ * With KEEP_LAST a full history replaces its oldest sample; with KEEP_ALL it
+ * rejects the new one. The history is not thread-safe; the reader locks it.
+ *
+ * Samples are addressed by index, oldest first. Samples the application has
+ * read always form a prefix of the history: reads mark the oldest samples of a
+ * state, and takes remove them. Every sample state filter therefore selects a
+ * contiguous range of indices. Indices shift as samples are removed; serial
+ * numbers do not, and find a sample again in logarithmic time.
+ */
+class SampleHistory {
+ public:
+  /**
+   * @brief A sample of the history.
+   */
+  struct SampleView {
+    // Serialized payload, or null if the sample only carries a message object
+    const void* data = nullptr;
+
+    // Size of the serialized payload in bytes
+    size_t size = 0;
+
+    // Message object from a typed LOCAL_ONLY write, or null
+    const google::protobuf::Message* message = nullptr;
+  };
+
+  /**
+   * @brief Constructor, allocates every slot.
+   * @param qos The history QoS of the reader.
+   */
+  explicit SampleHistory(const HistoryQos& qos);
+
+  /**
+   * @brief Destructor, returns spilled buffers to the pool.
+   */
+  ~SampleHistory();
+
+  SampleHistory(const SampleHistory&) = delete;
+  SampleHistory& operator=(const SampleHistory&) = delete;
+
+  /**
+   * @brief Stores a copy of a serialized sample.
+   * @param data Pointer to the serialized sample.
+   * @param size Size of the serialized sample in bytes.
+   * @param info Information returned with the sample.
+   * @return True if the sample was stored, false if a KEEP_ALL history is full.
+   */
+  auto PushCopy(const void* data, size_t size, const SampleInfo& info = SampleInfo()) -> bool;
+
+  /**
+   * @brief Stores a shared sample by reference.
+   * @param sample The sample; its payload or message is shared, not copied.
+   * @param info Information returned with the sample.
+   * @return True if the sample was stored, false if a KEEP_ALL history is full.
+   */
+  auto PushShared(const LocalSample& sample, const SampleInfo& info = SampleInfo()) -> bool;
+
+  /**
+   * @brief Gets a sample.
+   * @param index The index of the sample, which must be less than Size().
+   * @return A view that stays valid until the sample is removed.
+   */
+  auto At(size_t index) const -> SampleView;
+
+  /**
+   * @brief Gets the information stored with a sample.
+   * @param index The index of the sample, which must be less than Size().
+   * @return The information passed when the sample was stored.
+   */
+  auto Info(size_t index) const -> const SampleInfo& { return SlotAt(index).info; }
+
+  /**
+   * @brief Gets the serial number of a sample, which increases with every sample stored.
+   * @param index The index of the sample, which must be less than Size().
+   * @return The serial number, starting at 1.
+   */
+  auto Serial(size_t index) const -> uint64_t { return SlotAt(index).serial; }
+
+  /**
+   * @brief Finds a sample by its serial number.
+   * @param serial The serial number of the sample.
+   * @return The index of the sample, or Size() if it was removed.
+   */
+  auto Find(uint64_t serial) const -> size_t;
+
+  /**
+   * @brief Gets the oldest sample; the history must not be empty.
+   * @return A view that stays valid until the sample is removed.
+   */
+  auto Front() const -> SampleView { return At(0); }
+
+  /**
+   * @brief Copies a sample into a buffer, serializing message samples.
+   * @param index The index of the sample, which must be less than Size().
+   * @param buffer Buffer to store the data.
+   * @param buffer_size Size of the buffer.
+   * @return Number of bytes copied, or -1 if the buffer is too small.
+   */
+  auto CopyTo(size_t index, void* buffer, size_t buffer_size) const -> int32_t;
+
+  /**
+   * @brief Marks the samples before an index as read.
+   * @param end One past the index of the last sample read.
+   */
+  void MarkRead(size_t end);
+
+  /**
+   * @brief Removes a contiguous range of samples.
+   * @param first The index of the first sample to remove.
+   * @param count The number of samples to remove.
+   */
+  void Remove(size_t first, size_t count);
+
+  /**
+   * @brief Removes the oldest sample; the history must not be empty.
+   */
+  void Pop() { Remove(0, 1); }
+
+  /**
+   * @brief Copies the oldest sample into a buffer and removes it.
+   * @param buffer Buffer to store the data.
+   * @param buffer_size Size of the buffer.
+   * @return Number of bytes copied, or -1 if the history is empty or the buffer too small.
+   */
+  auto TakeInto(void* buffer, size_t buffer_size) -> int32_t;
+
+  /**
+   * @brief Gets the range of indices holding samples in the given states.
+   * @param sample_states A combination of the *_SAMPLE_STATE constants.
+   * @param[out] begin The index of the first matching sample.
+   * @param[out] end One past the index of the last matching sample.
+   */
+  void Select(SampleStateMask sample_states, size_t* begin, size_t* end) const;
+
+  /**
+   * @brief Gets the number of samples the application has read.
+   * @return The number of read samples, which are the oldest ones.
+   */
+  auto ReadCount() const -> size_t { return read_count_; }
+
+  /**
+   * @brief Checks whether the history holds no samples.
+   * @return True if the history is empty.
+   */
+  auto Empty() const -> bool { return count_ == 0; }
+
+  /**
+   * @brief Gets the number of samples held.
+   * @return The number of samples.
+   */
+  auto Size() const -> size_t { return count_; }
+
+  /**
+   * @brief Gets the maximum number of samples held.
+   * @return The number of slots.
+   */
+  auto Capacity() const -> size_t { return slots_.size(); }
+
+  /**
+   * @brief Gets the number of samples replaced (KEEP_LAST) or rejected (KEEP_ALL).
+   * @return The number of samples lost to a full history.
+   */
+  auto GetDroppedCount() const -> uint64_t { return dropped_count_; }
+
+ private:
+  // One stored sample
+  struct Slot {
+    // Inline storage of slot_size bytes in the slab; it moves with the slot
+    uint8_t* storage = nullptr;
+
+    // Size of the serialized payload in bytes
+    size_t size = 0;
+
+    // Pooled buffer holding a payload larger than slot_size, or null
+    uint8_t* spilled = nullptr;
+
+    // Payload shared with a LOCAL_ONLY writer, or null
+    std::shared_ptr<const void> shared_data;
+
+    // Message object from a typed LOCAL_ONLY write, or null
+    std::shared_ptr<const google::protobuf::Message> message;
+
+    // Information returned with the sample
+    SampleInfo info;
+
+    // Serial number of the sample; serials increase from the oldest sample on
+    uint64_t serial = 0;
+  };
+
+  // Makes room for one sample; returns the slot to fill, or null if it must be rejected
+  auto Reserve() -> Slot*;
+
+  // Returns the slot of a sample index
+  auto SlotAt(size_t index) -> Slot& { return slots_[(head_ + index) % slots_.size()]; }
+  auto SlotAt(size_t index) const -> const Slot& {
+    return slots_[(head_ + index) % slots_.size()];
+  }
+
+  // Releases whatever a slot refers to
+  static void Clear(Slot& slot);
+
+  // Whether a full history replaces its oldest sample
+  bool keep_last_;
+
+  // Inline bytes per slot
+  size_t slot_size_;
+
+  // Inline storage of all slots
+  std::unique_ptr<uint8_t[]> slab_;
+
+  // Ring of slots
+  std::vector<Slot> slots_;
+
+  // Index of the oldest sample
+  size_t head_ = 0;
+
+  // Number of samples held
+  size_t count_ = 0;
+
+  // Number of samples, from the oldest, that the application has read
+  size_t read_count_ = 0;
+
+  // Number of samples lost to a full history
+  uint64_t dropped_count_ = 0;
+
+  // Serial number of the next sample stored
+  uint64_t next_serial_ = 1;
+};
+
+}  // namespace core
+}  // namespace tiny_dds
+
+#endif  // TINY_DDS_CORE_SAMPLE_HISTORY_H_
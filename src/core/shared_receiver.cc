@@ -0,0 +1,113 @@
+#include "src/core/shared_receiver.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "src/core/buffer_pool.h"
+
+namespace tiny_dds::core {
+
+auto SharedReceiver::Join(const std::shared_ptr<TransportEndpoint>& endpoint, uint64_t* reader_id)
+    -> std::shared_ptr<SharedReceiver> {
+  std::shared_ptr<SharedReceiver> receiver;
+  {
+    absl::MutexLock lock(&RegistryMutex());
+
+    Key key(endpoint->GetTransport().get(), endpoint->GetTopicName());
+    std::weak_ptr<SharedReceiver>& entry = Registry()[key];
+    receiver = entry.lock();
+    if (!receiver) {
+      receiver = std::shared_ptr<SharedReceiver>(new SharedReceiver(std::move(key), endpoint));
+      entry = receiver;
+    }
+  }
+
+  absl::MutexLock lock(&receiver->mutex_);
+  *reader_id = receiver->next_reader_id_++;
+  receiver->readers_.push_back(Reader{*reader_id, {}});
+  return receiver;
+}
+
+SharedReceiver::SharedReceiver(Key key, std::shared_ptr<TransportEndpoint> endpoint)
+    : key_(std::move(key)), endpoint_(std::move(endpoint)) {}
+
+SharedReceiver::~SharedReceiver() {
+  absl::MutexLock lock(&RegistryMutex());
+
+  // A reader may already have opened a new receiver for the topic
+  auto it = Registry().find(key_);
+  if (it != Registry().end() && it->second.expired()) {
+    Registry().erase(it);
+  }
+}
+
+void SharedReceiver::Leave(uint64_t reader_id) {
+  absl::MutexLock lock(&mutex_);
+  auto is_leaving = [reader_id](const Reader& reader) { return reader.id == reader_id; };
+  readers_.erase(std::remove_if(readers_.begin(), readers_.end(), is_leaving), readers_.end());
+}
+
+auto SharedReceiver::Receive(uint64_t reader_id, std::vector<uint8_t>* buffer, Frame* frame)
+    -> bool {
+  absl::MutexLock lock(&mutex_);
+
+  auto self = std::find_if(readers_.begin(), readers_.end(),
+                           [reader_id](const Reader& reader) { return reader.id == reader_id; });
+  if (self == readers_.end()) {
+    return false;
+  }
+
+  if (!self->pending.empty()) {
+    *frame = std::move(self->pending.front());
+    self->pending.pop_front();
+    return true;
+  }
+
+  // Transports keep a sample larger than the buffer and report its size
+  size_t bytes_received = 0;
+  if (!endpoint_->Receive(buffer->data(), buffer->size(), &bytes_received)) {
+    if (bytes_received <= buffer->size()) {
+      return false;
+    }
+    buffer->resize(bytes_received);
+    if (!endpoint_->Receive(buffer->data(), buffer->size(), &bytes_received)) {
+      return false;
+    }
+  }
+
+  frame->size = bytes_received;
+  if (readers_.size() == 1) {
+    frame->data = buffer->data();
+    frame->buffer.reset();
+    return true;
+  }
+
+  // The sample is copied once, and every other reader gets a handle to the copy
+  std::shared_ptr<uint8_t> shared = BufferPool::Instance().AllocateShared(bytes_received);
+  std::memcpy(shared.get(), buffer->data(), bytes_received);
+  frame->data = shared.get();
+  frame->buffer = std::move(shared);
+
+  for (Reader& reader : readers_) {
+    if (reader.id == reader_id) {
+      continue;
+    }
+    if (reader.pending.size() >= kMaxPendingFrames) {
+      reader.pending.pop_front();
+    }
+    reader.pending.push_back(*frame);
+  }
+  return true;
+}
+
+auto SharedReceiver::Registry() -> absl::flat_hash_map<Key, std::weak_ptr<SharedReceiver>>& {
+  static auto* registry = new absl::flat_hash_map<Key, std::weak_ptr<SharedReceiver>>();
+  return *registry;
+}
+
+auto SharedReceiver::RegistryMutex() -> absl::Mutex& {
+  static auto* mutex = new absl::Mutex();
+  return *mutex;
+}
+
+}  // namespace tiny_dds::core
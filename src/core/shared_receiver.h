@@ -0,0 +1,131 @@
+#ifndef TINY_DDS_CORE_SHARED_RECEIVER_H_
+#define TINY_DDS_CORE_SHARED_RECEIVER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "include/tiny_dds/transport.h"
+
+namespace tiny_dds {
+namespace core {
+
+/**
+ * @brief Receives a network topic once for all DataReaders of this process.
+ *
+ * The transports of a process are shared by all its participants, so readers of
+ * the same topic would otherwise take turns at one socket or shared memory
+ * queue. The readers of a topic share one receiver instead: the reader that
+ * finds the next sample copies it once into a reference-counted buffer from the
+ * BufferPool, and queues a handle to it for each of the other readers, which
+ * store the handle in their history. The buffer returns to the pool once every
+ * reader has taken or dropped the sample.
+ *
+ * A reader alone on its topic receives into its own buffer, as before.
+ */
+class SharedReceiver {
+ public:
+  /**
+   * @brief A received sample, as raw transport bytes.
+   */
+  struct Frame {
+    // Pointer to the received bytes
+    const void* data = nullptr;
+
+    // Number of received bytes
+    size_t size = 0;
+
+    // Buffer holding the bytes if other readers hold them too, or null if they
+    // are in the buffer passed to Receive
+    std::shared_ptr<const void> buffer;
+  };
+
+  /**
+   * @brief Registers a reader with the receiver of its endpoint's topic.
+   * @param endpoint The reader's endpoint; the receiver of a new topic receives from it.
+   * @param reader_id Set to the identifier of the reader within the receiver.
+   * @return The receiver shared by the readers of the topic.
+   */
+  static auto Join(const std::shared_ptr<TransportEndpoint>& endpoint, uint64_t* reader_id)
+      -> std::shared_ptr<SharedReceiver>;
+
+  /**
+   * @brief Destructor, removes the receiver from the registry.
+   */
+  ~SharedReceiver();
+
+  SharedReceiver(const SharedReceiver&) = delete;
+  SharedReceiver& operator=(const SharedReceiver&) = delete;
+
+  /**
+   * @brief Unregisters a reader; the samples queued for it are dropped.
+   * @param reader_id The reader's identifier from Join.
+   */
+  void Leave(uint64_t reader_id);
+
+  /**
+   * @brief Receives the next sample for a reader.
+   *
+   * Samples other readers received first are returned before the transport is
+   * polled again.
+   *
+   * @param reader_id The reader's identifier from Join.
+   * @param buffer Buffer to receive into; it grows to fit samples larger than it.
+   * @param frame Set to the received sample.
+   * @return true if a sample was received, false otherwise.
+   */
+  auto Receive(uint64_t reader_id, std::vector<uint8_t>* buffer, Frame* frame) -> bool;
+
+  /**
+   * @brief Maximum number of samples queued for a reader; older ones are dropped.
+   */
+  static constexpr size_t kMaxPendingFrames = 4096;
+
+ private:
+  using Key = std::pair<const Transport*, std::string>;
+
+  // A reader sharing the receiver and the samples waiting for it
+  struct Reader {
+    uint64_t id;
+    std::deque<Frame> pending;
+  };
+
+  /**
+   * @brief Constructor.
+   * @param key The transport and topic received.
+   * @param endpoint The endpoint to receive from.
+   */
+  SharedReceiver(Key key, std::shared_ptr<TransportEndpoint> endpoint);
+
+  // Returns the registry of receivers by transport and topic; the caller holds RegistryMutex()
+  static auto Registry() -> absl::flat_hash_map<Key, std::weak_ptr<SharedReceiver>>&;
+
+  // Returns the mutex guarding the registry
+  static auto RegistryMutex() -> absl::Mutex&;
+
+  // The transport and topic received
+  const Key key_;
+
+  // Endpoint of the reader that opened the receiver
+  const std::shared_ptr<TransportEndpoint> endpoint_;
+
+  // Registered readers
+  std::vector<Reader> readers_;
+
+  // Identifier of the next reader to join
+  uint64_t next_reader_id_ = 1;
+
+  // Mutex for thread safety; readers take it while holding their own lock
+  absl::Mutex mutex_;
+};
+
+}  // namespace core
+}  // namespace tiny_dds
+
+#endif  // TINY_DDS_CORE_SHARED_RECEIVER_H_
@@ -1,8 +1,13 @@
 #include "src/core/subscriber_impl.h"
 
+#include "include/tiny_dds/data_writer.h"
+#include "include/tiny_dds/publisher.h"
 #include "src/core/data_reader_impl.h"
 #include "src/core/domain_participant_impl.h"
+#include "src/core/intra_process_bus.h"
+#include "src/core/receive_dispatcher.h"
 #include "src/core/topic_impl.h"
+#include "src/core/writer_history.h"
 
 namespace tiny_dds {
 namespace core {
@@ -19,6 +24,16 @@ SubscriberImpl::~SubscriberImpl() {
 }
 
 std::shared_ptr<DataReader> SubscriberImpl::CreateDataReader(std::shared_ptr<Topic> topic) {
+  DataReaderQos qos;
+  {
+    absl::MutexLock lock(&mutex_);
+    qos = default_data_reader_qos_;
+  }
+  return CreateDataReader(std::move(topic), qos);
+}
+
+std::shared_ptr<DataReader> SubscriberImpl::CreateDataReader(std::shared_ptr<Topic> topic,
+                                                             const DataReaderQos& qos) {
   // Store the participant pointer locally to avoid locking during DataReaderImpl construction
   std::shared_ptr<DomainParticipantImpl> participant;
   {
@@ -26,8 +41,14 @@ std::shared_ptr<DataReader> SubscriberImpl::CreateDataReader(std::shared_ptr<Top
     participant = participant_;
   }
 
+  // Readers of a content-filtered topic are matched with the writers of the related topic
+  std::string topic_name = topic->GetName();
+  if (auto filtered_topic = std::dynamic_pointer_cast<ContentFilteredTopic>(topic)) {
+    topic_name = filtered_topic->GetRelatedTopic()->GetName();
+  }
+
   // Create a new data reader
-  auto data_reader = std::make_shared<DataReaderImpl>(topic, shared_from_this());
+  auto data_reader = std::make_shared<DataReaderImpl>(topic, shared_from_this(), qos);
 
   // Add it to our map
   {
@@ -35,9 +56,34 @@ std::shared_ptr<DataReader> SubscriberImpl::CreateDataReader(std::shared_ptr<Top
     data_readers_[topic->GetName()] = data_reader;
   }
 
+  // LOCAL_ONLY readers are matched with writers in this process through the bus
+  // and other readers are fed by the participant's receive thread
+  if (participant->GetTransportType() == TransportType::LOCAL_ONLY) {
+    IntraProcessBus::Instance().AddReader(participant->GetDomainId(), topic_name, data_reader);
+  } else {
+    participant->GetReceiveDispatcher()->AddReader(data_reader);
+
+    // Writers that published before this reader joined replay their history
+    // on the topic when asked on its companion topic
+    if (qos.durability != DurabilityKind::VOLATILE) {
+      auto request_topic = participant->CreateTopic(HistoryRequestTopicName(topic_name),
+                                                    kHistoryRequestTypeName);
+      if (request_topic) {
+        const HistoryRequest request{qos.replay_from_sequence_number, qos.replay_from_timestamp};
+        participant->CreatePublisher()->CreateDataWriter(request_topic)->Write(&request,
+                                                                               sizeof(request));
+      }
+    }
+  }
+
   return data_reader;
 }
 
+void SubscriberImpl::SetDefaultDataReaderQos(const DataReaderQos& qos) {
+  absl::MutexLock lock(&mutex_);
+  default_data_reader_qos_ = qos;
+}
+
 std::shared_ptr<DomainParticipantImpl> SubscriberImpl::GetParticipant() const {
   absl::MutexLock lock(&mutex_);
   return participant_;
@@ -42,6 +42,21 @@ class SubscriberImpl : public tiny_dds::Subscriber,
   std::shared_ptr<tiny_dds::DataReader> CreateDataReader(
       std::shared_ptr<tiny_dds::Topic> topic) override;
 
+  /**
+   * @brief Creates a DataReader for a specific topic with the given QoS.
+   * @param topic The topic to subscribe to.
+   * @param qos The QoS of the DataReader.
+   * @return A shared pointer to the created DataReader.
+   */
+  std::shared_ptr<tiny_dds::DataReader> CreateDataReader(
+      std::shared_ptr<tiny_dds::Topic> topic, const tiny_dds::DataReaderQos& qos) override;
+
+  /**
+   * @brief Sets the QoS of DataReaders later created without one.
+   * @param qos The default QoS.
+   */
+  void SetDefaultDataReaderQos(const tiny_dds::DataReaderQos& qos) override;
+
   /**
    * @brief Gets the domain participant that created this subscriber.
    * @return A shared pointer to the domain participant.
@@ -55,6 +70,9 @@ class SubscriberImpl : public tiny_dds::Subscriber,
   // Map of data readers by topic name
   absl::flat_hash_map<std::string, std::shared_ptr<DataReaderImpl>> data_readers_;
 
+  // QoS of data readers created without one
+  tiny_dds::DataReaderQos default_data_reader_qos_;
+
   // Mutex for thread safety
   mutable absl::Mutex mutex_;
 };
@@ -0,0 +1,223 @@
+#include "src/core/timing_wheel.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace tiny_dds::core {
+
+TimingWheel::TimingWheel(std::chrono::nanoseconds tick)
+    : tick_(std::max(tick, std::chrono::nanoseconds(1))),
+      start_(std::chrono::steady_clock::now()) {
+  slots_.fill(kNil);
+}
+
+auto TimingWheel::Add(std::function<void()> callback) -> TimerId {
+  absl::MutexLock lock(&mutex_);
+  return AddLocked(std::move(callback), false);
+}
+
+void TimingWheel::Arm(TimerId timer, std::chrono::steady_clock::time_point due) {
+  absl::MutexLock lock(&mutex_);
+  if (timer == kNoTimer || timer > nodes_.size() || !nodes_[timer - 1].callback) {
+    return;
+  }
+  ArmLocked(timer - 1, due);
+}
+
+void TimingWheel::Cancel(TimerId timer) {
+  absl::MutexLock lock(&mutex_);
+  if (timer == kNoTimer || timer > nodes_.size() || nodes_[timer - 1].slot == kNil) {
+    return;
+  }
+  UnlinkLocked(timer - 1);
+  --armed_count_;
+  UpdateNextTickLocked();
+}
+
+void TimingWheel::Remove(TimerId timer) {
+  absl::MutexLock lock(&mutex_);
+  if (timer == kNoTimer || timer > nodes_.size() || !nodes_[timer - 1].callback) {
+    return;
+  }
+  const uint32_t index = timer - 1;
+  if (nodes_[index].slot != kNil) {
+    UnlinkLocked(index);
+    --armed_count_;
+    UpdateNextTickLocked();
+  }
+  nodes_[index].callback = nullptr;
+  free_nodes_.push_back(index);
+}
+
+void TimingWheel::Schedule(std::chrono::steady_clock::time_point due,
+                           std::function<void()> task) {
+  absl::MutexLock lock(&mutex_);
+  ArmLocked(AddLocked(std::move(task), true) - 1, due);
+}
+
+auto TimingWheel::Advance(std::chrono::steady_clock::time_point now) -> size_t {
+  std::vector<std::function<void()>> callbacks;
+  {
+    absl::MutexLock lock(&mutex_);
+    if (now < start_) {
+      return 0;
+    }
+
+    const auto last_tick = static_cast<uint64_t>((now - start_) / tick_);
+    while (armed_count_ > 0 && current_tick_ <= last_tick) {
+      // Each time a wheel wraps, the next slot of the level above moves down
+      const size_t index = current_tick_ & (kSlots - 1);
+      if (index == 0) {
+        for (size_t level = 1; level < kLevels; ++level) {
+          const size_t slot = (current_tick_ >> (kSlotBits * level)) & (kSlots - 1);
+          CascadeLocked(level, slot);
+          if (slot != 0) {
+            break;
+          }
+        }
+      }
+
+      uint32_t node_index = slots_[index];
+      while (node_index != kNil) {
+        Node& node = nodes_[node_index];
+        const uint32_t next = node.next;
+        UnlinkLocked(node_index);
+        --armed_count_;
+        if (node.one_shot) {
+          callbacks.push_back(std::move(node.callback));
+          node.callback = nullptr;
+          free_nodes_.push_back(node_index);
+        } else {
+          callbacks.push_back(node.callback);
+        }
+        node_index = next;
+      }
+      ++current_tick_;
+    }
+
+    // An empty wheel skips the ticks nothing is due in
+    if (armed_count_ == 0) {
+      current_tick_ = std::max(current_tick_, last_tick + 1);
+    }
+    UpdateNextTickLocked();
+  }
+
+  // Callbacks may arm timers, so they run without the lock
+  for (auto& callback : callbacks) {
+    callback();
+  }
+  return callbacks.size();
+}
+
+auto TimingWheel::ArmedCount() const -> size_t {
+  absl::MutexLock lock(&mutex_);
+  return armed_count_;
+}
+
+auto TimingWheel::TickAt(std::chrono::steady_clock::time_point time) const -> uint64_t {
+  if (time <= start_) {
+    return 0;
+  }
+  const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(time - start_);
+  return static_cast<uint64_t>((elapsed + tick_ - std::chrono::nanoseconds(1)) / tick_);
+}
+
+auto TimingWheel::AddLocked(std::function<void()> callback, bool one_shot) -> TimerId {
+  uint32_t index = 0;
+  if (free_nodes_.empty()) {
+    index = static_cast<uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+  } else {
+    index = free_nodes_.back();
+    free_nodes_.pop_back();
+  }
+
+  Node& node = nodes_[index];
+  node.callback = std::move(callback);
+  node.one_shot = one_shot;
+  return index + 1;
+}
+
+void TimingWheel::ArmLocked(uint32_t index, std::chrono::steady_clock::time_point due) {
+  if (nodes_[index].slot != kNil) {
+    UnlinkLocked(index);
+  } else {
+    // The ticks of an empty wheel are not processed, so it starts turning from now
+    if (armed_count_ == 0) {
+      const auto now = std::chrono::steady_clock::now();
+      if (now > start_) {
+        current_tick_ = std::max(current_tick_, static_cast<uint64_t>((now - start_) / tick_));
+      }
+    }
+    ++armed_count_;
+  }
+
+  nodes_[index].due_tick = TickAt(due);
+  LinkLocked(index);
+  UpdateNextTickLocked();
+}
+
+void TimingWheel::LinkLocked(uint32_t index) {
+  Node& node = nodes_[index];
+
+  // Timers already due fire with the next tick
+  uint64_t due_tick = std::max(node.due_tick, current_tick_);
+  const uint64_t delta = due_tick - current_tick_;
+  size_t level = 0;
+  while (level + 1 < kLevels && delta >= (uint64_t{1} << (kSlotBits * (level + 1)))) {
+    ++level;
+  }
+
+  // Beyond the top level's reach, timers wait in the slot it visits last
+  constexpr uint64_t kReach = uint64_t{1} << (kSlotBits * kLevels);
+  if (delta >= kReach) {
+    due_tick = current_tick_ + kReach - 1;
+  }
+
+  const auto slot =
+      static_cast<uint32_t>(level * kSlots + ((due_tick >> (kSlotBits * level)) & (kSlots - 1)));
+  node.slot = slot;
+  node.prev = kNil;
+  node.next = slots_[slot];
+  if (node.next != kNil) {
+    nodes_[node.next].prev = index;
+  }
+  slots_[slot] = index;
+}
+
+void TimingWheel::UnlinkLocked(uint32_t index) {
+  Node& node = nodes_[index];
+  if (node.prev != kNil) {
+    nodes_[node.prev].next = node.next;
+  } else {
+    slots_[node.slot] = node.next;
+  }
+  if (node.next != kNil) {
+    nodes_[node.next].prev = node.prev;
+  }
+  node.prev = kNil;
+  node.next = kNil;
+  node.slot = kNil;
+}
+
+void TimingWheel::CascadeLocked(size_t level, size_t slot) {
+  uint32_t index = slots_[level * kSlots + slot];
+  slots_[level * kSlots + slot] = kNil;
+  while (index != kNil) {
+    const uint32_t next = nodes_[index].next;
+    LinkLocked(index);
+    index = next;
+  }
+}
+
+void TimingWheel::UpdateNextTickLocked() {
+  if (armed_count_ == 0) {
+    next_tick_.store(INT64_MAX, std::memory_order_release);
+    return;
+  }
+  const auto next_tick = start_ + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                      tick_ * static_cast<int64_t>(current_tick_));
+  next_tick_.store(next_tick.time_since_epoch().count(), std::memory_order_release);
+}
+
+}  // namespace tiny_dds::core
@@ -0,0 +1,184 @@
+#ifndef TINY_DDS_CORE_TIMING_WHEEL_H_
+#define TINY_DDS_CORE_TIMING_WHEEL_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+
+namespace tiny_dds {
+namespace core {
+
+/**
+ * @brief Hierarchical timing wheel running callbacks once points in time have passed.
+ *
+ * Time is cut into ticks. Timers are kept in kLevels wheels of kSlots slots;
+ * a slot of level n spans kSlots^n ticks, and a timer is put in the lowest
+ * level whose wheel reaches its due tick. As the wheel turns into a slot of a
+ * higher level, the slot's timers are moved down (cascaded) to lower levels.
+ * Timers due further than the top level reaches wait in its last slot and are
+ * placed again when cascaded.
+ *
+ * Each slot is an intrusive list of timers, so arming, re-arming and
+ * cancelling a timer cost the same however many timers are armed. Timers are
+ * added once with their callback and armed any number of times, which does not
+ * allocate. Advancing costs one slot per elapsed tick, plus the cascades.
+ *
+ * Callbacks run on the thread that advances the wheel, without the lock held,
+ * so they may arm timers. A timer never fires before it is due, and fires at
+ * most one tick later on a wheel advanced at least once per tick.
+ *
+ * All methods are thread-safe.
+ */
+class TimingWheel {
+ public:
+  // Identifies a timer added to the wheel
+  using TimerId = uint32_t;
+
+  // Never the identifier of a timer
+  static constexpr TimerId kNoTimer = 0;
+
+  // Slots of each level's wheel
+  static constexpr size_t kSlotBits = 6;
+  static constexpr size_t kSlots = size_t{1} << kSlotBits;
+
+  // Number of levels; with 1ms ticks, the top level reaches 4.6 hours ahead
+  static constexpr size_t kLevels = 4;
+
+  /**
+   * @brief Constructor.
+   * @param tick Length of a tick, the precision of the timers.
+   */
+  explicit TimingWheel(std::chrono::nanoseconds tick = std::chrono::milliseconds(1));
+
+  TimingWheel(const TimingWheel&) = delete;
+  TimingWheel& operator=(const TimingWheel&) = delete;
+
+  /**
+   * @brief Adds a timer, not armed.
+   * @param callback Called each time the timer fires; it must own everything it refers to.
+   * @return The timer's identifier.
+   */
+  auto Add(std::function<void()> callback) -> TimerId;
+
+  /**
+   * @brief Arms a timer, replacing its due time if it is already armed.
+   * @param timer The timer.
+   * @param due When the timer fires; a time that has passed fires it with the next tick.
+   */
+  void Arm(TimerId timer, std::chrono::steady_clock::time_point due);
+
+  /**
+   * @brief Disarms a timer; it stays added and can be armed again.
+   * @param timer The timer.
+   */
+  void Cancel(TimerId timer);
+
+  /**
+   * @brief Removes a timer; its identifier may be reused by a later Add.
+   * @param timer The timer.
+   */
+  void Remove(TimerId timer);
+
+  /**
+   * @brief Runs a task once, when a point in time has passed.
+   * @param due When to run the task.
+   * @param task The task; it must own everything it refers to.
+   */
+  void Schedule(std::chrono::steady_clock::time_point due, std::function<void()> task);
+
+  /**
+   * @brief Turns the wheel up to a point in time, running the callbacks of timers due by then.
+   * @param now The current time.
+   * @return The number of callbacks run.
+   */
+  auto Advance(std::chrono::steady_clock::time_point now) -> size_t;
+
+  /**
+   * @brief Checks, without locking, whether Advance has work to do.
+   * @param now The current time.
+   * @return True if a timer is armed and a tick has passed since the last Advance.
+   */
+  auto IsDue(std::chrono::steady_clock::time_point now) const -> bool {
+    return now.time_since_epoch().count() >= next_tick_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Gets the number of armed timers.
+   * @return The number of timers that have yet to fire.
+   */
+  auto ArmedCount() const -> size_t;
+
+ private:
+  // Index of no node, ending the lists
+  static constexpr uint32_t kNil = UINT32_MAX;
+
+  // A timer, linked into the list of a slot while armed
+  struct Node {
+    std::function<void()> callback;
+    uint64_t due_tick = 0;
+    uint32_t prev = kNil;
+    uint32_t next = kNil;
+
+    // Index of the slot holding the timer, or kNil while not armed
+    uint32_t slot = kNil;
+
+    // Set for tasks run by Schedule, removed once run
+    bool one_shot = false;
+  };
+
+  // Converts a point in time to the first tick at or after it
+  auto TickAt(std::chrono::steady_clock::time_point time) const -> uint64_t;
+
+  // Adds a timer, reusing the index of a removed one; the caller holds mutex_
+  auto AddLocked(std::function<void()> callback, bool one_shot) -> TimerId;
+
+  // Arms the timer at an index; the caller holds mutex_
+  void ArmLocked(uint32_t index, std::chrono::steady_clock::time_point due);
+
+  // Puts an armed timer in the slot for its due tick; the caller holds mutex_
+  void LinkLocked(uint32_t index);
+
+  // Takes a timer out of its slot; the caller holds mutex_
+  void UnlinkLocked(uint32_t index);
+
+  // Moves the timers of a slot of a higher level down; the caller holds mutex_
+  void CascadeLocked(size_t level, size_t slot);
+
+  // Publishes the time of the next tick to process for IsDue; the caller holds mutex_
+  void UpdateNextTickLocked();
+
+  // Length of a tick, and the time of tick 0
+  const std::chrono::nanoseconds tick_;
+  const std::chrono::steady_clock::time_point start_;
+
+  // Next tick to process; every earlier tick has been
+  uint64_t current_tick_ = 0;
+
+  // Timers by index, and the indices of removed ones for reuse
+  std::vector<Node> nodes_;
+  std::vector<uint32_t> free_nodes_;
+
+  // First timer of each slot's list, level by level
+  std::array<uint32_t, kLevels * kSlots> slots_;
+
+  // Number of armed timers
+  size_t armed_count_ = 0;
+
+  // Time of the next tick to process in steady clock ticks, or INT64_MAX while
+  // no timer is armed; read by IsDue without taking the lock
+  std::atomic<int64_t> next_tick_{INT64_MAX};
+
+  // Mutex for thread safety
+  mutable absl::Mutex mutex_;
+};
+
+}  // namespace core
+}  // namespace tiny_dds
+
+#endif  // TINY_DDS_CORE_TIMING_WHEEL_H_
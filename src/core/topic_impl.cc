@@ -5,10 +5,14 @@
 namespace tiny_dds::core {
 
 TopicImpl::TopicImpl(std::string topic_name, std::string type_name,
-                     std::shared_ptr<DomainParticipantImpl> participant)
+                     std::shared_ptr<DomainParticipantImpl> participant,
+                     std::vector<int32_t> key_fields,
+                     std::shared_ptr<const InstanceKey> instance_key)
     : topic_name_(std::move(topic_name)),
       type_name_(std::move(type_name)),
-      participant_(std::move(participant)) {
+      participant_(std::move(participant)),
+      key_fields_(std::move(key_fields)),
+      instance_key_(std::move(instance_key)) {
   // Initialize any resources needed for the topic
 }
 
@@ -26,9 +30,30 @@ std::string TopicImpl::GetTypeName() const {
   return type_name_;
 }
 
+std::vector<int32_t> TopicImpl::GetKeyFields() const {
+  absl::MutexLock lock(&mutex_);
+  return key_fields_;
+}
+
+std::shared_ptr<const InstanceKey> TopicImpl::GetInstanceKey() const {
+  absl::MutexLock lock(&mutex_);
+  return instance_key_;
+}
+
 std::shared_ptr<DomainParticipantImpl> TopicImpl::GetParticipant() const {
   absl::MutexLock lock(&mutex_);
   return participant_;
 }
 
+ContentFilteredTopicImpl::ContentFilteredTopicImpl(std::string topic_name,
+                                                   std::shared_ptr<Topic> related_topic,
+                                                   std::string filter_expression,
+                                                   std::vector<std::string> expression_parameters,
+                                                   std::shared_ptr<const ContentFilter> filter)
+    : topic_name_(std::move(topic_name)),
+      related_topic_(std::move(related_topic)),
+      filter_expression_(std::move(filter_expression)),
+      expression_parameters_(std::move(expression_parameters)),
+      filter_(std::move(filter)) {}
+
 }  // namespace tiny_dds::core
\ No newline at end of file
@@ -3,9 +3,12 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "absl/synchronization/mutex.h"
 #include "include/tiny_dds/topic.h"
+#include "src/core/content_filter.h"
+#include "src/core/instance_key.h"
 
 namespace tiny_dds::core {
 
@@ -22,9 +25,13 @@ class TopicImpl : public tiny_dds::Topic, public std::enable_shared_from_this<To
    * @param topic_name The name of the topic.
    * @param type_name The name of the data type.
    * @param participant The domain participant that created this topic.
+   * @param key_fields The numbers of the key fields, empty if the topic is not keyed.
+   * @param instance_key The compiled key fields, or null if the topic is not keyed.
    */
   TopicImpl(std::string topic_name, std::string type_name,
-            std::shared_ptr<DomainParticipantImpl> participant);
+            std::shared_ptr<DomainParticipantImpl> participant,
+            std::vector<int32_t> key_fields = {},
+            std::shared_ptr<const InstanceKey> instance_key = nullptr);
 
   /**
    * @brief Destructor for TopicImpl.
@@ -43,6 +50,18 @@ class TopicImpl : public tiny_dds::Topic, public std::enable_shared_from_this<To
    */
   std::string GetTypeName() const override;
 
+  /**
+   * @brief Gets the key fields of this topic.
+   * @return The numbers of the key fields, empty if the topic is not keyed.
+   */
+  std::vector<int32_t> GetKeyFields() const override;
+
+  /**
+   * @brief Gets the compiled key fields of this topic.
+   * @return The key, or null if the topic is not keyed.
+   */
+  std::shared_ptr<const InstanceKey> GetInstanceKey() const;
+
   /**
    * @brief Gets the domain participant that created this topic.
    * @return A shared pointer to the domain participant.
@@ -59,10 +78,85 @@ class TopicImpl : public tiny_dds::Topic, public std::enable_shared_from_this<To
   // The domain participant that created this topic
   std::shared_ptr<DomainParticipantImpl> participant_;
 
+  // Key fields of a keyed topic, and their compiled form
+  std::vector<int32_t> key_fields_;
+  std::shared_ptr<const InstanceKey> instance_key_;
+
   // Mutex for thread safety
   mutable absl::Mutex mutex_;
 };
 
+/**
+ * @brief Implementation of the ContentFilteredTopic interface.
+ */
+class ContentFilteredTopicImpl : public tiny_dds::ContentFilteredTopic {
+ public:
+  /**
+   * @brief Constructor for ContentFilteredTopicImpl.
+   * @param topic_name The name of the filtered topic.
+   * @param related_topic The topic whose samples are filtered.
+   * @param filter_expression The filter expression.
+   * @param expression_parameters Values of the parameters of the expression.
+   * @param filter The compiled filter expression.
+   */
+  ContentFilteredTopicImpl(std::string topic_name, std::shared_ptr<Topic> related_topic,
+                           std::string filter_expression,
+                           std::vector<std::string> expression_parameters,
+                           std::shared_ptr<const ContentFilter> filter);
+
+  /**
+   * @brief Gets the name of this topic.
+   * @return The topic name.
+   */
+  std::string GetName() const override { return topic_name_; }
+
+  /**
+   * @brief Gets the type name of the related topic.
+   * @return The type name.
+   */
+  std::string GetTypeName() const override { return related_topic_->GetTypeName(); }
+
+  /**
+   * @brief Gets the key fields of the related topic.
+   * @return The numbers of the key fields.
+   */
+  std::vector<int32_t> GetKeyFields() const override { return related_topic_->GetKeyFields(); }
+
+  /**
+   * @brief Gets the topic whose samples are filtered.
+   * @return The related topic.
+   */
+  std::shared_ptr<Topic> GetRelatedTopic() const override { return related_topic_; }
+
+  /**
+   * @brief Gets the filter expression.
+   * @return The expression.
+   */
+  std::string GetFilterExpression() const override { return filter_expression_; }
+
+  /**
+   * @brief Gets the values of the parameters of the filter expression.
+   * @return The parameters.
+   */
+  std::vector<std::string> GetExpressionParameters() const override {
+    return expression_parameters_;
+  }
+
+  /**
+   * @brief Gets the compiled filter expression.
+   * @return The filter.
+   */
+  std::shared_ptr<const ContentFilter> GetFilter() const { return filter_; }
+
+ private:
+  // Set at construction and never modified, so no locking is needed
+  std::string topic_name_;
+  std::shared_ptr<Topic> related_topic_;
+  std::string filter_expression_;
+  std::vector<std::string> expression_parameters_;
+  std::shared_ptr<const ContentFilter> filter_;
+};
+
 }  // namespace tiny_dds::core
 
 #endif  // TINY_DDS_CORE_TOPIC_IMPL_H_
\ No newline at end of file
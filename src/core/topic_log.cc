@@ -0,0 +1,419 @@
+#include "src/core/topic_log.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#include "absl/time/time.h"
+
+namespace tiny_dds::core {
+
+namespace {
+
+// Records start on 8-byte boundaries
+constexpr size_t kRecordAlignment = 8;
+
+// Suffix of segment file names
+constexpr char kSegmentSuffix[] = ".log";
+
+auto AlignRecord(size_t size) -> size_t {
+  return (size + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+}
+
+// Creates a directory and its missing parents
+auto MakeDirectories(const std::string& path) -> bool {
+  for (size_t slash = path.find('/', 1); ; slash = path.find('/', slash + 1)) {
+    const std::string prefix = path.substr(0, slash);
+    if (mkdir(prefix.c_str(), S_IRWXU) == -1 && errno != EEXIST) {
+      std::cerr << "Failed to create log directory " << prefix << ": " << strerror(errno)
+                << std::endl;
+      return false;
+    }
+    if (slash == std::string::npos) {
+      return true;
+    }
+  }
+}
+
+// Segment files are named after their first sequence number, zero-padded so
+// that names sort in log order
+auto SegmentPath(const std::string& directory, uint64_t sequence_number) -> std::string {
+  char name[32];
+  std::snprintf(name, sizeof(name), "%020" PRIu64 "%s", sequence_number, kSegmentSuffix);
+  return directory + "/" + name;
+}
+
+}  // namespace
+
+auto TopicLogDirectory(const PersistenceQos& qos, DomainId domain_id,
+                       const std::string& topic_name) -> std::string {
+  std::string name = topic_name;
+  for (char& c : name) {
+    if (isalnum(static_cast<unsigned char>(c)) == 0 && c != '-' && c != '_' && c != '.') {
+      c = '_';
+    }
+  }
+  return qos.directory + "/" + std::to_string(domain_id) + "/" + name;
+}
+
+TopicLog::Segment::~Segment() {
+  if (base != nullptr) {
+    munmap(base, capacity);
+  }
+}
+
+auto TopicLog::Open(const std::string& directory, const PersistenceQos& qos)
+    -> std::shared_ptr<TopicLog> {
+  if (!MakeDirectories(directory)) {
+    return nullptr;
+  }
+
+  std::shared_ptr<TopicLog> log(new TopicLog(directory, qos));
+  if (!log->Recover()) {
+    return nullptr;
+  }
+
+  log->sync_thread_ = std::thread(&TopicLog::SyncLoop, log.get());
+  return log;
+}
+
+TopicLog::TopicLog(std::string directory, const PersistenceQos& qos)
+    : directory_(std::move(directory)), qos_(qos) {
+  qos_.max_segments = std::max<size_t>(qos_.max_segments, 1);
+}
+
+TopicLog::~TopicLog() {
+  {
+    absl::MutexLock lock(&mutex_);
+    stop_ = true;
+  }
+  if (sync_thread_.joinable()) {
+    sync_thread_.join();
+  }
+  SyncRecords();
+}
+
+auto TopicLog::Recover() -> bool {
+  DIR* dir = opendir(directory_.c_str());
+  if (dir == nullptr) {
+    std::cerr << "Failed to open log directory " << directory_ << ": " << strerror(errno)
+              << std::endl;
+    return false;
+  }
+
+  std::vector<std::string> names;
+  while (dirent* entry = readdir(dir)) {
+    const std::string name = entry->d_name;
+    const size_t suffix_size = sizeof(kSegmentSuffix) - 1;
+    if (name.size() > suffix_size &&
+        name.compare(name.size() - suffix_size, suffix_size, kSegmentSuffix) == 0) {
+      names.push_back(name);
+    }
+  }
+  closedir(dir);
+  std::sort(names.begin(), names.end());
+
+  absl::MutexLock lock(&mutex_);
+  for (const auto& name : names) {
+    auto segment = MapSegment(directory_ + "/" + name, 0);
+    if (!segment) {
+      return false;
+    }
+    ScanSegment(segment.get());
+
+    // A segment created just before a crash holds nothing worth keeping
+    if (segment->index.empty()) {
+      unlink(segment->path.c_str());
+      continue;
+    }
+    last_sequence_number_ = segment->index.back().sequence_number;
+    segments_.push_back(std::move(segment));
+  }
+  return true;
+}
+
+auto TopicLog::MapSegment(const std::string& path, size_t capacity) -> std::shared_ptr<Segment> {
+  int fd = open(path.c_str(), O_CREAT | O_RDWR | O_CLOEXEC, S_IRUSR | S_IWUSR);
+  if (fd == -1) {
+    std::cerr << "Failed to open log segment " << path << ": " << strerror(errno) << std::endl;
+    return nullptr;
+  }
+
+  // Existing segments are mapped at their size; new ones are allocated up
+  // front so that appends to the mapping cannot fail for lack of disk space
+  struct stat file_stat {};
+  if (fstat(fd, &file_stat) == -1) {
+    std::cerr << "Failed to stat log segment " << path << ": " << strerror(errno) << std::endl;
+    close(fd);
+    return nullptr;
+  }
+  if (static_cast<size_t>(file_stat.st_size) < capacity) {
+    int error = posix_fallocate(fd, 0, static_cast<off_t>(capacity));
+    if (error != 0) {
+      std::cerr << "Failed to allocate log segment " << path << ": " << strerror(error)
+                << std::endl;
+      close(fd);
+      return nullptr;
+    }
+  } else {
+    capacity = static_cast<size_t>(file_stat.st_size);
+  }
+
+  auto segment = std::make_shared<Segment>();
+  segment->path = path;
+  if (capacity > 0) {
+    void* memory = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (memory == MAP_FAILED) {
+      std::cerr << "Failed to map log segment " << path << ": " << strerror(errno) << std::endl;
+      close(fd);
+      return nullptr;
+    }
+    segment->base = static_cast<uint8_t*>(memory);
+    segment->capacity = capacity;
+  }
+
+  // The mapping remains valid without the descriptor
+  close(fd);
+  return segment;
+}
+
+void TopicLog::ScanSegment(Segment* segment) {
+  size_t offset = 0;
+  while (offset + sizeof(RecordHeader) + sizeof(SampleHeader) <= segment->capacity) {
+    RecordHeader header{};
+    std::memcpy(&header, segment->base + offset, sizeof(header));
+    const size_t record_size = AlignRecord(sizeof(RecordHeader) + sizeof(SampleHeader) + header.size);
+    if (header.magic != RecordHeader::MAGIC_NUMBER || offset + record_size > segment->capacity) {
+      break;
+    }
+
+    SampleMetadata metadata;
+    DecodeSampleHeader(segment->base + offset + sizeof(RecordHeader), sizeof(SampleHeader),
+                       &metadata);
+    segment->index.push_back({metadata.sequence_number, metadata.source_timestamp, offset});
+    offset += record_size;
+  }
+
+  segment->size = offset;
+  segment->synced = offset;
+}
+
+auto TopicLog::Append(const SampleMetadata& metadata, const void* data, size_t size) -> bool {
+  const size_t record_size = AlignRecord(sizeof(RecordHeader) + sizeof(SampleHeader) + size);
+
+  absl::MutexLock lock(&mutex_);
+
+  // Readers look records up by sequence number, so each may only be logged once
+  if (metadata.sequence_number <= last_sequence_number_) {
+    std::cerr << "Sequence number " << metadata.sequence_number << " is not above the last one "
+              << "logged in " << directory_ << std::endl;
+    return false;
+  }
+
+  if (segments_.empty() || segments_.back()->size + record_size > segments_.back()->capacity) {
+    if (!RotateLocked(metadata.sequence_number, record_size)) {
+      return false;
+    }
+  }
+
+  Segment& segment = *segments_.back();
+  uint8_t* record = segment.base + segment.size;
+  EncodeSampleHeader(metadata, record + sizeof(RecordHeader));
+  if (size > 0) {
+    std::memcpy(record + sizeof(RecordHeader) + sizeof(SampleHeader), data, size);
+  }
+
+  // The magic number completes the record
+  RecordHeader header{0, static_cast<uint32_t>(size)};
+  std::memcpy(record, &header, sizeof(header));
+  header.magic = RecordHeader::MAGIC_NUMBER;
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(record, &header.magic, sizeof(header.magic));
+
+  segment.index.push_back({metadata.sequence_number, metadata.source_timestamp, segment.size});
+  segment.size += record_size;
+  last_sequence_number_ = metadata.sequence_number;
+  unsynced_ = true;
+  return true;
+}
+
+auto TopicLog::RotateLocked(uint64_t sequence_number, size_t record_size) -> bool {
+  // Samples larger than a segment get a segment of their own
+  auto segment = MapSegment(SegmentPath(directory_, sequence_number),
+                            std::max(qos_.segment_size, record_size));
+  if (!segment) {
+    return false;
+  }
+
+  segments_.push_back(std::move(segment));
+
+  // Samples read from deleted segments stay valid until released
+  while (segments_.size() > qos_.max_segments) {
+    if (unlink(segments_.front()->path.c_str()) == -1) {
+      std::cerr << "Failed to delete log segment " << segments_.front()->path << ": "
+                << strerror(errno) << std::endl;
+    }
+    segments_.pop_front();
+  }
+  return true;
+}
+
+void TopicLog::Sync() { SyncRecords(); }
+
+void TopicLog::SyncRecords() {
+  // One flush at a time, so that the synced offsets only grow
+  absl::MutexLock sync_lock(&sync_mutex_);
+
+  struct Range {
+    std::shared_ptr<Segment> segment;
+    size_t begin;
+    size_t end;
+  };
+  std::vector<Range> ranges;
+  {
+    absl::MutexLock lock(&mutex_);
+    for (const auto& segment : segments_) {
+      if (segment->synced < segment->size) {
+        ranges.push_back({segment, segment->synced, segment->size});
+      }
+    }
+    unsynced_ = false;
+  }
+
+  // Appends continue while the records are flushed
+  const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  for (const auto& range : ranges) {
+    const size_t begin = range.begin & ~(page_size - 1);
+    if (msync(range.segment->base + begin, range.end - begin, MS_SYNC) == -1) {
+      std::cerr << "Failed to sync log segment " << range.segment->path << ": "
+                << strerror(errno) << std::endl;
+    }
+  }
+
+  absl::MutexLock lock(&mutex_);
+  for (const auto& range : ranges) {
+    range.segment->synced = std::max(range.segment->synced, range.end);
+  }
+}
+
+void TopicLog::SyncLoop() {
+  auto has_work = [this]() { return stop_ || unsynced_; };
+  auto stopping = [this]() { return stop_; };
+
+  while (true) {
+    {
+      absl::MutexLock lock(&mutex_);
+      mutex_.Await(absl::Condition(&has_work));
+
+      // Appends within the interval share the flush
+      mutex_.AwaitWithTimeout(absl::Condition(&stopping), absl::FromChrono(qos_.sync_interval));
+      if (stop_) {
+        return;
+      }
+    }
+    SyncRecords();
+  }
+}
+
+auto TopicLog::LastSequenceNumber() const -> uint64_t {
+  absl::MutexLock lock(&mutex_);
+  return last_sequence_number_;
+}
+
+auto TopicLog::Size() const -> size_t {
+  absl::MutexLock lock(&mutex_);
+
+  size_t size = 0;
+  for (const auto& segment : segments_) {
+    size += segment->index.size();
+  }
+  return size;
+}
+
+auto TopicLog::ReadFromSequenceNumber(uint64_t sequence_number, size_t max_samples) const
+    -> std::vector<LocalSample> {
+  absl::MutexLock lock(&mutex_);
+
+  for (size_t i = 0; i < segments_.size(); ++i) {
+    const auto& index = segments_[i]->index;
+    if (index.empty() || index.back().sequence_number < sequence_number) {
+      continue;
+    }
+    auto it = std::lower_bound(index.begin(), index.end(), sequence_number,
+                               [](const IndexEntry& entry, uint64_t value) {
+                                 return entry.sequence_number < value;
+                               });
+    return ReadLocked(i, static_cast<size_t>(it - index.begin()), max_samples);
+  }
+  return {};
+}
+
+auto TopicLog::ReadFromTimestamp(int64_t timestamp, size_t max_samples) const
+    -> std::vector<LocalSample> {
+  absl::MutexLock lock(&mutex_);
+
+  for (size_t i = 0; i < segments_.size(); ++i) {
+    const auto& index = segments_[i]->index;
+    if (index.empty() || index.back().source_timestamp < timestamp) {
+      continue;
+    }
+    auto it = std::lower_bound(index.begin(), index.end(), timestamp,
+                               [](const IndexEntry& entry, int64_t value) {
+                                 return entry.source_timestamp < value;
+                               });
+    return ReadLocked(i, static_cast<size_t>(it - index.begin()), max_samples);
+  }
+  return {};
+}
+
+auto TopicLog::ReadLast(size_t count) const -> std::vector<LocalSample> {
+  absl::MutexLock lock(&mutex_);
+
+  // Walk back from the end to the first record to read
+  size_t segment_index = segments_.size();
+  size_t remaining = count;
+  while (segment_index > 0 && remaining > 0) {
+    const size_t records = segments_[segment_index - 1]->index.size();
+    if (records >= remaining) {
+      return ReadLocked(segment_index - 1, records - remaining, count);
+    }
+    remaining -= records;
+    --segment_index;
+  }
+  return ReadLocked(segment_index, 0, count);
+}
+
+auto TopicLog::ReadLocked(size_t segment_index, size_t entry_index, size_t max_samples) const
+    -> std::vector<LocalSample> {
+  std::vector<LocalSample> samples;
+  for (; segment_index < segments_.size() && samples.size() < max_samples; ++segment_index) {
+    const std::shared_ptr<Segment>& segment = segments_[segment_index];
+    for (; entry_index < segment->index.size() && samples.size() < max_samples; ++entry_index) {
+      const uint8_t* record = segment->base + segment->index[entry_index].offset;
+      RecordHeader header{};
+      std::memcpy(&header, record, sizeof(header));
+
+      // The sample shares ownership of the mapping instead of copying from it
+      LocalSample sample;
+      sample.data = std::shared_ptr<const void>(
+          segment, record + sizeof(RecordHeader) + sizeof(SampleHeader));
+      sample.size = header.size;
+      DecodeSampleHeader(record + sizeof(RecordHeader), sizeof(SampleHeader), &sample.metadata);
+      samples.push_back(std::move(sample));
+    }
+    entry_index = 0;
+  }
+  return samples;
+}
+
+}  // namespace tiny_dds::core
@@ -0,0 +1,215 @@
+#ifndef TINY_DDS_CORE_TOPIC_LOG_H_
+#define TINY_DDS_CORE_TOPIC_LOG_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "include/tiny_dds/types.h"
+#include "src/core/intra_process_bus.h"
+#include "src/core/sample_header.h"
+
+namespace tiny_dds {
+namespace core {
+
+/**
+ * @brief Gets the directory holding the log of a topic.
+ * @param qos The persistence QoS of the writer.
+ * @param domain_id The domain of the topic.
+ * @param topic_name The topic name; characters other than letters, digits,
+ *        '-', '_' and '.' are replaced by '_'.
+ * @return The directory path.
+ */
+auto TopicLogDirectory(const PersistenceQos& qos, DomainId domain_id,
+                       const std::string& topic_name) -> std::string;
+
+/**
+ * @brief Append-only on-disk log of the samples of a PERSISTENT DataWriter.
+ *
+ * The log is a sequence of segment files, each preallocated to segment_size
+ * bytes, mapped into memory and named after the first sequence number it
+ * holds. A record is a small header followed by the sample header and the
+ * payload, so records are written, and read back, in place in the mapping.
+ * The record header's magic number is stored last; a record cut short by a
+ * crash is ignored when the log is opened again.
+ *
+ * An in-memory index of sequence numbers and source timestamps to record
+ * offsets is rebuilt from the segments on open. Reads return samples that
+ * point into the mapping and keep their segment mapped, so replaying the log
+ * copies nothing, even after the segment was deleted by retention.
+ *
+ * A sync thread flushes appended records to disk in groups: it waits for the
+ * first unsynced record, lets sync_interval pass so later appends join it,
+ * then flushes them all with one msync per segment. Sequence numbers must
+ * increase from one append to the next.
+ */
+class TopicLog {
+ public:
+  /**
+   * @brief Opens the log in a directory, creating it if needed, and starts the sync thread.
+   * @param directory The directory of the log's segments.
+   * @param qos The persistence configuration.
+   * @return A shared pointer to the log, or nullptr if the directory or a segment cannot be used.
+   */
+  static auto Open(const std::string& directory, const PersistenceQos& qos)
+      -> std::shared_ptr<TopicLog>;
+
+  /**
+   * @brief Destructor, flushes unsynced records and stops the sync thread.
+   */
+  ~TopicLog();
+
+  TopicLog(const TopicLog&) = delete;
+  TopicLog& operator=(const TopicLog&) = delete;
+
+  /**
+   * @brief Appends a sample; it is flushed to disk by the next group sync.
+   * @param metadata The writer's metadata for the sample.
+   * @param data Pointer to the serialized sample.
+   * @param size Size of the serialized sample in bytes.
+   * @return True if the sample was appended, false if its sequence number is not above
+   *         LastSequenceNumber() or a new segment could not be created.
+   */
+  auto Append(const SampleMetadata& metadata, const void* data, size_t size) -> bool;
+
+  /**
+   * @brief Flushes every appended record to disk before returning.
+   */
+  void Sync();
+
+  /**
+   * @brief Gets the sequence number of the last record.
+   * @return The sequence number, or 0 if the log is empty.
+   */
+  auto LastSequenceNumber() const -> uint64_t;
+
+  /**
+   * @brief Gets the number of records in the log.
+   * @return The number of records in the retained segments.
+   */
+  auto Size() const -> size_t;
+
+  /**
+   * @brief Reads the records from a sequence number on.
+   * @param sequence_number The first sequence number to read.
+   * @param max_samples Maximum number of records to read.
+   * @return The samples, oldest first, pointing into the mapping.
+   */
+  auto ReadFromSequenceNumber(uint64_t sequence_number, size_t max_samples) const
+      -> std::vector<LocalSample>;
+
+  /**
+   * @brief Reads the records written from a point in time on.
+   * @param timestamp The earliest source timestamp, in nanoseconds since the Unix epoch.
+   * @param max_samples Maximum number of records to read.
+   * @return The samples, oldest first, pointing into the mapping.
+   */
+  auto ReadFromTimestamp(int64_t timestamp, size_t max_samples) const -> std::vector<LocalSample>;
+
+  /**
+   * @brief Reads the last records.
+   * @param count Number of records to read.
+   * @return The samples, oldest first, pointing into the mapping.
+   */
+  auto ReadLast(size_t count) const -> std::vector<LocalSample>;
+
+ private:
+  // Locates a record in a segment
+  struct IndexEntry {
+    uint64_t sequence_number;
+    int64_t source_timestamp;
+    size_t offset;
+  };
+
+  // A mapped segment file; unmapped when the last sample read from it is released
+  struct Segment {
+    ~Segment();
+
+    std::string path;
+    uint8_t* base = nullptr;
+    size_t capacity = 0;
+
+    // Bytes used by records, and bytes of them flushed to disk
+    size_t size = 0;
+    size_t synced = 0;
+
+    std::vector<IndexEntry> index;
+  };
+
+  // Header in front of every record
+  struct RecordHeader {
+    uint32_t magic;  // Written last; anything else marks the end of the segment
+    uint32_t size;   // Size of the payload after the sample header
+
+    // Magic number for records
+    static constexpr uint32_t MAGIC_NUMBER = 0x474C4454;  // "TDLG" in ASCII
+  };
+
+  /**
+   * @brief Constructor.
+   * @param directory The directory of the log's segments.
+   * @param qos The persistence configuration.
+   */
+  TopicLog(std::string directory, const PersistenceQos& qos);
+
+  // Maps the existing segments and rebuilds the index
+  auto Recover() -> bool;
+
+  // Maps a segment file, creating it with the given capacity if it does not exist
+  auto MapSegment(const std::string& path, size_t capacity) -> std::shared_ptr<Segment>;
+
+  // Rebuilds the index of a mapped segment from its records
+  static void ScanSegment(Segment* segment);
+
+  // Starts a new segment for records from a sequence number on and applies
+  // retention; the caller holds mutex_
+  auto RotateLocked(uint64_t sequence_number, size_t record_size) -> bool;
+
+  // Reads up to max_samples records from a position on; the caller holds mutex_
+  auto ReadLocked(size_t segment_index, size_t entry_index, size_t max_samples) const
+      -> std::vector<LocalSample>;
+
+  // Flushes the records appended so far
+  void SyncRecords();
+
+  // Sync thread body
+  void SyncLoop();
+
+  // Directory of the segment files
+  std::string directory_;
+
+  // Persistence configuration
+  PersistenceQos qos_;
+
+  // Retained segments, oldest first; the last one takes appends
+  std::deque<std::shared_ptr<Segment>> segments_;
+
+  // Sequence number of the last record
+  uint64_t last_sequence_number_ = 0;
+
+  // Set by appends, cleared by the sync thread
+  bool unsynced_ = false;
+
+  // Flag to stop the sync thread
+  bool stop_ = false;
+
+  // Mutex for thread safety
+  mutable absl::Mutex mutex_;
+
+  // Serializes flushes, which run without mutex_
+  absl::Mutex sync_mutex_;
+
+  // Thread flushing appended records
+  std::thread sync_thread_;
+};
+
+}  // namespace core
+}  // namespace tiny_dds
+
+#endif  // TINY_DDS_CORE_TOPIC_LOG_H_
@@ -0,0 +1,213 @@
+#include "src/core/wait_set_impl.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "absl/time/time.h"
+
+namespace tiny_dds {
+
+// Static method implementation for GuardCondition::Create
+std::shared_ptr<GuardCondition> GuardCondition::Create() {
+  return std::make_shared<core::GuardConditionImpl>();
+}
+
+// Static method implementation for WaitSet::Create
+std::shared_ptr<WaitSet> WaitSet::Create() { return std::make_shared<core::WaitSetImpl>(); }
+
+namespace core {
+
+void ConditionImpl::AddWaitSet(const std::shared_ptr<WaitSetImpl>& wait_set) {
+  absl::MutexLock lock(&mutex_);
+
+  auto updated = std::make_shared<WaitSetList>();
+  if (wait_sets_) {
+    for (const auto& existing : *wait_sets_) {
+      if (!existing.expired()) {
+        updated->push_back(existing);
+      }
+    }
+  }
+  updated->push_back(wait_set);
+  wait_sets_ = std::move(updated);
+}
+
+void ConditionImpl::RemoveWaitSet(const WaitSetImpl* wait_set) {
+  absl::MutexLock lock(&mutex_);
+
+  if (!wait_sets_) {
+    return;
+  }
+
+  auto updated = std::make_shared<WaitSetList>();
+  for (const auto& existing : *wait_sets_) {
+    auto locked = existing.lock();
+    if (locked && locked.get() != wait_set) {
+      updated->push_back(existing);
+    }
+  }
+  wait_sets_ = updated->empty() ? nullptr : std::move(updated);
+}
+
+void ConditionImpl::NotifyWaitSets() {
+  std::shared_ptr<const WaitSetList> wait_sets;
+  std::vector<std::function<void()>> listeners;
+  {
+    absl::MutexLock lock(&mutex_);
+    wait_sets = wait_sets_;
+    if (!listeners_.empty()) {
+      listeners.swap(listeners_);
+    }
+  }
+
+  if (wait_sets) {
+    for (const auto& weak_wait_set : *wait_sets) {
+      if (auto wait_set = weak_wait_set.lock()) {
+        wait_set->Signal();
+      }
+    }
+  }
+
+  if (listeners.empty()) {
+    return;
+  }
+
+  // Listeners may register again while they run
+  for (auto& listener : listeners) {
+    listener();
+  }
+
+  // Hand the storage back for the next listeners
+  listeners.clear();
+  absl::MutexLock lock(&mutex_);
+  if (listeners_.empty() && listeners_.capacity() < listeners.capacity()) {
+    listeners_.swap(listeners);
+  }
+}
+
+void ConditionImpl::NotifyOnce(std::function<void()> listener) {
+  absl::MutexLock lock(&mutex_);
+  listeners_.push_back(std::move(listener));
+}
+
+bool GuardConditionImpl::GetTriggerValue() const {
+  return trigger_value_.load(std::memory_order_acquire);
+}
+
+void GuardConditionImpl::SetTriggerValue(bool value) {
+  trigger_value_.store(value, std::memory_order_release);
+  if (value) {
+    NotifyWaitSets();
+  }
+}
+
+WaitSetImpl::~WaitSetImpl() {
+  for (const auto& attachment : *attachments_) {
+    attachment.notifier->RemoveWaitSet(this);
+  }
+}
+
+bool WaitSetImpl::AttachCondition(std::shared_ptr<Condition> condition) {
+  auto* notifier = dynamic_cast<ConditionImpl*>(condition.get());
+  if (notifier == nullptr) {
+    std::cerr << "Condition was not created by Tiny DDS and cannot be attached" << std::endl;
+    return false;
+  }
+
+  {
+    absl::MutexLock lock(&mutex_);
+
+    auto it = std::find_if(attachments_->begin(), attachments_->end(),
+                           [&](const Attachment& a) { return a.condition == condition; });
+    if (it != attachments_->end()) {
+      return false;
+    }
+
+    auto updated = std::make_shared<AttachmentList>(*attachments_);
+    updated->push_back({std::move(condition), notifier});
+    attachments_ = std::move(updated);
+  }
+
+  notifier->AddWaitSet(shared_from_this());
+
+  // A waiting thread checks the new condition right away
+  Signal();
+  return true;
+}
+
+bool WaitSetImpl::DetachCondition(const std::shared_ptr<Condition>& condition) {
+  ConditionImpl* notifier = nullptr;
+  {
+    absl::MutexLock lock(&mutex_);
+
+    auto updated = std::make_shared<AttachmentList>();
+    for (const auto& attachment : *attachments_) {
+      if (attachment.condition == condition) {
+        notifier = attachment.notifier;
+      } else {
+        updated->push_back(attachment);
+      }
+    }
+
+    if (notifier == nullptr) {
+      return false;
+    }
+    attachments_ = std::move(updated);
+  }
+
+  notifier->RemoveWaitSet(this);
+  return true;
+}
+
+bool WaitSetImpl::Wait(std::vector<std::shared_ptr<Condition>>& active_conditions,
+                       std::chrono::nanoseconds timeout) {
+  const absl::Time deadline = absl::Now() + absl::FromChrono(timeout);
+
+  active_conditions.clear();
+
+  while (true) {
+    uint64_t observed_generation = 0;
+    std::shared_ptr<const AttachmentList> attachments;
+    {
+      absl::MutexLock lock(&mutex_);
+      observed_generation = generation_;
+      attachments = attachments_;
+    }
+
+    // Conditions take their own locks, so they are checked without holding mutex_
+    for (const auto& attachment : *attachments) {
+      if (attachment.condition->GetTriggerValue()) {
+        active_conditions.push_back(attachment.condition);
+      }
+    }
+
+    if (!active_conditions.empty()) {
+      return true;
+    }
+
+    absl::MutexLock lock(&mutex_);
+    auto notified = [this, observed_generation]() { return generation_ != observed_generation; };
+    if (!mutex_.AwaitWithDeadline(absl::Condition(&notified), deadline)) {
+      return false;
+    }
+  }
+}
+
+std::vector<std::shared_ptr<Condition>> WaitSetImpl::GetConditions() const {
+  absl::MutexLock lock(&mutex_);
+
+  std::vector<std::shared_ptr<Condition>> conditions;
+  conditions.reserve(attachments_->size());
+  for (const auto& attachment : *attachments_) {
+    conditions.push_back(attachment.condition);
+  }
+  return conditions;
+}
+
+void WaitSetImpl::Signal() {
+  absl::MutexLock lock(&mutex_);
+  ++generation_;
+}
+
+}  // namespace core
+}  // namespace tiny_dds
@@ -0,0 +1,163 @@
+#ifndef TINY_DDS_CORE_WAIT_SET_IMPL_H_
+#define TINY_DDS_CORE_WAIT_SET_IMPL_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "include/tiny_dds/wait_set.h"
+
+namespace tiny_dds {
+namespace core {
+
+// Forward declarations
+class WaitSetImpl;
+
+/**
+ * @brief Base of all condition implementations; wakes the WaitSets a condition is attached to.
+ *
+ * Implementations call NotifyWaitSets after a change that may have triggered
+ * the condition, without holding the locks their GetTriggerValue takes.
+ * Besides WaitSets, a notification runs the one-shot listeners registered
+ * with NotifyOnce, which let awaiting code resume without a blocked thread.
+ */
+class ConditionImpl {
+ public:
+  virtual ~ConditionImpl() = default;
+
+  /**
+   * @brief Registers a WaitSet to be woken by this condition.
+   * @param wait_set The WaitSet; it is held weakly.
+   */
+  void AddWaitSet(const std::shared_ptr<WaitSetImpl>& wait_set);
+
+  /**
+   * @brief Stops waking a WaitSet.
+   * @param wait_set The WaitSet to remove.
+   */
+  void RemoveWaitSet(const WaitSetImpl* wait_set);
+
+  /**
+   * @brief Wakes every WaitSet this condition is attached to and runs the pending listeners.
+   */
+  void NotifyWaitSets();
+
+  /**
+   * @brief Runs a function once, at the next notification.
+   * @param listener The function; it runs on the notifying thread, without locks held.
+   */
+  void NotifyOnce(std::function<void()> listener);
+
+ private:
+  using WaitSetList = std::vector<std::weak_ptr<WaitSetImpl>>;
+
+  // Attached WaitSets; the list is replaced rather than modified so that
+  // notifications are sent from a snapshot
+  std::shared_ptr<const WaitSetList> wait_sets_;
+
+  // Listeners waiting for the next notification; the vector keeps its
+  // storage across notifications, so that registering does not allocate
+  std::vector<std::function<void()>> listeners_;
+
+  // Mutex for thread safety
+  mutable absl::Mutex mutex_;
+};
+
+/**
+ * @brief Implementation of the GuardCondition interface.
+ */
+class GuardConditionImpl : public tiny_dds::GuardCondition, public ConditionImpl {
+ public:
+  /**
+   * @brief Gets whether the condition is currently triggered.
+   * @return True if the condition is triggered.
+   */
+  bool GetTriggerValue() const override;
+
+  /**
+   * @brief Sets the trigger value, waking the attached WaitSets when set to true.
+   * @param value The new trigger value.
+   */
+  void SetTriggerValue(bool value) override;
+
+ private:
+  // Current trigger value
+  std::atomic<bool> trigger_value_{false};
+};
+
+/**
+ * @brief Implementation of the WaitSet interface.
+ *
+ * Every notification from an attached condition advances a generation counter
+ * under the WaitSet's mutex. Wait records the generation before checking the
+ * conditions and only sleeps until the generation moves, so a notification
+ * arriving while the conditions are being checked is never lost.
+ */
+class WaitSetImpl : public tiny_dds::WaitSet, public std::enable_shared_from_this<WaitSetImpl> {
+ public:
+  /**
+   * @brief Destructor, detaches all conditions.
+   */
+  ~WaitSetImpl() override;
+
+  /**
+   * @brief Attaches a condition.
+   * @param condition The condition to attach.
+   * @return True if the condition was attached, false if it is not supported or already attached.
+   */
+  bool AttachCondition(std::shared_ptr<tiny_dds::Condition> condition) override;
+
+  /**
+   * @brief Detaches a condition.
+   * @param condition The condition to detach.
+   * @return True if the condition was detached, false if it was not attached.
+   */
+  bool DetachCondition(const std::shared_ptr<tiny_dds::Condition>& condition) override;
+
+  /**
+   * @brief Waits until at least one attached condition is triggered.
+   * @param[out] active_conditions The attached conditions that are triggered.
+   * @param timeout The maximum time to wait.
+   * @return True if a condition was triggered, false on timeout.
+   */
+  bool Wait(std::vector<std::shared_ptr<tiny_dds::Condition>>& active_conditions,
+            std::chrono::nanoseconds timeout) override;
+
+  /**
+   * @brief Gets the attached conditions.
+   * @return The attached conditions.
+   */
+  std::vector<std::shared_ptr<tiny_dds::Condition>> GetConditions() const override;
+
+  /**
+   * @brief Wakes the waiting thread so that it checks the conditions again.
+   */
+  void Signal();
+
+ private:
+  struct Attachment {
+    std::shared_ptr<tiny_dds::Condition> condition;
+    ConditionImpl* notifier;
+  };
+
+  using AttachmentList = std::vector<Attachment>;
+
+  // Attached conditions; the list is replaced rather than modified so that
+  // Wait can check a snapshot without holding the lock
+  std::shared_ptr<const AttachmentList> attachments_ = std::make_shared<AttachmentList>();
+
+  // Advanced by every notification
+  uint64_t generation_ = 0;
+
+  // Mutex for thread safety
+  mutable absl::Mutex mutex_;
+};
+
+}  // namespace core
+}  // namespace tiny_dds
+
+#endif  // TINY_DDS_CORE_WAIT_SET_IMPL_H_
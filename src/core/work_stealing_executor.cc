@@ -0,0 +1,204 @@
+#include "src/core/work_stealing_executor.h"
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace tiny_dds {
+
+// Static method implementation for Executor::Create
+std::shared_ptr<Executor> Executor::Create(const ExecutorConfig& config) {
+  return std::make_shared<core::WorkStealingExecutor>(config);
+}
+
+namespace core {
+
+namespace {
+
+// Workers and index of the worker running on this thread, if any
+thread_local const WorkStealingExecutor::Workers* current_workers = nullptr;
+thread_local size_t current_index = 0;
+
+// Runs its tasks one at a time, as a task of the executor that it reposts
+// while tasks are left
+class StrandImpl : public tiny_dds::Strand, public std::enable_shared_from_this<StrandImpl> {
+ public:
+  explicit StrandImpl(std::weak_ptr<WorkStealingExecutor::Workers> workers)
+      : workers_(std::move(workers)) {}
+
+  void Post(std::function<void()> task) override {
+    {
+      absl::MutexLock lock(&mutex_);
+      tasks_.push_back(std::move(task));
+      if (scheduled_) {
+        return;
+      }
+      scheduled_ = true;
+    }
+    Schedule();
+  }
+
+ private:
+  // Queues a turn of the strand on the executor, or drops the tasks if it is gone
+  void Schedule() {
+    if (auto workers = workers_.lock()) {
+      workers->Post([self = shared_from_this()]() { self->RunTurn(); });
+      return;
+    }
+
+    std::deque<std::function<void()>> dropped;
+    absl::MutexLock lock(&mutex_);
+    dropped.swap(tasks_);
+    scheduled_ = false;
+  }
+
+  // Runs the strand's tasks in order, then lets other tasks run on the worker
+  void RunTurn() {
+    for (size_t n = 0; n < WorkStealingExecutor::kMaxStrandTasksPerTurn; ++n) {
+      std::function<void()> task;
+      {
+        absl::MutexLock lock(&mutex_);
+        if (tasks_.empty()) {
+          scheduled_ = false;
+          return;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      task();
+    }
+    Schedule();
+  }
+
+  std::weak_ptr<WorkStealingExecutor::Workers> workers_;
+
+  std::deque<std::function<void()>> tasks_;
+
+  // Set while a turn of the strand is queued or running
+  bool scheduled_ = false;
+
+  // Mutex for thread safety
+  absl::Mutex mutex_;
+};
+
+}  // namespace
+
+WorkStealingExecutor::WorkStealingExecutor(const tiny_dds::ExecutorConfig& config) {
+  size_t count = config.workers;
+  if (count == 0) {
+    count = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  workers_ = std::make_shared<Workers>(count);
+  for (size_t i = 0; i < count; ++i) {
+    threads_.emplace_back(&WorkStealingExecutor::WorkerLoop, workers_, i);
+
+#ifdef __linux__
+    if (!config.cpus.empty()) {
+      const int cpu = config.cpus[i % config.cpus.size()];
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      CPU_SET(cpu, &cpus);
+      if (pthread_setaffinity_np(threads_.back().native_handle(), sizeof(cpus), &cpus) != 0) {
+        std::cerr << "Failed to pin executor worker " << i << " to CPU " << cpu << std::endl;
+      }
+    }
+#endif
+  }
+}
+
+WorkStealingExecutor::~WorkStealingExecutor() {
+  {
+    absl::MutexLock lock(&workers_->idle_mutex);
+    workers_->stop = true;
+  }
+
+  // The last reference may be dropped by a task running on one of the workers
+  for (std::thread& thread : threads_) {
+    if (thread.get_id() == std::this_thread::get_id()) {
+      thread.detach();
+    } else {
+      thread.join();
+    }
+  }
+}
+
+void WorkStealingExecutor::Post(std::function<void()> task) { workers_->Post(std::move(task)); }
+
+auto WorkStealingExecutor::CreateStrand() -> std::shared_ptr<tiny_dds::Strand> {
+  return std::make_shared<StrandImpl>(workers_);
+}
+
+void WorkStealingExecutor::Workers::Post(std::function<void()> task) {
+  // Workers keep the tasks they post, which are likely to use what they just touched
+  const size_t index = current_workers == this
+                           ? current_index
+                           : next.fetch_add(1, std::memory_order_relaxed) % queues.size();
+  {
+    absl::MutexLock lock(&queues[index].mutex);
+    queues[index].tasks.push_back(std::move(task));
+  }
+
+  // Either a worker about to sleep sees the task, or it is counted as sleeping
+  // here; releasing idle_mutex makes the sleeping workers check for tasks
+  pending.fetch_add(1);
+  if (sleeping.load() > 0) {
+    absl::MutexLock lock(&idle_mutex);
+  }
+}
+
+auto WorkStealingExecutor::Workers::Take(size_t index, std::function<void()>* task) -> bool {
+  {
+    Queue& own = queues[index];
+    absl::MutexLock lock(&own.mutex);
+    if (!own.tasks.empty()) {
+      *task = std::move(own.tasks.front());
+      own.tasks.pop_front();
+      pending.fetch_sub(1);
+      return true;
+    }
+  }
+
+  for (size_t n = 1; n < queues.size(); ++n) {
+    Queue& victim = queues[(index + n) % queues.size()];
+    absl::MutexLock lock(&victim.mutex);
+    if (!victim.tasks.empty()) {
+      *task = std::move(victim.tasks.back());
+      victim.tasks.pop_back();
+      pending.fetch_sub(1);
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingExecutor::WorkerLoop(std::shared_ptr<Workers> workers, size_t index) {
+  current_workers = workers.get();
+  current_index = index;
+
+  auto has_work = [&workers]() { return workers->stop || workers->pending.load() > 0; };
+
+  while (true) {
+    std::function<void()> task;
+    if (workers->Take(index, &task)) {
+      task();
+      continue;
+    }
+
+    absl::MutexLock lock(&workers->idle_mutex);
+    workers->sleeping.fetch_add(1);
+    workers->idle_mutex.Await(absl::Condition(&has_work));
+    workers->sleeping.fetch_sub(1);
+    if (workers->stop && workers->pending.load() <= 0) {
+      return;
+    }
+  }
+}
+
+}  // namespace core
+}  // namespace tiny_dds
@@ -0,0 +1,121 @@
+#ifndef TINY_DDS_CORE_WORK_STEALING_EXECUTOR_H_
+#define TINY_DDS_CORE_WORK_STEALING_EXECUTOR_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "include/tiny_dds/executor.h"
+
+namespace tiny_dds {
+namespace core {
+
+/**
+ * @brief Executor with a task deque per worker, from which idle workers steal.
+ *
+ * A worker takes tasks from the front of its own deque, in the order they were
+ * posted, and when it is empty steals the newest tasks from the back of the
+ * others'. Each deque has its own lock, held for a single push or pop. Workers
+ * sleep once there is nothing to take anywhere, and posting wakes them only if
+ * one is asleep.
+ *
+ * The queues and the workers' bookkeeping live in a state shared with the
+ * worker threads, so that the executor may be destroyed by a task running on
+ * one of its own workers. Strands refer to the state weakly and do not keep it
+ * alive.
+ */
+class WorkStealingExecutor : public tiny_dds::Executor {
+ public:
+  /**
+   * @brief Constructor, starts the workers and pins them to their CPUs.
+   * @param config The executor configuration.
+   */
+  explicit WorkStealingExecutor(const tiny_dds::ExecutorConfig& config);
+
+  /**
+   * @brief Destructor, runs the queued tasks and stops the workers.
+   */
+  ~WorkStealingExecutor() override;
+
+  WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+  WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+
+  /**
+   * @brief Queues a task on the calling worker's deque, or spreads it over the workers.
+   * @param task The task.
+   */
+  void Post(std::function<void()> task) override;
+
+  /**
+   * @brief Creates a strand on this executor.
+   * @return The strand.
+   */
+  std::shared_ptr<tiny_dds::Strand> CreateStrand() override;
+
+  /**
+   * @brief Gets the number of workers.
+   * @return The number of workers.
+   */
+  size_t WorkerCount() const override { return threads_.size(); }
+
+  /**
+   * @brief Maximum number of tasks a strand runs before letting other tasks run on its worker.
+   */
+  static constexpr size_t kMaxStrandTasksPerTurn = 16;
+
+  /**
+   * @brief State shared by the executor, its worker threads, and its strands.
+   */
+  struct Workers {
+    // Deque of one worker, aligned so that the workers' locks do not share cache lines
+    struct alignas(64) Queue {
+      absl::Mutex mutex;
+      std::deque<std::function<void()>> tasks;
+    };
+
+    explicit Workers(size_t count) : queues(count) {}
+
+    // Queues a task and wakes a sleeping worker if there is one
+    void Post(std::function<void()> task);
+
+    // Takes the oldest task of a worker's deque, or steals the newest task of another's
+    auto Take(size_t index, std::function<void()>* task) -> bool;
+
+    std::vector<Queue> queues;
+
+    // Tasks in all the deques; briefly negative while a task taken as it was
+    // queued is not counted yet
+    std::atomic<int64_t> pending{0};
+
+    // Workers waiting on idle_mutex for tasks
+    std::atomic<size_t> sleeping{0};
+
+    // Next deque for tasks posted from outside the workers
+    std::atomic<size_t> next{0};
+
+    // Set when the executor is destroyed; workers exit once the deques are empty
+    bool stop = false;
+
+    // Mutex the idle workers wait on
+    absl::Mutex idle_mutex;
+  };
+
+ private:
+  // Worker thread body
+  static void WorkerLoop(std::shared_ptr<Workers> workers, size_t index);
+
+  std::shared_ptr<Workers> workers_;
+
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace core
+}  // namespace tiny_dds
+
+#endif  // TINY_DDS_CORE_WORK_STEALING_EXECUTOR_H_
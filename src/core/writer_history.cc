@@ -0,0 +1,44 @@
+#include "src/core/writer_history.h"
+
+#include <algorithm>
+
+namespace tiny_dds::core {
+
+auto HistoryRequestTopicName(const std::string& topic_name) -> std::string {
+  return topic_name + "/__history_request";
+}
+
+WriterHistory::WriterHistory(const HistoryQos& qos)
+    : samples_(static_cast<size_t>(
+          std::max(qos.kind == HistoryKind::KEEP_LAST ? qos.depth : qos.max_samples, 1))) {}
+
+void WriterHistory::Push(const LocalSample& sample) {
+  absl::MutexLock lock(&mutex_);
+
+  if (size_ == samples_.size()) {
+    samples_[start_] = sample;
+    start_ = (start_ + 1) % samples_.size();
+    return;
+  }
+
+  samples_[(start_ + size_) % samples_.size()] = sample;
+  ++size_;
+}
+
+auto WriterHistory::Snapshot() const -> std::vector<LocalSample> {
+  absl::MutexLock lock(&mutex_);
+
+  std::vector<LocalSample> samples;
+  samples.reserve(size_);
+  for (size_t i = 0; i < size_; ++i) {
+    samples.push_back(samples_[(start_ + i) % samples_.size()]);
+  }
+  return samples;
+}
+
+auto WriterHistory::Size() const -> size_t {
+  absl::MutexLock lock(&mutex_);
+  return size_;
+}
+
+}  // namespace tiny_dds::core
@@ -0,0 +1,94 @@
+#ifndef TINY_DDS_CORE_WRITER_HISTORY_H_
+#define TINY_DDS_CORE_WRITER_HISTORY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "include/tiny_dds/types.h"
+#include "src/core/intra_process_bus.h"
+
+namespace tiny_dds {
+namespace core {
+
+/**
+ * @brief Name of the topic on which TRANSIENT_LOCAL readers ask for a replay.
+ *
+ * Readers that join a network topic write a HistoryRequest on this companion
+ * topic; the topic's TRANSIENT_LOCAL and PERSISTENT writers subscribe to it
+ * and answer by replaying their history on the topic itself.
+ *
+ * @param topic_name The topic whose history is requested.
+ * @return The name of the companion topic.
+ */
+auto HistoryRequestTopicName(const std::string& topic_name) -> std::string;
+
+// Type name of the companion topic
+constexpr char kHistoryRequestTypeName[] = "tiny_dds::HistoryRequest";
+
+// Sample of the companion topic, in host byte order. A request with neither
+// field set asks for the writer's last history.depth samples; an empty
+// sample is read as such a request.
+struct HistoryRequest {
+  uint64_t from_sequence_number = 0;
+  int64_t from_timestamp = 0;  // Nanoseconds since the Unix epoch
+};
+
+/**
+ * @brief Last samples of a TRANSIENT_LOCAL DataWriter, kept for late-joining readers.
+ *
+ * A ring of reference-counted samples sized once from the writer's HistoryQos;
+ * when it is full the oldest sample is replaced. Samples are shared with the
+ * readers the write delivered them to, so keeping them costs no copy for
+ * LOCAL_ONLY writers and one copy per sample for network writers. The history
+ * is thread-safe.
+ */
+class WriterHistory {
+ public:
+  /**
+   * @brief Constructor, allocates every slot.
+   * @param qos The history QoS of the writer.
+   */
+  explicit WriterHistory(const HistoryQos& qos);
+
+  WriterHistory(const WriterHistory&) = delete;
+  WriterHistory& operator=(const WriterHistory&) = delete;
+
+  /**
+   * @brief Stores a sample, replacing the oldest one if the history is full.
+   * @param sample The sample, with its metadata.
+   */
+  void Push(const LocalSample& sample);
+
+  /**
+   * @brief Copies the references to the stored samples.
+   * @return The samples, oldest first.
+   */
+  auto Snapshot() const -> std::vector<LocalSample>;
+
+  /**
+   * @brief Gets the number of stored samples.
+   * @return The number of samples.
+   */
+  auto Size() const -> size_t;
+
+ private:
+  // Ring of samples
+  std::vector<LocalSample> samples_;
+
+  // Index of the oldest sample
+  size_t start_ = 0;
+
+  // Number of stored samples
+  size_t size_ = 0;
+
+  // Mutex for thread safety
+  mutable absl::Mutex mutex_;
+};
+
+}  // namespace core
+}  // namespace tiny_dds
+
+#endif  // TINY_DDS_CORE_WRITER_HISTORY_H_
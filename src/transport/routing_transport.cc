@@ -0,0 +1,273 @@
+#include "src/transport/routing_transport.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <random>
+#include <utility>
+
+namespace tiny_dds::transport {
+
+// Largest UDP payload, used to size the receive buffer
+constexpr size_t kMaxDatagramSize = 64 * 1024;
+
+// Number of sequence numbers behind the highest one that are still tracked
+constexpr uint64_t kReceivedWindowSize = 64;
+
+namespace {
+
+// Endpoint of one writer; sequence numbers are assigned without taking a lock
+class RoutingEndpoint : public TransportEndpoint {
+ public:
+  RoutingEndpoint(std::shared_ptr<RoutingTransport> transport, std::string topic_name,
+                  std::shared_ptr<TransportEndpoint> udp_endpoint)
+      : TransportEndpoint(transport, std::move(topic_name)),
+        routing_transport_(std::move(transport)),
+        udp_endpoint_(std::move(udp_endpoint)),
+        writer_guid_(RoutingTransport::GenerateGuid()) {}
+
+  auto Send(const void* data, size_t size) -> bool override {
+    uint64_t sequence_number = sequence_number_.fetch_add(1, std::memory_order_relaxed) + 1;
+    return routing_transport_->Route(topic_name_, writer_guid_, sequence_number, data, size,
+                                     udp_endpoint_.get());
+  }
+
+  // Only the datagrams to other hosts cross the network, so only they are marked
+  auto SetTransportPriority(const TransportPriorityQos& qos) -> bool override {
+    return udp_endpoint_->SetTransportPriority(qos);
+  }
+
+ private:
+  // The routing transport, kept without a downcast on every send
+  std::shared_ptr<RoutingTransport> routing_transport_;
+
+  // Resolved UDP endpoint of the topic
+  std::shared_ptr<TransportEndpoint> udp_endpoint_;
+
+  // GUID identifying this writer to readers
+  Guid writer_guid_;
+
+  // Last sequence number sent
+  std::atomic<uint64_t> sequence_number_{0};
+};
+
+}  // namespace
+
+auto RoutingTransport::Create(DomainId domain_id, const std::string& participant_name,
+                              size_t buffer_size, size_t max_message_size,
+                              const std::string& multicast_group, bool multicast_loopback)
+    -> std::shared_ptr<RoutingTransport> {
+  return std::shared_ptr<RoutingTransport>(new RoutingTransport(
+      domain_id, participant_name, buffer_size, max_message_size, multicast_group,
+      multicast_loopback));
+}
+
+RoutingTransport::RoutingTransport(DomainId domain_id, std::string participant_name,
+                                   size_t buffer_size, size_t max_message_size,
+                                   std::string multicast_group, bool multicast_loopback)
+    : domain_id_(domain_id),
+      participant_name_(std::move(participant_name)),
+      buffer_size_(buffer_size),
+      max_message_size_(max_message_size),
+      multicast_group_(std::move(multicast_group)),
+      multicast_loopback_(multicast_loopback),
+      transport_guid_(GenerateGuid()) {}
+
+auto RoutingTransport::Initialize() -> bool {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (udp_transport_) {
+    return true;
+  }
+
+  auto udp_transport = UdpTransport::Create(domain_id_, participant_name_);
+  udp_transport->EnableMulticast(multicast_group_, multicast_loopback_);
+  if (!udp_transport->Initialize()) {
+    std::cerr << "Failed to initialize UDP transport for domain " << domain_id_ << std::endl;
+    return false;
+  }
+
+  // Without shared memory, local readers are reached over UDP like remote ones
+  auto shm_transport =
+      SharedMemoryTransport::Create(domain_id_, participant_name_, buffer_size_, max_message_size_);
+  if (shm_transport->Initialize()) {
+    shm_transport_ = std::move(shm_transport);
+  } else {
+    std::cerr << "Shared memory unavailable for domain " << domain_id_ << ", using UDP only"
+              << std::endl;
+  }
+
+  udp_transport_ = std::move(udp_transport);
+  receive_buffer_.resize(sizeof(SampleHeader) + std::max(max_message_size_, kMaxDatagramSize));
+  return true;
+}
+
+auto RoutingTransport::Advertise(const std::string& topic_name) -> bool {
+  if (shm_transport_ && !shm_transport_->Advertise(topic_name)) {
+    std::cerr << "Topic " << topic_name << " will not be sent over shared memory" << std::endl;
+  }
+
+  return udp_transport_->Advertise(topic_name);
+}
+
+auto RoutingTransport::Subscribe(const std::string& topic_name) -> bool {
+  if (shm_transport_ && !shm_transport_->Subscribe(topic_name)) {
+    std::cerr << "Topic " << topic_name << " will not be received over shared memory"
+              << std::endl;
+  }
+
+  return udp_transport_->Subscribe(topic_name);
+}
+
+auto RoutingTransport::OpenEndpoint(const std::string& topic_name)
+    -> std::shared_ptr<TransportEndpoint> {
+  auto self = std::static_pointer_cast<RoutingTransport>(shared_from_this());
+  return std::make_shared<RoutingEndpoint>(std::move(self), topic_name,
+                                           udp_transport_->OpenEndpoint(topic_name));
+}
+
+auto RoutingTransport::Send(const std::string& topic_name, const void* data, size_t size)
+    -> bool {
+  uint64_t sequence_number = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sequence_number = ++sequence_numbers_[topic_name];
+  }
+
+  return Route(topic_name, transport_guid_, sequence_number, data, size, nullptr);
+}
+
+auto RoutingTransport::Route(const std::string& topic_name, const Guid& writer_guid,
+                             uint64_t sequence_number, const void* data, size_t size,
+                             TransportEndpoint* udp_endpoint) -> bool {
+  // Both transports take one contiguous buffer, so the header and payload are
+  // assembled once per sample in a buffer reused by the sending thread
+  thread_local std::vector<uint8_t> packet;
+  packet.resize(sizeof(SampleHeader) + size);
+
+  SampleHeader header{};
+  header.magic = MAGIC_NUMBER;
+  header.writer_guid = writer_guid;
+  header.sequence_number = sequence_number;
+  std::memcpy(packet.data(), &header, sizeof(header));
+  std::memcpy(packet.data() + sizeof(header), data, size);
+
+  bool sent = false;
+
+  // Readers on this host get the sample from shared memory
+  if (shm_transport_ && shm_transport_->HasSubscribers(topic_name)) {
+    sent = shm_transport_->Send(topic_name, packet.data(), packet.size());
+  }
+
+  // Readers on other hosts get it from the multicast group
+  bool sent_udp = udp_endpoint != nullptr
+                      ? udp_endpoint->Send(packet.data(), packet.size())
+                      : udp_transport_->Send(topic_name, packet.data(), packet.size());
+
+  return sent || sent_udp;
+}
+
+auto RoutingTransport::Receive(const std::string& topic_name, void* buffer, size_t buffer_size,
+                               size_t* bytes_received) -> bool {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // Copies a payload out, or reports its size if it does not fit
+  auto deliver = [&](const uint8_t* payload, size_t payload_size) -> bool {
+    if (bytes_received != nullptr) {
+      *bytes_received = payload_size;
+    }
+    if (buffer_size < payload_size) {
+      return false;
+    }
+    std::memcpy(buffer, payload, payload_size);
+    return true;
+  };
+
+  auto held = held_samples_.find(topic_name);
+  if (held != held_samples_.end()) {
+    if (!deliver(held->second.data(), held->second.size())) {
+      return false;
+    }
+    held_samples_.erase(held);
+    return true;
+  }
+
+  auto& windows = received_[topic_name];
+
+  for (Transport* transport : {static_cast<Transport*>(shm_transport_.get()),
+                               static_cast<Transport*>(udp_transport_.get())}) {
+    if (transport == nullptr) {
+      continue;
+    }
+
+    size_t packet_size = 0;
+    while (transport->Receive(topic_name, receive_buffer_.data(), receive_buffer_.size(),
+                              &packet_size)) {
+      SampleHeader header{};
+      if (packet_size < sizeof(header)) {
+        std::cerr << "Dropping truncated sample on topic " << topic_name << std::endl;
+        continue;
+      }
+
+      std::memcpy(&header, receive_buffer_.data(), sizeof(header));
+      if (header.magic != MAGIC_NUMBER) {
+        std::cerr << "Dropping sample without routing header on topic " << topic_name
+                  << std::endl;
+        continue;
+      }
+
+      // The same sample may arrive over both transports
+      if (!Accept(windows[header.writer_guid], header.sequence_number)) {
+        continue;
+      }
+
+      // The sample is accepted now, so one too large for the buffer is kept
+      // rather than lost, since its copy on the other transport is a duplicate
+      const uint8_t* payload = receive_buffer_.data() + sizeof(header);
+      size_t payload_size = packet_size - sizeof(header);
+      if (!deliver(payload, payload_size)) {
+        held_samples_[topic_name].assign(payload, payload + payload_size);
+        return false;
+      }
+      return true;
+    }
+  }
+
+  return false;
+}
+
+auto RoutingTransport::GenerateGuid() -> Guid {
+  thread_local std::mt19937_64 generator{std::random_device{}()};
+
+  Guid guid;
+  for (size_t offset = 0; offset < guid.value.size(); offset += sizeof(uint64_t)) {
+    uint64_t random = generator();
+    std::memcpy(guid.value.data() + offset, &random, sizeof(random));
+  }
+  return guid;
+}
+
+auto RoutingTransport::Accept(ReceivedWindow& window, uint64_t sequence_number) -> bool {
+  if (sequence_number > window.highest) {
+    uint64_t shift = sequence_number - window.highest;
+    window.mask = shift >= kReceivedWindowSize ? 0 : window.mask << shift;
+    window.mask |= 1;
+    window.highest = sequence_number;
+    return true;
+  }
+
+  uint64_t age = window.highest - sequence_number;
+  if (age >= kReceivedWindowSize) {
+    return false;
+  }
+
+  uint64_t bit = uint64_t{1} << age;
+  if ((window.mask & bit) != 0) {
+    return false;
+  }
+
+  window.mask |= bit;
+  return true;
+}
+
+}  // namespace tiny_dds::transport
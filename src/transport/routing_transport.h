@@ -0,0 +1,224 @@
+#ifndef TINY_DDS_TRANSPORT_ROUTING_TRANSPORT_H_
+#define TINY_DDS_TRANSPORT_ROUTING_TRANSPORT_H_
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "include/tiny_dds/transport.h"
+#include "include/tiny_dds/transport_types.h"
+#include "include/tiny_dds/types.h"
+#include "src/transport/shared_memory_transport.h"
+#include "src/transport/udp_transport.h"
+
+namespace tiny_dds::transport {
+
+/**
+ * @brief Routes every sample over shared memory and UDP multicast at once.
+ *
+ * A sample goes into the topic's shared memory ring when a reader on this host
+ * has subscribed to it, and to the topic's multicast group for readers on other
+ * hosts. Multicast loopback is off by default, so same-host readers only get the
+ * shared memory copy.
+ *
+ * Every sample carries the writer's GUID and a per-writer sequence number, and
+ * readers drop samples they have already received over the other transport.
+ * Readers that cannot open shared memory only receive over UDP, so they miss the
+ * samples of writers on the same host unless those enable multicast loopback.
+ */
+class RoutingTransport : public Transport {
+ public:
+  /**
+   * @brief Default multicast group for remote delivery.
+   */
+  static constexpr char kDefaultMulticastGroup[] = "239.255.0.1";
+
+  /**
+   * @brief Creates a new routing transport instance.
+   *
+   * @param domain_id The domain ID for this transport.
+   * @param participant_name The name of the participant using this transport.
+   * @param buffer_size The size of each shared memory ring.
+   * @param max_message_size The maximum size of a single message in shared memory.
+   * @param multicast_group The IPv4 multicast group used for remote hosts.
+   * @param multicast_loopback Whether multicast datagrams are also delivered on this host.
+   * @return A shared pointer to the created transport.
+   */
+  static auto Create(DomainId domain_id, const std::string& participant_name,
+                     size_t buffer_size = 1024 * 1024, size_t max_message_size = 64 * 1024,
+                     const std::string& multicast_group = kDefaultMulticastGroup,
+                     bool multicast_loopback = false) -> std::shared_ptr<RoutingTransport>;
+
+  /**
+   * @brief Initializes the shared memory and UDP transports.
+   *
+   * @return true if at least the UDP transport was initialized, false otherwise.
+   */
+  auto Initialize() -> bool override;
+
+  /**
+   * @brief Sends data to a topic on behalf of the transport's own writer GUID.
+   *
+   * @param topic_name The name of the topic.
+   * @param data Pointer to the data to send.
+   * @param size Size of the data in bytes.
+   * @return true if the data was sent on at least one transport, false otherwise.
+   */
+  auto Send(const std::string& topic_name, const void* data, size_t size) -> bool override;
+
+  /**
+   * @brief Receives the next sample of a topic that was not already received.
+   *
+   * A sample larger than the buffer is kept for the next call, see Transport::Receive.
+   *
+   * @param topic_name The name of the topic.
+   * @param buffer Pointer to the buffer to store the received data.
+   * @param buffer_size Size of the buffer in bytes.
+   * @param bytes_received Output parameter to store the number of bytes received.
+   * @return true if data was received successfully, false otherwise.
+   */
+  auto Receive(const std::string& topic_name, void* buffer, size_t buffer_size,
+               size_t* bytes_received) -> bool override;
+
+  /**
+   * @brief Subscribes to a topic on both transports.
+   *
+   * @param topic_name The name of the topic to subscribe to.
+   * @return true if the UDP subscription was successful, false otherwise.
+   */
+  auto Subscribe(const std::string& topic_name) -> bool override;
+
+  /**
+   * @brief Advertises a topic on both transports.
+   *
+   * @param topic_name The name of the topic to advertise.
+   * @return true if the UDP advertisement was successful, false otherwise.
+   */
+  auto Advertise(const std::string& topic_name) -> bool override;
+
+  /**
+   * @brief Gets the type of this transport.
+   *
+   * @return The transport type.
+   */
+  auto GetType() const -> TransportType override { return TransportType::AUTO; }
+
+  /**
+   * @brief Opens an endpoint with its own writer GUID and sequence numbers.
+   *
+   * @param topic_name The name of the topic.
+   * @return The endpoint for the topic.
+   */
+  auto OpenEndpoint(const std::string& topic_name) -> std::shared_ptr<TransportEndpoint> override;
+
+  /**
+   * @brief Sends a sample of a given writer over every transport that has readers for it.
+   *
+   * @param topic_name The name of the topic.
+   * @param writer_guid The GUID of the writer.
+   * @param sequence_number The writer's sequence number for the sample, starting at 1.
+   * @param data Pointer to the data to send.
+   * @param size Size of the data in bytes.
+   * @param udp_endpoint The topic's UDP endpoint, or nullptr to send through the transport.
+   * @return true if the data was sent on at least one transport, false otherwise.
+   */
+  auto Route(const std::string& topic_name, const Guid& writer_guid, uint64_t sequence_number,
+             const void* data, size_t size, TransportEndpoint* udp_endpoint) -> bool;
+
+  /**
+   * @brief Generates a random writer GUID.
+   *
+   * @return The GUID.
+   */
+  static auto GenerateGuid() -> Guid;
+
+ private:
+  /**
+   * @brief Constructor.
+   */
+  RoutingTransport(DomainId domain_id, std::string participant_name, size_t buffer_size,
+                   size_t max_message_size, std::string multicast_group, bool multicast_loopback);
+
+  /**
+   * @brief Header in front of every routed sample.
+   */
+  struct SampleHeader {
+    uint32_t magic;            // Identifies routed samples
+    uint32_t reserved;         // Padding, always zero
+    Guid writer_guid;          // Writer that produced the sample
+    uint64_t sequence_number;  // Writer's sequence number for the sample
+  };
+
+  /**
+   * @brief Sequence numbers recently received from one writer.
+   */
+  struct ReceivedWindow {
+    uint64_t highest{0};  // Highest sequence number received
+    uint64_t mask{0};     // Bit i set if highest - i was received
+  };
+
+  /**
+   * @brief Hashes a GUID for use as a map key.
+   */
+  struct GuidHash {
+    auto operator()(const Guid& guid) const -> size_t {
+      uint64_t high = 0;
+      uint64_t low = 0;
+      std::memcpy(&high, guid.value.data(), sizeof(high));
+      std::memcpy(&low, guid.value.data() + sizeof(high), sizeof(low));
+      return static_cast<size_t>(high ^ (low * 0x9E3779B97F4A7C15ULL));
+    }
+  };
+
+  // Records a sequence number; returns false if it was already received or is too old
+  static auto Accept(ReceivedWindow& window, uint64_t sequence_number) -> bool;
+
+  // Domain ID for this transport
+  DomainId domain_id_;
+
+  // Participant name
+  std::string participant_name_;
+
+  // Shared memory ring geometry
+  size_t buffer_size_;
+  size_t max_message_size_;
+
+  // Multicast settings for the UDP transport
+  std::string multicast_group_;
+  bool multicast_loopback_;
+
+  // Transport for readers on this host, or null if shared memory is unavailable
+  std::shared_ptr<SharedMemoryTransport> shm_transport_;
+
+  // Transport for readers on other hosts
+  std::shared_ptr<UdpTransport> udp_transport_;
+
+  // Writer GUID for samples sent without an endpoint
+  Guid transport_guid_;
+
+  // Mutex for thread safety
+  std::mutex mutex_;
+
+  // Last sequence number sent without an endpoint, by topic name
+  std::unordered_map<std::string, uint64_t> sequence_numbers_;
+
+  // Recently received sequence numbers, by topic name and writer GUID
+  std::unordered_map<std::string, std::unordered_map<Guid, ReceivedWindow, GuidHash>> received_;
+
+  // Receive buffer for a header plus the largest payload
+  std::vector<uint8_t> receive_buffer_;
+
+  // Accepted payloads that did not fit the caller's buffer, by topic name
+  std::unordered_map<std::string, std::vector<uint8_t>> held_samples_;
+
+  // Magic number for sample headers
+  static constexpr uint32_t MAGIC_NUMBER = 0x54524444;  // "DDRT" in ASCII
+};
+
+}  // namespace tiny_dds::transport
+
+#endif  // TINY_DDS_TRANSPORT_ROUTING_TRANSPORT_H_
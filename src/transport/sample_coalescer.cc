@@ -0,0 +1,182 @@
+#include "src/transport/sample_coalescer.h"
+
+#include <cstring>
+#include <iostream>
+
+namespace tiny_dds::transport {
+
+auto SampleCoalescer::Create(const CoalescingConfig& config, FlushCallback flush_callback)
+    -> std::shared_ptr<SampleCoalescer> {
+  return std::shared_ptr<SampleCoalescer>(new SampleCoalescer(config, std::move(flush_callback)));
+}
+
+SampleCoalescer::SampleCoalescer(const CoalescingConfig& config, FlushCallback flush_callback)
+    : config_(config),
+      flush_callback_(std::move(flush_callback)),
+      record_count_(0),
+      stop_(false) {
+  buffer_.reserve(config_.max_datagram_size);
+  flush_thread_ = std::thread(&SampleCoalescer::FlushLoop, this);
+}
+
+SampleCoalescer::~SampleCoalescer() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+
+  if (flush_thread_.joinable()) {
+    flush_thread_.join();
+  }
+
+  // Do not drop samples that were accepted by Add()
+  std::lock_guard<std::mutex> lock(mutex_);
+  FlushLocked();
+}
+
+auto SampleCoalescer::Add(const std::string& topic_name, const void* data, size_t size) -> bool {
+  const size_t record_size = EncodedSize(topic_name, size);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  bool result = true;
+
+  // Close the current datagram if this record does not fit in it
+  if (record_count_ > 0 && buffer_.size() + record_size > config_.max_datagram_size) {
+    result = FlushLocked();
+  }
+
+  const bool was_empty = record_count_ == 0;
+  AppendLocked(topic_name, data, size);
+
+  // Oversized samples and exactly full datagrams leave immediately
+  if (buffer_.size() >= config_.max_datagram_size) {
+    return FlushLocked() && result;
+  }
+
+  // The first record of a datagram starts the latency budget
+  if (was_empty) {
+    deadline_ = std::chrono::steady_clock::now() + config_.latency_budget;
+    cv_.notify_one();
+  }
+
+  return result;
+}
+
+auto SampleCoalescer::Flush() -> bool {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return FlushLocked();
+}
+
+auto SampleCoalescer::IsCoalesced(const void* data, size_t size) -> bool {
+  if (data == nullptr || size < sizeof(BundleHeader)) {
+    return false;
+  }
+
+  BundleHeader header{};
+  std::memcpy(&header, data, sizeof(header));
+  return header.magic == MAGIC_NUMBER;
+}
+
+auto SampleCoalescer::Unpack(const void* data, size_t size, const RecordCallback& callback)
+    -> bool {
+  if (!IsCoalesced(data, size)) {
+    return false;
+  }
+
+  const auto* bytes = static_cast<const uint8_t*>(data);
+
+  BundleHeader header{};
+  std::memcpy(&header, bytes, sizeof(header));
+
+  size_t offset = sizeof(header);
+  std::string topic_name;
+
+  for (uint32_t i = 0; i < header.record_count; ++i) {
+    if (size - offset < sizeof(RecordHeader)) {
+      std::cerr << "Truncated coalesced datagram" << std::endl;
+      return false;
+    }
+
+    RecordHeader record{};
+    std::memcpy(&record, bytes + offset, sizeof(record));
+    offset += sizeof(record);
+
+    if (size - offset < static_cast<size_t>(record.topic_length) + record.payload_length) {
+      std::cerr << "Truncated coalesced datagram" << std::endl;
+      return false;
+    }
+
+    topic_name.assign(reinterpret_cast<const char*>(bytes + offset), record.topic_length);
+    offset += record.topic_length;
+
+    callback(topic_name, bytes + offset, record.payload_length);
+    offset += record.payload_length;
+  }
+
+  return true;
+}
+
+auto SampleCoalescer::EncodedSize(const std::string& topic_name, size_t size) -> size_t {
+  return sizeof(RecordHeader) + topic_name.size() + size;
+}
+
+void SampleCoalescer::AppendLocked(const std::string& topic_name, const void* data, size_t size) {
+  if (record_count_ == 0) {
+    buffer_.resize(sizeof(BundleHeader));
+  }
+
+  RecordHeader record{};
+  record.topic_length = static_cast<uint32_t>(topic_name.size());
+  record.payload_length = static_cast<uint32_t>(size);
+
+  const size_t offset = buffer_.size();
+  buffer_.resize(offset + EncodedSize(topic_name, size));
+
+  std::memcpy(&buffer_[offset], &record, sizeof(record));
+  std::memcpy(&buffer_[offset + sizeof(record)], topic_name.data(), topic_name.size());
+  if (size > 0) {
+    std::memcpy(&buffer_[offset + sizeof(record) + topic_name.size()], data, size);
+  }
+
+  ++record_count_;
+}
+
+auto SampleCoalescer::FlushLocked() -> bool {
+  if (record_count_ == 0) {
+    return true;
+  }
+
+  BundleHeader header{};
+  header.magic = MAGIC_NUMBER;
+  header.record_count = record_count_;
+  std::memcpy(buffer_.data(), &header, sizeof(header));
+
+  const bool result = flush_callback_ && flush_callback_(buffer_.data(), buffer_.size());
+
+  buffer_.clear();
+  record_count_ = 0;
+
+  return result;
+}
+
+void SampleCoalescer::FlushLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (!stop_) {
+    if (record_count_ == 0) {
+      cv_.wait(lock, [this] { return stop_ || record_count_ > 0; });
+      continue;
+    }
+
+    // Sleep until the latency budget of the pending datagram expires. A flush
+    // triggered by Add() in the meantime re-arms the deadline for the next one.
+    if (cv_.wait_until(lock, deadline_) == std::cv_status::timeout && record_count_ > 0 &&
+        std::chrono::steady_clock::now() >= deadline_) {
+      FlushLocked();
+    }
+  }
+}
+
+}  // namespace tiny_dds::transport
@@ -0,0 +1,179 @@
+#ifndef TINY_DDS_TRANSPORT_SAMPLE_COALESCER_H_
+#define TINY_DDS_TRANSPORT_SAMPLE_COALESCER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "include/tiny_dds/transport_types.h"
+
+namespace tiny_dds::transport {
+
+/**
+ * @brief Packs small samples from several topics into shared datagrams.
+ *
+ * Samples are appended to a datagram buffer as (topic, payload) records. The
+ * buffer is handed to the flush callback when the next sample would not fit,
+ * or when the oldest buffered sample has waited for the configured latency
+ * budget. A background thread enforces the latency budget.
+ *
+ * Datagram layout (host byte order, all peers are expected to share it):
+ *   BundleHeader | RecordHeader topic payload | RecordHeader topic payload | ...
+ */
+class SampleCoalescer {
+ public:
+  /**
+   * @brief Callback invoked with a complete datagram.
+   *
+   * @param data Pointer to the datagram.
+   * @param size Size of the datagram in bytes.
+   * @return true if the datagram was sent successfully, false otherwise.
+   */
+  using FlushCallback = std::function<bool(const void* data, size_t size)>;
+
+  /**
+   * @brief Callback invoked for every record while unpacking a datagram.
+   *
+   * @param topic_name The topic the sample was written on.
+   * @param data Pointer to the sample payload inside the datagram.
+   * @param size Size of the sample payload in bytes.
+   */
+  using RecordCallback =
+      std::function<void(const std::string& topic_name, const void* data, size_t size)>;
+
+  /**
+   * @brief Creates a coalescer and starts its flush thread.
+   *
+   * @param config The coalescing configuration.
+   * @param flush_callback Callback used to send completed datagrams.
+   * @return A shared pointer to the created coalescer.
+   */
+  static auto Create(const CoalescingConfig& config, FlushCallback flush_callback)
+      -> std::shared_ptr<SampleCoalescer>;
+
+  /**
+   * @brief Destructor, flushes any buffered samples and stops the flush thread.
+   */
+  ~SampleCoalescer();
+
+  SampleCoalescer(const SampleCoalescer&) = delete;
+  auto operator=(const SampleCoalescer&) -> SampleCoalescer& = delete;
+
+  /**
+   * @brief Appends a sample to the current datagram.
+   *
+   * Samples that are too large to share a datagram are flushed on their own.
+   *
+   * @param topic_name The topic the sample is written on.
+   * @param data Pointer to the sample payload.
+   * @param size Size of the sample payload in bytes.
+   * @return true if the sample was buffered or sent, false otherwise.
+   */
+  auto Add(const std::string& topic_name, const void* data, size_t size) -> bool;
+
+  /**
+   * @brief Sends the current datagram immediately, if it holds any samples.
+   *
+   * @return true if nothing was pending or the datagram was sent, false otherwise.
+   */
+  auto Flush() -> bool;
+
+  /**
+   * @brief Gets the longest time a sample waits in the coalescer.
+   *
+   * @return The latency budget of the configuration.
+   */
+  auto GetLatencyBudget() const -> std::chrono::microseconds { return config_.latency_budget; }
+
+  /**
+   * @brief Checks whether a buffer holds a coalesced datagram.
+   *
+   * @param data Pointer to the received data.
+   * @param size Size of the received data in bytes.
+   * @return true if the data starts with a valid bundle header.
+   */
+  static auto IsCoalesced(const void* data, size_t size) -> bool;
+
+  /**
+   * @brief Unpacks a coalesced datagram, invoking the callback for each record.
+   *
+   * @param data Pointer to the datagram.
+   * @param size Size of the datagram in bytes.
+   * @param callback Callback invoked for each record.
+   * @return true if the whole datagram was well formed, false otherwise.
+   */
+  static auto Unpack(const void* data, size_t size, const RecordCallback& callback) -> bool;
+
+  /**
+   * @brief Returns the number of bytes a sample occupies inside a datagram.
+   *
+   * @param topic_name The topic the sample is written on.
+   * @param size Size of the sample payload in bytes.
+   * @return The encoded record size in bytes.
+   */
+  static auto EncodedSize(const std::string& topic_name, size_t size) -> size_t;
+
+ private:
+  SampleCoalescer(const CoalescingConfig& config, FlushCallback flush_callback);
+
+  // Header at the start of every coalesced datagram
+  struct BundleHeader {
+    uint32_t magic;         // Identifies coalesced datagrams
+    uint32_t record_count;  // Number of records that follow
+  };
+
+  // Header in front of every record
+  struct RecordHeader {
+    uint32_t topic_length;    // Length of the topic name that follows
+    uint32_t payload_length;  // Length of the payload that follows the topic name
+  };
+
+  // Appends a record to the buffer; the caller holds mutex_
+  void AppendLocked(const std::string& topic_name, const void* data, size_t size);
+
+  // Sends the buffered datagram; the caller holds mutex_
+  auto FlushLocked() -> bool;
+
+  // Flush thread body, enforces the latency budget
+  void FlushLoop();
+
+  // Coalescing configuration
+  CoalescingConfig config_;
+
+  // Callback used to send completed datagrams
+  FlushCallback flush_callback_;
+
+  // Datagram under construction
+  std::vector<uint8_t> buffer_;
+
+  // Number of records in the datagram under construction
+  uint32_t record_count_;
+
+  // Time at which the datagram under construction must be flushed
+  std::chrono::steady_clock::time_point deadline_;
+
+  // Mutex for thread safety
+  std::mutex mutex_;
+
+  // Wakes the flush thread when the first record is buffered or on shutdown
+  std::condition_variable cv_;
+
+  // Flag to stop the flush thread
+  bool stop_;
+
+  // Thread enforcing the latency budget
+  std::thread flush_thread_;
+
+  // Magic number for bundle headers
+  static constexpr uint32_t MAGIC_NUMBER = 0x42445444;  // "DTDB" in ASCII
+};
+
+}  // namespace tiny_dds::transport
+
+#endif  // TINY_DDS_TRANSPORT_SAMPLE_COALESCER_H_
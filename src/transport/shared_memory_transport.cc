@@ -29,6 +29,15 @@ SharedMemoryTransport::SharedMemoryTransport(DomainId domain_id, std::string par
       initialized_(false) {}
 
 SharedMemoryTransport::~SharedMemoryTransport() {
+  // Stop counting as a subscriber before the segments go away
+  for (const auto& topic_name : subscribed_topics_) {
+    auto it = segments_.find(topic_name);
+    if (it != segments_.end() && it->second.memory != nullptr) {
+      static_cast<RingBuffer*>(it->second.memory)
+          ->subscriber_count.fetch_sub(1, std::memory_order_acq_rel);
+    }
+  }
+
   // Close all shared memory segments
   for (auto& pair : segments_) {
     CloseSegment(pair.second);
@@ -36,7 +45,7 @@ SharedMemoryTransport::~SharedMemoryTransport() {
 }
 
 auto SharedMemoryTransport::Initialize() -> bool {
-  std::lock_guard<std::mutex> lock(mutex_);
+  std::unique_lock<std::shared_mutex> lock(mutex_);
 
   if (initialized_) {
     return true;
@@ -49,7 +58,7 @@ auto SharedMemoryTransport::Initialize() -> bool {
 }
 
 auto SharedMemoryTransport::Advertise(const std::string& topic_name) -> bool {
-  std::lock_guard<std::mutex> lock(mutex_);
+  std::unique_lock<std::shared_mutex> lock(mutex_);
 
   // Check if we already have this segment
   auto it = segments_.find(topic_name);
@@ -64,12 +73,12 @@ auto SharedMemoryTransport::Advertise(const std::string& topic_name) -> bool {
     return false;
   }
 
-  // Initialize the ring buffer
+  // Drop stale messages left in the ring unless someone is reading it
   auto* buffer = static_cast<RingBuffer*>(segment.memory);
-  buffer->write_index.store(0, std::memory_order_relaxed);
-  buffer->read_index.store(0, std::memory_order_relaxed);
-  buffer->buffer_size = static_cast<uint32_t>(buffer_size_);
-  buffer->max_message_size = static_cast<uint32_t>(max_message_size_);
+  if (buffer->subscriber_count.load(std::memory_order_acquire) == 0) {
+    buffer->write_index.store(0, std::memory_order_relaxed);
+    buffer->read_index.store(0, std::memory_order_relaxed);
+  }
 
   // Store the segment
   segments_[topic_name] = segment;
@@ -78,27 +87,44 @@ auto SharedMemoryTransport::Advertise(const std::string& topic_name) -> bool {
 }
 
 auto SharedMemoryTransport::Subscribe(const std::string& topic_name) -> bool {
-  std::lock_guard<std::mutex> lock(mutex_);
+  std::unique_lock<std::shared_mutex> lock(mutex_);
 
-  // Check if we already have this segment
-  auto it = segments_.find(topic_name);
-  if (it != segments_.end()) {
-    return true;  // Already subscribed
+  // Check if we are already subscribed
+  if (subscribed_topics_.count(topic_name) > 0) {
+    return true;
   }
 
-  // Create a new shared memory segment for this topic
-  SharedMemorySegment segment(topic_name, buffer_size_);
-  if (!CreateOrOpenSegment(topic_name, segment)) {
-    std::cerr << "Failed to open shared memory segment for topic: " << topic_name << std::endl;
-    return false;
+  // Open the topic's segment unless it was already opened to advertise the topic
+  auto it = segments_.find(topic_name);
+  if (it == segments_.end()) {
+    SharedMemorySegment segment(topic_name, buffer_size_);
+    if (!CreateOrOpenSegment(topic_name, segment)) {
+      std::cerr << "Failed to open shared memory segment for topic: " << topic_name << std::endl;
+      return false;
+    }
+    it = segments_.emplace(topic_name, segment).first;
   }
 
-  // Store the segment
-  segments_[topic_name] = segment;
+  // Let writers on this host know the topic has a local reader
+  static_cast<RingBuffer*>(it->second.memory)
+      ->subscriber_count.fetch_add(1, std::memory_order_acq_rel);
+  subscribed_topics_.insert(topic_name);
 
   return true;
 }
 
+auto SharedMemoryTransport::HasSubscribers(const std::string& topic_name) -> bool {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+
+  auto it = segments_.find(topic_name);
+  if (it == segments_.end()) {
+    return false;
+  }
+
+  return static_cast<RingBuffer*>(it->second.memory)
+             ->subscriber_count.load(std::memory_order_acquire) > 0;
+}
+
 auto SharedMemoryTransport::Send(const std::string& topic_name, const void* data, size_t size)
     -> bool {
   if (size > max_message_size_) {
@@ -106,7 +132,7 @@ auto SharedMemoryTransport::Send(const std::string& topic_name, const void* data
     return false;
   }
 
-  std::lock_guard<std::mutex> lock(mutex_);
+  std::shared_lock<std::shared_mutex> lock(mutex_);
 
   // Find the segment for this topic
   auto it = segments_.find(topic_name);
@@ -115,16 +141,13 @@ auto SharedMemoryTransport::Send(const std::string& topic_name, const void* data
     return false;
   }
 
-  // Get the ring buffer
-  auto* buffer = static_cast<RingBuffer*>(it->second.memory);
-
   // Write the message to the ring buffer
-  return WriteToRingBuffer(buffer, topic_name, data, size);
+  return WriteToRingBuffer(it->second, topic_name, data, size);
 }
 
 auto SharedMemoryTransport::Receive(const std::string& topic_name, void* buffer, size_t buffer_size,
                                     size_t* bytes_received) -> bool {
-  std::lock_guard<std::mutex> lock(mutex_);
+  std::shared_lock<std::shared_mutex> lock(mutex_);
 
   // Find the segment for this topic
   auto it = segments_.find(topic_name);
@@ -137,6 +160,7 @@ auto SharedMemoryTransport::Receive(const std::string& topic_name, void* buffer,
   auto* ring_buffer = static_cast<RingBuffer*>(it->second.memory);
 
   // Read a message from the ring buffer
+  std::lock_guard<std::mutex> read_lock(*it->second.read_mutex);
   return ReadFromRingBuffer(ring_buffer, topic_name, buffer, buffer_size, bytes_received);
 }
 
@@ -171,7 +195,7 @@ auto SharedMemoryTransport::CreateOrOpenSegment(const std::string& topic_name,
 
   // Map the shared memory segment
   void* memory = mmap(nullptr, total_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
-  if (memory == nullptr) {
+  if (memory == MAP_FAILED) {
     std::cerr << "Failed to map shared memory: " << strerror(errno) << std::endl;
     close(fd);
     return false;
@@ -180,6 +204,14 @@ auto SharedMemoryTransport::CreateOrOpenSegment(const std::string& topic_name,
   // Close the file descriptor (the mapping remains valid)
   close(fd);
 
+  // A new segment is zero-filled; set up its ring geometry. Whoever opens it
+  // first, advertiser or subscriber, does this, and later openers keep it.
+  auto* buffer = static_cast<RingBuffer*>(memory);
+  if (buffer->buffer_size == 0) {
+    buffer->buffer_size = static_cast<uint32_t>(segment.size);
+    buffer->max_message_size = static_cast<uint32_t>(max_message_size_);
+  }
+
   // Update the segment
   segment.name = shm_name;
   segment.memory = memory;
@@ -199,8 +231,11 @@ void SharedMemoryTransport::CloseSegment(SharedMemorySegment& segment) {
   }
 }
 
-auto SharedMemoryTransport::WriteToRingBuffer(RingBuffer* buffer, const std::string& topic_name,
-                                              const void* data, size_t size) -> bool {
+auto SharedMemoryTransport::WriteToRingBuffer(const SharedMemorySegment& segment,
+                                              const std::string& topic_name, const void* data,
+                                              size_t size) -> bool {
+  auto* buffer = static_cast<RingBuffer*>(segment.memory);
+
   // Calculate the total size needed for the message (header + data)
   size_t total_size = sizeof(MessageHeader) + size;
   if (total_size > buffer->max_message_size) {
@@ -208,12 +243,42 @@ auto SharedMemoryTransport::WriteToRingBuffer(RingBuffer* buffer, const std::str
     return false;
   }
 
+  // Prepare the message header before taking the ring
+  MessageHeader header{};
+  header.magic = MAGIC_NUMBER;
+  header.size = static_cast<uint32_t>(size);
+  header.checksum = 0;  // TODO(fliu): Implement checksum
+  header.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+                         std::chrono::system_clock::now().time_since_epoch())
+                         .count();
+
+  // Copy the topic name and sender name
+  const char* topic_name_cstr = topic_name.c_str();
+  std::copy_n(topic_name_cstr, std::min(topic_name.length(), sizeof(header.topic_name) - 1),
+              header.topic_name);
+  header.topic_name[sizeof(header.topic_name) - 1] = '\0';
+
+  const char* participant_name_cstr = participant_name_.c_str();
+  std::copy_n(participant_name_cstr,
+              std::min(participant_name_.length(), sizeof(header.sender_name) - 1),
+              header.sender_name);
+  header.sender_name[sizeof(header.sender_name) - 1] = '\0';
+
+  std::lock_guard<std::mutex> lock(*segment.write_mutex);
+
   // Get the current write index
   uint32_t write_index = buffer->write_index.load(std::memory_order_relaxed);
 
   // Calculate the position in the buffer
   uint32_t position = write_index % buffer->buffer_size;
 
+  // Messages are never split; if one does not fit before the end of the ring,
+  // the rest of the lap is skipped and the message goes at the start
+  uint32_t padding = 0;
+  if (buffer->buffer_size - position < total_size) {
+    padding = buffer->buffer_size - position;
+  }
+
   // Check if there's enough space in the buffer
   uint32_t read_index = buffer->read_index.load(std::memory_order_acquire);
   uint32_t available_space;
@@ -224,32 +289,22 @@ auto SharedMemoryTransport::WriteToRingBuffer(RingBuffer* buffer, const std::str
     available_space = read_index - write_index;
   }
 
-  if (available_space <= total_size) {
+  if (available_space <= total_size + padding) {
     std::cerr << "Not enough space in the ring buffer" << std::endl;
     return false;
   }
 
-  // Prepare the message header
-  MessageHeader header{};
-  header.magic = MAGIC_NUMBER;
+  if (padding > 0) {
+    // Readers skip a tail too short for a header without needing a marker
+    if (padding >= sizeof(MessageHeader)) {
+      MessageHeader marker{};
+      marker.magic = WRAP_MAGIC_NUMBER;
+      std::memcpy(&buffer->data[position], &marker, sizeof(marker));
+    }
+    write_index += padding;
+    position = 0;
+  }
   header.sequence = write_index;
-  header.size = static_cast<uint32_t>(size);
-  header.checksum = 0;  // TODO(fliu): Implement checksum
-  header.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-                         std::chrono::system_clock::now().time_since_epoch())
-                         .count();
-
-  // Copy the topic name and sender name
-  const char* topic_name_cstr = topic_name.c_str();
-  std::copy_n(topic_name_cstr, std::min(topic_name.length(), sizeof(header.topic_name) - 1),
-              header.topic_name);
-  header.topic_name[sizeof(header.topic_name) - 1] = '\0';
-
-  const char* participant_name_cstr = participant_name_.c_str();
-  std::copy_n(participant_name_cstr,
-              std::min(participant_name_.length(), sizeof(header.sender_name) - 1),
-              header.sender_name);
-  header.sender_name[sizeof(header.sender_name) - 1] = '\0';
 
   // Write the header and data to the buffer
   size_t write_offset = position;
@@ -283,12 +338,24 @@ auto SharedMemoryTransport::ReadFromRingBuffer(RingBuffer* buffer, const std::st
   // Calculate the position in the buffer
   uint32_t position = read_index % buffer->buffer_size;
 
+  // Follow the writer back to the start of the ring when it skipped the tail
+  MessageHeader header{};
+  if (buffer->buffer_size - position >= sizeof(header)) {
+    std::memcpy(&header, &buffer->data[position], sizeof(header));
+  }
+  if (buffer->buffer_size - position < sizeof(header) || header.magic == WRAP_MAGIC_NUMBER) {
+    read_index += buffer->buffer_size - position;
+    buffer->read_index.store(read_index, std::memory_order_release);
+    if (read_index == write_index) {
+      return false;
+    }
+    position = 0;
+    std::memcpy(&header, &buffer->data[position], sizeof(header));
+  }
+
   // Read the header using indexing instead of pointer arithmetic
   size_t read_offset = position;
 
-  MessageHeader header{};
-  std::memcpy(&header, &buffer->data[read_offset], sizeof(header));
-
   // Verify the magic number
   if (header.magic != MAGIC_NUMBER) {
     std::cerr << "Invalid message header (magic number mismatch)" << std::endl;
@@ -5,8 +5,10 @@
 #include <cstdint>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "include/tiny_dds/transport.h"
 #include "include/tiny_dds/transport_types.h"
@@ -93,6 +95,14 @@ class SharedMemoryTransport : public Transport {
    */
   auto GetType() const -> TransportType override { return TransportType::SHARED_MEMORY; }
 
+  /**
+   * @brief Checks whether any transport on this host is subscribed to a topic.
+   *
+   * @param topic_name The name of the topic.
+   * @return true if at least one subscriber has the topic's segment open.
+   */
+  auto HasSubscribers(const std::string& topic_name) -> bool;
+
  private:
   // Private constructor
   SharedMemoryTransport(DomainId domain_id, std::string participant_name, size_t buffer_size,
@@ -104,6 +114,12 @@ class SharedMemoryTransport : public Transport {
     void* memory;
     size_t size;
 
+    // The ring has one write index and one read index, so the threads of this
+    // process writing to it, and those reading from it, take turns; other
+    // topics' rings are used in parallel
+    std::shared_ptr<std::mutex> write_mutex = std::make_shared<std::mutex>();
+    std::shared_ptr<std::mutex> read_mutex = std::make_shared<std::mutex>();
+
     // Default constructor
     SharedMemorySegment() : memory(nullptr), size(0) {}
 
@@ -125,11 +141,12 @@ class SharedMemoryTransport : public Transport {
 
   // Ring buffer structure
   struct RingBuffer {
-    std::atomic<uint32_t> write_index;  // Current write position
-    std::atomic<uint32_t> read_index;   // Current read position
-    uint32_t buffer_size;               // Total size of the buffer
-    uint32_t max_message_size;          // Maximum size of a single message
-    char data[1];                       // Flexible array member for the actual data
+    std::atomic<uint32_t> write_index;       // Current write position
+    std::atomic<uint32_t> read_index;        // Current read position
+    std::atomic<uint32_t> subscriber_count;  // Number of transports subscribed to the topic
+    uint32_t buffer_size;                    // Total size of the buffer
+    uint32_t max_message_size;               // Maximum size of a single message
+    char data[1];                            // Flexible array member for the actual data
   };
 
   // Creates or opens a shared memory segment
@@ -138,9 +155,9 @@ class SharedMemoryTransport : public Transport {
   // Closes a shared memory segment
   static void CloseSegment(SharedMemorySegment& segment);
 
-  // Writes a message to a ring buffer
-  auto WriteToRingBuffer(RingBuffer* buffer, const std::string& topic_name, const void* data,
-                         size_t size) -> bool;
+  // Writes a message to the ring buffer of a segment, taking its write mutex
+  auto WriteToRingBuffer(const SharedMemorySegment& segment, const std::string& topic_name,
+                         const void* data, size_t size) -> bool;
 
   // Reads a message from a ring buffer
   static auto ReadFromRingBuffer(RingBuffer* buffer, const std::string& topic_name, void* data,
@@ -161,14 +178,21 @@ class SharedMemoryTransport : public Transport {
   // Map of topic names to shared memory segments
   std::unordered_map<std::string, SharedMemorySegment> segments_;
 
-  // Mutex for thread safety
-  std::mutex mutex_;
+  // Topics this transport is counted as a subscriber of
+  std::unordered_set<std::string> subscribed_topics_;
+
+  // Guards segments_ and subscribed_topics_; sends and receives only look
+  // their segment up, so they share it
+  std::shared_mutex mutex_;
 
   // Flag to indicate if the transport is initialized
   bool initialized_;
 
   // Magic number for message headers
   static constexpr uint32_t MAGIC_NUMBER = 0x44445348;  // "SHDD" in ASCII
+
+  // Magic number of the marker that sends readers back to the start of the ring
+  static constexpr uint32_t WRAP_MAGIC_NUMBER = 0x50415257;  // "WRAP" in ASCII
 };
 
 }  // namespace tiny_dds::transport
@@ -0,0 +1,509 @@
+#include "src/transport/tcp_transport.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+namespace tiny_dds::transport {
+
+// Constants for port generation
+constexpr int kBaseTcpPortNumber = 30000;
+constexpr int kTcpPortRangeSize = 10000;
+
+// Connections accepted at once by the listening socket
+constexpr int kListenBacklog = 64;
+
+// Chunk size used when draining incoming connections
+constexpr size_t kReadChunkSize = 64 * 1024;
+
+// Frames larger than this are treated as a corrupted stream
+constexpr uint64_t kMaxFrameSize = 1ULL << 30;  // 1GB
+
+// Bound on how long a frame may block on a peer that stopped reading
+constexpr struct timeval kSendTimeout = {1, 0};  // 1 second
+
+// Bound on how long Advertise() waits for each peer to accept the connection
+constexpr std::chrono::milliseconds kConnectTimeout{1000};
+
+// Default peer when none has been added
+constexpr char kDefaultPeerAddress[] = "127.0.0.1";
+
+auto TcpTransport::Create(DomainId domain_id, const std::string& participant_name)
+    -> std::shared_ptr<TcpTransport> {
+  return std::shared_ptr<TcpTransport>(new TcpTransport(domain_id, participant_name));
+}
+
+TcpTransport::TcpTransport(DomainId domain_id, std::string participant_name)
+    : domain_id_(domain_id),
+      participant_name_(std::move(participant_name)),
+      initialized_(false),
+      no_delay_(true),
+      cork_(false),
+      listen_fd_(-1) {}
+
+TcpTransport::~TcpTransport() {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  for (auto& peer : peers_) {
+    if (peer->socket_fd >= 0) {
+      close(peer->socket_fd);
+    }
+  }
+
+  for (auto& connection : incoming_) {
+    close(connection.socket_fd);
+  }
+
+  if (listen_fd_ >= 0) {
+    close(listen_fd_);
+  }
+}
+
+auto TcpTransport::Initialize() -> bool {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (initialized_) {
+    return true;
+  }
+
+  // Nothing to do here for now, initialization happens when topics are advertised or subscribed
+
+  initialized_ = true;
+  return true;
+}
+
+void TcpTransport::AddPeer(const std::string& address, int port) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto peer = std::make_shared<PeerConnection>();
+  peer->address = address;
+  peer->port = port != 0 ? port : GetDomainPort(domain_id_);
+  peers_.push_back(std::move(peer));
+}
+
+void TcpTransport::SetNoDelay(bool no_delay) {
+  no_delay_ = no_delay;
+  for (const auto& peer : SnapshotPeers()) {
+    std::lock_guard<std::mutex> peer_lock(peer->mutex);
+    if (peer->connected) {
+      ApplySocketOptions(peer->socket_fd);
+    }
+  }
+}
+
+void TcpTransport::SetCork(bool cork) {
+  cork_ = cork;
+  for (const auto& peer : SnapshotPeers()) {
+    std::lock_guard<std::mutex> peer_lock(peer->mutex);
+    if (peer->connected) {
+      ApplySocketOptions(peer->socket_fd);
+    }
+  }
+}
+
+auto TcpTransport::GetDomainPort(DomainId domain_id) -> int {
+  return kBaseTcpPortNumber + static_cast<int>(domain_id % kTcpPortRangeSize);
+}
+
+auto TcpTransport::Advertise(const std::string& topic_name) -> bool {
+  std::vector<std::shared_ptr<PeerConnection>> peers;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    advertised_topics_.insert(topic_name);
+
+    if (peers_.empty()) {
+      auto peer = std::make_shared<PeerConnection>();
+      peer->address = kDefaultPeerAddress;
+      peer->port = GetDomainPort(domain_id_);
+      peers_.push_back(std::move(peer));
+    }
+    peers = peers_;
+  }
+
+  // Peers that are not up yet are retried on the next Send()
+  for (const auto& peer : peers) {
+    std::lock_guard<std::mutex> peer_lock(peer->mutex);
+    Connect(*peer, kConnectTimeout);
+  }
+
+  return true;
+}
+
+auto TcpTransport::Subscribe(const std::string& topic_name) -> bool {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (listen_fd_ < 0 && !Listen()) {
+    return false;
+  }
+
+  subscribed_topics_.insert(topic_name);
+  return true;
+}
+
+auto TcpTransport::Send(const std::string& topic_name, const void* data, size_t size) -> bool {
+  std::vector<std::shared_ptr<PeerConnection>> peers;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (advertised_topics_.count(topic_name) == 0) {
+      std::cerr << "Topic not advertised: " << topic_name << std::endl;
+      return false;
+    }
+    peers = peers_;
+  }
+
+  // Peers still connecting are skipped rather than waited for
+  bool sent = false;
+  for (const auto& peer : peers) {
+    std::lock_guard<std::mutex> peer_lock(peer->mutex);
+    if (!Connect(*peer, std::chrono::milliseconds(0))) {
+      continue;
+    }
+
+    if (WriteFrame(peer->socket_fd, topic_name, data, size)) {
+      sent = true;
+    } else {
+      Disconnect(*peer);
+    }
+  }
+
+  return sent;
+}
+
+auto TcpTransport::Receive(const std::string& topic_name, void* buffer, size_t buffer_size,
+                           size_t* bytes_received) -> bool {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (subscribed_topics_.count(topic_name) == 0) {
+    std::cerr << "Topic not subscribed: " << topic_name << std::endl;
+    return false;
+  }
+
+  auto it = pending_samples_.find(topic_name);
+  if (it == pending_samples_.end() || it->second.empty()) {
+    Poll();
+    it = pending_samples_.find(topic_name);
+    if (it == pending_samples_.end() || it->second.empty()) {
+      return false;  // No data available
+    }
+  }
+
+  // The sample stays queued until the caller has a buffer large enough for it
+  const std::vector<uint8_t>& sample = it->second.front();
+  if (buffer_size < sample.size()) {
+    if (bytes_received != nullptr) {
+      *bytes_received = sample.size();
+    }
+    return false;
+  }
+
+  std::memcpy(buffer, sample.data(), sample.size());
+  if (bytes_received != nullptr) {
+    *bytes_received = sample.size();
+  }
+
+  it->second.pop_front();
+  return true;
+}
+
+auto TcpTransport::Listen() -> bool {
+  int socket_fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (socket_fd < 0) {
+    std::cerr << "Failed to create socket: " << strerror(errno) << std::endl;
+    return false;
+  }
+
+  int reuse = 1;
+  if (setsockopt(socket_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0) {
+    std::cerr << "Failed to set socket options: " << strerror(errno) << std::endl;
+    close(socket_fd);
+    return false;
+  }
+
+  int flags = fcntl(socket_fd, F_GETFL, 0);
+  if (flags < 0 || fcntl(socket_fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+    std::cerr << "Failed to set socket to non-blocking mode: " << strerror(errno) << std::endl;
+    close(socket_fd);
+    return false;
+  }
+
+  struct sockaddr_in local_addr {};  // Zero-initialize the struct
+  local_addr.sin_family = AF_INET;
+  local_addr.sin_port = htons(GetDomainPort(domain_id_));
+  local_addr.sin_addr.s_addr = INADDR_ANY;  // Listen on all interfaces
+
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  if (bind(socket_fd, reinterpret_cast<struct sockaddr*>(&local_addr), sizeof(local_addr)) < 0) {
+    std::cerr << "Failed to bind socket: " << strerror(errno) << std::endl;
+    close(socket_fd);
+    return false;
+  }
+
+  if (listen(socket_fd, kListenBacklog) < 0) {
+    std::cerr << "Failed to listen on socket: " << strerror(errno) << std::endl;
+    close(socket_fd);
+    return false;
+  }
+
+  listen_fd_ = socket_fd;
+  return true;
+}
+
+auto TcpTransport::Connect(PeerConnection& peer, std::chrono::milliseconds timeout) -> bool {
+  if (peer.connected) {
+    return true;
+  }
+
+  // Start a non-blocking connect, or keep waiting for the one a previous call started
+  if (peer.socket_fd < 0) {
+    int socket_fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (socket_fd < 0) {
+      std::cerr << "Failed to create socket: " << strerror(errno) << std::endl;
+      return false;
+    }
+
+    struct sockaddr_in peer_addr {};  // Zero-initialize the struct
+    peer_addr.sin_family = AF_INET;
+    peer_addr.sin_port = htons(peer.port);
+    if (inet_pton(AF_INET, peer.address.c_str(), &peer_addr.sin_addr) <= 0) {
+      std::cerr << "Invalid address: " << peer.address << std::endl;
+      close(socket_fd);
+      return false;
+    }
+
+    int flags = fcntl(socket_fd, F_GETFL, 0);
+    if (flags < 0 || fcntl(socket_fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+      std::cerr << "Failed to set socket to non-blocking mode: " << strerror(errno) << std::endl;
+      close(socket_fd);
+      return false;
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    if (connect(socket_fd, reinterpret_cast<struct sockaddr*>(&peer_addr), sizeof(peer_addr)) < 0 &&
+        errno != EINPROGRESS) {
+      close(socket_fd);
+      return false;
+    }
+    peer.socket_fd = socket_fd;
+  }
+
+  struct pollfd poll_fd {};  // Zero-initialize the struct
+  poll_fd.fd = peer.socket_fd;
+  poll_fd.events = POLLOUT;
+  int ready = poll(&poll_fd, 1, static_cast<int>(timeout.count()));
+  if (ready == 0) {
+    return false;  // Still connecting
+  }
+
+  int error = 0;
+  socklen_t error_size = sizeof(error);
+  if (ready < 0 ||
+      getsockopt(peer.socket_fd, SOL_SOCKET, SO_ERROR, &error, &error_size) < 0 || error != 0) {
+    Disconnect(peer);
+    return false;
+  }
+
+  // The sending side is blocking so a frame is always written completely, but a
+  // peer that stops reading must not stall the publisher forever
+  int flags = fcntl(peer.socket_fd, F_GETFL, 0);
+  if (flags < 0 || fcntl(peer.socket_fd, F_SETFL, flags & ~O_NONBLOCK) < 0) {
+    std::cerr << "Failed to set socket to blocking mode: " << strerror(errno) << std::endl;
+    Disconnect(peer);
+    return false;
+  }
+  if (setsockopt(peer.socket_fd, SOL_SOCKET, SO_SNDTIMEO, &kSendTimeout, sizeof(kSendTimeout)) <
+      0) {
+    std::cerr << "Failed to set socket options: " << strerror(errno) << std::endl;
+  }
+
+  ApplySocketOptions(peer.socket_fd);
+  peer.connected = true;
+  return true;
+}
+
+void TcpTransport::Disconnect(PeerConnection& peer) {
+  close(peer.socket_fd);
+  peer.socket_fd = -1;
+  peer.connected = false;
+}
+
+auto TcpTransport::SnapshotPeers() -> std::vector<std::shared_ptr<PeerConnection>> {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return peers_;
+}
+
+void TcpTransport::ApplySocketOptions(int socket_fd) const {
+  int no_delay = no_delay_ ? 1 : 0;
+  if (setsockopt(socket_fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay)) < 0) {
+    std::cerr << "Failed to set TCP_NODELAY: " << strerror(errno) << std::endl;
+  }
+
+  int cork = cork_ ? 1 : 0;
+  if (setsockopt(socket_fd, IPPROTO_TCP, TCP_CORK, &cork, sizeof(cork)) < 0) {
+    std::cerr << "Failed to set TCP_CORK: " << strerror(errno) << std::endl;
+  }
+}
+
+auto TcpTransport::WriteFrame(int socket_fd, const std::string& topic_name, const void* data,
+                              size_t size) -> bool {
+  FrameHeader header{};
+  header.magic = MAGIC_NUMBER;
+  header.topic_length = static_cast<uint32_t>(topic_name.size());
+  header.payload_length = size;
+
+  // Header, topic and payload go out in one system call without being concatenated
+  std::array<struct iovec, 3> iov{};
+  iov[0].iov_base = &header;
+  iov[0].iov_len = sizeof(header);
+  iov[1].iov_base = const_cast<char*>(topic_name.data());
+  iov[1].iov_len = topic_name.size();
+  iov[2].iov_base = const_cast<void*>(data);
+  iov[2].iov_len = size;
+
+  size_t first = 0;
+  while (first < iov.size()) {
+    struct msghdr message {};
+    message.msg_iov = &iov[first];
+    message.msg_iovlen = iov.size() - first;
+
+    // sendmsg() is writev() with flags, MSG_NOSIGNAL turns a dropped peer into EPIPE
+    ssize_t written = sendmsg(socket_fd, &message, MSG_NOSIGNAL);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      std::cerr << "Failed to send data: " << strerror(errno) << std::endl;
+      return false;
+    }
+
+    // Skip the parts that were written completely and trim the partial one
+    auto remaining = static_cast<size_t>(written);
+    while (first < iov.size() && remaining >= iov[first].iov_len) {
+      remaining -= iov[first].iov_len;
+      ++first;
+    }
+    if (first < iov.size()) {
+      iov[first].iov_base = static_cast<uint8_t*>(iov[first].iov_base) + remaining;
+      iov[first].iov_len -= remaining;
+    }
+  }
+
+  return true;
+}
+
+void TcpTransport::Poll() {
+  // Accept connections from new publishers
+  while (listen_fd_ >= 0) {
+    int socket_fd = accept(listen_fd_, nullptr, nullptr);
+    if (socket_fd < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        std::cerr << "Failed to accept connection: " << strerror(errno) << std::endl;
+      }
+      break;
+    }
+
+    int flags = fcntl(socket_fd, F_GETFL, 0);
+    if (flags < 0 || fcntl(socket_fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+      std::cerr << "Failed to set socket to non-blocking mode: " << strerror(errno) << std::endl;
+      close(socket_fd);
+      continue;
+    }
+
+    IncomingConnection connection;
+    connection.socket_fd = socket_fd;
+    incoming_.push_back(std::move(connection));
+  }
+
+  // Drain every connection and split the stream into frames
+  for (auto it = incoming_.begin(); it != incoming_.end();) {
+    bool open = true;
+
+    while (true) {
+      const size_t used = it->buffer.size();
+      it->buffer.resize(used + kReadChunkSize);
+      ssize_t received = recv(it->socket_fd, &it->buffer[used], kReadChunkSize, MSG_DONTWAIT);
+      it->buffer.resize(used + std::max<ssize_t>(received, 0));
+
+      if (received > 0) {
+        continue;
+      }
+      if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        break;
+      }
+      if (received < 0 && errno == EINTR) {
+        continue;
+      }
+
+      // Orderly shutdown or error
+      open = false;
+      break;
+    }
+
+    if (!ParseFrames(*it)) {
+      open = false;
+    }
+
+    if (open) {
+      ++it;
+    } else {
+      close(it->socket_fd);
+      it = incoming_.erase(it);
+    }
+  }
+}
+
+auto TcpTransport::ParseFrames(IncomingConnection& connection) -> bool {
+  std::vector<uint8_t>& buffer = connection.buffer;
+
+  while (buffer.size() - connection.offset >= sizeof(FrameHeader)) {
+    FrameHeader header{};
+    std::memcpy(&header, &buffer[connection.offset], sizeof(header));
+
+    if (header.magic != MAGIC_NUMBER || header.payload_length > kMaxFrameSize) {
+      std::cerr << "Invalid frame header, closing connection" << std::endl;
+      return false;
+    }
+
+    const size_t frame_size = sizeof(header) + header.topic_length + header.payload_length;
+    if (buffer.size() - connection.offset < frame_size) {
+      break;  // Wait for the rest of the frame
+    }
+
+    const size_t topic_offset = connection.offset + sizeof(header);
+    std::string topic_name(reinterpret_cast<const char*>(&buffer[topic_offset]),
+                           header.topic_length);
+
+    if (subscribed_topics_.count(topic_name) != 0) {
+      const uint8_t* payload = &buffer[topic_offset + header.topic_length];
+      pending_samples_[topic_name].emplace_back(payload, payload + header.payload_length);
+    }
+
+    connection.offset += frame_size;
+  }
+
+  // Compact the buffer once everything parsed so far has been consumed
+  if (connection.offset == buffer.size()) {
+    buffer.clear();
+    connection.offset = 0;
+  } else if (connection.offset > kReadChunkSize) {
+    buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(connection.offset));
+    connection.offset = 0;
+  }
+
+  return true;
+}
+
+}  // namespace tiny_dds::transport
@@ -0,0 +1,244 @@
+#ifndef TINY_DDS_TRANSPORT_TCP_TRANSPORT_H_
+#define TINY_DDS_TRANSPORT_TCP_TRANSPORT_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "include/tiny_dds/transport.h"
+#include "include/tiny_dds/transport_types.h"
+#include "include/tiny_dds/types.h"
+
+namespace tiny_dds::transport {
+
+/**
+ * @brief Implements transport over TCP streams for large messages and lossy links.
+ *
+ * Every peer participant is reached over a single connection shared by all topics.
+ * Samples are framed with a fixed-size header followed by the topic name and the
+ * payload, and the three parts are sent with one scatter-gather call so the payload
+ * is never copied into a staging buffer.
+ *
+ * A transport that subscribes to a topic listens on the domain's TCP port and
+ * accepts connections from publishing transports; a transport that advertises a
+ * topic connects to its peers, which default to the local host.
+ *
+ * Frames are written under a lock of their peer only, and Send() never waits for
+ * a connection to be established, so a slow or dead peer does not hold up the
+ * other peers or Receive().
+ */
+class TcpTransport : public Transport {
+ public:
+  /**
+   * @brief Creates a new TCP transport instance.
+   *
+   * @param domain_id The domain ID for this transport.
+   * @param participant_name The name of the participant using this transport.
+   * @return A shared pointer to the created transport.
+   */
+  static auto Create(DomainId domain_id, const std::string& participant_name)
+      -> std::shared_ptr<TcpTransport>;
+
+  /**
+   * @brief Destructor, closes all connections.
+   */
+  ~TcpTransport() override;
+
+  /**
+   * @brief Initializes the transport.
+   *
+   * @return true if initialization was successful, false otherwise.
+   */
+  auto Initialize() -> bool override;
+
+  /**
+   * @brief Sends data to a topic on every connected peer.
+   *
+   * @param topic_name The name of the topic.
+   * @param data Pointer to the data to send.
+   * @param size Size of the data in bytes.
+   * @return true if the data was sent to at least one peer, false otherwise.
+   */
+  auto Send(const std::string& topic_name, const void* data, size_t size) -> bool override;
+
+  /**
+   * @brief Receives data from a topic.
+   *
+   * @param topic_name The name of the topic.
+   * @param buffer Pointer to the buffer to store the received data.
+   * @param buffer_size Size of the buffer in bytes.
+   * @param bytes_received Output parameter to store the number of bytes received.
+   * @return true if data was received successfully, false otherwise.
+   */
+  auto Receive(const std::string& topic_name, void* buffer, size_t buffer_size,
+               size_t* bytes_received) -> bool override;
+
+  /**
+   * @brief Subscribes to a topic, listening on the domain's TCP port if needed.
+   *
+   * @param topic_name The name of the topic to subscribe to.
+   * @return true if subscription was successful, false otherwise.
+   */
+  auto Subscribe(const std::string& topic_name) -> bool override;
+
+  /**
+   * @brief Advertises a topic, connecting to the known peers if needed.
+   *
+   * @param topic_name The name of the topic to advertise.
+   * @return true if advertisement was successful, false otherwise.
+   */
+  auto Advertise(const std::string& topic_name) -> bool override;
+
+  /**
+   * @brief Gets the type of this transport.
+   *
+   * @return The transport type.
+   */
+  auto GetType() const -> TransportType override { return TransportType::TCP; }
+
+  /**
+   * @brief Adds a peer participant to publish to.
+   *
+   * Without explicit peers the transport publishes to the local host.
+   *
+   * @param address The IPv4 address of the peer.
+   * @param port The TCP port of the peer, or 0 for the domain's default port.
+   */
+  void AddPeer(const std::string& address, int port = 0);
+
+  /**
+   * @brief Enables or disables TCP_NODELAY on all connections (enabled by default).
+   *
+   * @param no_delay Whether small frames are sent without Nagle delay.
+   */
+  void SetNoDelay(bool no_delay);
+
+  /**
+   * @brief Enables or disables TCP_CORK on all connections.
+   *
+   * While corked the kernel only sends full segments, which batches many small
+   * frames together. Uncorking flushes whatever is queued.
+   *
+   * @param cork Whether outgoing frames are held back until a segment is full.
+   */
+  void SetCork(bool cork);
+
+  /**
+   * @brief Gets the TCP port used by a domain.
+   *
+   * @param domain_id The domain ID.
+   * @return The TCP port.
+   */
+  static auto GetDomainPort(DomainId domain_id) -> int;
+
+ private:
+  /**
+   * @brief Constructor.
+   *
+   * @param domain_id The domain ID for this transport.
+   * @param participant_name The name of the participant using this transport.
+   */
+  TcpTransport(DomainId domain_id, std::string participant_name);
+
+  /**
+   * @brief Header in front of every frame on the stream.
+   */
+  struct FrameHeader {
+    uint32_t magic;           // Identifies the start of a frame
+    uint32_t topic_length;    // Length of the topic name that follows
+    uint64_t payload_length;  // Length of the payload that follows the topic name
+  };
+
+  /**
+   * @brief An outgoing connection to a peer participant.
+   */
+  struct PeerConnection {
+    std::string address;    // Peer IPv4 address
+    int port{0};            // Peer TCP port
+    std::mutex mutex;       // Serializes the frames written to the peer, guards the fields below
+    int socket_fd{-1};      // Connected or connecting socket, or -1
+    bool connected{false};  // Whether the connection on socket_fd is established
+  };
+
+  /**
+   * @brief An incoming connection from a publishing participant.
+   */
+  struct IncomingConnection {
+    int socket_fd{-1};            // Accepted socket
+    std::vector<uint8_t> buffer;  // Bytes received but not yet parsed
+    size_t offset{0};             // Start of the first unparsed frame in buffer
+  };
+
+  // Starts listening on the domain's port; the caller holds mutex_
+  auto Listen() -> bool;
+
+  // Connects to a peer if not already connected, waiting at most timeout for the handshake;
+  // the caller holds peer.mutex
+  auto Connect(PeerConnection& peer, std::chrono::milliseconds timeout) -> bool;
+
+  // Closes a peer's connection, it is re-established on the next Send(); the caller holds
+  // peer.mutex
+  static void Disconnect(PeerConnection& peer);
+
+  // Returns a copy of the peers, so they can be used without holding mutex_
+  auto SnapshotPeers() -> std::vector<std::shared_ptr<PeerConnection>>;
+
+  // Applies the current socket options to a connection
+  void ApplySocketOptions(int socket_fd) const;
+
+  // Writes a whole frame with scatter-gather sends, handling partial writes
+  static auto WriteFrame(int socket_fd, const std::string& topic_name, const void* data,
+                         size_t size) -> bool;
+
+  // Accepts new connections and parses received frames; the caller holds mutex_
+  void Poll();
+
+  // Parses complete frames out of a connection's buffer; the caller holds mutex_
+  auto ParseFrames(IncomingConnection& connection) -> bool;
+
+  // Domain ID for this transport
+  DomainId domain_id_;
+
+  // Participant name
+  std::string participant_name_;
+
+  // Mutex for thread safety
+  std::mutex mutex_;
+
+  // Flag to indicate if the transport is initialized
+  bool initialized_;
+
+  // Socket options applied to every connection, read without mutex_
+  std::atomic<bool> no_delay_;
+  std::atomic<bool> cork_;
+
+  // Listening socket, or -1 if nothing is subscribed
+  int listen_fd_;
+
+  // Topics advertised and subscribed on this transport
+  std::unordered_set<std::string> advertised_topics_;
+  std::unordered_set<std::string> subscribed_topics_;
+
+  // Outgoing connections, one per peer participant
+  std::vector<std::shared_ptr<PeerConnection>> peers_;
+
+  // Incoming connections, one per publishing participant
+  std::vector<IncomingConnection> incoming_;
+
+  // Received samples waiting to be read, by topic name
+  std::unordered_map<std::string, std::deque<std::vector<uint8_t>>> pending_samples_;
+
+  // Magic number for frame headers
+  static constexpr uint32_t MAGIC_NUMBER = 0x50435444;  // "DTCP" in ASCII
+};
+
+}  // namespace tiny_dds::transport
+
+#endif  // TINY_DDS_TRANSPORT_TCP_TRANSPORT_H_
@@ -4,6 +4,11 @@
 
 namespace tiny_dds::transport {
 
+auto TransportManager::GetInstance() -> std::shared_ptr<TransportManager> {
+  static const auto* instance = new std::shared_ptr<TransportManager>(new TransportManager());
+  return *instance;
+}
+
 auto TransportManager::Create() -> std::shared_ptr<TransportManager> {
   return std::shared_ptr<TransportManager>(new TransportManager());
 }
@@ -21,6 +26,17 @@ auto TransportManager::Send(DomainId domain_id, const std::string& topic_name, c
   return transport->Send(topic_name, data, size);
 }
 
+auto TransportManager::SendCoalesced(DomainId domain_id, const void* data, size_t size,
+                                     TransportType transport_type) -> bool {
+  auto transport = GetTransport(domain_id, transport_type);
+  if (!transport) {
+    std::cerr << "Transport not found for domain " << domain_id << std::endl;
+    return false;
+  }
+
+  return transport->SendCoalesced(data, size);
+}
+
 auto TransportManager::Receive(DomainId domain_id, const std::string& topic_name, void* buffer,
                                size_t buffer_size, size_t* bytes_received,
                                TransportType transport_type) -> bool {
@@ -40,7 +56,7 @@ auto TransportManager::CreateTransport(DomainId domain_id, const std::string& pa
   std::lock_guard<std::mutex> lock(mutex_);
 
   // Check if we already have a transport for this domain and type
-  auto transport = GetTransport(domain_id, transport_type);
+  auto transport = FindTransport(domain_id, transport_type);
   if (transport) {
     // Transport already exists, just return success
     return true;
@@ -68,6 +84,35 @@ auto TransportManager::CreateTransport(DomainId domain_id, const std::string& pa
       shared_memory_transports_[domain_id] = shm_transport;
       break;
     }
+    case TransportType::TCP: {
+      auto tcp_transport = TcpTransport::Create(domain_id, participant_name);
+      if (!tcp_transport || !tcp_transport->Initialize()) {
+        std::cerr << "Failed to create TCP transport for domain " << domain_id << std::endl;
+        return false;
+      }
+      tcp_transports_[domain_id] = tcp_transport;
+      break;
+    }
+    case TransportType::UNIX_SOCKET: {
+      auto unix_socket_transport = UnixSocketTransport::Create(domain_id, participant_name);
+      if (!unix_socket_transport || !unix_socket_transport->Initialize()) {
+        std::cerr << "Failed to create Unix domain socket transport for domain " << domain_id
+                  << std::endl;
+        return false;
+      }
+      unix_socket_transports_[domain_id] = unix_socket_transport;
+      break;
+    }
+    case TransportType::AUTO: {
+      auto routing_transport =
+          RoutingTransport::Create(domain_id, participant_name, buffer_size, max_message_size);
+      if (!routing_transport || !routing_transport->Initialize()) {
+        std::cerr << "Failed to create routing transport for domain " << domain_id << std::endl;
+        return false;
+      }
+      routing_transports_[domain_id] = routing_transport;
+      break;
+    }
     default:
       std::cerr << "Unsupported transport type" << std::endl;
       return false;
@@ -98,10 +143,26 @@ auto TransportManager::Subscribe(DomainId domain_id, const std::string& topic_na
   return transport->Subscribe(topic_name);
 }
 
+auto TransportManager::OpenEndpoint(DomainId domain_id, const std::string& topic_name,
+                                    TransportType transport_type)
+    -> std::shared_ptr<TransportEndpoint> {
+  auto transport = GetTransport(domain_id, transport_type);
+  if (!transport) {
+    std::cerr << "Transport not found for domain " << domain_id << std::endl;
+    return nullptr;
+  }
+
+  return transport->OpenEndpoint(topic_name);
+}
+
 auto TransportManager::GetTransport(DomainId domain_id, TransportType transport_type)
     -> std::shared_ptr<Transport> {
   std::lock_guard<std::mutex> lock(mutex_);
+  return FindTransport(domain_id, transport_type);
+}
 
+auto TransportManager::FindTransport(DomainId domain_id, TransportType transport_type)
+    -> std::shared_ptr<Transport> {
   switch (transport_type) {
     case TransportType::UDP: {
       auto it = udp_transports_.find(domain_id);
@@ -117,6 +178,27 @@ auto TransportManager::GetTransport(DomainId domain_id, TransportType transport_
       }
       break;
     }
+    case TransportType::TCP: {
+      auto it = tcp_transports_.find(domain_id);
+      if (it != tcp_transports_.end()) {
+        return it->second;
+      }
+      break;
+    }
+    case TransportType::UNIX_SOCKET: {
+      auto it = unix_socket_transports_.find(domain_id);
+      if (it != unix_socket_transports_.end()) {
+        return it->second;
+      }
+      break;
+    }
+    case TransportType::AUTO: {
+      auto it = routing_transports_.find(domain_id);
+      if (it != routing_transports_.end()) {
+        return it->second;
+      }
+      break;
+    }
     default:
       std::cerr << "Unsupported transport type" << std::endl;
       break;
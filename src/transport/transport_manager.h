@@ -10,8 +10,11 @@
 #include "include/tiny_dds/transport.h"
 #include "include/tiny_dds/transport_types.h"
 #include "include/tiny_dds/types.h"
+#include "src/transport/routing_transport.h"
 #include "src/transport/shared_memory_transport.h"
+#include "src/transport/tcp_transport.h"
 #include "src/transport/udp_transport.h"
+#include "src/transport/unix_socket_transport.h"
 
 namespace tiny_dds {
 namespace transport {
@@ -22,7 +25,14 @@ namespace transport {
 class TransportManager {
  public:
   /**
-   * @brief Creates a new transport manager.
+   * @brief Gets the transport manager shared by all entities in this process.
+   *
+   * @return std::shared_ptr<TransportManager> The process-wide manager.
+   */
+  static std::shared_ptr<TransportManager> GetInstance();
+
+  /**
+   * @brief Creates a new transport manager with its own transports.
    *
    * @return std::shared_ptr<TransportManager> The created manager.
    */
@@ -41,6 +51,18 @@ class TransportManager {
   bool Send(DomainId domain_id, const std::string& topic_name, const void* data, size_t size,
             TransportType transport_type = TransportType::UDP);
 
+  /**
+   * @brief Sends a coalesced datagram via the appropriate transport.
+   *
+   * @param domain_id The domain ID.
+   * @param data The coalesced datagram.
+   * @param size The size of the datagram.
+   * @param transport_type The transport type to use.
+   * @return true if successful, false otherwise.
+   */
+  bool SendCoalesced(DomainId domain_id, const void* data, size_t size,
+                     TransportType transport_type = TransportType::UDP);
+
   /**
    * @brief Receives data via the appropriate transport.
    *
@@ -92,6 +114,20 @@ class TransportManager {
   bool Subscribe(DomainId domain_id, const std::string& topic_name,
                  TransportType transport_type = TransportType::UDP);
 
+  /**
+   * @brief Opens an endpoint for an advertised or subscribed topic.
+   *
+   * DataWriters and DataReaders keep the endpoint for their lifetime, so the
+   * per-sample path does not go through the manager at all.
+   *
+   * @param domain_id The domain ID.
+   * @param topic_name The topic name.
+   * @param transport_type The transport type to use.
+   * @return std::shared_ptr<TransportEndpoint> The endpoint, or nullptr if there is no transport.
+   */
+  std::shared_ptr<TransportEndpoint> OpenEndpoint(DomainId domain_id, const std::string& topic_name,
+                                                  TransportType transport_type = TransportType::UDP);
+
  private:
   /**
    * @brief Constructor.
@@ -107,9 +143,21 @@ class TransportManager {
    */
   std::shared_ptr<Transport> GetTransport(DomainId domain_id, TransportType transport_type);
 
+  /**
+   * @brief Looks up the transport for the given type; the caller holds mutex_.
+   *
+   * @param domain_id The domain ID.
+   * @param transport_type The transport type.
+   * @return std::shared_ptr<Transport> The transport instance, or nullptr.
+   */
+  std::shared_ptr<Transport> FindTransport(DomainId domain_id, TransportType transport_type);
+
   // Map of domain ID to transport instances
   std::unordered_map<DomainId, std::shared_ptr<Transport>> udp_transports_;
   std::unordered_map<DomainId, std::shared_ptr<Transport>> shared_memory_transports_;
+  std::unordered_map<DomainId, std::shared_ptr<Transport>> tcp_transports_;
+  std::unordered_map<DomainId, std::shared_ptr<Transport>> unix_socket_transports_;
+  std::unordered_map<DomainId, std::shared_ptr<Transport>> routing_transports_;
 
   // Mutex for thread safety
   std::mutex mutex_;
@@ -6,10 +6,15 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <array>
 #include <cerrno>
 #include <cstring>
+#include <initializer_list>
 #include <iostream>
+#include <utility>
+
+#include "src/transport/sample_coalescer.h"
 
 namespace tiny_dds::transport {
 
@@ -18,25 +23,130 @@ constexpr int kBasePortNumber = 40000;
 constexpr int kPortRangeSize = 10000;
 constexpr size_t kBufferSize = 256;
 
+// Name hashed into the port shared by all coalesced datagrams of a domain
+constexpr char kCoalescedChannelName[] = "__tiny_dds_coalesced__";
+
+// Largest UDP payload, used to size the coalesced receive buffer
+constexpr size_t kMaxDatagramSize = 64 * 1024;
+
+// Upper bound on unpacked samples waiting per topic; the oldest are dropped first
+constexpr size_t kMaxPendingSamples = 1024;
+
+namespace {
+
+// Marks the datagrams of a socket with a transport priority
+auto MarkSocket(int socket_fd, const TransportPriorityQos& qos) -> bool {
+  // The DSCP is the upper six bits of the type of service byte
+  const int dscp = qos.dscp >= 0 ? qos.dscp : std::clamp(qos.value, 0, 7) * 8;
+  int tos = (dscp & 0x3f) << 2;
+  if (setsockopt(socket_fd, IPPROTO_IP, IP_TOS, &tos, sizeof(tos)) < 0) {
+    std::cerr << "Failed to set the DSCP of a socket: " << strerror(errno) << std::endl;
+    return false;
+  }
+
+#ifdef __linux__
+  // Set after IP_TOS, which also sets the priority; higher ones need CAP_NET_ADMIN
+  int priority = std::clamp(qos.value, 0, 6);
+  if (setsockopt(socket_fd, SOL_SOCKET, SO_PRIORITY, &priority, sizeof(priority)) < 0) {
+    std::cerr << "Failed to set the priority of a socket: " << strerror(errno) << std::endl;
+    return false;
+  }
+#endif
+
+  return true;
+}
+
+// Endpoint of an advertised topic; the socket stays open as long as the transport
+class UdpTopicEndpoint : public TransportEndpoint {
+ public:
+  UdpTopicEndpoint(std::shared_ptr<Transport> transport, std::string topic_name, int socket_fd,
+                   const struct sockaddr_in& destination)
+      : TransportEndpoint(std::move(transport), std::move(topic_name)),
+        socket_fd_(socket_fd),
+        destination_(destination) {}
+
+  ~UdpTopicEndpoint() override {
+    if (marked_socket_fd_ >= 0) {
+      close(marked_socket_fd_);
+    }
+  }
+
+  auto Send(const void* data, size_t size) -> bool override {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    ssize_t sent = sendto(socket_fd_, data, size, 0,
+                          reinterpret_cast<const struct sockaddr*>(&destination_),
+                          sizeof(destination_));
+    if (sent < 0) {
+      std::cerr << "Failed to send data: " << strerror(errno) << std::endl;
+      return false;
+    }
+
+    return true;
+  }
+
+  auto SetTransportPriority(const TransportPriorityQos& qos) -> bool override {
+    // Writers of a topic share its socket, so a marked writer sends from its own
+    int socket_fd = static_cast<UdpTransport*>(transport_.get())->OpenSendSocket();
+    if (socket_fd < 0) {
+      return false;
+    }
+    if (!MarkSocket(socket_fd, qos)) {
+      close(socket_fd);
+      return false;
+    }
+
+    if (marked_socket_fd_ >= 0) {
+      close(marked_socket_fd_);
+    }
+    marked_socket_fd_ = socket_fd;
+    socket_fd_ = socket_fd;
+    return true;
+  }
+
+ private:
+  // Socket the endpoint sends from: the publisher socket of the topic, or its marked socket
+  int socket_fd_;
+
+  // Socket marked with the writer's transport priority, owned by the endpoint, or -1
+  int marked_socket_fd_ = -1;
+
+  // Resolved destination address of the topic
+  struct sockaddr_in destination_;
+};
+
+}  // namespace
+
 auto UdpTransport::Create(DomainId domain_id, const std::string& participant_name)
     -> std::shared_ptr<UdpTransport> {
   return std::shared_ptr<UdpTransport>(new UdpTransport(domain_id, participant_name));
 }
 
 UdpTransport::UdpTransport(DomainId domain_id, std::string participant_name)
-    : domain_id_(domain_id), participant_name_(std::move(participant_name)), initialized_(false) {}
+    : domain_id_(domain_id),
+      participant_name_(std::move(participant_name)),
+      initialized_(false),
+      multicast_loopback_(false) {}
 
 UdpTransport::~UdpTransport() {
   // Close all sockets
   std::lock_guard<std::mutex> lock(mutex_);
 
-  for (auto& pair : udp_sockets_) {
-    if (pair.second.socket_fd >= 0) {
-      close(pair.second.socket_fd);
+  for (auto* sockets : {&publisher_sockets_, &subscriber_sockets_}) {
+    for (auto& pair : *sockets) {
+      if (pair.second.socket_fd >= 0) {
+        close(pair.second.socket_fd);
+      }
     }
+    sockets->clear();
+  }
+
+  if (coalesced_sender_.socket_fd >= 0) {
+    close(coalesced_sender_.socket_fd);
   }
 
-  udp_sockets_.clear();
+  if (coalesced_receiver_.socket_fd >= 0) {
+    close(coalesced_receiver_.socket_fd);
+  }
 }
 
 bool UdpTransport::Initialize() {
@@ -52,6 +162,12 @@ bool UdpTransport::Initialize() {
   return true;
 }
 
+void UdpTransport::EnableMulticast(const std::string& group, bool loopback) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  multicast_group_ = group;
+  multicast_loopback_ = loopback;
+}
+
 bool UdpTransport::Advertise(const std::string& topic_name) { return CreateSocket(topic_name); }
 
 bool UdpTransport::Subscribe(const std::string& topic_name) { return ConnectToSocket(topic_name); }
@@ -60,15 +176,57 @@ auto UdpTransport::Send(const std::string& topic_name, const void* data, size_t
   std::lock_guard<std::mutex> lock(mutex_);
 
   // Find the socket for this topic
-  auto it = udp_sockets_.find(topic_name);
-  if (it == udp_sockets_.end()) {
+  auto it = publisher_sockets_.find(topic_name);
+  if (it == publisher_sockets_.end()) {
     std::cerr << "Socket not found for topic: " << topic_name << std::endl;
     return false;
   }
 
-  // Get the socket info
-  const UdpSocketInfo& info = it->second;
+  return SendTo(it->second, data, size);
+}
 
+auto UdpTransport::OpenEndpoint(const std::string& topic_name)
+    -> std::shared_ptr<TransportEndpoint> {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // Reader-only endpoints receive through the transport as usual
+  auto it = publisher_sockets_.find(topic_name);
+  if (it == publisher_sockets_.end()) {
+    return Transport::OpenEndpoint(topic_name);
+  }
+
+  struct sockaddr_in destination {};  // Zero-initialize the struct
+  destination.sin_family = AF_INET;
+  destination.sin_port = htons(it->second.port);
+  if (inet_pton(AF_INET, it->second.address.c_str(), &destination.sin_addr) <= 0) {
+    std::cerr << "Invalid address: " << it->second.address << std::endl;
+    return Transport::OpenEndpoint(topic_name);
+  }
+
+  return std::make_shared<UdpTopicEndpoint>(shared_from_this(), topic_name, it->second.socket_fd,
+                                            destination);
+}
+
+auto UdpTransport::SendCoalesced(const void* data, size_t size) -> bool {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // Lazily create the sending socket for the coalesced channel, addressed like the topic sockets
+  if (coalesced_sender_.socket_fd < 0) {
+    int socket_fd = OpenSendSocketLocked();
+    if (socket_fd < 0) {
+      return false;
+    }
+
+    coalesced_sender_.socket_fd = socket_fd;
+    coalesced_sender_.port = GenerateUdpPort(kCoalescedChannelName);
+    coalesced_sender_.address = multicast_group_.empty() ? "0.0.0.0" : multicast_group_;
+    coalesced_sender_.is_publisher = true;
+  }
+
+  return SendTo(coalesced_sender_, data, size);
+}
+
+auto UdpTransport::SendTo(const UdpSocketInfo& info, const void* data, size_t size) -> bool {
   // Set up the destination address
   struct sockaddr_in dest_addr {};  // Zero-initialize the struct
   dest_addr.sin_family = AF_INET;
@@ -99,12 +257,43 @@ auto UdpTransport::Receive(const std::string& topic_name, void* buffer, size_t b
   std::lock_guard<std::mutex> lock(mutex_);
 
   // Find the socket for this topic
-  auto it = udp_sockets_.find(topic_name);
-  if (it == udp_sockets_.end()) {
+  auto it = subscriber_sockets_.find(topic_name);
+  if (it == subscriber_sockets_.end()) {
     std::cerr << "Socket not found for topic: " << topic_name << std::endl;
     return false;
   }
 
+  // Samples unpacked from coalesced datagrams are delivered first
+  bool too_small = false;
+  auto pop_pending = [&]() -> bool {
+    auto pending_it = pending_samples_.find(topic_name);
+    if (pending_it == pending_samples_.end() || pending_it->second.empty()) {
+      return false;
+    }
+
+    // The sample stays queued until the caller has a buffer large enough for it
+    const std::vector<uint8_t>& sample = pending_it->second.front();
+    if (buffer_size < sample.size()) {
+      if (bytes_received != nullptr) {
+        *bytes_received = sample.size();
+      }
+      too_small = true;
+      return false;
+    }
+
+    std::memcpy(buffer, sample.data(), sample.size());
+    if (bytes_received != nullptr) {
+      *bytes_received = sample.size();
+    }
+
+    pending_it->second.pop_front();
+    return true;
+  };
+
+  if (pop_pending() || too_small) {
+    return !too_small;
+  }
+
   // Get the socket info
   const UdpSocketInfo& info = it->second;
 
@@ -120,8 +309,9 @@ auto UdpTransport::Receive(const std::string& topic_name, void* buffer, size_t b
 
   if (received < 0) {
     if (errno == EAGAIN || errno == EWOULDBLOCK) {
-      // No data available, not an error
-      return false;
+      // Nothing on the topic socket, look for samples in coalesced datagrams
+      DrainCoalescedSocket();
+      return pop_pending();
     }
 
     std::cerr << "Failed to receive data: " << strerror(errno) << std::endl;
@@ -140,17 +330,44 @@ bool UdpTransport::CreateSocket(const std::string& topic_name) {
   std::lock_guard<std::mutex> lock(mutex_);
 
   // Check if socket already exists
-  auto it = udp_sockets_.find(topic_name);
-  if (it != udp_sockets_.end()) {
+  auto it = publisher_sockets_.find(topic_name);
+  if (it != publisher_sockets_.end()) {
     // Socket already exists, just return success
     return true;
   }
 
+  int socket_fd = OpenSendSocketLocked();
+  if (socket_fd < 0) {
+    return false;
+  }
+
+  // Generate a port for this topic
+  int port = GenerateUdpPort(topic_name);
+
+  // Create socket info
+  UdpSocketInfo info;
+  info.socket_fd = socket_fd;
+  info.port = port;
+  info.address = multicast_group_.empty() ? "0.0.0.0" : multicast_group_;
+  info.is_publisher = true;
+
+  // Store the socket info
+  publisher_sockets_[topic_name] = info;
+
+  return true;
+}
+
+auto UdpTransport::OpenSendSocket() -> int {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return OpenSendSocketLocked();
+}
+
+auto UdpTransport::OpenSendSocketLocked() -> int {
   // Create a new UDP socket
   int socket_fd = socket(AF_INET, SOCK_DGRAM, 0);
   if (socket_fd < 0) {
     std::cerr << "Failed to create socket: " << strerror(errno) << std::endl;
-    return false;
+    return -1;
   }
 
   // Set socket options for broadcast
@@ -158,7 +375,7 @@ bool UdpTransport::CreateSocket(const std::string& topic_name) {
   if (setsockopt(socket_fd, SOL_SOCKET, SO_BROADCAST, &broadcast, sizeof(broadcast)) < 0) {
     std::cerr << "Failed to set socket options: " << strerror(errno) << std::endl;
     close(socket_fd);
-    return false;
+    return -1;
   }
 
   // Set socket to non-blocking mode
@@ -166,37 +383,34 @@ bool UdpTransport::CreateSocket(const std::string& topic_name) {
   if (flags < 0) {
     std::cerr << "Failed to get socket flags: " << strerror(errno) << std::endl;
     close(socket_fd);
-    return false;
+    return -1;
   }
 
   if (fcntl(socket_fd, F_SETFL, flags | O_NONBLOCK) < 0) {
     std::cerr << "Failed to set socket to non-blocking mode: " << strerror(errno) << std::endl;
     close(socket_fd);
-    return false;
+    return -1;
   }
 
-  // Generate a port for this topic
-  int port = GenerateUdpPort(topic_name);
-
-  // Create socket info
-  UdpSocketInfo info;
-  info.socket_fd = socket_fd;
-  info.port = port;
-  info.address = "0.0.0.0";  // Bind to all interfaces
-  info.is_publisher = true;
-
-  // Store the socket info
-  udp_sockets_[topic_name] = info;
+  // Keep multicast datagrams on this host only if asked to
+  if (!multicast_group_.empty()) {
+    unsigned char loopback = multicast_loopback_ ? 1 : 0;
+    if (setsockopt(socket_fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loopback, sizeof(loopback)) < 0) {
+      std::cerr << "Failed to set multicast loopback: " << strerror(errno) << std::endl;
+      close(socket_fd);
+      return -1;
+    }
+  }
 
-  return true;
+  return socket_fd;
 }
 
 auto UdpTransport::ConnectToSocket(const std::string& topic_name) -> bool {
   std::lock_guard<std::mutex> lock(mutex_);
 
   // Check if socket already exists
-  auto it = udp_sockets_.find(topic_name);
-  if (it != udp_sockets_.end()) {
+  auto it = subscriber_sockets_.find(topic_name);
+  if (it != subscriber_sockets_.end()) {
     // Socket already exists, just return success
     return true;
   }
@@ -222,6 +436,16 @@ auto UdpTransport::ConnectToSocket(const std::string& topic_name) -> bool {
     return false;
   }
 
+  // Subscribers of a multicast group on the same host share the topic's port
+  if (!multicast_group_.empty()) {
+    int reuse = 1;
+    if (setsockopt(socket_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0) {
+      std::cerr << "Failed to set socket options: " << strerror(errno) << std::endl;
+      close(socket_fd);
+      return false;
+    }
+  }
+
   // Generate a port for this topic
   int port = GenerateUdpPort(topic_name);
 
@@ -240,6 +464,20 @@ auto UdpTransport::ConnectToSocket(const std::string& topic_name) -> bool {
     return false;
   }
 
+  // Join the multicast group on the default interface
+  if (!multicast_group_.empty()) {
+    struct ip_mreq membership {};
+    membership.imr_interface.s_addr = INADDR_ANY;
+    if (inet_pton(AF_INET, multicast_group_.c_str(), &membership.imr_multiaddr) <= 0 ||
+        setsockopt(socket_fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) <
+            0) {
+      std::cerr << "Failed to join multicast group " << multicast_group_ << ": "
+                << strerror(errno) << std::endl;
+      close(socket_fd);
+      return false;
+    }
+  }
+
   // Create socket info
   UdpSocketInfo info;
   info.socket_fd = socket_fd;
@@ -248,27 +486,133 @@ auto UdpTransport::ConnectToSocket(const std::string& topic_name) -> bool {
   info.is_publisher = false;
 
   // Store the socket info
-  udp_sockets_[topic_name] = info;
+  subscriber_sockets_[topic_name] = info;
+
+  // Coalesced datagrams are optional, the topic socket still works without them
+  if (coalesced_receiver_.socket_fd < 0 && !OpenCoalescedSocket()) {
+    std::cerr << "Coalesced datagrams will not be received for domain " << domain_id_
+              << std::endl;
+  }
 
   return true;
 }
 
-void UdpTransport::CloseSocket(const std::string& topic_name) {
-  std::lock_guard<std::mutex> lock(mutex_);
+auto UdpTransport::OpenCoalescedSocket() -> bool {
+  int socket_fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (socket_fd < 0) {
+    std::cerr << "Failed to create socket: " << strerror(errno) << std::endl;
+    return false;
+  }
 
-  // Find the socket for this topic
-  auto it = udp_sockets_.find(topic_name);
-  if (it == udp_sockets_.end()) {
-    return;  // Socket not found, nothing to do
+  // As for topic sockets, only subscribers of a multicast group share the coalesced port; a
+  // unicast datagram would reach just one of them
+  if (!multicast_group_.empty()) {
+    int reuse = 1;
+    if (setsockopt(socket_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0) {
+      std::cerr << "Failed to set socket options: " << strerror(errno) << std::endl;
+      close(socket_fd);
+      return false;
+    }
   }
 
-  // Close the socket
-  if (it->second.socket_fd >= 0) {
-    close(it->second.socket_fd);
+  int flags = fcntl(socket_fd, F_GETFL, 0);
+  if (flags < 0 || fcntl(socket_fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+    std::cerr << "Failed to set socket to non-blocking mode: " << strerror(errno) << std::endl;
+    close(socket_fd);
+    return false;
+  }
+
+  int port = GenerateUdpPort(kCoalescedChannelName);
+
+  struct sockaddr_in local_addr {};  // Zero-initialize the struct
+  local_addr.sin_family = AF_INET;
+  local_addr.sin_port = htons(port);
+  local_addr.sin_addr.s_addr = INADDR_ANY;  // Bind to all interfaces
+
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  if (bind(socket_fd, reinterpret_cast<struct sockaddr*>(&local_addr), sizeof(local_addr)) < 0) {
+    std::cerr << "Failed to bind coalesced socket: " << strerror(errno) << std::endl;
+    close(socket_fd);
+    return false;
+  }
+
+  if (!multicast_group_.empty()) {
+    struct ip_mreq membership {};
+    membership.imr_interface.s_addr = INADDR_ANY;
+    if (inet_pton(AF_INET, multicast_group_.c_str(), &membership.imr_multiaddr) <= 0 ||
+        setsockopt(socket_fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) <
+            0) {
+      std::cerr << "Failed to join multicast group " << multicast_group_ << ": "
+                << strerror(errno) << std::endl;
+      close(socket_fd);
+      return false;
+    }
+  }
+
+  coalesced_receiver_.socket_fd = socket_fd;
+  coalesced_receiver_.port = port;
+  coalesced_receiver_.address = "0.0.0.0";
+  coalesced_receiver_.is_publisher = false;
+  coalesced_buffer_.resize(kMaxDatagramSize);
+
+  return true;
+}
+
+void UdpTransport::DrainCoalescedSocket() {
+  if (coalesced_receiver_.socket_fd < 0) {
+    return;
+  }
+
+  auto queue_sample = [this](const std::string& topic_name, const void* data, size_t size) {
+    // Only keep samples for topics this transport subscribed to
+    if (subscriber_sockets_.find(topic_name) == subscriber_sockets_.end()) {
+      return;
+    }
+
+    auto& queue = pending_samples_[topic_name];
+    if (queue.size() >= kMaxPendingSamples) {
+      queue.pop_front();
+    }
+
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    queue.emplace_back(bytes, bytes + size);
+  };
+
+  while (true) {
+    ssize_t received = recv(coalesced_receiver_.socket_fd, coalesced_buffer_.data(),
+                            coalesced_buffer_.size(), MSG_DONTWAIT);
+    if (received < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        std::cerr << "Failed to receive data: " << strerror(errno) << std::endl;
+      }
+      return;
+    }
+
+    if (!SampleCoalescer::Unpack(coalesced_buffer_.data(), static_cast<size_t>(received),
+                                 queue_sample)) {
+      std::cerr << "Dropping malformed coalesced datagram" << std::endl;
+    }
   }
+}
+
+void UdpTransport::CloseSocket(const std::string& topic_name) {
+  std::lock_guard<std::mutex> lock(mutex_);
 
-  // Remove from map
-  udp_sockets_.erase(it);
+  for (auto* sockets : {&publisher_sockets_, &subscriber_sockets_}) {
+    // Find the socket for this topic
+    auto it = sockets->find(topic_name);
+    if (it == sockets->end()) {
+      continue;  // Socket not found, nothing to do
+    }
+
+    // Close the socket
+    if (it->second.socket_fd >= 0) {
+      close(it->second.socket_fd);
+    }
+
+    // Remove from map
+    sockets->erase(it);
+  }
 }
 
 auto UdpTransport::GenerateUdpPort(const std::string& topic_name) -> int {
@@ -2,10 +2,12 @@
 #define TINY_DDS_TRANSPORT_UDP_TRANSPORT_H_
 
 #include <cstdint>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "include/tiny_dds/transport.h"
 #include "include/tiny_dds/transport_types.h"
@@ -50,9 +52,23 @@ class UdpTransport : public Transport {
    */
   auto Send(const std::string& topic_name, const void* data, size_t size) -> bool override;
 
+  /**
+   * @brief Sends a coalesced datagram on the domain's coalesced channel.
+   *
+   * The datagram goes to the multicast group if one is enabled, like topic samples.
+   *
+   * @param data Pointer to the coalesced datagram.
+   * @param size Size of the datagram in bytes.
+   * @return true if the datagram was sent successfully, false otherwise.
+   */
+  auto SendCoalesced(const void* data, size_t size) -> bool override;
+
   /**
    * @brief Receives data from a topic.
    *
+   * Samples unpacked from coalesced datagrams are returned before new datagrams
+   * are read from the topic socket.
+   *
    * @param topic_name The name of the topic.
    * @param buffer Pointer to the buffer to store the received data.
    * @param buffer_size Size of the buffer in bytes.
@@ -85,7 +101,49 @@ class UdpTransport : public Transport {
    */
   auto GetType() const -> TransportType override { return TransportType::UDP; }
 
+  /**
+   * @brief Publishes and subscribes through a multicast group instead of the local host.
+   *
+   * Must be called before any topic is advertised or subscribed. Subscribers on
+   * the same host can share a topic's port.
+   *
+   * @param group The IPv4 multicast group address.
+   * @param loopback Whether sent datagrams are also delivered on this host.
+   */
+  void EnableMulticast(const std::string& group, bool loopback);
+
+  /**
+   * @brief Opens an endpoint bound to a topic.
+   *
+   * Endpoints of advertised topics send straight to the topic's resolved address,
+   * without taking the transport lock or looking up the topic's socket.
+   *
+   * @param topic_name The name of the topic.
+   * @return The endpoint for the topic.
+   */
+  auto OpenEndpoint(const std::string& topic_name) -> std::shared_ptr<TransportEndpoint> override;
+
+  /**
+   * @brief Opens a socket set up like the publisher sockets of the topics.
+   *
+   * Endpoints of writers with a transport priority send from such a socket,
+   * so that marking it does not mark the other writers of the topic.
+   *
+   * @return The socket, which the caller closes, or -1 on failure.
+   */
+  auto OpenSendSocket() -> int;
+
  private:
+  /**
+   * @brief Information about a UDP socket.
+   */
+  struct UdpSocketInfo {
+    int socket_fd{-1};         // Socket file descriptor
+    int port{0};               // UDP port
+    std::string address;       // UDP address
+    bool is_publisher{false};  // Whether this is a publisher socket
+  };
+
   /**
    * @brief Constructor.
    *
@@ -110,6 +168,45 @@ class UdpTransport : public Transport {
    */
   auto ConnectToSocket(const std::string& topic_name) -> bool;
 
+  /**
+   * @brief Opens a non-blocking socket to send datagrams from.
+   *
+   * The caller must hold mutex_.
+   *
+   * @return The socket, or -1 on failure.
+   */
+  auto OpenSendSocketLocked() -> int;
+
+  /**
+   * @brief Sends a datagram to the destination described by a socket info.
+   *
+   * @param info The socket to send from and the destination port and address.
+   * @param data Pointer to the data to send.
+   * @param size Size of the data in bytes.
+   * @return true if successful, false otherwise.
+   */
+  static auto SendTo(const UdpSocketInfo& info, const void* data, size_t size) -> bool;
+
+  /**
+   * @brief Binds the socket that receives coalesced datagrams for this domain.
+   *
+   * Joins the multicast group if one is enabled, so every subscriber on the host
+   * receives the datagrams.
+   *
+   * The caller must hold mutex_.
+   *
+   * @return true if successful, false otherwise.
+   */
+  auto OpenCoalescedSocket() -> bool;
+
+  /**
+   * @brief Reads all pending coalesced datagrams and queues their samples by topic.
+   *
+   * Only samples for topics subscribed on this transport are kept. The caller must
+   * hold mutex_.
+   */
+  void DrainCoalescedSocket();
+
   /**
    * @brief Closes a UDP socket.
    *
@@ -125,16 +222,6 @@ class UdpTransport : public Transport {
    */
   auto GenerateUdpPort(const std::string& topic_name) -> int;
 
-  /**
-   * @brief Information about a UDP socket.
-   */
-  struct UdpSocketInfo {
-    int socket_fd{-1};         // Socket file descriptor
-    int port{0};               // UDP port
-    std::string address;       // UDP address
-    bool is_publisher{false};  // Whether this is a publisher socket
-  };
-
   // Domain ID for this transport
   DomainId domain_id_;
 
@@ -147,8 +234,26 @@ class UdpTransport : public Transport {
   // Flag to indicate if the transport is initialized
   bool initialized_;
 
-  // Map of UDP sockets by topic name
-  std::unordered_map<std::string, UdpSocketInfo> udp_sockets_;
+  // Multicast group, or empty to publish to the local host
+  std::string multicast_group_;
+
+  // Whether multicast datagrams are looped back to this host
+  bool multicast_loopback_;
+
+  // UDP sockets by topic name, kept apart so one transport can publish and
+  // subscribe to the same topic
+  std::unordered_map<std::string, UdpSocketInfo> publisher_sockets_;
+  std::unordered_map<std::string, UdpSocketInfo> subscriber_sockets_;
+
+  // Sockets used to send and receive coalesced datagrams
+  UdpSocketInfo coalesced_sender_;
+  UdpSocketInfo coalesced_receiver_;
+
+  // Receive buffer for coalesced datagrams
+  std::vector<uint8_t> coalesced_buffer_;
+
+  // Samples unpacked from coalesced datagrams, by topic name
+  std::unordered_map<std::string, std::deque<std::vector<uint8_t>>> pending_samples_;
 };
 
 }  // namespace tiny_dds::transport
@@ -0,0 +1,606 @@
+#include "src/transport/unix_socket_transport.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <utility>
+
+namespace tiny_dds::transport {
+
+// Connections accepted at once by the listening socket
+constexpr int kListenBacklog = 64;
+
+// Bound on how long a packet may block on a reader that stopped reading
+constexpr struct timeval kSendTimeout = {1, 0};  // 1 second
+
+namespace {
+
+// Tells the transports of this process apart in their listening addresses
+std::atomic<uint32_t> next_transport_index{0};
+
+// Counts the listening sockets opened in this process, so that advertising
+// transports search for a listener of the same process as soon as it is up
+std::atomic<uint64_t> listener_generation{0};
+
+}  // namespace
+
+auto UnixSocketTransport::Create(DomainId domain_id, const std::string& participant_name,
+                                 bool abstract_namespace)
+    -> std::shared_ptr<UnixSocketTransport> {
+  return std::shared_ptr<UnixSocketTransport>(
+      new UnixSocketTransport(domain_id, participant_name, abstract_namespace));
+}
+
+UnixSocketTransport::UnixSocketTransport(DomainId domain_id, std::string participant_name,
+                                         bool abstract_namespace)
+    : domain_id_(domain_id),
+      participant_name_(std::move(participant_name)),
+      abstract_namespace_(abstract_namespace),
+      initialized_(false),
+      listen_fd_(-1) {
+  std::stringstream ss;
+  ss << AddressPrefix() << getpid() << "_" << next_transport_index.fetch_add(1);
+  if (!abstract_namespace_) {
+    ss << ".sock";
+  }
+  listen_name_ = ss.str();
+}
+
+UnixSocketTransport::~UnixSocketTransport() {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  for (int socket_fd : incoming_) {
+    close(socket_fd);
+  }
+
+  for (const auto& [name, peer] : peers_) {
+    if (peer->socket_fd >= 0) {
+      close(peer->socket_fd);
+    }
+  }
+
+  if (listen_fd_ >= 0) {
+    close(listen_fd_);
+
+    // Filesystem sockets outlive their descriptor, remove ours
+    if (!abstract_namespace_) {
+      unlink(listen_name_.c_str());
+    }
+  }
+}
+
+auto UnixSocketTransport::Initialize() -> bool {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (initialized_) {
+    return true;
+  }
+
+  // Nothing to do here for now, initialization happens when topics are advertised or subscribed
+
+  initialized_ = true;
+  return true;
+}
+
+auto UnixSocketTransport::Advertise(const std::string& topic_name) -> bool {
+  if (topic_name.size() > kMaxTopicNameLength) {
+    std::cerr << "Topic name too long: " << topic_name << std::endl;
+    return false;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    advertised_topics_.insert(topic_name);
+  }
+
+  // Subscribers that are not up yet are searched for again while sending
+  Connect(true);
+  return true;
+}
+
+auto UnixSocketTransport::Subscribe(const std::string& topic_name) -> bool {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (listen_fd_ < 0 && !Listen()) {
+    return false;
+  }
+
+  subscribed_topics_.insert(topic_name);
+  return true;
+}
+
+auto UnixSocketTransport::Send(const std::string& topic_name, const void* data, size_t size)
+    -> bool {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (advertised_topics_.count(topic_name) == 0) {
+      std::cerr << "Topic not advertised: " << topic_name << std::endl;
+      return false;
+    }
+  }
+
+  // A subscriber that stops reading blocks sendmsg() for up to kSendTimeout, so the
+  // peers are sent to under their own locks and Receive() is never held up
+  Connect(false);
+  std::vector<std::shared_ptr<PeerConnection>> peers = SnapshotPeers();
+  if (peers.empty()) {
+    return false;
+  }
+
+  PacketHeader header{};
+  header.magic = MAGIC_NUMBER;
+  header.flags = kInlinePayload;
+  header.topic_length = static_cast<uint32_t>(topic_name.size());
+  header.payload_length = size;
+
+  std::array<struct iovec, 3> iov{};
+  iov[0].iov_base = &header;
+  iov[0].iov_len = sizeof(header);
+  iov[1].iov_base = const_cast<char*>(topic_name.data());
+  iov[1].iov_len = topic_name.size();
+
+  struct msghdr message {};
+  message.msg_iov = iov.data();
+  message.msg_iovlen = iov.size();
+
+  // Space for one descriptor in the ancillary data
+  alignas(struct cmsghdr) std::array<char, CMSG_SPACE(sizeof(int))> control{};
+  int payload_fd = -1;
+
+  if (size > kInlinePayloadThreshold) {
+    payload_fd = CreatePayloadDescriptor(data, size);
+    if (payload_fd < 0) {
+      return false;
+    }
+
+    header.flags = kDescriptorPayload;
+    message.msg_iovlen = 2;
+    message.msg_control = control.data();
+    message.msg_controllen = control.size();
+
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    std::memcpy(CMSG_DATA(cmsg), &payload_fd, sizeof(int));
+  } else {
+    iov[2].iov_base = const_cast<void*>(data);
+    iov[2].iov_len = size;
+  }
+
+  // Every subscriber gets the packet; a memfd payload is shared, not copied
+  bool sent = false;
+  std::vector<std::shared_ptr<PeerConnection>> closed;
+  for (const auto& peer : peers) {
+    std::lock_guard<std::mutex> peer_lock(peer->mutex);
+    if (peer->socket_fd < 0) {
+      continue;  // Closed by a concurrent Send()
+    }
+
+    if (sendmsg(peer->socket_fd, &message, MSG_NOSIGNAL) < 0) {
+      std::cerr << "Failed to send data: " << strerror(errno) << std::endl;
+
+      // Drop the connection, the subscriber is connected again if it is still listening
+      close(peer->socket_fd);
+      peer->socket_fd = -1;
+      closed.push_back(peer);
+      continue;
+    }
+    sent = true;
+  }
+
+  if (!closed.empty()) {
+    RemovePeers(closed);
+  }
+
+  // The readers hold their own references to the memfd once the packets are queued
+  if (payload_fd >= 0) {
+    close(payload_fd);
+  }
+
+  return sent;
+}
+
+auto UnixSocketTransport::Receive(const std::string& topic_name, void* buffer,
+                                  size_t buffer_size, size_t* bytes_received) -> bool {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (subscribed_topics_.count(topic_name) == 0) {
+    std::cerr << "Topic not subscribed: " << topic_name << std::endl;
+    return false;
+  }
+
+  auto it = pending_samples_.find(topic_name);
+  if (it == pending_samples_.end() || it->second.empty()) {
+    Poll();
+    it = pending_samples_.find(topic_name);
+    if (it == pending_samples_.end() || it->second.empty()) {
+      return false;  // No data available
+    }
+  }
+
+  // The sample stays queued until the caller has a buffer large enough for it
+  const ReceivedSample& sample = it->second.front();
+  if (buffer_size < sample.size) {
+    if (bytes_received != nullptr) {
+      *bytes_received = sample.size;
+    }
+    return false;
+  }
+
+  std::memcpy(buffer, sample.data(), sample.size);
+  if (bytes_received != nullptr) {
+    *bytes_received = sample.size;
+  }
+
+  it->second.pop_front();
+  return true;
+}
+
+auto UnixSocketTransport::MakeAddress(const std::string& name,
+                                      struct sockaddr_un* address) const -> socklen_t {
+  address->sun_family = AF_UNIX;
+
+  // Abstract names start with a NUL byte and are not NUL terminated
+  const size_t offset = abstract_namespace_ ? 1 : 0;
+  const size_t length = std::min(name.size(), sizeof(address->sun_path) - 1 - offset);
+  std::memcpy(address->sun_path + offset, name.data(), length);
+
+  return static_cast<socklen_t>(offsetof(struct sockaddr_un, sun_path) + offset + length +
+                                (abstract_namespace_ ? 0 : 1));
+}
+
+auto UnixSocketTransport::AddressPrefix() const -> std::string {
+  std::stringstream ss;
+  if (abstract_namespace_) {
+    ss << "tiny_dds_" << domain_id_ << "_";
+  } else {
+    ss << "/tmp/tiny_dds_" << domain_id_ << "/";
+  }
+  return ss.str();
+}
+
+auto UnixSocketTransport::FindListeners() const -> std::vector<std::string> {
+  const std::string prefix = AddressPrefix();
+  std::set<std::string> names;
+
+  if (abstract_namespace_) {
+    // The last column holds the address, abstract ones start with '@'
+    std::ifstream table("/proc/net/unix");
+    std::string line;
+    while (std::getline(table, line)) {
+      const size_t column = line.rfind(' ');
+      if (column != std::string::npos && line.compare(column + 1, 1, "@") == 0 &&
+          line.compare(column + 2, prefix.size(), prefix) == 0) {
+        names.insert(line.substr(column + 2));
+      }
+    }
+  } else {
+    DIR* directory = opendir(prefix.c_str());
+    if (directory == nullptr) {
+      return {};
+    }
+    while (struct dirent* entry = readdir(directory)) {
+      const std::string file_name = entry->d_name;
+      if (file_name.size() > 5 && file_name.compare(file_name.size() - 5, 5, ".sock") == 0) {
+        names.insert(prefix + file_name);
+      }
+    }
+    closedir(directory);
+  }
+
+  return std::vector<std::string>(names.begin(), names.end());
+}
+
+auto UnixSocketTransport::Listen() -> bool {
+  if (!abstract_namespace_) {
+    const std::string directory = AddressPrefix();
+    if (mkdir(directory.c_str(), 0777) < 0 && errno != EEXIST) {
+      std::cerr << "Failed to create socket directory " << directory << ": " << strerror(errno)
+                << std::endl;
+      return false;
+    }
+
+    // A file left at this address by a crashed process is removed, a live socket is not
+    if (access(listen_name_.c_str(), F_OK) == 0) {
+      int live_fd = ConnectTo(listen_name_);
+      if (live_fd >= 0) {
+        close(live_fd);
+        std::cerr << "Socket address already in use: " << listen_name_ << std::endl;
+        return false;
+      }
+      unlink(listen_name_.c_str());
+    }
+  }
+
+  int socket_fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (socket_fd < 0) {
+    std::cerr << "Failed to create socket: " << strerror(errno) << std::endl;
+    return false;
+  }
+
+  struct sockaddr_un address {};
+  socklen_t address_length = MakeAddress(listen_name_, &address);
+
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  if (bind(socket_fd, reinterpret_cast<struct sockaddr*>(&address), address_length) < 0) {
+    std::cerr << "Failed to bind socket " << listen_name_ << ": " << strerror(errno) << std::endl;
+    close(socket_fd);
+    return false;
+  }
+
+  if (listen(socket_fd, kListenBacklog) < 0) {
+    std::cerr << "Failed to listen on socket: " << strerror(errno) << std::endl;
+    close(socket_fd);
+    return false;
+  }
+
+  listen_fd_ = socket_fd;
+  packet_buffer_.resize(sizeof(PacketHeader) + kMaxTopicNameLength + kInlinePayloadThreshold);
+  listener_generation.fetch_add(1, std::memory_order_release);
+  return true;
+}
+
+void UnixSocketTransport::Connect(bool force) {
+  std::unordered_set<std::string> connected;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const auto now = std::chrono::steady_clock::now();
+    const uint64_t generation = listener_generation.load(std::memory_order_acquire);
+    if (!force && generation == seen_generation_ && now - last_discovery_ < kDiscoveryInterval) {
+      return;
+    }
+    last_discovery_ = now;
+    seen_generation_ = generation;
+
+    for (const auto& [name, peer] : peers_) {
+      connected.insert(name);
+    }
+  }
+
+  // connect() waits for room in the backlog of a listener that stopped accepting
+  std::vector<std::pair<std::string, int>> connections;
+  for (const std::string& name : FindListeners()) {
+    if (connected.count(name) != 0) {
+      continue;
+    }
+    int socket_fd = ConnectTo(name);
+    if (socket_fd >= 0) {
+      connections.emplace_back(name, socket_fd);
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& [name, socket_fd] : connections) {
+    // A concurrent Connect() may have connected to the same listener first
+    auto peer = std::make_shared<PeerConnection>();
+    peer->socket_fd = socket_fd;
+    if (!peers_.emplace(name, std::move(peer)).second) {
+      close(socket_fd);
+    }
+  }
+}
+
+auto UnixSocketTransport::SnapshotPeers() -> std::vector<std::shared_ptr<PeerConnection>> {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  std::vector<std::shared_ptr<PeerConnection>> peers;
+  peers.reserve(peers_.size());
+  for (const auto& [name, peer] : peers_) {
+    peers.push_back(peer);
+  }
+  return peers;
+}
+
+void UnixSocketTransport::RemovePeers(const std::vector<std::shared_ptr<PeerConnection>>& closed) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  for (auto it = peers_.begin(); it != peers_.end();) {
+    if (std::find(closed.begin(), closed.end(), it->second) != closed.end()) {
+      it = peers_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+auto UnixSocketTransport::ConnectTo(const std::string& name) const -> int {
+  int socket_fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+  if (socket_fd < 0) {
+    std::cerr << "Failed to create socket: " << strerror(errno) << std::endl;
+    return -1;
+  }
+
+  if (setsockopt(socket_fd, SOL_SOCKET, SO_SNDTIMEO, &kSendTimeout, sizeof(kSendTimeout)) < 0) {
+    std::cerr << "Failed to set socket options: " << strerror(errno) << std::endl;
+  }
+
+  struct sockaddr_un address {};
+  socklen_t address_length = MakeAddress(name, &address);
+
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  if (connect(socket_fd, reinterpret_cast<struct sockaddr*>(&address), address_length) < 0) {
+    // Nobody listens on a socket file left by a crashed process
+    if (errno == ECONNREFUSED && !abstract_namespace_) {
+      unlink(name.c_str());
+    }
+    close(socket_fd);
+    return -1;
+  }
+
+  return socket_fd;
+}
+
+auto UnixSocketTransport::CreatePayloadDescriptor(const void* data, size_t size) -> int {
+  int fd = memfd_create("tiny_dds_payload", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+  if (fd < 0) {
+    std::cerr << "Failed to create memfd: " << strerror(errno) << std::endl;
+    return -1;
+  }
+
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  size_t written = 0;
+  while (written < size) {
+    ssize_t result = write(fd, bytes + written, size - written);
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      std::cerr << "Failed to write memfd: " << strerror(errno) << std::endl;
+      close(fd);
+      return -1;
+    }
+    written += static_cast<size_t>(result);
+  }
+
+  // Seal the payload so the reader can map it without fearing later changes
+  if (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) < 0) {
+    std::cerr << "Failed to seal memfd: " << strerror(errno) << std::endl;
+    close(fd);
+    return -1;
+  }
+
+  return fd;
+}
+
+void UnixSocketTransport::Poll() {
+  // Accept connections from new publishers
+  while (listen_fd_ >= 0) {
+    int socket_fd = accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (socket_fd < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        std::cerr << "Failed to accept connection: " << strerror(errno) << std::endl;
+      }
+      break;
+    }
+    incoming_.push_back(socket_fd);
+  }
+
+  // Read every packet that is already queued
+  for (auto it = incoming_.begin(); it != incoming_.end();) {
+    bool got_packet = true;
+    bool open = true;
+    while (open && got_packet) {
+      open = ReadPacket(*it, &got_packet);
+    }
+
+    if (open) {
+      ++it;
+    } else {
+      close(*it);
+      it = incoming_.erase(it);
+    }
+  }
+}
+
+auto UnixSocketTransport::ReadPacket(int socket_fd, bool* got_packet) -> bool {
+  *got_packet = false;
+
+  struct iovec iov {};
+  iov.iov_base = packet_buffer_.data();
+  iov.iov_len = packet_buffer_.size();
+
+  alignas(struct cmsghdr) std::array<char, CMSG_SPACE(sizeof(int))> control{};
+
+  struct msghdr message {};
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control.data();
+  message.msg_controllen = control.size();
+
+  ssize_t received = recvmsg(socket_fd, &message, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+  if (received < 0) {
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+  }
+  if (received == 0) {
+    return false;  // Orderly shutdown
+  }
+
+  *got_packet = true;
+
+  // Take ownership of a passed descriptor before anything can fail
+  int payload_fd = -1;
+  struct cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+  if (cmsg != nullptr && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+    std::memcpy(&payload_fd, CMSG_DATA(cmsg), sizeof(int));
+  }
+
+  PacketHeader header{};
+  const auto size = static_cast<size_t>(received);
+  bool valid = size >= sizeof(header) && (message.msg_flags & MSG_TRUNC) == 0;
+  if (valid) {
+    std::memcpy(&header, packet_buffer_.data(), sizeof(header));
+    valid = header.magic == MAGIC_NUMBER && sizeof(header) + header.topic_length <= size;
+  }
+
+  if (!valid) {
+    std::cerr << "Dropping malformed packet" << std::endl;
+    if (payload_fd >= 0) {
+      close(payload_fd);
+    }
+    return true;
+  }
+
+  std::string topic_name(reinterpret_cast<const char*>(&packet_buffer_[sizeof(header)]),
+                         header.topic_length);
+  const size_t payload_offset = sizeof(header) + header.topic_length;
+
+  ReceivedSample sample;
+  sample.size = header.payload_length;
+
+  if (header.flags == kDescriptorPayload) {
+    struct stat payload_stat {};
+    if (payload_fd < 0 || fstat(payload_fd, &payload_stat) < 0 ||
+        static_cast<uint64_t>(payload_stat.st_size) < header.payload_length) {
+      std::cerr << "Dropping packet with invalid payload descriptor" << std::endl;
+      if (payload_fd >= 0) {
+        close(payload_fd);
+      }
+      return true;
+    }
+
+    void* mapping = mmap(nullptr, sample.size, PROT_READ, MAP_SHARED, payload_fd, 0);
+    close(payload_fd);
+    if (mapping == MAP_FAILED) {
+      std::cerr << "Failed to map payload: " << strerror(errno) << std::endl;
+      return true;
+    }
+
+    const size_t mapping_size = sample.size;
+    sample.mapping =
+        std::shared_ptr<void>(mapping, [mapping_size](void* p) { munmap(p, mapping_size); });
+  } else {
+    if (payload_fd >= 0) {
+      close(payload_fd);
+    }
+    if (payload_offset + header.payload_length != size) {
+      std::cerr << "Dropping malformed packet" << std::endl;
+      return true;
+    }
+    sample.inline_payload.assign(packet_buffer_.begin() + payload_offset,
+                                 packet_buffer_.begin() + size);
+  }
+
+  if (subscribed_topics_.count(topic_name) != 0) {
+    pending_samples_[topic_name].push_back(std::move(sample));
+  }
+
+  return true;
+}
+
+}  // namespace tiny_dds::transport
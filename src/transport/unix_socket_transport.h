@@ -0,0 +1,257 @@
+#ifndef TINY_DDS_TRANSPORT_UNIX_SOCKET_TRANSPORT_H_
+#define TINY_DDS_TRANSPORT_UNIX_SOCKET_TRANSPORT_H_
+
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "include/tiny_dds/transport.h"
+#include "include/tiny_dds/transport_types.h"
+#include "include/tiny_dds/types.h"
+
+namespace tiny_dds::transport {
+
+/**
+ * @brief Implements transport over AF_UNIX SOCK_SEQPACKET sockets for same-host peers.
+ *
+ * Unlike SharedMemoryTransport this needs no writable /dev/shm and no ring sizing,
+ * and the kernel preserves message boundaries, so every sample is one packet.
+ * Samples larger than the inline threshold are written into a sealed memfd that
+ * is passed to the reader with SCM_RIGHTS; the reader maps it instead of pulling
+ * the payload through the socket buffer.
+ *
+ * A transport that subscribes to a topic listens on an address of its own, named
+ * after the domain, the process and the transport; a transport that advertises a
+ * topic connects to every such address of the domain and sends each sample to all
+ * of them. Addresses live in the abstract namespace by default, where they are
+ * found in /proc/net/unix, or in a directory per domain under /tmp when the
+ * abstract namespace is not available (for example across network namespaces).
+ */
+class UnixSocketTransport : public Transport {
+ public:
+  /**
+   * @brief Creates a new Unix domain socket transport instance.
+   *
+   * @param domain_id The domain ID for this transport.
+   * @param participant_name The name of the participant using this transport.
+   * @param abstract_namespace Whether to bind in the Linux abstract socket namespace.
+   * @return A shared pointer to the created transport.
+   */
+  static auto Create(DomainId domain_id, const std::string& participant_name,
+                     bool abstract_namespace = true) -> std::shared_ptr<UnixSocketTransport>;
+
+  /**
+   * @brief Destructor, closes all sockets.
+   */
+  ~UnixSocketTransport() override;
+
+  /**
+   * @brief Initializes the transport.
+   *
+   * @return true if initialization was successful, false otherwise.
+   */
+  auto Initialize() -> bool override;
+
+  /**
+   * @brief Sends data to a topic.
+   *
+   * @param topic_name The name of the topic.
+   * @param data Pointer to the data to send.
+   * @param size Size of the data in bytes.
+   * @return true if the data was sent successfully, false otherwise.
+   */
+  auto Send(const std::string& topic_name, const void* data, size_t size) -> bool override;
+
+  /**
+   * @brief Receives data from a topic.
+   *
+   * @param topic_name The name of the topic.
+   * @param buffer Pointer to the buffer to store the received data.
+   * @param buffer_size Size of the buffer in bytes.
+   * @param bytes_received Output parameter to store the number of bytes received.
+   * @return true if data was received successfully, false otherwise.
+   */
+  auto Receive(const std::string& topic_name, void* buffer, size_t buffer_size,
+               size_t* bytes_received) -> bool override;
+
+  /**
+   * @brief Subscribes to a topic, listening on the transport's socket address if needed.
+   *
+   * @param topic_name The name of the topic to subscribe to.
+   * @return true if subscription was successful, false otherwise.
+   */
+  auto Subscribe(const std::string& topic_name) -> bool override;
+
+  /**
+   * @brief Advertises a topic, connecting to the domain's listening transports.
+   *
+   * @param topic_name The name of the topic to advertise.
+   * @return true if advertisement was successful, false otherwise.
+   */
+  auto Advertise(const std::string& topic_name) -> bool override;
+
+  /**
+   * @brief Gets the type of this transport.
+   *
+   * @return The transport type.
+   */
+  auto GetType() const -> TransportType override { return TransportType::UNIX_SOCKET; }
+
+  /**
+   * @brief Payloads larger than this are passed in a memfd instead of inline.
+   */
+  static constexpr size_t kInlinePayloadThreshold = 64 * 1024;
+
+  /**
+   * @brief Longest topic name that can be carried in a packet.
+   */
+  static constexpr size_t kMaxTopicNameLength = 256;
+
+  /**
+   * @brief Shortest time between two searches for new listening transports while sending.
+   */
+  static constexpr std::chrono::milliseconds kDiscoveryInterval{100};
+
+ private:
+  /**
+   * @brief Constructor.
+   *
+   * @param domain_id The domain ID for this transport.
+   * @param participant_name The name of the participant using this transport.
+   * @param abstract_namespace Whether to bind in the Linux abstract socket namespace.
+   */
+  UnixSocketTransport(DomainId domain_id, std::string participant_name, bool abstract_namespace);
+
+  /**
+   * @brief Header at the start of every packet.
+   */
+  struct PacketHeader {
+    uint32_t magic;           // Identifies valid packets
+    uint32_t flags;           // PacketFlags
+    uint32_t topic_length;    // Length of the topic name that follows
+    uint32_t reserved;        // Padding, always zero
+    uint64_t payload_length;  // Length of the payload (inline or in the memfd)
+  };
+
+  /**
+   * @brief Flags describing a packet's payload.
+   */
+  enum PacketFlags : uint32_t {
+    kInlinePayload = 0,      // Payload follows the topic name in the packet
+    kDescriptorPayload = 1,  // Payload is in a memfd passed with SCM_RIGHTS
+  };
+
+  /**
+   * @brief A received sample waiting to be read.
+   */
+  struct ReceivedSample {
+    std::vector<uint8_t> inline_payload;  // Payload copied out of the packet
+    std::shared_ptr<void> mapping;        // Read-only mapping of a memfd payload
+    size_t size{0};                       // Payload size in bytes
+
+    auto data() const -> const void* {
+      return mapping ? mapping.get() : static_cast<const void*>(inline_payload.data());
+    }
+  };
+
+  /**
+   * @brief Connection to one listening transport.
+   */
+  struct PeerConnection {
+    std::mutex mutex;  // Serializes the packets sent to the peer, guards socket_fd
+    int socket_fd;     // Connected socket, or -1 once sending to it failed
+  };
+
+  // Fills a sockaddr_un with a listening address and returns its length
+  auto MakeAddress(const std::string& name, struct sockaddr_un* address) const -> socklen_t;
+
+  // Returns the prefix shared by the listening addresses of the domain
+  auto AddressPrefix() const -> std::string;
+
+  // Returns the listening addresses of the domain, including this transport's
+  auto FindListeners() const -> std::vector<std::string>;
+
+  // Starts listening on the transport's own address; the caller holds mutex_
+  auto Listen() -> bool;
+
+  // Connects to listening transports not connected yet, searching for new ones
+  // at most every kDiscoveryInterval unless forced; takes mutex_ only to read and
+  // update peers_, so connecting never blocks Receive()
+  void Connect(bool force);
+
+  // Returns a copy of the peers, so they can be used without holding mutex_
+  auto SnapshotPeers() -> std::vector<std::shared_ptr<PeerConnection>>;
+
+  // Forgets peers whose connection was closed after a failed send
+  void RemovePeers(const std::vector<std::shared_ptr<PeerConnection>>& closed);
+
+  // Connects to one listening address, returns the socket or -1
+  auto ConnectTo(const std::string& name) const -> int;
+
+  // Copies a payload into a sealed memfd, returns the descriptor or -1
+  static auto CreatePayloadDescriptor(const void* data, size_t size) -> int;
+
+  // Accepts new connections and reads pending packets; the caller holds mutex_
+  void Poll();
+
+  // Reads one packet from a connection; returns false when the connection is closed
+  auto ReadPacket(int socket_fd, bool* got_packet) -> bool;
+
+  // Domain ID for this transport
+  DomainId domain_id_;
+
+  // Participant name
+  std::string participant_name_;
+
+  // Whether the socket address lives in the abstract namespace
+  bool abstract_namespace_;
+
+  // Mutex for thread safety
+  std::mutex mutex_;
+
+  // Flag to indicate if the transport is initialized
+  bool initialized_;
+
+  // Listening socket, or -1 if nothing is subscribed
+  int listen_fd_;
+
+  // Address of the listening socket, unique to this transport
+  std::string listen_name_;
+
+  // Connections to the listening transports of the domain, by address
+  std::unordered_map<std::string, std::shared_ptr<PeerConnection>> peers_;
+
+  // When the listening transports were last searched for, and how many
+  // listening sockets this process had opened by then
+  std::chrono::steady_clock::time_point last_discovery_;
+  uint64_t seen_generation_ = 0;
+
+  // Topics advertised and subscribed on this transport
+  std::unordered_set<std::string> advertised_topics_;
+  std::unordered_set<std::string> subscribed_topics_;
+
+  // Accepted connections from publishing transports
+  std::vector<int> incoming_;
+
+  // Receive buffer sized for the largest inline packet
+  std::vector<uint8_t> packet_buffer_;
+
+  // Received samples waiting to be read, by topic name
+  std::unordered_map<std::string, std::deque<ReceivedSample>> pending_samples_;
+
+  // Magic number for packet headers
+  static constexpr uint32_t MAGIC_NUMBER = 0x58554444;  // "DDUX" in ASCII
+};
+
+}  // namespace tiny_dds::transport
+
+#endif  // TINY_DDS_TRANSPORT_UNIX_SOCKET_TRANSPORT_H_
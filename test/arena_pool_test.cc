@@ -0,0 +1,106 @@
+#include "src/core/arena_pool.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "google/protobuf/arena.h"
+#include "google/protobuf/descriptor.pb.h"
+#include "gtest/gtest.h"
+#include "include/tiny_dds/data_reader.h"
+#include "include/tiny_dds/data_writer.h"
+#include "include/tiny_dds/domain_participant.h"
+#include "include/tiny_dds/publisher.h"
+#include "include/tiny_dds/subscriber.h"
+#include "include/tiny_dds/topic.h"
+#include "include/tiny_dds/transport_types.h"
+#include "include/tiny_dds/typed_data.h"
+#include "test/test_util.h"
+
+namespace tiny_dds {
+namespace {
+
+using core::ArenaPool;
+using google::protobuf::FieldDescriptorProto;
+
+TEST(ArenaPoolTest, ReusesReleasedArenas) {
+  auto pool = ArenaPool::Create();
+  ArenaPool::PooledArena* arena = pool->Acquire();
+  google::protobuf::Arena::CreateArray<char>(arena->arena(), 100);
+  arena->Release();
+  EXPECT_EQ(pool->FreeCount(), 1);
+
+  // The arena comes back reset
+  EXPECT_EQ(pool->Acquire(), arena);
+  EXPECT_EQ(pool->FreeCount(), 0);
+  EXPECT_LE(arena->arena()->SpaceUsed(), 0);
+  arena->Release();
+}
+
+TEST(ArenaPoolTest, SizesBlocksFromTheSpaceArenasNeeded) {
+  auto pool = ArenaPool::Create();
+  EXPECT_EQ(pool->BlockSize(), ArenaPool::kInitialBlockSize);
+
+  // An arena outgrowing its block is replaced by one with a larger block
+  ArenaPool::PooledArena* arena = pool->Acquire();
+  google::protobuf::Arena::CreateArray<char>(arena->arena(), 100000);
+  arena->Release();
+  EXPECT_GE(pool->BlockSize(), 100000);
+  EXPECT_EQ(pool->FreeCount(), 0);
+
+  // which holds the same allocations without another block
+  arena = pool->Acquire();
+  google::protobuf::Arena::CreateArray<char>(arena->arena(), 100000);
+  EXPECT_LE(arena->arena()->SpaceAllocated(), pool->BlockSize());
+  arena->Release();
+  EXPECT_EQ(pool->FreeCount(), 1);
+}
+
+TEST(ArenaPoolTest, LentArenasOutliveThePool) {
+  auto pool = ArenaPool::Create();
+  std::vector<ArenaPool::PooledArena*> arenas = {pool->Acquire(), pool->Acquire()};
+  arenas[0]->Release();
+  pool.reset();
+  arenas[1]->Release();
+}
+
+TEST(ArenaPoolTest, ReadersTakeMessagesOnPooledArenas) {
+  auto participant = DomainParticipant::Create(201, "arena_reader");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  auto topic = participant->CreateTopic(TestTopicName(), "google.protobuf.FieldDescriptorProto");
+  auto reader = TypedDataReader<FieldDescriptorProto>::Create(
+      participant->CreateSubscriber()->CreateDataReader(topic));
+  auto writer = TypedDataWriter<FieldDescriptorProto>::Create(
+      participant->CreatePublisher()->CreateDataWriter(topic));
+
+  FieldDescriptorProto sample;
+  for (const std::string& name : {std::string(20000, 'a'), std::string("b")}) {
+    sample.set_name(name);
+    ASSERT_TRUE(writer->Write(sample));
+  }
+
+  SampleInfo info;
+  ArenaMessagePtr<FieldDescriptorProto> first = reader->TakeArenaMessage(info);
+  ArenaMessagePtr<FieldDescriptorProto> second = reader->TakeArenaMessage(info);
+  ASSERT_NE(first, nullptr);
+  ASSERT_NE(second, nullptr);
+  EXPECT_EQ(first->name().size(), 20000);
+  EXPECT_EQ(second->name(), "b");
+  EXPECT_EQ(info.sequence_number, 2);
+  EXPECT_NE(first->GetArena(), nullptr);
+  EXPECT_NE(first->GetArena(), second->GetArena());
+  EXPECT_EQ(reader->TakeArenaMessage(info), nullptr);
+
+  // Messages from writers in other processes are parsed into the arena
+  ArenaMessagePtr<> untyped;
+  const std::string bytes = sample.SerializeAsString();
+  ASSERT_TRUE(writer->GetDataWriter()->Write(bytes.data(), bytes.size()));
+  untyped = reader->GetDataReader()->TakeArenaMessage(FieldDescriptorProto::default_instance(),
+                                                      info);
+  ASSERT_NE(untyped, nullptr);
+  EXPECT_EQ(static_cast<FieldDescriptorProto*>(untyped.get())->name(), "b");
+}
+
+}  // namespace
+}  // namespace tiny_dds
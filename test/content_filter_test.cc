@@ -0,0 +1,166 @@
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "google/protobuf/descriptor.pb.h"
+#include "gtest/gtest.h"
+#include "include/tiny_dds/data_reader.h"
+#include "include/tiny_dds/data_writer.h"
+#include "include/tiny_dds/domain_participant.h"
+#include "include/tiny_dds/publisher.h"
+#include "include/tiny_dds/subscriber.h"
+#include "include/tiny_dds/topic.h"
+#include "include/tiny_dds/transport_types.h"
+#include "src/core/content_filter.h"
+#include "test/test_util.h"
+
+namespace tiny_dds {
+namespace {
+
+using google::protobuf::FieldDescriptorProto;
+
+// A message type with strings, integers, enums and a nested message
+constexpr char kTypeName[] = "google.protobuf.FieldDescriptorProto";
+
+FieldDescriptorProto Field(const std::string& name, int32_t number, bool packed = false) {
+  FieldDescriptorProto field;
+  field.set_name(name);
+  field.set_number(number);
+  field.set_label(number % 2 == 0 ? FieldDescriptorProto::LABEL_REPEATED
+                                  : FieldDescriptorProto::LABEL_OPTIONAL);
+  if (packed) {
+    field.mutable_options()->set_packed(true);
+  }
+  return field;
+}
+
+auto Compile(const std::string& expression, const std::vector<std::string>& parameters = {})
+    -> std::shared_ptr<const core::ContentFilter> {
+  return core::ContentFilter::Compile(FieldDescriptorProto::descriptor(), expression, parameters);
+}
+
+// Evaluates a filter on the serialized message and checks the message object agrees
+bool Matches(const core::ContentFilter& filter, const FieldDescriptorProto& message) {
+  const std::string bytes = message.SerializeAsString();
+  const bool matches = filter.Evaluate(bytes.data(), bytes.size());
+  EXPECT_EQ(filter.Evaluate(message), matches);
+  return matches;
+}
+
+TEST(ContentFilterTest, EvaluatesComparisonsOfFields) {
+  auto filter = Compile("number > 10 AND (name LIKE 'temp%' OR name = 'pressure')");
+  ASSERT_NE(filter, nullptr);
+  EXPECT_TRUE(Matches(*filter, Field("temperature", 11)));
+  EXPECT_TRUE(Matches(*filter, Field("pressure", 200)));
+  EXPECT_FALSE(Matches(*filter, Field("temperature", 10)));
+  EXPECT_FALSE(Matches(*filter, Field("humidity", 50)));
+
+  filter = Compile("number NOT BETWEEN %0 AND %1 AND label = LABEL_REPEATED", {"-5", "5"});
+  ASSERT_NE(filter, nullptr);
+  EXPECT_TRUE(Matches(*filter, Field("a", 6)));
+  EXPECT_FALSE(Matches(*filter, Field("a", 7)));
+  EXPECT_FALSE(Matches(*filter, Field("a", 4)));
+
+  // Missing fields compare as their default, nested ones too
+  filter = Compile("options.packed = TRUE");
+  ASSERT_NE(filter, nullptr);
+  EXPECT_TRUE(Matches(*filter, Field("a", 1, true)));
+  EXPECT_FALSE(Matches(*filter, Field("a", 1)));
+  filter = Compile("type_name = '' AND NOT options.deprecated");
+  ASSERT_NE(filter, nullptr);
+  EXPECT_TRUE(Matches(*filter, Field("a", 1)));
+
+  // Empty expressions accept everything, unparsable samples nothing
+  filter = Compile("");
+  ASSERT_NE(filter, nullptr);
+  EXPECT_TRUE(Matches(*filter, Field("a", 1)));
+  const uint8_t garbage[] = {0xff, 0xff, 0xff};
+  EXPECT_FALSE(Compile("number = 1")->Evaluate(garbage, sizeof(garbage)));
+}
+
+TEST(ContentFilterTest, RejectsInvalidExpressions) {
+  EXPECT_EQ(Compile("missing = 1"), nullptr);
+  EXPECT_EQ(Compile("name = 1"), nullptr);
+  EXPECT_EQ(Compile("number = 'one'"), nullptr);
+  EXPECT_EQ(Compile("number >"), nullptr);
+  EXPECT_EQ(Compile("(number = 1"), nullptr);
+  EXPECT_EQ(Compile("name = 'unterminated"), nullptr);
+  EXPECT_EQ(Compile("label = NOT_A_LABEL"), nullptr);
+  EXPECT_EQ(Compile("number = %0"), nullptr);
+  EXPECT_EQ(Compile("options = 1"), nullptr);
+  EXPECT_EQ(core::ContentFilter::Compile(nullptr, "", {}), nullptr);
+}
+
+TEST(ContentFilterTest, LocalWritersSkipReadersWhoseFilterRejects) {
+  auto participant = DomainParticipant::Create(151, "content_filter_local");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  auto topic = participant->CreateTopic(TestTopicName(), kTypeName);
+  EXPECT_EQ(participant->CreateContentFilteredTopic(TestTopicName(), topic, ""), nullptr);
+  EXPECT_EQ(participant->CreateContentFilteredTopic("filtered", topic, "missing = 1"), nullptr);
+  auto filtered_topic =
+      participant->CreateContentFilteredTopic(TestTopicName() + "_even", topic, "number < %0",
+                                              {"100"});
+  ASSERT_NE(filtered_topic, nullptr);
+  EXPECT_EQ(filtered_topic->GetRelatedTopic(), topic);
+  EXPECT_EQ(filtered_topic->GetTypeName(), kTypeName);
+
+  auto subscriber = participant->CreateSubscriber();
+  auto reader = subscriber->CreateDataReader(filtered_topic);
+  auto unfiltered_reader = subscriber->CreateDataReader(topic);
+  EXPECT_EQ(reader->GetTopic(), filtered_topic);
+
+  auto writer = participant->CreatePublisher()->CreateDataWriter(topic);
+  for (int32_t number : {1, 200, 3}) {
+    const std::string bytes = Field("a", number).SerializeAsString();
+    ASSERT_TRUE(writer->Write(bytes.data(), bytes.size()));
+  }
+  ASSERT_TRUE(writer->WriteMessage(std::make_shared<FieldDescriptorProto>(Field("b", 400))));
+  ASSERT_TRUE(writer->WriteMessage(std::make_shared<FieldDescriptorProto>(Field("b", 5))));
+
+  FieldDescriptorProto message;
+  SampleInfo info;
+  std::vector<int32_t> numbers;
+  while (reader->TakeMessage(&message, info)) {
+    numbers.push_back(message.number());
+    EXPECT_EQ(info.lost_sample_count, 0);
+  }
+  EXPECT_EQ(numbers, (std::vector<int32_t>{1, 3, 5}));
+
+  numbers.clear();
+  while (unfiltered_reader->TakeMessage(&message, info)) {
+    numbers.push_back(message.number());
+  }
+  EXPECT_EQ(numbers, (std::vector<int32_t>{1, 200, 3, 400, 5}));
+}
+
+TEST(ContentFilterTest, NetworkReadersFilterReceivedSamples) {
+  auto publisher_participant = DomainParticipant::Create(151, "content_filter_publisher");
+  auto subscriber_participant = DomainParticipant::Create(151, "content_filter_subscriber");
+
+  auto topic = subscriber_participant->CreateTopic(TestTopicName(), kTypeName);
+  auto reader = subscriber_participant->CreateSubscriber()->CreateDataReader(
+      subscriber_participant->CreateContentFilteredTopic(TestTopicName() + "_named", topic,
+                                                         "name <> 'skip'"));
+  auto writer = publisher_participant->CreatePublisher()->CreateDataWriter(
+      publisher_participant->CreateTopic(TestTopicName(), kTypeName));
+
+  for (const char* name : {"skip", "keep", "skip"}) {
+    const std::string bytes = Field(name, 1).SerializeAsString();
+    ASSERT_TRUE(writer->Write(bytes.data(), bytes.size()));
+  }
+
+  FieldDescriptorProto message;
+  SampleInfo info;
+  std::vector<uint8_t> buffer(256);
+  const int32_t size = reader->Take(buffer.data(), buffer.size(), info, std::chrono::seconds(2));
+  ASSERT_GT(size, 0);
+  ASSERT_TRUE(message.ParseFromArray(buffer.data(), size));
+  EXPECT_EQ(message.name(), "keep");
+  EXPECT_EQ(info.sequence_number, 2);
+  EXPECT_EQ(reader->Take(buffer.data(), buffer.size(), info, std::chrono::milliseconds(100)), -1);
+}
+
+}  // namespace
+}  // namespace tiny_dds
@@ -0,0 +1,223 @@
+#include "include/tiny_dds/coroutine.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/tiny_dds/data_reader.h"
+#include "include/tiny_dds/data_writer.h"
+#include "include/tiny_dds/domain_participant.h"
+#include "include/tiny_dds/executor.h"
+#include "include/tiny_dds/publisher.h"
+#include "include/tiny_dds/subscriber.h"
+#include "include/tiny_dds/topic.h"
+#include "include/tiny_dds/transport_types.h"
+#include "test/test_util.h"
+
+// Built with C++20 (see BUILD); without coroutine support there is nothing to test
+#ifdef TINY_DDS_HAS_COROUTINES
+
+namespace tiny_dds {
+namespace {
+
+// Polls a condition until it holds or two seconds have passed
+bool WaitFor(const std::function<bool()>& condition) {
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+  while (!condition()) {
+    if (std::chrono::steady_clock::now() >= deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  return true;
+}
+
+struct Received {
+  std::vector<int32_t> values;
+  std::atomic<bool> done{false};
+  std::thread::id thread;
+};
+
+DetachedTask ReceiveValues(std::shared_ptr<AsyncDataReader> reader, int count,
+                           std::shared_ptr<Received> received) {
+  for (int i = 0; i < count; ++i) {
+    int32_t value = -1;
+    SampleInfo info;
+    if (co_await reader->NextSample(&value, sizeof(value), info) == sizeof(value)) {
+      received->values.push_back(value);
+    }
+  }
+  received->thread = std::this_thread::get_id();
+  received->done.store(true);
+}
+
+TEST(CoroutineTest, NextSampleResumesWhenASampleIsQueued) {
+  auto participant = DomainParticipant::Create(221, "coroutine_next");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  auto topic = participant->CreateTopic(TestTopicName(), "test_type");
+  auto reader = AsyncDataReader::Create(participant->CreateSubscriber()->CreateDataReader(topic));
+  auto writer = participant->CreatePublisher()->CreateDataWriter(topic);
+
+  // A sample queued before the coroutine starts is taken without suspending
+  int32_t value = 0;
+  ASSERT_TRUE(writer->Write(&value, sizeof(value)));
+  auto received = std::make_shared<Received>();
+  ReceiveValues(reader, 3, received);
+  EXPECT_EQ(received->values, std::vector<int32_t>{0});
+
+  // Later ones resume it on the writer's thread
+  for (value = 1; value < 3; ++value) {
+    ASSERT_TRUE(writer->Write(&value, sizeof(value)));
+  }
+  ASSERT_TRUE(received->done.load());
+  EXPECT_EQ(received->values, (std::vector<int32_t>{0, 1, 2}));
+  EXPECT_EQ(received->thread, std::this_thread::get_id());
+}
+
+TEST(CoroutineTest, ManyCoroutinesAwaitWithoutThreads) {
+  auto participant = DomainParticipant::Create(221, "coroutine_many");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  auto topic = participant->CreateTopic(TestTopicName(), "test_type");
+  auto subscriber = participant->CreateSubscriber();
+
+  std::vector<std::shared_ptr<Received>> all_received;
+  for (int i = 0; i < 200; ++i) {
+    all_received.push_back(std::make_shared<Received>());
+    ReceiveValues(AsyncDataReader::Create(subscriber->CreateDataReader(topic)), 2,
+                  all_received.back());
+  }
+
+  auto writer = participant->CreatePublisher()->CreateDataWriter(topic);
+  for (int32_t value = 0; value < 2; ++value) {
+    ASSERT_TRUE(writer->Write(&value, sizeof(value)));
+  }
+  for (const auto& received : all_received) {
+    EXPECT_TRUE(received->done.load());
+    EXPECT_EQ(received->values, (std::vector<int32_t>{0, 1}));
+  }
+}
+
+TEST(CoroutineTest, ResumesOnTheChosenExecutor) {
+  auto participant = DomainParticipant::Create(221, "coroutine_executor");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  auto topic = participant->CreateTopic(TestTopicName(), "test_type");
+  ExecutorConfig config;
+  config.workers = 1;
+  auto reader = AsyncDataReader::Create(participant->CreateSubscriber()->CreateDataReader(topic),
+                                        Executor::Create(config));
+  auto writer = participant->CreatePublisher()->CreateDataWriter(topic);
+
+  auto received = std::make_shared<Received>();
+  ReceiveValues(reader, 2, received);
+  for (int32_t value = 0; value < 2; ++value) {
+    ASSERT_TRUE(writer->Write(&value, sizeof(value)));
+  }
+
+  ASSERT_TRUE(WaitFor([received]() { return received->done.load(); }));
+  EXPECT_EQ(received->values, (std::vector<int32_t>{0, 1}));
+  EXPECT_NE(received->thread, std::this_thread::get_id());
+}
+
+DetachedTask ReceiveBatch(std::shared_ptr<AsyncDataReader> reader,
+                          std::shared_ptr<Received> received) {
+  int32_t values[4] = {};
+  SampleBuffer buffers[4];
+  for (size_t i = 0; i < 4; ++i) {
+    buffers[i].data = &values[i];
+    buffers[i].capacity = sizeof(int32_t);
+  }
+  SampleInfo infos[4];
+
+  const int32_t count = co_await reader->TakeBatch(buffers, infos, 4);
+  received->values.assign(values, values + count);
+  received->done.store(true);
+}
+
+TEST(CoroutineTest, TakeBatchTakesTheSamplesQueuedTogether) {
+  auto participant = DomainParticipant::Create(221, "coroutine_batch");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  auto topic = participant->CreateTopic(TestTopicName(), "test_type");
+  auto data_reader = participant->CreateSubscriber()->CreateDataReader(topic);
+  auto reader = AsyncDataReader::Create(data_reader);
+  auto writer = participant->CreatePublisher()->CreateDataWriter(topic);
+
+  // Nothing is queued, so the coroutine suspends
+  auto received = std::make_shared<Received>();
+  ReceiveBatch(reader, received);
+  EXPECT_FALSE(received->done.load());
+
+  // and takes the first sample as soon as it is queued
+  int32_t value = 7;
+  ASSERT_TRUE(writer->Write(&value, sizeof(value)));
+  ASSERT_TRUE(received->done.load());
+  EXPECT_EQ(received->values, std::vector<int32_t>{7});
+
+  // A batch already queued completes at once
+  for (value = 0; value < 6; ++value) {
+    ASSERT_TRUE(writer->Write(&value, sizeof(value)));
+  }
+  received = std::make_shared<Received>();
+  ReceiveBatch(reader, received);
+  ASSERT_TRUE(received->done.load());
+  EXPECT_EQ(received->values, (std::vector<int32_t>{0, 1, 2, 3}));
+}
+
+struct Written {
+  std::vector<bool> results;
+  std::atomic<bool> done{false};
+};
+
+DetachedTask WriteValues(std::shared_ptr<AsyncDataWriter> writer, int count,
+                         std::shared_ptr<Written> written) {
+  for (int32_t value = 0; value < count; ++value) {
+    written->results.push_back(co_await writer->WriteReliable(&value, sizeof(value)));
+  }
+  written->done.store(true);
+}
+
+TEST(CoroutineTest, WriteReliableWaitsForRoomInTheQueue) {
+  auto subscriber_participant = DomainParticipant::Create(221, "coroutine_write_subscriber");
+  auto publisher_participant = DomainParticipant::Create(221, "coroutine_write_publisher");
+  auto reader = subscriber_participant->CreateSubscriber()->CreateDataReader(
+      subscriber_participant->CreateTopic(TestTopicName(), "test_type"));
+
+  auto publisher = publisher_participant->CreatePublisher();
+  AsyncPublishConfig config;
+  config.queue_capacity = 2;
+  config.max_batch_size = 1;
+  config.batch_interval = std::chrono::milliseconds(5);
+  ASSERT_TRUE(publisher->EnableAsynchronousPublishing(config));
+  auto data_writer =
+      publisher->CreateDataWriter(publisher_participant->CreateTopic(TestTopicName(), "test_type"));
+
+  // Fill the queue, so that the first write is only queued once it drains
+  int32_t filler = -1;
+  while (data_writer->Write(&filler, sizeof(filler))) {
+  }
+
+  auto written = std::make_shared<Written>();
+  WriteValues(AsyncDataWriter::Create(data_writer), 5, written);
+  ASSERT_TRUE(WaitFor([written]() { return written->done.load(); }));
+  EXPECT_EQ(written->results, std::vector<bool>(5, true));
+
+  std::vector<int32_t> values;
+  int32_t value = 0;
+  SampleInfo info;
+  while (reader->Take(&value, sizeof(value), info, std::chrono::milliseconds(500)) >= 0) {
+    if (value >= 0) {
+      values.push_back(value);
+    }
+  }
+  EXPECT_EQ(values, (std::vector<int32_t>{0, 1, 2, 3, 4}));
+}
+
+}  // namespace
+}  // namespace tiny_dds
+
+#endif  // TINY_DDS_HAS_COROUTINES
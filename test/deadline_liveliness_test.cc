@@ -0,0 +1,180 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "absl/synchronization/mutex.h"
+#include "google/protobuf/descriptor.pb.h"
+#include "gtest/gtest.h"
+#include "include/tiny_dds/data_reader.h"
+#include "include/tiny_dds/data_writer.h"
+#include "include/tiny_dds/domain_participant.h"
+#include "include/tiny_dds/publisher.h"
+#include "include/tiny_dds/subscriber.h"
+#include "include/tiny_dds/topic.h"
+#include "include/tiny_dds/transport_types.h"
+#include "include/tiny_dds/wait_set.h"
+#include "test/test_util.h"
+
+namespace tiny_dds {
+namespace {
+
+using google::protobuf::FieldDescriptorProto;
+using std::chrono::milliseconds;
+
+constexpr char kTypeName[] = "google.protobuf.FieldDescriptorProto";
+
+void WriteSample(DataWriter& writer, const std::string& name) {
+  FieldDescriptorProto sample;
+  sample.set_name(name);
+  const std::string bytes = sample.SerializeAsString();
+  ASSERT_TRUE(writer.Write(bytes.data(), bytes.size()));
+}
+
+// Polls a condition until it holds or two seconds have passed
+bool WaitFor(const std::function<bool()>& condition) {
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+  while (!condition()) {
+    if (std::chrono::steady_clock::now() >= deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(milliseconds(5));
+  }
+  return true;
+}
+
+TEST(DeadlineLivelinessTest, ReadersReportTheInstancesThatMissTheirDeadline) {
+  auto participant = DomainParticipant::Create(181, "deadline_reader");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  auto topic = participant->CreateTopic(TestTopicName(), kTypeName,
+                                        {FieldDescriptorProto::kNameFieldNumber});
+  DataReaderQos qos;
+  qos.deadline.period = milliseconds(50);
+  auto reader = participant->CreateSubscriber()->CreateDataReader(topic, qos);
+  auto writer = participant->CreatePublisher()->CreateDataWriter(topic);
+  auto condition = reader->GetStatusCondition();
+  condition->SetEnabledStatuses(REQUESTED_DEADLINE_MISSED_STATUS);
+
+  // Instance a gets a sample every 10ms, instance b only one
+  WriteSample(*writer, "b");
+  for (int i = 0; i < 30; ++i) {
+    WriteSample(*writer, "a");
+    std::this_thread::sleep_for(milliseconds(10));
+  }
+
+  FieldDescriptorProto key;
+  key.set_name("b");
+  EXPECT_TRUE(condition->GetTriggerValue());
+  const RequestedDeadlineMissedStatus status = reader->GetRequestedDeadlineMissedStatus();
+  EXPECT_GE(status.total_count, 3);
+  EXPECT_EQ(status.total_count_change, status.total_count);
+  EXPECT_EQ(status.last_instance_handle, reader->LookupInstance(key));
+  EXPECT_FALSE(condition->GetTriggerValue());
+  EXPECT_EQ(reader->GetRequestedDeadlineMissedStatus().total_count_change, 0);
+}
+
+TEST(DeadlineLivelinessTest, WritersReportPeriodsWithoutWrites) {
+  auto participant = DomainParticipant::Create(181, "deadline_writer");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  DataWriterQos qos;
+  qos.deadline.period = milliseconds(30);
+  auto writer = participant->CreatePublisher()->CreateDataWriter(
+      participant->CreateTopic(TestTopicName(), kTypeName), qos);
+
+  // Callbacks may still run on other threads as the test returns, so they own what they write to
+  auto missed = std::make_shared<std::atomic<int32_t>>(0);
+  writer->SetOfferedDeadlineMissedCallback(
+      [missed](const OfferedDeadlineMissedStatus& status) { *missed = status.total_count; });
+  ASSERT_TRUE(WaitFor([missed]() { return *missed >= 2; }));
+
+  // Writing more often than the period misses no deadline
+  WriteSample(*writer, "a");
+  const int32_t before = *missed;
+  for (int i = 0; i < 20; ++i) {
+    WriteSample(*writer, "a");
+    std::this_thread::sleep_for(milliseconds(5));
+  }
+  EXPECT_EQ(*missed, before);
+  EXPECT_EQ(writer->GetOfferedDeadlineMissedStatus().total_count_change, 0);
+}
+
+TEST(DeadlineLivelinessTest, ManualWritersLoseAndRegainTheirLiveliness) {
+  auto participant = DomainParticipant::Create(181, "liveliness_manual");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  auto topic = participant->CreateTopic(TestTopicName(), kTypeName);
+
+  DataReaderQos reader_qos;
+  reader_qos.liveliness.lease_duration = milliseconds(100);
+  auto reader = participant->CreateSubscriber()->CreateDataReader(topic, reader_qos);
+  struct Reported {
+    absl::Mutex mutex;
+    LivelinessChangedStatus status;
+  };
+  auto reported = std::make_shared<Reported>();
+  reader->SetLivelinessChangedCallback([reported](const LivelinessChangedStatus& status) {
+    absl::MutexLock lock(&reported->mutex);
+    reported->status = status;
+  });
+  auto current = [reported](int32_t alive, int32_t not_alive) {
+    return [reported, alive, not_alive]() {
+      absl::MutexLock lock(&reported->mutex);
+      return reported->status.alive_count == alive &&
+             reported->status.not_alive_count == not_alive;
+    };
+  };
+
+  DataWriterQos writer_qos;
+  writer_qos.liveliness.kind = LivelinessKind::MANUAL_BY_TOPIC;
+  writer_qos.liveliness.lease_duration = milliseconds(50);
+  auto writer = participant->CreatePublisher()->CreateDataWriter(topic, writer_qos);
+  auto lost = std::make_shared<std::atomic<int32_t>>(0);
+  writer->SetLivelinessLostCallback(
+      [lost](const LivelinessLostStatus& status) { *lost = status.total_count; });
+
+  // A heartbeat makes the writer alive, without a sample
+  ASSERT_TRUE(writer->AssertLiveliness());
+  ASSERT_TRUE(WaitFor(current(1, 0)));
+  SampleInfo info;
+  FieldDescriptorProto sample;
+  EXPECT_FALSE(reader->TakeMessage(&sample, info));
+
+  // Silence loses the liveliness on both sides, and a write regains it
+  ASSERT_TRUE(WaitFor(current(0, 1)));
+  EXPECT_EQ(*lost, 1);
+  WriteSample(*writer, "a");
+  ASSERT_TRUE(WaitFor(current(1, 0)));
+  {
+    absl::MutexLock lock(&reported->mutex);
+    EXPECT_EQ(reported->status.alive_count_change, 1);
+    EXPECT_EQ(reported->status.not_alive_count_change, -1);
+  }
+  EXPECT_TRUE(reader->TakeMessage(&sample, info));
+}
+
+TEST(DeadlineLivelinessTest, AutomaticWritersStayAliveWithoutWriting) {
+  auto publisher_participant = DomainParticipant::Create(181, "liveliness_publisher");
+  auto subscriber_participant = DomainParticipant::Create(181, "liveliness_subscriber");
+
+  DataReaderQos reader_qos;
+  reader_qos.liveliness.lease_duration = milliseconds(100);
+  auto reader = subscriber_participant->CreateSubscriber()->CreateDataReader(
+      subscriber_participant->CreateTopic(TestTopicName(), kTypeName), reader_qos);
+  DataWriterQos writer_qos;
+  writer_qos.liveliness.lease_duration = milliseconds(60);
+  auto writer = publisher_participant->CreatePublisher()->CreateDataWriter(
+      publisher_participant->CreateTopic(TestTopicName(), kTypeName), writer_qos);
+
+  ASSERT_TRUE(
+      WaitFor([&reader]() { return reader->GetLivelinessChangedStatus().alive_count == 1; }));
+  std::this_thread::sleep_for(milliseconds(300));
+  const LivelinessChangedStatus status = reader->GetLivelinessChangedStatus();
+  EXPECT_EQ(status.alive_count, 1);
+  EXPECT_EQ(status.not_alive_count, 0);
+  EXPECT_EQ(writer->GetLivelinessLostStatus().total_count, 0);
+}
+
+}  // namespace
+}  // namespace tiny_dds
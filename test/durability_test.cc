@@ -0,0 +1,296 @@
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "google/protobuf/wrappers.pb.h"
+#include "gtest/gtest.h"
+#include "include/tiny_dds/data_reader.h"
+#include "include/tiny_dds/data_writer.h"
+#include "include/tiny_dds/domain_participant.h"
+#include "include/tiny_dds/publisher.h"
+#include "include/tiny_dds/subscriber.h"
+#include "include/tiny_dds/topic.h"
+#include "include/tiny_dds/transport_types.h"
+#include "include/tiny_dds/types.h"
+#include "src/core/data_reader_impl.h"
+#include "src/core/sample_header.h"
+#include "src/core/topic_log.h"
+#include "test/test_util.h"
+
+namespace tiny_dds {
+namespace {
+
+DataWriterQos TransientLocalWriterQos(int32_t depth) {
+  DataWriterQos qos;
+  qos.durability = DurabilityKind::TRANSIENT_LOCAL;
+  qos.history.depth = depth;
+  return qos;
+}
+
+DataReaderQos TransientLocalReaderQos() {
+  DataReaderQos qos;
+  qos.durability = DurabilityKind::TRANSIENT_LOCAL;
+  return qos;
+}
+
+// Frames a sample the way a writer's replay does
+std::vector<uint8_t> ReplayedPacket(uint64_t sequence_number, uint32_t flags) {
+  core::SampleMetadata metadata;
+  metadata.writer_guid.value[0] = 1;
+  metadata.sequence_number = sequence_number;
+  metadata.flags = flags;
+
+  std::vector<uint8_t> packet(sizeof(core::SampleHeader) + sizeof(sequence_number));
+  core::EncodeSampleHeader(metadata, packet.data());
+  std::memcpy(packet.data() + sizeof(core::SampleHeader), &sequence_number,
+              sizeof(sequence_number));
+  return packet;
+}
+
+TEST(DurabilityTest, LocalLateJoinerReceivesWriterHistory) {
+  auto participant = DomainParticipant::Create(141, "durability_local");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  auto topic = participant->CreateTopic(TestTopicName(), "test_type");
+  auto subscriber = participant->CreateSubscriber();
+  auto writer = participant->CreatePublisher()->CreateDataWriter(topic, TransientLocalWriterQos(3));
+
+  for (int32_t i = 0; i < 5; ++i) {
+    ASSERT_TRUE(writer->Write(&i, sizeof(i)));
+  }
+
+  // The history holds the last three samples; volatile readers start empty
+  auto reader = subscriber->CreateDataReader(topic, TransientLocalReaderQos());
+  auto volatile_reader = subscriber->CreateDataReader(topic);
+  for (int32_t i = 2; i < 5; ++i) {
+    int32_t value = -1;
+    SampleInfo info;
+    ASSERT_EQ(reader->Take(&value, sizeof(value), info), sizeof(value));
+    EXPECT_EQ(value, i);
+    EXPECT_EQ(info.sequence_number, static_cast<uint64_t>(i + 1));
+  }
+
+  int32_t value = 5;
+  ASSERT_TRUE(writer->Write(&value, sizeof(value)));
+  SampleInfo info;
+  ASSERT_EQ(reader->Take(&value, sizeof(value), info), sizeof(value));
+  EXPECT_EQ(info.sequence_number, 6);
+  EXPECT_EQ(reader->Take(&value, sizeof(value), info), -1);
+
+  ASSERT_EQ(volatile_reader->Take(&value, sizeof(value), info), sizeof(value));
+  EXPECT_EQ(info.sequence_number, 6);
+}
+
+TEST(DurabilityTest, LateJoinerReceivesConcurrentWritesInOrder) {
+  auto participant = DomainParticipant::Create(141, "durability_local_concurrent");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  auto topic = participant->CreateTopic(TestTopicName(), "test_type");
+  auto writer =
+      participant->CreatePublisher()->CreateDataWriter(topic, TransientLocalWriterQos(100));
+
+  constexpr int kThreads = 8;
+  constexpr int kWritesPerThread = 2000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&writer]() {
+      for (int32_t i = 0; i < kWritesPerThread; ++i) {
+        writer->Write(&i, sizeof(i));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // The history holds the last samples written, oldest first
+  auto reader =
+      participant->CreateSubscriber()->CreateDataReader(topic, TransientLocalReaderQos());
+  int32_t value = -1;
+  SampleInfo info;
+  uint64_t expected = kThreads * kWritesPerThread - 100 + 1;
+  while (reader->Take(&value, sizeof(value), info) == sizeof(value)) {
+    ASSERT_EQ(info.sequence_number, expected);
+    ++expected;
+  }
+  EXPECT_EQ(expected, kThreads * kWritesPerThread + 1);
+}
+
+TEST(DurabilityTest, ReadersDropReplayedSamplesTheyAlreadyHave) {
+  auto participant = DomainParticipant::Create(141, "durability_duplicates");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  auto topic = participant->CreateTopic(TestTopicName(), "test_type");
+  auto subscriber = participant->CreateSubscriber();
+  auto reader = std::static_pointer_cast<core::DataReaderImpl>(
+      subscriber->CreateDataReader(topic, TransientLocalReaderQos()));
+  auto volatile_reader =
+      std::static_pointer_cast<core::DataReaderImpl>(subscriber->CreateDataReader(topic));
+
+  // Sample 5 arrives live before the replay of 3 to 5, which fills in 3 and 4
+  auto packets = {ReplayedPacket(5, 0), ReplayedPacket(3, core::SampleMetadata::REPLAYED),
+                  ReplayedPacket(4, core::SampleMetadata::REPLAYED),
+                  ReplayedPacket(5, core::SampleMetadata::REPLAYED |
+                                        core::SampleMetadata::END_OF_REPLAY),
+                  // A replay for another reader, then a live sample already replayed
+                  ReplayedPacket(3, core::SampleMetadata::REPLAYED), ReplayedPacket(4, 0)};
+  for (const auto& packet : packets) {
+    reader->OnDataReceived(packet.data(), packet.size());
+    volatile_reader->OnDataReceived(packet.data(), packet.size());
+  }
+
+  std::vector<uint64_t> received;
+  uint64_t value = 0;
+  SampleInfo info;
+  while (reader->Take(&value, sizeof(value), info) == sizeof(value)) {
+    received.push_back(value);
+  }
+  EXPECT_EQ(received, (std::vector<uint64_t>{5, 3, 4}));
+
+  received.clear();
+  while (volatile_reader->Take(&value, sizeof(value), info) == sizeof(value)) {
+    received.push_back(value);
+  }
+  EXPECT_EQ(received, (std::vector<uint64_t>{5, 4}));
+}
+
+TEST(DurabilityTest, NetworkLateJoinerRequestsWriterHistory) {
+  auto publisher_participant = DomainParticipant::Create(141, "durability_publisher");
+  auto subscriber_participant = DomainParticipant::Create(141, "durability_subscriber");
+
+  auto writer = publisher_participant->CreatePublisher()->CreateDataWriter(
+      publisher_participant->CreateTopic(TestTopicName(), "test_type"),
+      TransientLocalWriterQos(2));
+  for (int32_t i = 0; i < 3; ++i) {
+    ASSERT_TRUE(writer->Write(&i, sizeof(i)));
+  }
+
+  // Nobody listened to the writes; the reader's request brings the last two back
+  auto reader = subscriber_participant->CreateSubscriber()->CreateDataReader(
+      subscriber_participant->CreateTopic(TestTopicName(), "test_type"),
+      TransientLocalReaderQos());
+  int32_t value = -1;
+  SampleInfo info;
+  for (int32_t i = 1; i < 3; ++i) {
+    ASSERT_EQ(reader->Take(&value, sizeof(value), info, std::chrono::seconds(2)), sizeof(value));
+    EXPECT_EQ(value, i);
+    EXPECT_EQ(info.sequence_number, static_cast<uint64_t>(i + 1));
+  }
+
+  value = 3;
+  ASSERT_TRUE(writer->Write(&value, sizeof(value)));
+  ASSERT_EQ(reader->Take(&value, sizeof(value), info, std::chrono::seconds(2)), sizeof(value));
+  EXPECT_EQ(info.sequence_number, 4);
+}
+
+TEST(DurabilityTest, PersistentWriterReplaysItsLogFromRequestedSequenceNumber) {
+  auto participant = DomainParticipant::Create(141, "durability_persistent");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  auto topic = participant->CreateTopic(TestTopicName(), "test_type");
+
+  DataWriterQos writer_qos;
+  writer_qos.durability = DurabilityKind::PERSISTENT;
+  writer_qos.history.depth = 2;
+  writer_qos.persistence.directory = std::string(::testing::TempDir()) + "/" + TestTopicName();
+  std::filesystem::remove_all(writer_qos.persistence.directory);
+  auto writer = participant->CreatePublisher()->CreateDataWriter(topic, writer_qos);
+  for (int32_t i = 0; i < 10; ++i) {
+    ASSERT_TRUE(writer->Write(&i, sizeof(i)));
+  }
+
+  // Readers get the last history.depth samples, or those from a sequence number on
+  DataReaderQos reader_qos;
+  reader_qos.durability = DurabilityKind::PERSISTENT;
+  auto latest_reader = participant->CreateSubscriber()->CreateDataReader(topic, reader_qos);
+  reader_qos.replay_from_sequence_number = 7;
+  auto reader = participant->CreateSubscriber()->CreateDataReader(topic, reader_qos);
+
+  int32_t value = -1;
+  SampleInfo info;
+  std::vector<int32_t> received;
+  while (latest_reader->Take(&value, sizeof(value), info) == sizeof(value)) {
+    received.push_back(value);
+  }
+  EXPECT_EQ(received, (std::vector<int32_t>{8, 9}));
+
+  received.clear();
+  while (reader->Take(&value, sizeof(value), info) == sizeof(value)) {
+    received.push_back(value);
+  }
+  EXPECT_EQ(received, (std::vector<int32_t>{6, 7, 8, 9}));
+  EXPECT_EQ(info.sequence_number, 10);
+}
+
+TEST(DurabilityTest, PersistentWriterLogsEachMessageOnce) {
+  auto participant = DomainParticipant::Create(141, "durability_persistent_message");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  auto topic = participant->CreateTopic(TestTopicName(), "test_type");
+
+  DataWriterQos writer_qos;
+  writer_qos.durability = DurabilityKind::PERSISTENT;
+  writer_qos.persistence.directory = std::string(::testing::TempDir()) + "/" + TestTopicName();
+  std::filesystem::remove_all(writer_qos.persistence.directory);
+  auto writer = participant->CreatePublisher()->CreateDataWriter(topic, writer_qos);
+  auto message = std::make_shared<google::protobuf::StringValue>();
+  message->set_value("logged");
+  ASSERT_TRUE(writer->WriteMessage(message));
+
+  // The reopened log holds the serialized message alone, not an empty record before it
+  auto log = core::TopicLog::Open(
+      core::TopicLogDirectory(writer_qos.persistence, 141, TestTopicName()),
+      writer_qos.persistence);
+  ASSERT_NE(log, nullptr);
+  EXPECT_EQ(log->Size(), 1);
+  auto samples = log->ReadFromSequenceNumber(1, 10);
+  ASSERT_EQ(samples.size(), 1);
+  EXPECT_EQ(samples[0].metadata.sequence_number, 1);
+  google::protobuf::StringValue logged;
+  ASSERT_TRUE(logged.ParseFromArray(samples[0].data.get(), static_cast<int>(samples[0].size)));
+  EXPECT_EQ(logged.value(), "logged");
+}
+
+TEST(DurabilityTest, PersistentWriterLogsConcurrentWritesInOrder) {
+  auto participant = DomainParticipant::Create(141, "durability_persistent_concurrent");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  auto topic = participant->CreateTopic(TestTopicName(), "test_type");
+
+  DataWriterQos writer_qos;
+  writer_qos.durability = DurabilityKind::PERSISTENT;
+  writer_qos.persistence.directory = std::string(::testing::TempDir()) + "/" + TestTopicName();
+  std::filesystem::remove_all(writer_qos.persistence.directory);
+  auto writer = participant->CreatePublisher()->CreateDataWriter(topic, writer_qos);
+
+  constexpr int kThreads = 8;
+  constexpr int kWritesPerThread = 2000;
+  std::vector<int> failures(kThreads, 0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int32_t i = 0; i < kWritesPerThread; ++i) {
+        if (!writer->Write(&i, sizeof(i))) {
+          ++failures[t];
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(failures, std::vector<int>(kThreads, 0));
+
+  // Every write was logged, in sequence order
+  auto log = core::TopicLog::Open(
+      core::TopicLogDirectory(writer_qos.persistence, 141, TestTopicName()),
+      writer_qos.persistence);
+  ASSERT_NE(log, nullptr);
+  auto samples = log->ReadFromSequenceNumber(1, kThreads * kWritesPerThread);
+  ASSERT_EQ(samples.size(), kThreads * kWritesPerThread);
+  for (size_t i = 0; i < samples.size(); ++i) {
+    ASSERT_EQ(samples[i].metadata.sequence_number, i + 1);
+  }
+}
+
+}  // namespace
+}  // namespace tiny_dds
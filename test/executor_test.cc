@@ -0,0 +1,234 @@
+#include "include/tiny_dds/executor.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include "absl/synchronization/mutex.h"
+#include "google/protobuf/descriptor.pb.h"
+#include "gtest/gtest.h"
+#include "include/tiny_dds/data_reader.h"
+#include "include/tiny_dds/data_writer.h"
+#include "include/tiny_dds/domain_participant.h"
+#include "include/tiny_dds/publisher.h"
+#include "include/tiny_dds/subscriber.h"
+#include "include/tiny_dds/topic.h"
+#include "include/tiny_dds/transport_types.h"
+#include "test/test_util.h"
+
+namespace tiny_dds {
+namespace {
+
+using google::protobuf::FieldDescriptorProto;
+
+constexpr char kTypeName[] = "google.protobuf.FieldDescriptorProto";
+
+// Polls a condition until it holds or two seconds have passed
+bool WaitFor(const std::function<bool()>& condition) {
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+  while (!condition()) {
+    if (std::chrono::steady_clock::now() >= deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  return true;
+}
+
+TEST(ExecutorTest, RunsQueuedTasksBeforeItIsDestroyed) {
+  auto ran = std::make_shared<std::atomic<int>>(0);
+  {
+    ExecutorConfig config;
+    config.workers = 2;
+    auto executor = Executor::Create(config);
+    EXPECT_EQ(executor->WorkerCount(), 2);
+    for (int i = 0; i < 1000; ++i) {
+      executor->Post([ran]() { ran->fetch_add(1); });
+    }
+  }
+  EXPECT_EQ(ran->load(), 1000);
+}
+
+TEST(ExecutorTest, IdleWorkersStealTasksQueuedBehindABusyOne) {
+  ExecutorConfig config;
+  config.workers = 2;
+  auto executor = Executor::Create(config);
+
+  // Tasks posted from a worker go to its own deque, so the second task runs
+  // only if the other worker steals it while the first one waits for it
+  auto stolen = std::make_shared<std::atomic<bool>>(false);
+  auto done = std::make_shared<std::atomic<bool>>(false);
+  executor->Post([executor_ptr = executor.get(), stolen, done]() {
+    executor_ptr->Post([stolen]() { stolen->store(true); });
+    WaitFor([stolen]() { return stolen->load(); });
+    done->store(true);
+  });
+  ASSERT_TRUE(WaitFor([done]() { return done->load(); }));
+  EXPECT_TRUE(stolen->load());
+}
+
+TEST(ExecutorTest, StrandsRunTheirTasksInOrderOneAtATime) {
+  ExecutorConfig config;
+  config.workers = 4;
+  auto executor = Executor::Create(config);
+
+  struct Record {
+    std::vector<int> order;
+    std::atomic<int> running{0};
+    std::atomic<bool> overlapped{false};
+  };
+  std::vector<std::shared_ptr<Record>> records;
+  std::vector<std::shared_ptr<Strand>> strands;
+  for (int s = 0; s < 3; ++s) {
+    records.push_back(std::make_shared<Record>());
+    strands.push_back(executor->CreateStrand());
+  }
+
+  // The records are written without locks, as strands promise
+  for (int i = 0; i < 300; ++i) {
+    for (size_t s = 0; s < strands.size(); ++s) {
+      strands[s]->Post([record = records[s], i]() {
+        if (record->running.fetch_add(1) != 0) {
+          record->overlapped.store(true);
+        }
+        record->order.push_back(i);
+        record->running.fetch_sub(1);
+      });
+    }
+  }
+  executor.reset();
+
+  for (const auto& record : records) {
+    EXPECT_FALSE(record->overlapped.load());
+    ASSERT_EQ(record->order.size(), 300);
+    for (int i = 0; i < 300; ++i) {
+      EXPECT_EQ(record->order[i], i);
+    }
+  }
+}
+
+#ifdef __linux__
+TEST(ExecutorTest, PinsWorkersToTheirCpus) {
+  ExecutorConfig config;
+  config.workers = 2;
+  config.cpus = {0};
+  auto executor = Executor::Create(config);
+
+  auto cpus = std::make_shared<std::vector<int>>();
+  auto mutex = std::make_shared<absl::Mutex>();
+  for (int i = 0; i < 20; ++i) {
+    executor->Post([cpus, mutex]() {
+      absl::MutexLock lock(mutex.get());
+      cpus->push_back(sched_getcpu());
+    });
+  }
+  executor.reset();
+
+  EXPECT_EQ(*cpus, std::vector<int>(20, 0));
+}
+#endif
+
+TEST(ExecutorTest, ReaderCallbacksRunInOrderOnTheChosenExecutor) {
+  auto participant = DomainParticipant::Create(211, "executor_reader");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  auto topic = participant->CreateTopic(TestTopicName(), kTypeName);
+  auto reader = participant->CreateSubscriber()->CreateDataReader(topic);
+  auto writer = participant->CreatePublisher()->CreateDataWriter(topic);
+
+  ExecutorConfig config;
+  config.workers = 4;
+  reader->SetCallbackExecutor(Executor::Create(config));
+
+  // Callbacks may still run on other threads as the test returns, so they own what they write to
+  struct Received {
+    std::vector<uint64_t> sequence_numbers;
+    std::atomic<size_t> count{0};
+    std::atomic<bool> on_writer_thread{false};
+  };
+  auto received = std::make_shared<Received>();
+  const std::thread::id writer_thread = std::this_thread::get_id();
+  reader->SetDataReceivedCallback(
+      [received, writer_thread](const void* /*data*/, size_t /*size*/, const SampleInfo& info) {
+        if (std::this_thread::get_id() == writer_thread) {
+          received->on_writer_thread.store(true);
+        }
+        received->sequence_numbers.push_back(info.sequence_number);
+        received->count.fetch_add(1);
+      });
+
+  const std::string bytes = FieldDescriptorProto().SerializeAsString();
+  for (int i = 0; i < 200; ++i) {
+    ASSERT_TRUE(writer->Write(bytes.data(), bytes.size()));
+  }
+
+  ASSERT_TRUE(WaitFor([received]() { return received->count.load() == 200; }));
+  EXPECT_FALSE(received->on_writer_thread.load());
+  for (size_t i = 0; i < received->sequence_numbers.size(); ++i) {
+    EXPECT_EQ(received->sequence_numbers[i], i + 1);
+  }
+}
+
+TEST(ExecutorTest, CallbacksOfEachInstanceStayInOrder) {
+  auto participant = DomainParticipant::Create(211, "executor_instances");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  auto topic = participant->CreateTopic(TestTopicName(), kTypeName,
+                                        {FieldDescriptorProto::kNameFieldNumber});
+  auto reader = participant->CreateSubscriber()->CreateDataReader(topic);
+  auto writer = participant->CreatePublisher()->CreateDataWriter(topic);
+
+  ExecutorConfig config;
+  config.workers = 4;
+  reader->SetCallbackExecutor(Executor::Create(config), CallbackOrdering::PER_INSTANCE);
+
+  // Instances may be called back concurrently, so the numbers they saw are locked
+  struct Received {
+    absl::Mutex mutex;
+    std::map<std::string, std::vector<int32_t>> numbers;
+    std::atomic<size_t> count{0};
+  };
+  auto received = std::make_shared<Received>();
+  reader->SetDataReceivedCallback(
+      [received](const void* data, size_t size, const SampleInfo& /*info*/) {
+        FieldDescriptorProto sample;
+        sample.ParseFromArray(data, static_cast<int>(size));
+        {
+          absl::MutexLock lock(&received->mutex);
+          received->numbers[sample.name()].push_back(sample.number());
+        }
+        received->count.fetch_add(1);
+      });
+
+  const std::vector<std::string> names = {"a", "b", "c", "d", "e"};
+  for (int32_t number = 0; number < 50; ++number) {
+    for (const std::string& name : names) {
+      FieldDescriptorProto sample;
+      sample.set_name(name);
+      sample.set_number(number);
+      const std::string bytes = sample.SerializeAsString();
+      ASSERT_TRUE(writer->Write(bytes.data(), bytes.size()));
+    }
+  }
+
+  ASSERT_TRUE(WaitFor([received]() { return received->count.load() == 250; }));
+  absl::MutexLock lock(&received->mutex);
+  ASSERT_EQ(received->numbers.size(), names.size());
+  for (const auto& [name, numbers] : received->numbers) {
+    ASSERT_EQ(numbers.size(), 50) << name;
+    for (int32_t number = 0; number < 50; ++number) {
+      EXPECT_EQ(numbers[number], number) << name;
+    }
+  }
+}
+
+}  // namespace
+}  // namespace tiny_dds
@@ -0,0 +1,130 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "google/protobuf/wrappers.pb.h"
+#include "gtest/gtest.h"
+#include "include/tiny_dds/data_reader.h"
+#include "include/tiny_dds/data_writer.h"
+#include "include/tiny_dds/domain_participant.h"
+#include "include/tiny_dds/publisher.h"
+#include "include/tiny_dds/subscriber.h"
+#include "include/tiny_dds/topic.h"
+#include "include/tiny_dds/transport_types.h"
+#include "include/tiny_dds/types.h"
+#include "test/test_util.h"
+
+namespace tiny_dds {
+namespace {
+
+class IntraProcessTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    participant_ = DomainParticipant::Create(61, "intra_process_participant");
+    ASSERT_NE(participant_, nullptr);
+    ASSERT_TRUE(participant_->SetTransportType(TransportType::LOCAL_ONLY));
+
+    publisher_ = participant_->CreatePublisher();
+    subscriber_ = participant_->CreateSubscriber();
+    topic_name_ = TestTopicName();
+    topic_ = participant_->CreateTopic(topic_name_, "google.protobuf.StringValue");
+    ASSERT_NE(topic_, nullptr);
+  }
+
+  std::shared_ptr<DomainParticipant> participant_;
+  std::shared_ptr<Publisher> publisher_;
+  std::shared_ptr<Subscriber> subscriber_;
+  std::string topic_name_;
+  std::shared_ptr<Topic> topic_;
+};
+
+TEST_F(IntraProcessTest, DeliversBytesToLocalReader) {
+  auto reader = subscriber_->CreateDataReader(topic_);
+  auto writer = publisher_->CreateDataWriter(topic_);
+  ASSERT_NE(reader, nullptr);
+  ASSERT_NE(writer, nullptr);
+
+  const char first[] = "first";
+  const char second[] = "second";
+  EXPECT_TRUE(writer->Write(first, sizeof(first)));
+  EXPECT_TRUE(writer->Write(second, sizeof(second)));
+
+  char buffer[64] = {0};
+  SampleInfo info;
+  ASSERT_EQ(reader->Take(buffer, sizeof(buffer), info), sizeof(first));
+  EXPECT_TRUE(info.valid_data);
+  EXPECT_STREQ(buffer, first);
+  ASSERT_EQ(reader->Take(buffer, sizeof(buffer), info), sizeof(second));
+  EXPECT_STREQ(buffer, second);
+  EXPECT_EQ(reader->Take(buffer, sizeof(buffer), info), -1);
+}
+
+TEST_F(IntraProcessTest, SharesBufferWithCallbacks) {
+  auto writer = publisher_->CreateDataWriter(topic_);
+  auto other_subscriber = participant_->CreateSubscriber();
+  auto first_reader = subscriber_->CreateDataReader(topic_);
+  auto second_reader = other_subscriber->CreateDataReader(topic_);
+
+  std::vector<const void*> seen;
+  auto record = [&](const void* data, size_t /*size*/, const SampleInfo& /*info*/) {
+    seen.push_back(data);
+  };
+  first_reader->SetDataReceivedCallback(record);
+  second_reader->SetDataReceivedCallback(record);
+
+  auto payload = std::make_shared<const std::vector<uint8_t>>(1024, 0x5A);
+  ASSERT_TRUE(writer->WriteShared(std::shared_ptr<const void>(payload, payload->data()),
+                                  payload->size()));
+
+  // Both readers see the writer's buffer itself, not a copy
+  ASSERT_EQ(seen.size(), 2);
+  EXPECT_EQ(seen[0], payload->data());
+  EXPECT_EQ(seen[1], payload->data());
+}
+
+TEST_F(IntraProcessTest, PassesMessagesWithoutSerialization) {
+  auto reader = subscriber_->CreateDataReader(topic_);
+  auto writer = publisher_->CreateDataWriter(topic_);
+
+  auto message = std::make_shared<google::protobuf::StringValue>();
+  message->set_value("component output");
+  ASSERT_TRUE(writer->WriteMessage(message));
+  ASSERT_TRUE(writer->WriteMessage(message));
+
+  google::protobuf::StringValue received;
+  SampleInfo info;
+  ASSERT_TRUE(reader->TakeMessage(&received, info));
+  EXPECT_TRUE(info.valid_data);
+  EXPECT_EQ(received.value(), "component output");
+
+  // Byte readers still get the serialized form
+  char buffer[64];
+  int32_t size = reader->Take(buffer, sizeof(buffer), info);
+  ASSERT_GT(size, 0);
+  google::protobuf::StringValue parsed;
+  ASSERT_TRUE(parsed.ParseFromArray(buffer, size));
+  EXPECT_EQ(parsed.value(), "component output");
+}
+
+TEST_F(IntraProcessTest, IgnoresOtherTopicsAndDomains) {
+  auto reader = subscriber_->CreateDataReader(topic_);
+
+  auto other_topic = participant_->CreateTopic("unrelated", "google.protobuf.StringValue");
+  auto other_writer = publisher_->CreateDataWriter(other_topic);
+
+  auto other_participant = DomainParticipant::Create(62, "other_domain_participant");
+  ASSERT_TRUE(other_participant->SetTransportType(TransportType::LOCAL_ONLY));
+  auto other_domain_writer = other_participant->CreatePublisher()->CreateDataWriter(
+      other_participant->CreateTopic(topic_name_, "google.protobuf.StringValue"));
+
+  const char sample[] = "sample";
+  EXPECT_TRUE(other_writer->Write(sample, sizeof(sample)));
+  EXPECT_TRUE(other_domain_writer->Write(sample, sizeof(sample)));
+
+  char buffer[64];
+  SampleInfo info;
+  EXPECT_EQ(reader->Take(buffer, sizeof(buffer), info), -1);
+}
+
+}  // namespace
+}  // namespace tiny_dds
@@ -0,0 +1,200 @@
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "google/protobuf/descriptor.pb.h"
+#include "gtest/gtest.h"
+#include "include/tiny_dds/data_reader.h"
+#include "include/tiny_dds/data_writer.h"
+#include "include/tiny_dds/domain_participant.h"
+#include "include/tiny_dds/publisher.h"
+#include "include/tiny_dds/subscriber.h"
+#include "include/tiny_dds/topic.h"
+#include "include/tiny_dds/transport_types.h"
+#include "src/core/instance_key.h"
+#include "test/test_util.h"
+
+namespace tiny_dds {
+namespace {
+
+using google::protobuf::FieldDescriptorProto;
+
+// Samples are keyed by name and extendee, fields 1 and 2
+constexpr char kTypeName[] = "google.protobuf.FieldDescriptorProto";
+const std::vector<int32_t> kKeyFields = {FieldDescriptorProto::kNameFieldNumber,
+                                         FieldDescriptorProto::kExtendeeFieldNumber};
+
+FieldDescriptorProto Sample(const std::string& name, int32_t number) {
+  FieldDescriptorProto sample;
+  sample.set_name(name);
+  sample.set_number(number);
+  return sample;
+}
+
+// Reads the newest sample of an instance and returns its number, or -1
+int32_t ReadNumber(DataReader& reader, InstanceHandle handle, SampleInfo* info = nullptr) {
+  std::vector<uint8_t> buffer(256);
+  SampleInfo sample_info;
+  const int32_t size = reader.ReadInstance(handle, buffer.data(), buffer.size(), sample_info);
+  FieldDescriptorProto sample;
+  if (size < 0 || !sample.ParseFromArray(buffer.data(), size)) {
+    return -1;
+  }
+  if (info != nullptr) {
+    *info = sample_info;
+  }
+  return sample.number();
+}
+
+TEST(KeyedTopicTest, KeysAreTheSameForSamplesAndMessages) {
+  auto key = core::InstanceKey::Compile(FieldDescriptorProto::descriptor(), kKeyFields);
+  ASSERT_NE(key, nullptr);
+
+  FieldDescriptorProto sample = Sample("speed", 1);
+  std::string from_message;
+  std::string from_bytes;
+  ASSERT_TRUE(key->Extract(sample, &from_message));
+  const std::string bytes = sample.SerializeAsString();
+  ASSERT_TRUE(key->Extract(bytes.data(), bytes.size(), &from_bytes));
+  EXPECT_EQ(from_message, from_bytes);
+
+  // Other fields are not part of the key; unset key fields are, with their default values
+  std::string other;
+  ASSERT_TRUE(key->Extract(Sample("speed", 2), &other));
+  EXPECT_EQ(other, from_message);
+  sample.set_extendee("vehicle");
+  ASSERT_TRUE(key->Extract(sample, &other));
+  EXPECT_NE(other, from_message);
+
+  EXPECT_EQ(core::InstanceKey::Compile(FieldDescriptorProto::descriptor(), {99}), nullptr);
+  EXPECT_EQ(core::InstanceKey::Compile(FieldDescriptorProto::descriptor(), {1, 1}), nullptr);
+  EXPECT_EQ(core::InstanceKey::Compile(FieldDescriptorProto::descriptor(),
+                                       {FieldDescriptorProto::kOptionsFieldNumber}),
+            nullptr);
+}
+
+TEST(KeyedTopicTest, ReadersKeepTheLastSamplesOfEachInstance) {
+  auto participant = DomainParticipant::Create(161, "keyed_topic_local");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  auto topic = participant->CreateTopic(TestTopicName(), kTypeName, kKeyFields);
+  ASSERT_NE(topic, nullptr);
+  EXPECT_EQ(topic->GetKeyFields(), kKeyFields);
+  EXPECT_EQ(participant->CreateTopic(TestTopicName(), kTypeName), nullptr);
+  EXPECT_EQ(participant->CreateTopic(TestTopicName() + "_raw", "raw", {1}), nullptr);
+
+  DataReaderQos qos;
+  qos.history.depth = 2;
+  auto reader = participant->CreateSubscriber()->CreateDataReader(topic, qos);
+  auto writer = participant->CreatePublisher()->CreateDataWriter(topic);
+  EXPECT_EQ(reader->LookupInstance(Sample("a", 0)), HANDLE_NIL);
+
+  for (int32_t number : {1, 2, 3}) {
+    ASSERT_TRUE(writer->WriteMessage(std::make_shared<FieldDescriptorProto>(Sample("a", number))));
+  }
+  const std::string bytes = Sample("b", 10).SerializeAsString();
+  ASSERT_TRUE(writer->Write(bytes.data(), bytes.size()));
+  ASSERT_TRUE(writer->WriteMessage(std::make_shared<FieldDescriptorProto>(Sample("a", 4))));
+
+  const InstanceHandle a = reader->LookupInstance(Sample("a", 0));
+  const InstanceHandle b = reader->LookupInstance(bytes.data(), bytes.size());
+  ASSERT_NE(a, HANDLE_NIL);
+  ASSERT_NE(b, HANDLE_NIL);
+  EXPECT_NE(a, b);
+
+  SampleInfo info;
+  EXPECT_EQ(ReadNumber(*reader, a, &info), 4);
+  EXPECT_EQ(info.instance_handle, a);
+  EXPECT_EQ(info.sample_state, SampleStateKind::NOT_READ);
+  EXPECT_EQ(ReadNumber(*reader, b), 10);
+  EXPECT_EQ(ReadNumber(*reader, HANDLE_NIL), -1);
+
+  // Instance a kept its last 2 samples, in the order they arrived with b's
+  FieldDescriptorProto sample;
+  std::vector<int32_t> numbers;
+  while (reader->TakeMessage(&sample, info)) {
+    numbers.push_back(sample.number());
+    EXPECT_EQ(info.instance_handle, sample.name() == "a" ? a : b);
+  }
+  EXPECT_EQ(numbers, (std::vector<int32_t>{3, 10, 4}));
+
+  // Taken samples leave the history, but each instance keeps its last value
+  EXPECT_EQ(ReadNumber(*reader, a, &info), 4);
+  EXPECT_EQ(info.sample_state, SampleStateKind::READ);
+  ASSERT_TRUE(writer->WriteMessage(std::make_shared<FieldDescriptorProto>(Sample("a", 5))));
+  EXPECT_EQ(reader->LookupInstance(Sample("a", 0)), a);
+  EXPECT_EQ(ReadNumber(*reader, a), 5);
+}
+
+TEST(KeyedTopicTest, InstancesKeepTheirLastValueWhenTheHistoryIsFull) {
+  auto participant = DomainParticipant::Create(161, "keyed_topic_full");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  auto topic = participant->CreateTopic(TestTopicName(), kTypeName, kKeyFields);
+
+  DataReaderQos qos;
+  qos.history.depth = 1;
+  qos.history.max_samples = 2;
+  auto reader = participant->CreateSubscriber()->CreateDataReader(topic, qos);
+  auto writer = participant->CreatePublisher()->CreateDataWriter(topic);
+
+  for (const char* name : {"a", "b", "c"}) {
+    const std::string bytes = Sample(name, 7).SerializeAsString();
+    ASSERT_TRUE(writer->Write(bytes.data(), bytes.size()));
+  }
+
+  // The sample of a was replaced in the history, not as the value of a
+  for (const char* name : {"a", "b", "c"}) {
+    EXPECT_EQ(ReadNumber(*reader, reader->LookupInstance(Sample(name, 0))), 7) << name;
+  }
+}
+
+TEST(KeyedTopicTest, NetworkReadersServeTheLatestStateOfEachInstance) {
+  auto publisher_participant = DomainParticipant::Create(161, "keyed_topic_publisher");
+  auto subscriber_participant = DomainParticipant::Create(161, "keyed_topic_subscriber");
+
+  DataReaderQos qos;
+  qos.history.depth = 1;
+  auto reader = subscriber_participant->CreateSubscriber()->CreateDataReader(
+      subscriber_participant->CreateTopic(TestTopicName(), kTypeName, kKeyFields), qos);
+  auto writer = publisher_participant->CreatePublisher()->CreateDataWriter(
+      publisher_participant->CreateTopic(TestTopicName(), kTypeName, kKeyFields));
+
+  for (int32_t round = 0; round < 3; ++round) {
+    for (const char* name : {"x", "y", "z"}) {
+      const std::string bytes = Sample(name, round).SerializeAsString();
+      ASSERT_TRUE(writer->Write(bytes.data(), bytes.size()));
+    }
+  }
+
+  // Wait for the last sample to arrive
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+  InstanceHandle z = HANDLE_NIL;
+  while (std::chrono::steady_clock::now() < deadline) {
+    z = reader->LookupInstance(Sample("z", 0));
+    if (z != HANDLE_NIL && ReadNumber(*reader, z) == 2) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  ASSERT_NE(z, HANDLE_NIL);
+
+  for (const char* name : {"x", "y", "z"}) {
+    EXPECT_EQ(ReadNumber(*reader, reader->LookupInstance(Sample(name, 0))), 2) << name;
+  }
+  EXPECT_EQ(reader->LookupInstance(Sample("w", 0)), HANDLE_NIL);
+
+  // One sample per instance is kept
+  std::vector<SampleBuffer> buffers(8);
+  std::vector<std::vector<uint8_t>> storage(8, std::vector<uint8_t>(256));
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    buffers[i].data = storage[i].data();
+    buffers[i].capacity = storage[i].size();
+  }
+  std::vector<SampleInfo> infos(buffers.size());
+  EXPECT_EQ(reader->TakeN(buffers.data(), infos.data(), buffers.size(), ANY_SAMPLE_STATE), 3);
+}
+
+}  // namespace
+}  // namespace tiny_dds
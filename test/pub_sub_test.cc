@@ -156,6 +156,77 @@ TEST_F(SimplePubSubTest, AttemptDataReaderCreation) {
   std::cout << "AttemptDataReaderCreation test complete!" << std::endl;
 }
 
-// Skip data reader/writer tests for now since they seem to be causing issues
+TEST_F(SimplePubSubTest, WriteAndTakeOverUdp) {
+  auto publisher = publisher_participant_->CreatePublisher();
+  auto subscriber = subscriber_participant_->CreateSubscriber();
+  auto publisher_topic = publisher_participant_->CreateTopic("udp_topic", "test_type");
+  auto subscriber_topic = subscriber_participant_->CreateTopic("udp_topic", "test_type");
+
+  auto data_reader = subscriber->CreateDataReader(subscriber_topic);
+  auto data_writer = publisher->CreateDataWriter(publisher_topic);
+  ASSERT_NE(data_reader, nullptr);
+  ASSERT_NE(data_writer, nullptr);
+
+  const char sample[] = "udp-sample";
+  ASSERT_TRUE(data_writer->Write(sample, sizeof(sample)));
+
+  char buffer[64] = {0};
+  SampleInfo info;
+  int32_t bytes_read = -1;
+  auto start = std::chrono::steady_clock::now();
+  while (bytes_read < 0 && std::chrono::steady_clock::now() - start < std::chrono::seconds(2)) {
+    bytes_read = data_reader->Take(buffer, sizeof(buffer), info);
+    if (bytes_read < 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  ASSERT_EQ(bytes_read, sizeof(sample));
+  EXPECT_TRUE(info.valid_data);
+  EXPECT_STREQ(buffer, sample);
+}
+
+// Writes one sample larger than 64KB, then a small one, and takes both through a DataReader
+void ExpectLargeSampleIsTaken(TransportType transport_type, const std::string& topic_name) {
+  auto publisher_participant = DomainParticipant::Create(43, "large_publisher");
+  auto subscriber_participant = DomainParticipant::Create(43, "large_subscriber");
+  ASSERT_TRUE(publisher_participant->SetTransportType(transport_type));
+  ASSERT_TRUE(subscriber_participant->SetTransportType(transport_type));
+
+  auto data_reader = subscriber_participant->CreateSubscriber()->CreateDataReader(
+      subscriber_participant->CreateTopic(topic_name, "test_type"));
+  auto data_writer = publisher_participant->CreatePublisher()->CreateDataWriter(
+      publisher_participant->CreateTopic(topic_name, "test_type"));
+  ASSERT_NE(data_reader, nullptr);
+  ASSERT_NE(data_writer, nullptr);
+
+  std::vector<uint8_t> large(1024 * 1024);
+  for (size_t i = 0; i < large.size(); ++i) {
+    large[i] = static_cast<uint8_t>(i * 7);
+  }
+  const char small[] = "after-large";
+  ASSERT_TRUE(data_writer->Write(large.data(), large.size()));
+  ASSERT_TRUE(data_writer->Write(small, sizeof(small)));
+
+  // The large sample does not hold up the samples behind it
+  std::vector<uint8_t> buffer(large.size());
+  SampleInfo info;
+  ASSERT_EQ(data_reader->Take(buffer.data(), buffer.size(), info, std::chrono::seconds(5)),
+            large.size());
+  EXPECT_EQ(buffer, large);
+  ASSERT_EQ(data_reader->Take(buffer.data(), buffer.size(), info, std::chrono::seconds(5)),
+            sizeof(small));
+  EXPECT_STREQ(reinterpret_cast<const char*>(buffer.data()), small);
+}
+
+TEST(LargeSampleTest, TakesSamplesLargerThan64KBOverTcp) {
+  ExpectLargeSampleIsTaken(TransportType::TCP, "large_tcp_topic");
+}
+
+// Samples above the inline threshold reach the reader as memfds
+TEST(LargeSampleTest, TakesSamplesPassedAsDescriptorsOverUnixSockets) {
+  ExpectLargeSampleIsTaken(TransportType::UNIX_SOCKET, "large_unix_topic");
+}
+
 }  // namespace
 }  // namespace tiny_dds
\ No newline at end of file
@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/tiny_dds/data_reader.h"
+#include "include/tiny_dds/data_writer.h"
+#include "include/tiny_dds/domain_participant.h"
+#include "include/tiny_dds/publisher.h"
+#include "include/tiny_dds/subscriber.h"
+#include "include/tiny_dds/topic.h"
+#include "include/tiny_dds/transport_types.h"
+#include "include/tiny_dds/types.h"
+#include "test/test_util.h"
+
+namespace tiny_dds {
+namespace {
+
+TEST(PublishQueueTest, DeliversQueuedSamplesInOrder) {
+  auto subscriber_participant = DomainParticipant::Create(131, "publish_queue_subscriber");
+  auto publisher_participant = DomainParticipant::Create(131, "publish_queue_publisher");
+
+  // The reader binds first so that the writer's samples find it
+  auto reader = subscriber_participant->CreateSubscriber()->CreateDataReader(
+      subscriber_participant->CreateTopic(TestTopicName(), "test_type"));
+  auto publisher = publisher_participant->CreatePublisher();
+  AsyncPublishConfig config;
+  config.slot_size = 64;  // The large sample below spills to a pooled buffer
+  config.max_batch_size = 4;
+  ASSERT_TRUE(publisher->EnableAsynchronousPublishing(config));
+  auto writer =
+      publisher->CreateDataWriter(publisher_participant->CreateTopic(TestTopicName(), "test_type"));
+
+  for (int32_t i = 0; i < 10; ++i) {
+    ASSERT_TRUE(writer->Write(&i, sizeof(i)));
+  }
+  std::vector<uint8_t> large(1024, 0xab);
+  ASSERT_TRUE(writer->Write(large.data(), large.size()));
+  publisher->Flush();
+
+  for (int32_t i = 0; i < 10; ++i) {
+    int32_t value = -1;
+    SampleInfo info;
+    ASSERT_EQ(reader->Take(&value, sizeof(value), info, std::chrono::seconds(2)), sizeof(value));
+    EXPECT_EQ(value, i);
+    EXPECT_EQ(info.sequence_number, static_cast<uint64_t>(i + 1));
+  }
+  std::vector<uint8_t> received(2048);
+  SampleInfo info;
+  ASSERT_EQ(reader->Take(received.data(), received.size(), info, std::chrono::seconds(2)),
+            large.size());
+  received.resize(large.size());
+  EXPECT_EQ(received, large);
+}
+
+TEST(PublishQueueTest, RejectsSamplesWhenFull) {
+  auto participant = DomainParticipant::Create(131, "publish_queue_full");
+  auto publisher = participant->CreatePublisher();
+
+  // One sample per batch and a slow pace keep the flusher from draining the queue
+  AsyncPublishConfig config;
+  config.queue_capacity = 2;
+  config.max_batch_size = 1;
+  config.batch_interval = std::chrono::milliseconds(500);
+  ASSERT_TRUE(publisher->EnableAsynchronousPublishing(config));
+  auto writer = publisher->CreateDataWriter(participant->CreateTopic(TestTopicName(), "test_type"));
+
+  int accepted = 0;
+  for (int32_t i = 0; i < 8; ++i) {
+    if (writer->Write(&i, sizeof(i))) {
+      ++accepted;
+    }
+  }
+  EXPECT_GE(accepted, 2);
+  EXPECT_LE(accepted, 3);
+}
+
+// Takes the values of the samples a reader receives until none arrives for a while
+std::vector<int32_t> TakeValues(const std::shared_ptr<DataReader>& reader) {
+  std::vector<int32_t> values;
+  int32_t value = 0;
+  SampleInfo info;
+  while (reader->Take(&value, sizeof(value), info, std::chrono::milliseconds(500)) >= 0) {
+    values.push_back(value);
+  }
+  return values;
+}
+
+TEST(PublishQueueTest, HigherPrioritiesInterruptPacedBatches) {
+  auto subscriber_participant = DomainParticipant::Create(131, "publish_queue_priority_sub");
+  auto publisher_participant = DomainParticipant::Create(131, "publish_queue_priority_pub");
+  auto reader = subscriber_participant->CreateSubscriber()->CreateDataReader(
+      subscriber_participant->CreateTopic(TestTopicName(), "test_type"));
+
+  // One sample per batch, paced slowly enough that the bulk samples queue up
+  auto publisher = publisher_participant->CreatePublisher();
+  AsyncPublishConfig config;
+  config.max_batch_size = 1;
+  config.batch_interval = std::chrono::milliseconds(20);
+  ASSERT_TRUE(publisher->EnableAsynchronousPublishing(config));
+  auto topic = publisher_participant->CreateTopic(TestTopicName(), "test_type");
+  auto bulk_writer = publisher->CreateDataWriter(topic);
+  DataWriterQos control_qos;
+  control_qos.transport_priority.value = 5;
+  auto control_writer = publisher->CreateDataWriter(topic, control_qos);
+
+  for (int32_t i = 0; i < 5; ++i) {
+    ASSERT_TRUE(bulk_writer->Write(&i, sizeof(i)));
+  }
+  const int32_t control = 100;
+  ASSERT_TRUE(control_writer->Write(&control, sizeof(control)));
+  publisher->Flush();
+
+  // The control sample overtakes the bulk samples still waiting for their batch
+  const std::vector<int32_t> values = TakeValues(reader);
+  ASSERT_EQ(values.size(), 6);
+  const auto control_position = std::find(values.begin(), values.end(), control);
+  EXPECT_LE(control_position - values.begin(), 1);
+
+  std::vector<int32_t> bulk = values;
+  bulk.erase(std::remove(bulk.begin(), bulk.end(), control), bulk.end());
+  EXPECT_EQ(bulk, (std::vector<int32_t>{0, 1, 2, 3, 4}));
+}
+
+TEST(PublishQueueTest, LatencyBudgetBoundsTheWaitBehindHigherPriorities) {
+  auto subscriber_participant = DomainParticipant::Create(131, "publish_queue_budget_sub");
+  auto publisher_participant = DomainParticipant::Create(131, "publish_queue_budget_pub");
+  auto reader = subscriber_participant->CreateSubscriber()->CreateDataReader(
+      subscriber_participant->CreateTopic(TestTopicName(), "test_type"));
+
+  auto publisher = publisher_participant->CreatePublisher();
+  AsyncPublishConfig config;
+  config.max_batch_size = 1;
+  config.batch_interval = std::chrono::milliseconds(10);
+  ASSERT_TRUE(publisher->EnableAsynchronousPublishing(config));
+  auto topic = publisher_participant->CreateTopic(TestTopicName(), "test_type");
+  DataWriterQos high_qos;
+  high_qos.transport_priority.value = 1;
+  auto high_writer = publisher->CreateDataWriter(topic, high_qos);
+  DataWriterQos low_qos;
+  low_qos.latency_budget.duration = std::chrono::milliseconds(1);
+  auto low_writer = publisher->CreateDataWriter(topic, low_qos);
+
+  for (int32_t i = 0; i < 10; ++i) {
+    ASSERT_TRUE(high_writer->Write(&i, sizeof(i)));
+  }
+  const int32_t low = 100;
+  ASSERT_TRUE(low_writer->Write(&low, sizeof(low)));
+  publisher->Flush();
+
+  // Without its budget, the low-priority sample would wait for all ten others
+  const std::vector<int32_t> values = TakeValues(reader);
+  ASSERT_EQ(values.size(), 11);
+  EXPECT_LE(std::find(values.begin(), values.end(), low) - values.begin(), 2);
+}
+
+TEST(PublishQueueTest, LocalOnlyIsNotSupported) {
+  auto participant = DomainParticipant::Create(131, "publish_queue_local");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  EXPECT_FALSE(participant->CreatePublisher()->EnableAsynchronousPublishing(AsyncPublishConfig{}));
+}
+
+}  // namespace
+}  // namespace tiny_dds
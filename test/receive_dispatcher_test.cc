@@ -0,0 +1,236 @@
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "gtest/gtest.h"
+#include "include/tiny_dds/data_reader.h"
+#include "include/tiny_dds/data_writer.h"
+#include "include/tiny_dds/domain_participant.h"
+#include "include/tiny_dds/publisher.h"
+#include "include/tiny_dds/subscriber.h"
+#include "include/tiny_dds/topic.h"
+#include "include/tiny_dds/transport_types.h"
+#include "include/tiny_dds/types.h"
+#include "test/test_util.h"
+
+namespace tiny_dds {
+namespace {
+
+constexpr int kSampleCount = 20;
+
+class ReceiveDispatcherTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    publisher_participant_ = DomainParticipant::Create(91, "dispatcher_publisher");
+    subscriber_participant_ = DomainParticipant::Create(91, "dispatcher_subscriber");
+    ASSERT_NE(publisher_participant_, nullptr);
+    ASSERT_NE(subscriber_participant_, nullptr);
+
+    topic_name_ = TestTopicName();
+  }
+
+  // Creates the reader first so that the writer's samples find its socket bound
+  void CreateEntities() {
+    reader_ = subscriber_participant_->CreateSubscriber()->CreateDataReader(
+        subscriber_participant_->CreateTopic(topic_name_, "test_type"));
+    writer_ = publisher_participant_->CreatePublisher()->CreateDataWriter(
+        publisher_participant_->CreateTopic(topic_name_, "test_type"));
+    ASSERT_NE(reader_, nullptr);
+    ASSERT_NE(writer_, nullptr);
+  }
+
+  // Writes samples 0..kSampleCount-1, each carrying its index
+  void WriteSamples() {
+    for (int i = 0; i < kSampleCount; ++i) {
+      ASSERT_TRUE(writer_->Write(&i, sizeof(i)));
+    }
+  }
+
+  // Waits until the callbacks have seen every sample
+  bool WaitForSamples() {
+    absl::MutexLock lock(&mutex_);
+    auto all_received = [this]() {
+      return received_.size() >= kSampleCount && topics_.size() >= expected_topics_;
+    };
+    return mutex_.AwaitWithTimeout(absl::Condition(&all_received), absl::Seconds(2));
+  }
+
+  void Record(const void* data, size_t size) {
+    int value = -1;
+    if (size == sizeof(value)) {
+      std::memcpy(&value, data, sizeof(value));
+    }
+    absl::MutexLock lock(&mutex_);
+    received_.push_back(value);
+    threads_.push_back(std::this_thread::get_id());
+  }
+
+  void RecordTopic(DomainId domain_id, const std::string& topic_name) {
+    absl::MutexLock lock(&mutex_);
+    domains_.push_back(domain_id);
+    topics_.push_back(topic_name);
+  }
+
+  std::vector<int> Expected() const {
+    std::vector<int> expected;
+    for (int i = 0; i < kSampleCount; ++i) {
+      expected.push_back(i);
+    }
+    return expected;
+  }
+
+  std::shared_ptr<DomainParticipant> publisher_participant_;
+  std::shared_ptr<DomainParticipant> subscriber_participant_;
+  std::string topic_name_;
+  std::shared_ptr<DataReader> reader_;
+  std::shared_ptr<DataWriter> writer_;
+
+  absl::Mutex mutex_;
+  std::vector<int> received_;
+  std::vector<std::thread::id> threads_;
+  std::vector<DomainId> domains_;
+  std::vector<std::string> topics_;
+  size_t expected_topics_ = 0;
+};
+
+TEST_F(ReceiveDispatcherTest, InvokesCallbacksOnReceiveThread) {
+  CreateEntities();
+
+  reader_->SetDataReceivedCallback(
+      [this](const void* data, size_t size, const SampleInfo& info) {
+        EXPECT_TRUE(info.valid_data);
+        Record(data, size);
+      });
+  reader_->SetDataCallback([this](DomainId domain_id, const std::string& topic_name,
+                                  const void* /*data*/, size_t /*size*/) {
+    RecordTopic(domain_id, topic_name);
+  });
+  expected_topics_ = kSampleCount;
+
+  WriteSamples();
+  ASSERT_TRUE(WaitForSamples());
+
+  absl::MutexLock lock(&mutex_);
+  EXPECT_EQ(received_, Expected());
+  EXPECT_EQ(domains_, std::vector<DomainId>(kSampleCount, 91));
+  EXPECT_EQ(topics_, std::vector<std::string>(kSampleCount, topic_name_));
+  for (const auto& thread : threads_) {
+    EXPECT_NE(thread, std::this_thread::get_id());
+    EXPECT_EQ(thread, threads_.front());
+  }
+}
+
+TEST_F(ReceiveDispatcherTest, RunsCallbacksOnApplicationExecutor) {
+  std::atomic<int> tasks{0};
+  subscriber_participant_->SetCallbackThreading(CallbackThreading::EXECUTOR,
+                                                [&tasks](std::function<void()> task) {
+                                                  ++tasks;
+                                                  task();
+                                                });
+  CreateEntities();
+
+  reader_->SetDataReceivedCallback(
+      [this](const void* data, size_t size, const SampleInfo& /*info*/) { Record(data, size); });
+
+  WriteSamples();
+  ASSERT_TRUE(WaitForSamples());
+
+  absl::MutexLock lock(&mutex_);
+  EXPECT_EQ(received_, Expected());
+  EXPECT_EQ(tasks.load(), kSampleCount);
+}
+
+TEST_F(ReceiveDispatcherTest, RunsCallbacksInOrderOnCallbackThread) {
+  subscriber_participant_->SetCallbackThreading(CallbackThreading::EXECUTOR);
+  CreateEntities();
+
+  // A slow callback must not stop the receive thread from draining the socket
+  reader_->SetDataReceivedCallback(
+      [this](const void* data, size_t size, const SampleInfo& /*info*/) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        Record(data, size);
+      });
+
+  WriteSamples();
+  ASSERT_TRUE(WaitForSamples());
+
+  absl::MutexLock lock(&mutex_);
+  EXPECT_EQ(received_, Expected());
+}
+
+TEST_F(ReceiveDispatcherTest, QueuesSamplesForReadersWithoutCallbacks) {
+  CreateEntities();
+  WriteSamples();
+
+  // Let the receive thread move the samples off the socket
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  std::vector<int> taken;
+  SampleInfo info;
+  int value = -1;
+  while (reader_->Take(&value, sizeof(value), info) == sizeof(value)) {
+    taken.push_back(value);
+  }
+  EXPECT_EQ(taken, Expected());
+}
+
+TEST_F(ReceiveDispatcherTest, DeliversEverySampleToEveryReaderOfTheTopic) {
+  auto other_participant = DomainParticipant::Create(91, "dispatcher_other_subscriber");
+  ASSERT_NE(other_participant, nullptr);
+  auto other_reader = other_participant->CreateSubscriber()->CreateDataReader(
+      other_participant->CreateTopic(topic_name_, "test_type"));
+  ASSERT_NE(other_reader, nullptr);
+  CreateEntities();
+  WriteSamples();
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  // Readers of one topic share the samples rather than take turns at the socket
+  for (const auto& reader : {reader_, other_reader}) {
+    std::vector<int> taken;
+    SampleInfo info;
+    int value = -1;
+    while (reader->Take(&value, sizeof(value), info) == sizeof(value)) {
+      taken.push_back(value);
+    }
+    EXPECT_EQ(taken, Expected());
+  }
+}
+
+TEST_F(ReceiveDispatcherTest, SharesOneBufferAmongReadersOfTheTopic) {
+  auto other_participant = DomainParticipant::Create(91, "dispatcher_other_subscriber");
+  ASSERT_NE(other_participant, nullptr);
+  auto other_reader = other_participant->CreateSubscriber()->CreateDataReader(
+      other_participant->CreateTopic(topic_name_, "test_type"));
+  ASSERT_NE(other_reader, nullptr);
+  CreateEntities();
+
+  std::vector<const void*> buffers[2];
+  auto record_buffer = [this](std::vector<const void*>* buffers) {
+    return [this, buffers](const void* data, size_t /*size*/, const SampleInfo& info) {
+      absl::MutexLock lock(&mutex_);
+      buffers->push_back(data);
+      received_.push_back(static_cast<int>(info.sequence_number));
+    };
+  };
+  reader_->SetDataReceivedCallback(record_buffer(&buffers[0]));
+  other_reader->SetDataReceivedCallback(record_buffer(&buffers[1]));
+  WriteSamples();
+
+  absl::MutexLock lock(&mutex_);
+  auto all_received = [this]() { return received_.size() >= 2 * kSampleCount; };
+  ASSERT_TRUE(mutex_.AwaitWithTimeout(absl::Condition(&all_received), absl::Seconds(2)));
+
+  // Both readers are handed the same copy of every sample
+  EXPECT_EQ(buffers[0].size(), kSampleCount);
+  EXPECT_EQ(buffers[0], buffers[1]);
+}
+
+}  // namespace
+}  // namespace tiny_dds
@@ -0,0 +1,205 @@
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "google/protobuf/wrappers.pb.h"
+#include "gtest/gtest.h"
+#include "include/tiny_dds/types.h"
+#include "src/core/buffer_pool.h"
+#include "src/core/intra_process_bus.h"
+#include "src/core/sample_history.h"
+
+namespace tiny_dds {
+namespace core {
+namespace {
+
+HistoryQos KeepLast(int32_t depth, size_t slot_size = 64) {
+  HistoryQos qos;
+  qos.kind = HistoryKind::KEEP_LAST;
+  qos.depth = depth;
+  qos.slot_size = slot_size;
+  return qos;
+}
+
+int32_t TakeInt(SampleHistory& history) {
+  int32_t value = -1;
+  EXPECT_EQ(history.TakeInto(&value, sizeof(value)), sizeof(value));
+  return value;
+}
+
+TEST(SampleHistoryTest, KeepLastReplacesOldest) {
+  SampleHistory history(KeepLast(3));
+  EXPECT_EQ(history.Capacity(), 3);
+
+  for (int32_t i = 0; i < 5; ++i) {
+    EXPECT_TRUE(history.PushCopy(&i, sizeof(i)));
+  }
+
+  EXPECT_EQ(history.Size(), 3);
+  EXPECT_EQ(history.GetDroppedCount(), 2);
+  EXPECT_EQ(TakeInt(history), 2);
+  EXPECT_EQ(TakeInt(history), 3);
+  EXPECT_EQ(TakeInt(history), 4);
+  EXPECT_TRUE(history.Empty());
+
+  char buffer[8];
+  EXPECT_EQ(history.TakeInto(buffer, sizeof(buffer)), -1);
+}
+
+TEST(SampleHistoryTest, KeepAllRejectsWhenFull) {
+  HistoryQos qos;
+  qos.kind = HistoryKind::KEEP_ALL;
+  qos.max_samples = 2;
+  SampleHistory history(qos);
+
+  for (int32_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(history.PushCopy(&i, sizeof(i)), i < 2);
+  }
+
+  EXPECT_EQ(history.GetDroppedCount(), 1);
+  EXPECT_EQ(TakeInt(history), 0);
+  EXPECT_EQ(TakeInt(history), 1);
+}
+
+TEST(SampleHistoryTest, SpillsLargeSamplesToPool) {
+  SampleHistory history(KeepLast(4, 16));
+
+  std::vector<uint8_t> large(1000, 0xAB);
+  const char small[] = "small";
+  ASSERT_TRUE(history.PushCopy(large.data(), large.size()));
+  ASSERT_TRUE(history.PushCopy(small, sizeof(small)));
+
+  // A buffer too small for the sample leaves it in place
+  std::vector<uint8_t> buffer(large.size());
+  EXPECT_EQ(history.TakeInto(buffer.data(), 10), -1);
+  ASSERT_EQ(history.TakeInto(buffer.data(), buffer.size()), large.size());
+  EXPECT_EQ(buffer, large);
+
+  ASSERT_EQ(history.TakeInto(buffer.data(), buffer.size()), sizeof(small));
+  EXPECT_STREQ(reinterpret_cast<const char*>(buffer.data()), small);
+}
+
+TEST(SampleHistoryTest, ReusesPooledBuffers) {
+  SampleHistory history(KeepLast(1, 0));
+  std::vector<uint8_t> sample(3000, 0x11);
+
+  ASSERT_TRUE(history.PushCopy(sample.data(), sample.size()));
+  const void* first = history.Front().data;
+  history.Pop();
+
+  // The buffer released by the first sample is handed out for the next one
+  ASSERT_TRUE(history.PushCopy(sample.data(), sample.size()));
+  EXPECT_EQ(history.Front().data, first);
+  EXPECT_EQ(BufferPool::Capacity(sample.size()), 4096);
+}
+
+TEST(SampleHistoryTest, ReferencesSharedSamples) {
+  SampleHistory history(KeepLast(2));
+
+  auto payload = std::make_shared<const std::vector<uint8_t>>(512, 0x5A);
+  LocalSample shared;
+  shared.data = std::shared_ptr<const void>(payload, payload->data());
+  shared.size = payload->size();
+  ASSERT_TRUE(history.PushShared(shared));
+
+  auto message = std::make_shared<google::protobuf::StringValue>();
+  message->set_value("typed");
+  LocalSample typed;
+  typed.message = message;
+  ASSERT_TRUE(history.PushShared(typed));
+
+  EXPECT_EQ(history.Front().data, payload->data());
+  history.Pop();
+
+  // Message samples are serialized when taken as bytes
+  EXPECT_EQ(history.Front().message, message.get());
+  char buffer[64];
+  int32_t size = history.TakeInto(buffer, sizeof(buffer));
+  ASSERT_GT(size, 0);
+  google::protobuf::StringValue parsed;
+  ASSERT_TRUE(parsed.ParseFromArray(buffer, size));
+  EXPECT_EQ(parsed.value(), "typed");
+}
+
+TEST(SampleHistoryTest, ReturnsSharedBuffersToPoolAfterLastReader) {
+  SampleHistory first(KeepLast(2));
+  SampleHistory second(KeepLast(2));
+
+  std::vector<uint8_t> bytes(2000, 0x3C);
+  LocalSample shared = CopyToLocalSample(bytes.data(), bytes.size());
+  const void* buffer = shared.data.get();
+  ASSERT_TRUE(first.PushShared(shared));
+  ASSERT_TRUE(second.PushShared(shared));
+  shared = LocalSample();
+
+  // Each history holds a handle to the one copy
+  EXPECT_EQ(first.Front().data, buffer);
+  EXPECT_EQ(second.Front().data, buffer);
+
+  // The buffer is handed out again only once both histories dropped it
+  std::vector<uint8_t> taken(bytes.size());
+  ASSERT_EQ(first.TakeInto(taken.data(), taken.size()), bytes.size());
+  EXPECT_EQ(taken, bytes);
+  EXPECT_NE(BufferPool::Instance().AllocateShared(bytes.size()).get(), buffer);
+  second.Pop();
+  EXPECT_EQ(BufferPool::Instance().AllocateShared(bytes.size()).get(), buffer);
+}
+
+TEST(SampleHistoryTest, TracksReadSamplesAsPrefix) {
+  SampleHistory history(KeepLast(4));
+  for (int32_t i = 0; i < 4; ++i) {
+    ASSERT_TRUE(history.PushCopy(&i, sizeof(i)));
+  }
+
+  size_t begin = 0;
+  size_t end = 0;
+  history.MarkRead(2);
+  history.Select(NOT_READ_SAMPLE_STATE, &begin, &end);
+  EXPECT_EQ(begin, 2);
+  EXPECT_EQ(end, 4);
+  history.Select(READ_SAMPLE_STATE, &begin, &end);
+  EXPECT_EQ(begin, 0);
+  EXPECT_EQ(end, 2);
+
+  // Removing unread samples closes the gap behind the read ones, which wrap around the ring
+  history.Remove(2, 1);
+  EXPECT_EQ(history.ReadCount(), 2);
+  int32_t value = 4;
+  ASSERT_TRUE(history.PushCopy(&value, sizeof(value)));
+  value = 5;
+  ASSERT_TRUE(history.PushCopy(&value, sizeof(value)));
+
+  // The history was full, so the oldest sample, which was read, was replaced
+  EXPECT_EQ(history.ReadCount(), 1);
+  std::vector<int32_t> values;
+  for (size_t i = 0; i < history.Size(); ++i) {
+    ASSERT_EQ(history.CopyTo(i, &value, sizeof(value)), sizeof(value));
+    values.push_back(value);
+  }
+  EXPECT_EQ(values, (std::vector<int32_t>{1, 3, 4, 5}));
+}
+
+TEST(SampleHistoryTest, FindsSamplesBySerialAfterRemovals) {
+  SampleHistory history(KeepLast(4));
+  for (int32_t i = 0; i < 6; ++i) {
+    ASSERT_TRUE(history.PushCopy(&i, sizeof(i)));
+  }
+
+  // Samples 0 and 1 were replaced; serials start at 1
+  EXPECT_EQ(history.Serial(0), 3);
+  const uint64_t serial_of_4 = history.Serial(2);
+  history.Remove(1, 1);
+  ASSERT_EQ(history.Find(serial_of_4), 1);
+  int32_t value = -1;
+  ASSERT_EQ(history.CopyTo(history.Find(serial_of_4), &value, sizeof(value)), sizeof(value));
+  EXPECT_EQ(value, 4);
+  EXPECT_EQ(history.Find(1), history.Size());
+  EXPECT_EQ(history.Find(4), history.Size());
+  EXPECT_EQ(history.Find(100), history.Size());
+}
+
+}  // namespace
+}  // namespace core
+}  // namespace tiny_dds
@@ -0,0 +1,147 @@
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/tiny_dds/data_reader.h"
+#include "include/tiny_dds/data_writer.h"
+#include "include/tiny_dds/domain_participant.h"
+#include "include/tiny_dds/publisher.h"
+#include "include/tiny_dds/subscriber.h"
+#include "include/tiny_dds/topic.h"
+#include "include/tiny_dds/transport_types.h"
+#include "include/tiny_dds/types.h"
+#include "src/core/data_reader_impl.h"
+#include "src/core/sample_header.h"
+#include "test/test_util.h"
+
+namespace tiny_dds {
+namespace {
+
+TEST(SampleInfoTest, HeaderRoundTrip) {
+  core::SampleMetadata metadata;
+  metadata.writer_guid.value[0] = 0x42;
+  metadata.sequence_number = 7;
+  metadata.source_timestamp = core::NowNanoseconds();
+
+  std::vector<uint8_t> packet(sizeof(core::SampleHeader) + 4);
+  core::EncodeSampleHeader(metadata, packet.data());
+
+  core::SampleMetadata decoded;
+  ASSERT_TRUE(core::DecodeSampleHeader(packet.data(), packet.size(), &decoded));
+  EXPECT_EQ(decoded.writer_guid, metadata.writer_guid);
+  EXPECT_EQ(decoded.sequence_number, 7);
+  EXPECT_EQ(decoded.source_timestamp, metadata.source_timestamp);
+
+  // Data without a header, or too short for one, is left alone
+  EXPECT_FALSE(core::DecodeSampleHeader(packet.data(), sizeof(core::SampleHeader) - 1, &decoded));
+  const char raw[64] = "raw payload";
+  EXPECT_FALSE(core::DecodeSampleHeader(raw, sizeof(raw), &decoded));
+}
+
+TEST(SampleInfoTest, LocalSamplesCarryWriterMetadata) {
+  auto participant = DomainParticipant::Create(121, "sample_info_local");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  auto topic = participant->CreateTopic(TestTopicName(), "test_type");
+  auto reader = participant->CreateSubscriber()->CreateDataReader(topic);
+  auto publisher = participant->CreatePublisher();
+  auto first_writer = publisher->CreateDataWriter(topic);
+  auto second_writer = publisher->CreateDataWriter(topic);
+
+  const int64_t before = core::NowNanoseconds();
+  for (int32_t i = 0; i < 3; ++i) {
+    ASSERT_TRUE(first_writer->Write(&i, sizeof(i)));
+  }
+  ASSERT_TRUE(second_writer->Write("x", 1));
+
+  SampleInfo infos[4];
+  for (uint64_t i = 0; i < 3; ++i) {
+    int32_t value = -1;
+    ASSERT_EQ(reader->Take(&value, sizeof(value), infos[i]), sizeof(value));
+    EXPECT_EQ(infos[i].sequence_number, i + 1);
+    EXPECT_GE(infos[i].source_timestamp, before);
+    EXPECT_GE(infos[i].reception_timestamp, infos[i].source_timestamp);
+    EXPECT_EQ(infos[i].lost_sample_count, 0);
+  }
+  char byte = 0;
+  ASSERT_EQ(reader->Take(&byte, sizeof(byte), infos[3]), 1);
+
+  EXPECT_EQ(infos[0].publication_handle, infos[2].publication_handle);
+  EXPECT_NE(infos[0].publication_handle, Guid{});
+  EXPECT_NE(infos[0].publication_handle, infos[3].publication_handle);
+  EXPECT_EQ(infos[3].sequence_number, 1);
+}
+
+TEST(SampleInfoTest, CountsGapsInSequenceNumbersAsLost) {
+  auto participant = DomainParticipant::Create(121, "sample_info_lost");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  auto reader = std::static_pointer_cast<core::DataReaderImpl>(
+      participant->CreateSubscriber()->CreateDataReader(
+          participant->CreateTopic(TestTopicName(), "test_type")));
+
+  // Sequence numbers 3 and 4 never arrive; 2 arrives late and is no longer counted
+  core::SampleMetadata metadata;
+  metadata.writer_guid.value[0] = 1;
+  for (uint64_t sequence_number : {1, 5, 2, 6}) {
+    metadata.sequence_number = sequence_number;
+    std::vector<uint8_t> packet(sizeof(core::SampleHeader) + sizeof(sequence_number));
+    core::EncodeSampleHeader(metadata, packet.data());
+    std::memcpy(packet.data() + sizeof(core::SampleHeader), &sequence_number,
+                sizeof(sequence_number));
+    reader->OnDataReceived(packet.data(), packet.size());
+  }
+
+  // Data sent without a header is delivered as a whole, without writer metadata
+  const char raw[] = "raw";
+  reader->OnDataReceived(raw, sizeof(raw));
+
+  std::vector<uint64_t> lost;
+  for (int i = 0; i < 4; ++i) {
+    uint64_t value = 0;
+    SampleInfo info;
+    ASSERT_EQ(reader->Take(&value, sizeof(value), info), sizeof(value));
+    EXPECT_EQ(value, info.sequence_number);
+    lost.push_back(info.lost_sample_count);
+  }
+  EXPECT_EQ(lost, (std::vector<uint64_t>{0, 3, 2, 2}));
+
+  char buffer[16];
+  SampleInfo info;
+  ASSERT_EQ(reader->Take(buffer, sizeof(buffer), info), sizeof(raw));
+  EXPECT_STREQ(buffer, raw);
+  EXPECT_EQ(info.sequence_number, 0);
+  EXPECT_GT(info.reception_timestamp, 0);
+}
+
+TEST(SampleInfoTest, NetworkSamplesCarryWriterMetadata) {
+  auto subscriber_participant = DomainParticipant::Create(121, "sample_info_subscriber");
+  auto publisher_participant = DomainParticipant::Create(121, "sample_info_publisher");
+
+  // The reader binds first so that the writer's samples find it
+  auto reader = subscriber_participant->CreateSubscriber()->CreateDataReader(
+      subscriber_participant->CreateTopic(TestTopicName(), "test_type"));
+  auto writer = publisher_participant->CreatePublisher()->CreateDataWriter(
+      publisher_participant->CreateTopic(TestTopicName(), "test_type"));
+
+  const int64_t before = core::NowNanoseconds();
+  for (int32_t i = 0; i < 3; ++i) {
+    ASSERT_TRUE(writer->Write(&i, sizeof(i)));
+  }
+
+  for (int32_t i = 0; i < 3; ++i) {
+    int32_t value = -1;
+    SampleInfo info;
+    ASSERT_EQ(reader->Take(&value, sizeof(value), info, std::chrono::seconds(2)), sizeof(value));
+    EXPECT_EQ(value, i);
+    EXPECT_EQ(info.sequence_number, static_cast<uint64_t>(i + 1));
+    EXPECT_GE(info.source_timestamp, before);
+    EXPECT_GE(info.reception_timestamp, info.source_timestamp);
+    EXPECT_NE(info.publication_handle, Guid{});
+  }
+}
+
+}  // namespace
+}  // namespace tiny_dds
@@ -0,0 +1,163 @@
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/tiny_dds/data_reader.h"
+#include "include/tiny_dds/data_writer.h"
+#include "include/tiny_dds/domain_participant.h"
+#include "include/tiny_dds/publisher.h"
+#include "include/tiny_dds/subscriber.h"
+#include "include/tiny_dds/topic.h"
+#include "include/tiny_dds/transport_types.h"
+#include "include/tiny_dds/types.h"
+#include "include/tiny_dds/wait_set.h"
+#include "test/test_util.h"
+
+namespace tiny_dds {
+namespace {
+
+class SampleStateTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    participant_ = DomainParticipant::Create(111, "sample_state_participant");
+    ASSERT_NE(participant_, nullptr);
+    ASSERT_TRUE(participant_->SetTransportType(TransportType::LOCAL_ONLY));
+
+    publisher_ = participant_->CreatePublisher();
+    subscriber_ = participant_->CreateSubscriber();
+
+    auto topic = participant_->CreateTopic(TestTopicName(), "test_type");
+    reader_ = subscriber_->CreateDataReader(topic);
+    writer_ = publisher_->CreateDataWriter(topic);
+  }
+
+  void WriteValues(int32_t first, int32_t count) {
+    for (int32_t i = first; i < first + count; ++i) {
+      ASSERT_TRUE(writer_->Write(&i, sizeof(i)));
+    }
+  }
+
+  // Reads or takes up to max_samples int32_t samples in the given states
+  std::vector<int32_t> Bulk(bool take, size_t max_samples, SampleStateMask sample_states,
+                            std::vector<SampleInfo>* infos = nullptr) {
+    std::vector<int32_t> values(max_samples, -1);
+    std::vector<SampleBuffer> buffers(max_samples);
+    for (size_t i = 0; i < max_samples; ++i) {
+      buffers[i].data = &values[i];
+      buffers[i].capacity = sizeof(int32_t);
+    }
+
+    std::vector<SampleInfo> local_infos(max_samples);
+    int32_t count =
+        take ? reader_->TakeN(buffers.data(), local_infos.data(), max_samples, sample_states)
+             : reader_->ReadN(buffers.data(), local_infos.data(), max_samples, sample_states);
+    values.resize(count);
+    local_infos.resize(count);
+    if (infos != nullptr) {
+      *infos = local_infos;
+    }
+    return values;
+  }
+
+  std::shared_ptr<DomainParticipant> participant_;
+  std::shared_ptr<Publisher> publisher_;
+  std::shared_ptr<Subscriber> subscriber_;
+  std::shared_ptr<DataReader> reader_;
+  std::shared_ptr<DataWriter> writer_;
+};
+
+TEST_F(SampleStateTest, ReadLeavesSamplesAndTakeRemovesThem) {
+  WriteValues(0, 2);
+
+  int32_t value = -1;
+  SampleInfo info;
+  ASSERT_EQ(reader_->Read(&value, sizeof(value), info), sizeof(value));
+  EXPECT_EQ(value, 0);
+  EXPECT_EQ(info.sample_state, SampleStateKind::NOT_READ);
+  ASSERT_EQ(reader_->Read(&value, sizeof(value), info), sizeof(value));
+  EXPECT_EQ(value, 1);
+
+  // Every sample has been read once
+  EXPECT_EQ(reader_->Read(&value, sizeof(value), info), -1);
+
+  // Read samples are still there to take
+  ASSERT_EQ(reader_->Take(&value, sizeof(value), info), sizeof(value));
+  EXPECT_EQ(value, 0);
+  EXPECT_EQ(info.sample_state, SampleStateKind::READ);
+  ASSERT_EQ(reader_->Take(&value, sizeof(value), info), sizeof(value));
+  EXPECT_EQ(value, 1);
+  EXPECT_EQ(reader_->Take(&value, sizeof(value), info), -1);
+}
+
+TEST_F(SampleStateTest, BulkReadFiltersByState) {
+  WriteValues(0, 5);
+
+  std::vector<SampleInfo> infos;
+  EXPECT_EQ(Bulk(false, 3, NOT_READ_SAMPLE_STATE, &infos), (std::vector<int32_t>{0, 1, 2}));
+  ASSERT_EQ(infos.size(), 3);
+  EXPECT_TRUE(infos[0].valid_data);
+  EXPECT_EQ(infos[0].sample_state, SampleStateKind::NOT_READ);
+
+  WriteValues(5, 1);
+  EXPECT_EQ(Bulk(false, 10, NOT_READ_SAMPLE_STATE), (std::vector<int32_t>{3, 4, 5}));
+  EXPECT_EQ(Bulk(false, 10, NOT_READ_SAMPLE_STATE), std::vector<int32_t>{});
+
+  EXPECT_EQ(Bulk(false, 10, ANY_SAMPLE_STATE, &infos),
+            (std::vector<int32_t>{0, 1, 2, 3, 4, 5}));
+  EXPECT_EQ(infos[5].sample_state, SampleStateKind::READ);
+}
+
+TEST_F(SampleStateTest, BulkTakeRemovesOnlySelectedStates) {
+  WriteValues(0, 4);
+  EXPECT_EQ(Bulk(false, 2, ANY_SAMPLE_STATE), (std::vector<int32_t>{0, 1}));
+
+  // Taking the unread samples keeps the read ones in order
+  EXPECT_EQ(Bulk(true, 10, NOT_READ_SAMPLE_STATE), (std::vector<int32_t>{2, 3}));
+  WriteValues(4, 1);
+
+  std::vector<SampleInfo> infos;
+  EXPECT_EQ(Bulk(true, 10, READ_SAMPLE_STATE, &infos), (std::vector<int32_t>{0, 1}));
+  EXPECT_EQ(infos[1].sample_state, SampleStateKind::READ);
+  EXPECT_EQ(Bulk(true, 10, ANY_SAMPLE_STATE), (std::vector<int32_t>{4}));
+}
+
+TEST_F(SampleStateTest, BulkStopsAtSampleLargerThanBuffer) {
+  WriteValues(0, 1);
+  const char large[] = "larger than an int";
+  ASSERT_TRUE(writer_->Write(large, sizeof(large)));
+
+  EXPECT_EQ(Bulk(true, 4, ANY_SAMPLE_STATE), (std::vector<int32_t>{0}));
+
+  char buffer[64];
+  SampleInfo info;
+  EXPECT_EQ(reader_->Take(buffer, sizeof(buffer), info), sizeof(large));
+}
+
+TEST_F(SampleStateTest, ReadConditionFollowsSampleStates) {
+  auto not_read = reader_->CreateReadCondition(NOT_READ_SAMPLE_STATE);
+  auto any = reader_->CreateReadCondition();
+  EXPECT_EQ(not_read->GetSampleStateMask(), NOT_READ_SAMPLE_STATE);
+  EXPECT_EQ(any->GetSampleStateMask(), ANY_SAMPLE_STATE);
+
+  auto wait_set = WaitSet::Create();
+  ASSERT_TRUE(wait_set->AttachCondition(not_read));
+
+  WriteValues(0, 1);
+  std::vector<std::shared_ptr<Condition>> active;
+  ASSERT_TRUE(wait_set->Wait(active, std::chrono::seconds(1)));
+
+  // Reading clears the NOT_READ condition while the sample stays in the history
+  EXPECT_EQ(Bulk(false, 1, ANY_SAMPLE_STATE), (std::vector<int32_t>{0}));
+  EXPECT_FALSE(not_read->GetTriggerValue());
+  EXPECT_TRUE(any->GetTriggerValue());
+  EXPECT_FALSE(wait_set->Wait(active, std::chrono::milliseconds(1)));
+
+  EXPECT_EQ(Bulk(true, 1, ANY_SAMPLE_STATE), (std::vector<int32_t>{0}));
+  EXPECT_FALSE(any->GetTriggerValue());
+}
+
+}  // namespace
+}  // namespace tiny_dds
@@ -0,0 +1,25 @@
+#ifndef TINY_DDS_TEST_TEST_UTIL_H_
+#define TINY_DDS_TEST_TEST_UTIL_H_
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace tiny_dds {
+
+/**
+ * @brief Gets a topic name of the running test.
+ *
+ * The tests of a binary run in one process and often share a domain, so each
+ * test uses its own topics to keep the samples of other tests out of its readers.
+ *
+ * @param suffix Appended to the name, for tests that use several topics.
+ * @return The name of the running test followed by the suffix.
+ */
+inline auto TestTopicName(const std::string& suffix = "") -> std::string {
+  return ::testing::UnitTest::GetInstance()->current_test_info()->name() + suffix;
+}
+
+}  // namespace tiny_dds
+
+#endif  // TINY_DDS_TEST_TEST_UTIL_H_
@@ -0,0 +1,113 @@
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "google/protobuf/descriptor.pb.h"
+#include "gtest/gtest.h"
+#include "include/tiny_dds/data_reader.h"
+#include "include/tiny_dds/data_writer.h"
+#include "include/tiny_dds/domain_participant.h"
+#include "include/tiny_dds/publisher.h"
+#include "include/tiny_dds/subscriber.h"
+#include "include/tiny_dds/topic.h"
+#include "include/tiny_dds/transport_types.h"
+#include "test/test_util.h"
+
+namespace tiny_dds {
+namespace {
+
+using google::protobuf::FieldDescriptorProto;
+
+constexpr char kTypeName[] = "google.protobuf.FieldDescriptorProto";
+
+// Samples written in a burst are far closer together than this
+constexpr auto kMinimumSeparation = std::chrono::milliseconds(200);
+
+DataReaderQos TimeBasedFilter() {
+  DataReaderQos qos;
+  qos.time_based_filter.minimum_separation = kMinimumSeparation;
+  return qos;
+}
+
+void WriteBurst(DataWriter& writer, const std::string& name, int32_t first, int32_t count) {
+  for (int32_t number = first; number < first + count; ++number) {
+    FieldDescriptorProto sample;
+    sample.set_name(name);
+    sample.set_number(number);
+    const std::string bytes = sample.SerializeAsString();
+    ASSERT_TRUE(writer.Write(bytes.data(), bytes.size()));
+  }
+}
+
+std::vector<int32_t> TakeNumbers(DataReader& reader) {
+  std::vector<int32_t> numbers;
+  FieldDescriptorProto sample;
+  SampleInfo info;
+  while (reader.TakeMessage(&sample, info)) {
+    numbers.push_back(sample.number());
+    EXPECT_EQ(info.lost_sample_count, 0);
+  }
+  return numbers;
+}
+
+TEST(TimeBasedFilterTest, LocalReadersKeepOneSamplePerPeriod) {
+  auto participant = DomainParticipant::Create(171, "time_based_filter_local");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  auto topic = participant->CreateTopic(TestTopicName(), kTypeName);
+  auto subscriber = participant->CreateSubscriber();
+  auto reader = subscriber->CreateDataReader(topic, TimeBasedFilter());
+  auto unfiltered_reader = subscriber->CreateDataReader(topic);
+  auto writer = participant->CreatePublisher()->CreateDataWriter(topic);
+
+  WriteBurst(*writer, "a", 1, 10);
+  std::this_thread::sleep_for(kMinimumSeparation + std::chrono::milliseconds(50));
+  WriteBurst(*writer, "a", 11, 10);
+
+  EXPECT_EQ(TakeNumbers(*reader), (std::vector<int32_t>{1, 11}));
+  EXPECT_EQ(TakeNumbers(*unfiltered_reader).size(), 20);
+}
+
+TEST(TimeBasedFilterTest, KeyedReadersKeepOneSamplePerPeriodOfEachInstance) {
+  auto participant = DomainParticipant::Create(171, "time_based_filter_keyed");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  auto topic = participant->CreateTopic(TestTopicName(), kTypeName,
+                                        {FieldDescriptorProto::kNameFieldNumber});
+  auto reader = participant->CreateSubscriber()->CreateDataReader(topic, TimeBasedFilter());
+  auto writer = participant->CreatePublisher()->CreateDataWriter(topic);
+
+  WriteBurst(*writer, "a", 1, 5);
+  WriteBurst(*writer, "b", 6, 5);
+  WriteBurst(*writer, "a", 11, 5);
+
+  EXPECT_EQ(TakeNumbers(*reader), (std::vector<int32_t>{1, 6}));
+}
+
+TEST(TimeBasedFilterTest, NetworkReadersDropSamplesOnArrival) {
+  auto publisher_participant = DomainParticipant::Create(171, "time_based_filter_publisher");
+  auto subscriber_participant = DomainParticipant::Create(171, "time_based_filter_subscriber");
+
+  auto reader = subscriber_participant->CreateSubscriber()->CreateDataReader(
+      subscriber_participant->CreateTopic(TestTopicName(), kTypeName), TimeBasedFilter());
+  auto writer = publisher_participant->CreatePublisher()->CreateDataWriter(
+      publisher_participant->CreateTopic(TestTopicName(), kTypeName));
+
+  WriteBurst(*writer, "a", 1, 10);
+  std::this_thread::sleep_for(kMinimumSeparation + std::chrono::milliseconds(50));
+  WriteBurst(*writer, "a", 11, 10);
+
+  // Dropped samples count as received, not lost
+  std::vector<uint8_t> buffer(256);
+  SampleInfo info;
+  std::vector<uint64_t> sequence_numbers;
+  while (reader->Take(buffer.data(), buffer.size(), info, std::chrono::milliseconds(200)) > 0) {
+    sequence_numbers.push_back(info.sequence_number);
+    EXPECT_EQ(info.lost_sample_count, 0);
+  }
+  EXPECT_EQ(sequence_numbers, (std::vector<uint64_t>{1, 11}));
+}
+
+}  // namespace
+}  // namespace tiny_dds
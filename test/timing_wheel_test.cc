@@ -0,0 +1,121 @@
+#include "src/core/timing_wheel.h"
+
+#include <chrono>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace tiny_dds {
+namespace {
+
+using core::TimingWheel;
+using std::chrono::milliseconds;
+using std::chrono::steady_clock;
+
+class TimingWheelTest : public ::testing::Test {
+ protected:
+  // The wheel is turned by hand, from a start later than any arming below
+  TimingWheelTest() : start_(steady_clock::now() + milliseconds(10)) {}
+
+  auto At(int64_t ms) const -> steady_clock::time_point { return start_ + milliseconds(ms); }
+
+  // Timers fire with the first tick at or after their due time
+  auto Past(int64_t ms) const -> steady_clock::time_point { return At(ms + 1); }
+
+  // Adds a timer recording its firings in fired_
+  auto AddRecording(int id) -> TimingWheel::TimerId {
+    return wheel_.Add([this, id]() { fired_.push_back(id); });
+  }
+
+  TimingWheel wheel_;
+  const steady_clock::time_point start_;
+  std::vector<int> fired_;
+};
+
+TEST_F(TimingWheelTest, FiresTimersInOrderAndNeverEarly) {
+  const auto first = AddRecording(1);
+  const auto second = AddRecording(2);
+  wheel_.Arm(second, At(30));
+  wheel_.Arm(first, At(20));
+  EXPECT_EQ(wheel_.ArmedCount(), 2);
+
+  wheel_.Advance(At(19));
+  EXPECT_TRUE(fired_.empty());
+  wheel_.Advance(Past(20));
+  EXPECT_EQ(fired_, (std::vector<int>{1}));
+  EXPECT_EQ(wheel_.Advance(Past(20)), 0);
+  wheel_.Advance(Past(30));
+  EXPECT_EQ(fired_, (std::vector<int>{1, 2}));
+  EXPECT_EQ(wheel_.ArmedCount(), 0);
+  EXPECT_FALSE(wheel_.IsDue(At(1000)));
+}
+
+TEST_F(TimingWheelTest, RearmingAndCancellingReplaceTheDueTime) {
+  const auto timer = AddRecording(1);
+  wheel_.Arm(timer, At(20));
+  wheel_.Arm(timer, At(50));
+  EXPECT_EQ(wheel_.ArmedCount(), 1);
+  wheel_.Advance(At(40));
+  EXPECT_TRUE(fired_.empty());
+
+  wheel_.Cancel(timer);
+  wheel_.Advance(At(60));
+  EXPECT_TRUE(fired_.empty());
+
+  // Cancelled timers can be armed again; removed ones cannot
+  wheel_.Arm(timer, At(70));
+  wheel_.Advance(Past(70));
+  EXPECT_EQ(fired_, (std::vector<int>{1}));
+  wheel_.Remove(timer);
+  wheel_.Arm(timer, At(80));
+  EXPECT_EQ(wheel_.ArmedCount(), 0);
+}
+
+TEST_F(TimingWheelTest, CascadesTimersFromHigherLevels) {
+  // Due in the second, third and fourth levels, and beyond the top level's reach
+  const std::vector<int64_t> delays = {100, 5000, 300000, 20000000};
+  for (size_t i = 0; i < delays.size(); ++i) {
+    wheel_.Arm(AddRecording(static_cast<int>(i)), At(delays[i]));
+  }
+
+  std::vector<int> expected;
+  for (size_t i = 0; i < delays.size(); ++i) {
+    wheel_.Advance(At(delays[i] - 1));
+    EXPECT_EQ(fired_, expected) << delays[i];
+    wheel_.Advance(Past(delays[i]));
+    expected.push_back(static_cast<int>(i));
+    EXPECT_EQ(fired_, expected) << delays[i];
+  }
+}
+
+TEST_F(TimingWheelTest, CallbacksMayRearmTheirTimer) {
+  TimingWheel::TimerId timer = TimingWheel::kNoTimer;
+  int64_t due = 10;
+  timer = wheel_.Add([&]() {
+    fired_.push_back(static_cast<int>(due));
+    due += 10;
+    wheel_.Arm(timer, At(due));
+  });
+  wheel_.Arm(timer, At(due));
+
+  for (int64_t ms = 0; ms <= 46; ++ms) {
+    wheel_.Advance(At(ms));
+  }
+  EXPECT_EQ(fired_, (std::vector<int>{10, 20, 30, 40}));
+}
+
+TEST_F(TimingWheelTest, ScheduledTasksRunOnceAndFreeTheirTimer) {
+  wheel_.Schedule(At(5), [this]() { fired_.push_back(5); });
+  wheel_.Schedule(At(5), [this]() { fired_.push_back(6); });
+  EXPECT_EQ(wheel_.Advance(At(4)), 0);
+  EXPECT_EQ(wheel_.Advance(Past(5)), 2);
+  EXPECT_EQ(wheel_.Advance(At(100)), 0);
+  EXPECT_EQ(fired_.size(), 2);
+
+  // Timers already due fire with the next advance
+  wheel_.Schedule(At(0), [this]() { fired_.push_back(7); });
+  EXPECT_EQ(wheel_.Advance(Past(100)), 1);
+}
+
+}  // namespace
+}  // namespace tiny_dds
@@ -0,0 +1,144 @@
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/tiny_dds/types.h"
+#include "src/core/intra_process_bus.h"
+#include "src/core/sample_header.h"
+#include "src/core/topic_log.h"
+
+namespace tiny_dds {
+namespace core {
+namespace {
+
+// Every test logs to its own empty directory
+std::string TestDirectory() {
+  const std::string directory =
+      std::string(::testing::TempDir()) + "/topic_log_test_" + std::to_string(getpid()) + "_" +
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  std::filesystem::remove_all(directory);
+  return directory;
+}
+
+PersistenceQos Persistence(size_t segment_size = 4096, size_t max_segments = 16) {
+  PersistenceQos qos;
+  qos.segment_size = segment_size;
+  qos.max_segments = max_segments;
+  qos.sync_interval = std::chrono::milliseconds(1);
+  return qos;
+}
+
+// Appends samples holding their own sequence number, written one second apart
+void AppendSamples(TopicLog& log, uint64_t first, uint64_t last) {
+  for (uint64_t sequence_number = first; sequence_number <= last; ++sequence_number) {
+    SampleMetadata metadata;
+    metadata.sequence_number = sequence_number;
+    metadata.source_timestamp = static_cast<int64_t>(sequence_number) * 1000000000;
+    ASSERT_TRUE(log.Append(metadata, &sequence_number, sizeof(sequence_number)));
+  }
+}
+
+std::vector<uint64_t> Values(const std::vector<LocalSample>& samples) {
+  std::vector<uint64_t> values;
+  for (const auto& sample : samples) {
+    uint64_t value = 0;
+    EXPECT_EQ(sample.size, sizeof(value));
+    std::memcpy(&value, sample.data.get(), sizeof(value));
+    EXPECT_EQ(value, sample.metadata.sequence_number);
+    values.push_back(value);
+  }
+  return values;
+}
+
+TEST(TopicLogTest, ReadsFromSequenceNumberTimestampOrEnd) {
+  auto log = TopicLog::Open(TestDirectory(), Persistence());
+  ASSERT_NE(log, nullptr);
+  EXPECT_EQ(log->LastSequenceNumber(), 0);
+  EXPECT_TRUE(log->ReadLast(3).empty());
+
+  AppendSamples(*log, 1, 10);
+  EXPECT_EQ(log->Size(), 10);
+  EXPECT_EQ(log->LastSequenceNumber(), 10);
+
+  EXPECT_EQ(Values(log->ReadFromSequenceNumber(7, 100)), (std::vector<uint64_t>{7, 8, 9, 10}));
+  EXPECT_EQ(Values(log->ReadFromSequenceNumber(2, 2)), (std::vector<uint64_t>{2, 3}));
+  EXPECT_EQ(Values(log->ReadFromTimestamp(8500000000, 100)), (std::vector<uint64_t>{9, 10}));
+  EXPECT_EQ(Values(log->ReadLast(3)), (std::vector<uint64_t>{8, 9, 10}));
+  EXPECT_EQ(log->ReadLast(20).size(), 10);
+  EXPECT_TRUE(log->ReadFromSequenceNumber(11, 100).empty());
+}
+
+TEST(TopicLogTest, ReopenedLogRecoversItsRecords) {
+  const std::string directory = TestDirectory();
+  {
+    auto log = TopicLog::Open(directory, Persistence());
+    ASSERT_NE(log, nullptr);
+    AppendSamples(*log, 1, 5);
+    log->Sync();
+  }
+
+  auto log = TopicLog::Open(directory, Persistence());
+  ASSERT_NE(log, nullptr);
+  EXPECT_EQ(log->LastSequenceNumber(), 5);
+  EXPECT_EQ(Values(log->ReadFromSequenceNumber(1, 100)), (std::vector<uint64_t>{1, 2, 3, 4, 5}));
+
+  // Appends continue in the recovered segment
+  AppendSamples(*log, 6, 7);
+  EXPECT_EQ(Values(log->ReadLast(3)), (std::vector<uint64_t>{5, 6, 7}));
+}
+
+TEST(TopicLogTest, RejectsSequenceNumbersAlreadyLogged) {
+  auto log = TopicLog::Open(TestDirectory(), Persistence());
+  ASSERT_NE(log, nullptr);
+  AppendSamples(*log, 1, 3);
+
+  SampleMetadata metadata;
+  for (uint64_t sequence_number : {uint64_t{3}, uint64_t{2}}) {
+    metadata.sequence_number = sequence_number;
+    EXPECT_FALSE(log->Append(metadata, &sequence_number, sizeof(sequence_number)));
+  }
+  EXPECT_EQ(log->Size(), 3);
+  EXPECT_EQ(log->LastSequenceNumber(), 3);
+}
+
+TEST(TopicLogTest, RotatesSegmentsAndDeletesTheOldest) {
+  const std::string directory = TestDirectory();
+
+  // 56-byte records: 8 per segment, the last 3 segments retained
+  auto log = TopicLog::Open(directory, Persistence(448, 3));
+  ASSERT_NE(log, nullptr);
+  AppendSamples(*log, 1, 8);
+  auto first_segment = log->ReadFromSequenceNumber(1, 8);
+
+  AppendSamples(*log, 9, 40);
+  EXPECT_EQ(log->Size(), 24);
+  EXPECT_EQ(Values(log->ReadFromSequenceNumber(1, 100)).front(), 17);
+  EXPECT_EQ(std::distance(std::filesystem::directory_iterator(directory),
+                          std::filesystem::directory_iterator()),
+            3);
+
+  // Samples read before the segment was deleted remain valid
+  EXPECT_EQ(Values(first_segment), (std::vector<uint64_t>{1, 2, 3, 4, 5, 6, 7, 8}));
+
+  // A sample larger than a segment gets one of its own
+  std::vector<uint8_t> large(2048, 7);
+  SampleMetadata metadata;
+  metadata.sequence_number = 41;
+  ASSERT_TRUE(log->Append(metadata, large.data(), large.size()));
+  auto samples = log->ReadLast(1);
+  ASSERT_EQ(samples.size(), 1);
+  EXPECT_EQ(samples[0].size, large.size());
+  EXPECT_EQ(std::memcmp(samples[0].data.get(), large.data(), large.size()), 0);
+}
+
+}  // namespace
+}  // namespace core
+}  // namespace tiny_dds
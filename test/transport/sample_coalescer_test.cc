@@ -0,0 +1,178 @@
+#include "src/transport/sample_coalescer.h"
+
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/tiny_dds/transport_types.h"
+#include "src/transport/udp_transport.h"
+
+namespace tiny_dds {
+namespace transport {
+namespace {
+
+// Records the datagrams produced by a coalescer
+struct DatagramSink {
+  std::mutex mutex;
+  std::vector<std::vector<uint8_t>> datagrams;
+
+  auto Callback() -> SampleCoalescer::FlushCallback {
+    return [this](const void* data, size_t size) {
+      std::lock_guard<std::mutex> lock(mutex);
+      const auto* bytes = static_cast<const uint8_t*>(data);
+      datagrams.emplace_back(bytes, bytes + size);
+      return true;
+    };
+  }
+
+  auto Count() -> size_t {
+    std::lock_guard<std::mutex> lock(mutex);
+    return datagrams.size();
+  }
+};
+
+TEST(SampleCoalescerTest, PacksSamplesFromSeveralTopics) {
+  DatagramSink sink;
+  CoalescingConfig config;
+  config.latency_budget = std::chrono::seconds(10);
+  auto coalescer = SampleCoalescer::Create(config, sink.Callback());
+
+  const char first[] = "telemetry-1";
+  const char second[] = "status-2";
+  EXPECT_TRUE(coalescer->Add("telemetry", first, sizeof(first)));
+  EXPECT_TRUE(coalescer->Add("status", second, sizeof(second)));
+  EXPECT_EQ(sink.Count(), 0);
+
+  EXPECT_TRUE(coalescer->Flush());
+  ASSERT_EQ(sink.Count(), 1);
+
+  std::vector<std::pair<std::string, std::string>> records;
+  const auto& datagram = sink.datagrams.front();
+  ASSERT_TRUE(SampleCoalescer::IsCoalesced(datagram.data(), datagram.size()));
+  EXPECT_TRUE(SampleCoalescer::Unpack(
+      datagram.data(), datagram.size(),
+      [&](const std::string& topic_name, const void* data, size_t size) {
+        records.emplace_back(topic_name, std::string(static_cast<const char*>(data), size));
+      }));
+
+  ASSERT_EQ(records.size(), 2);
+  EXPECT_EQ(records[0].first, "telemetry");
+  EXPECT_STREQ(records[0].second.c_str(), first);
+  EXPECT_EQ(records[1].first, "status");
+  EXPECT_STREQ(records[1].second.c_str(), second);
+}
+
+TEST(SampleCoalescerTest, FlushesWhenDatagramIsFull) {
+  DatagramSink sink;
+  CoalescingConfig config;
+  config.max_datagram_size = 256;
+  config.latency_budget = std::chrono::seconds(10);
+  auto coalescer = SampleCoalescer::Create(config, sink.Callback());
+
+  const std::vector<uint8_t> sample(40, 0xAB);
+  const size_t record_size = SampleCoalescer::EncodedSize("topic", sample.size());
+  const size_t samples_per_datagram = (config.max_datagram_size - 8) / record_size;
+
+  for (size_t i = 0; i < samples_per_datagram * 3; ++i) {
+    EXPECT_TRUE(coalescer->Add("topic", sample.data(), sample.size()));
+  }
+
+  // The last datagram is still open until the next sample or the budget expires
+  EXPECT_EQ(sink.Count(), 2);
+  for (const auto& datagram : sink.datagrams) {
+    EXPECT_LE(datagram.size(), config.max_datagram_size);
+  }
+}
+
+TEST(SampleCoalescerTest, FlushesWhenLatencyBudgetExpires) {
+  DatagramSink sink;
+  CoalescingConfig config;
+  config.latency_budget = std::chrono::milliseconds(5);
+  auto coalescer = SampleCoalescer::Create(config, sink.Callback());
+
+  const char sample[] = "sample";
+  EXPECT_TRUE(coalescer->Add("topic", sample, sizeof(sample)));
+
+  auto start = std::chrono::steady_clock::now();
+  while (sink.Count() == 0 && std::chrono::steady_clock::now() - start < std::chrono::seconds(2)) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  EXPECT_EQ(sink.Count(), 1);
+}
+
+TEST(SampleCoalescerTest, UdpReaderUnpacksCoalescedDatagrams) {
+  auto writer_transport = UdpTransport::Create(91, "coalescing_writer");
+  auto reader_transport = UdpTransport::Create(91, "coalescing_reader");
+  ASSERT_TRUE(writer_transport->Initialize());
+  ASSERT_TRUE(reader_transport->Initialize());
+
+  ASSERT_TRUE(reader_transport->Subscribe("pose"));
+  ASSERT_TRUE(reader_transport->Subscribe("battery"));
+
+  CoalescingConfig config;
+  config.latency_budget = std::chrono::seconds(10);
+  auto coalescer = SampleCoalescer::Create(config, [&](const void* data, size_t size) {
+    return writer_transport->SendCoalesced(data, size);
+  });
+
+  const char pose[] = "pose-sample";
+  const char battery[] = "battery-sample";
+  ASSERT_TRUE(coalescer->Add("pose", pose, sizeof(pose)));
+  ASSERT_TRUE(coalescer->Add("battery", battery, sizeof(battery)));
+  ASSERT_TRUE(coalescer->Add("unsubscribed", pose, sizeof(pose)));
+  ASSERT_TRUE(coalescer->Flush());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  char buffer[256] = {0};
+  size_t bytes_received = 0;
+  ASSERT_TRUE(reader_transport->Receive("battery", buffer, sizeof(buffer), &bytes_received));
+  EXPECT_EQ(bytes_received, sizeof(battery));
+  EXPECT_STREQ(buffer, battery);
+
+  ASSERT_TRUE(reader_transport->Receive("pose", buffer, sizeof(buffer), &bytes_received));
+  EXPECT_EQ(bytes_received, sizeof(pose));
+  EXPECT_STREQ(buffer, pose);
+
+  EXPECT_FALSE(reader_transport->Receive("pose", buffer, sizeof(buffer), &bytes_received));
+}
+
+TEST(SampleCoalescerTest, EveryMulticastSubscriberReceivesCoalescedDatagrams) {
+  auto writer_transport = UdpTransport::Create(92, "coalescing_writer");
+  auto first_reader = UdpTransport::Create(92, "coalescing_reader_1");
+  auto second_reader = UdpTransport::Create(92, "coalescing_reader_2");
+  for (const auto& transport : {writer_transport, first_reader, second_reader}) {
+    transport->EnableMulticast("239.255.0.2", /*loopback=*/true);
+    ASSERT_TRUE(transport->Initialize());
+  }
+
+  ASSERT_TRUE(first_reader->Subscribe("pose"));
+  ASSERT_TRUE(second_reader->Subscribe("pose"));
+
+  const char pose[] = "pose-sample";
+  auto coalescer = SampleCoalescer::Create(CoalescingConfig{}, [&](const void* data, size_t size) {
+    return writer_transport->SendCoalesced(data, size);
+  });
+  ASSERT_TRUE(coalescer->Add("pose", pose, sizeof(pose)));
+  ASSERT_TRUE(coalescer->Flush());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  for (const auto& reader : {first_reader, second_reader}) {
+    char buffer[256] = {0};
+    size_t bytes_received = 0;
+    ASSERT_TRUE(reader->Receive("pose", buffer, sizeof(buffer), &bytes_received));
+    EXPECT_EQ(bytes_received, sizeof(pose));
+    EXPECT_STREQ(buffer, pose);
+  }
+}
+
+}  // namespace
+}  // namespace transport
+}  // namespace tiny_dds
@@ -5,6 +5,7 @@
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "include/tiny_dds/transport.h"
@@ -68,6 +69,28 @@ TEST_F(SharedMemoryTransportTest, BasicFunctionality) {
   EXPECT_STREQ(buffer, test_data);
 }
 
+TEST_F(SharedMemoryTransportTest, WrapsAroundTheRing) {
+  const std::string topic_name = "WrapTopic";
+  ASSERT_TRUE(reader_transport_->Subscribe(topic_name));
+  ASSERT_TRUE(writer_transport_->Advertise(topic_name));
+  EXPECT_TRUE(writer_transport_->HasSubscribers(topic_name));
+
+  // Several laps of the 1MB ring with sizes that do not divide it evenly
+  std::vector<char> sample(40 * 1000);
+  std::vector<char> buffer(sample.size());
+  for (int i = 0; i < 100; ++i) {
+    std::fill(sample.begin(), sample.end(), static_cast<char>(i));
+    ASSERT_TRUE(writer_transport_->Send(topic_name, sample.data(), sample.size())) << i;
+
+    size_t bytes_received = 0;
+    ASSERT_TRUE(
+        reader_transport_->Receive(topic_name, buffer.data(), buffer.size(), &bytes_received))
+        << i;
+    ASSERT_EQ(bytes_received, sample.size());
+    EXPECT_EQ(buffer, sample) << i;
+  }
+}
+
 TEST_F(SharedMemoryTransportTest, TransportTypeCheck) {
   // Verify the transport type is correctly identified
   EXPECT_EQ(writer_transport_->GetType(), TransportType::SHARED_MEMORY);
@@ -0,0 +1,165 @@
+#include "src/transport/tcp_transport.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/tiny_dds/transport.h"
+#include "include/tiny_dds/transport_types.h"
+#include "include/tiny_dds/types.h"
+
+namespace tiny_dds {
+namespace transport {
+namespace {
+
+class TcpTransportTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    writer_transport_ = TcpTransport::Create(17, "writer_participant");
+    reader_transport_ = TcpTransport::Create(17, "reader_participant");
+
+    ASSERT_TRUE(writer_transport_ != nullptr);
+    ASSERT_TRUE(reader_transport_ != nullptr);
+    ASSERT_TRUE(writer_transport_->Initialize());
+    ASSERT_TRUE(reader_transport_->Initialize());
+  }
+
+  void TearDown() override {
+    writer_transport_.reset();
+    reader_transport_.reset();
+  }
+
+  // Polls the reader until a sample arrives or the timeout expires
+  auto ReceiveWithTimeout(const std::string& topic_name, std::vector<uint8_t>& buffer,
+                          size_t* bytes_received) -> bool {
+    auto start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < std::chrono::seconds(5)) {
+      if (reader_transport_->Receive(topic_name, buffer.data(), buffer.size(), bytes_received)) {
+        return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+  }
+
+  std::shared_ptr<TcpTransport> writer_transport_;
+  std::shared_ptr<TcpTransport> reader_transport_;
+};
+
+TEST_F(TcpTransportTest, TopicsShareOneConnection) {
+  ASSERT_TRUE(reader_transport_->Subscribe("map"));
+  ASSERT_TRUE(reader_transport_->Subscribe("model"));
+  ASSERT_TRUE(writer_transport_->Advertise("map"));
+  ASSERT_TRUE(writer_transport_->Advertise("model"));
+
+  const char map_data[] = "map-tile";
+  const char model_data[] = "model-weights";
+  EXPECT_TRUE(writer_transport_->Send("map", map_data, sizeof(map_data)));
+  EXPECT_TRUE(writer_transport_->Send("model", model_data, sizeof(model_data)));
+
+  std::vector<uint8_t> buffer(1024);
+  size_t bytes_received = 0;
+  ASSERT_TRUE(ReceiveWithTimeout("model", buffer, &bytes_received));
+  EXPECT_EQ(bytes_received, sizeof(model_data));
+  EXPECT_STREQ(reinterpret_cast<const char*>(buffer.data()), model_data);
+
+  ASSERT_TRUE(ReceiveWithTimeout("map", buffer, &bytes_received));
+  EXPECT_EQ(bytes_received, sizeof(map_data));
+  EXPECT_STREQ(reinterpret_cast<const char*>(buffer.data()), map_data);
+}
+
+TEST_F(TcpTransportTest, CarriesSamplesLargerThanADatagram) {
+  ASSERT_TRUE(reader_transport_->Subscribe("bulk"));
+  ASSERT_TRUE(writer_transport_->Advertise("bulk"));
+
+  std::vector<uint8_t> sample(4 * 1024 * 1024);
+  for (size_t i = 0; i < sample.size(); ++i) {
+    sample[i] = static_cast<uint8_t>(i * 31);
+  }
+
+  // The reader drains concurrently so the writer never blocks on a full socket
+  bool sent = false;
+  std::thread writer([&]() { sent = writer_transport_->Send("bulk", sample.data(), sample.size()); });
+
+  std::vector<uint8_t> buffer(sample.size());
+  size_t bytes_received = 0;
+  bool received = ReceiveWithTimeout("bulk", buffer, &bytes_received);
+  writer.join();
+
+  EXPECT_TRUE(sent);
+  ASSERT_TRUE(received);
+  EXPECT_EQ(bytes_received, sample.size());
+  EXPECT_EQ(buffer, sample);
+}
+
+TEST_F(TcpTransportTest, CorkedFramesAreFlushedOnUncork) {
+  ASSERT_TRUE(reader_transport_->Subscribe("batched"));
+  ASSERT_TRUE(writer_transport_->Advertise("batched"));
+
+  writer_transport_->SetCork(true);
+  for (uint32_t i = 0; i < 100; ++i) {
+    EXPECT_TRUE(writer_transport_->Send("batched", &i, sizeof(i)));
+  }
+  writer_transport_->SetCork(false);
+
+  std::vector<uint8_t> buffer(sizeof(uint32_t));
+  size_t bytes_received = 0;
+  for (uint32_t i = 0; i < 100; ++i) {
+    ASSERT_TRUE(ReceiveWithTimeout("batched", buffer, &bytes_received));
+    uint32_t value = 0;
+    std::memcpy(&value, buffer.data(), sizeof(value));
+    EXPECT_EQ(value, i);
+  }
+}
+
+TEST_F(TcpTransportTest, StalledPeerDoesNotBlockReceive) {
+  // A peer that accepts connections but never reads them
+  int stalled_fd = socket(AF_INET, SOCK_STREAM, 0);
+  ASSERT_GE(stalled_fd, 0);
+  struct sockaddr_in address {};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t address_size = sizeof(address);
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  auto* socket_address = reinterpret_cast<struct sockaddr*>(&address);
+  ASSERT_EQ(bind(stalled_fd, socket_address, sizeof(address)), 0);
+  ASSERT_EQ(listen(stalled_fd, 1), 0);
+  ASSERT_EQ(getsockname(stalled_fd, socket_address, &address_size), 0);
+
+  writer_transport_->AddPeer("127.0.0.1", ntohs(address.sin_port));
+  ASSERT_TRUE(writer_transport_->Subscribe("status"));
+  ASSERT_TRUE(writer_transport_->Advertise("bulk"));
+
+  // The frame fills the socket buffers and blocks until the send timeout
+  std::vector<uint8_t> sample(64 * 1024 * 1024);
+  std::thread writer([&]() { writer_transport_->Send("bulk", sample.data(), sample.size()); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<uint8_t> buffer(16);
+  size_t bytes_received = 0;
+  EXPECT_FALSE(writer_transport_->Receive("status", buffer.data(), buffer.size(), &bytes_received));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+
+  writer.join();
+  close(stalled_fd);
+}
+
+TEST_F(TcpTransportTest, TransportTypeCheck) {
+  EXPECT_EQ(writer_transport_->GetType(), TransportType::TCP);
+  EXPECT_EQ(StringToTransportType("TCP"), TransportType::TCP);
+  EXPECT_EQ(TransportTypeToString(TransportType::TCP), "TCP");
+}
+
+}  // namespace
+}  // namespace transport
+}  // namespace tiny_dds
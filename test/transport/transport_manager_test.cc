@@ -0,0 +1,100 @@
+#include "src/transport/transport_manager.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "include/tiny_dds/transport.h"
+#include "include/tiny_dds/transport_types.h"
+#include "include/tiny_dds/types.h"
+
+namespace tiny_dds {
+namespace transport {
+namespace {
+
+TEST(TransportManagerTest, InstanceIsSharedAcrossCalls) {
+  EXPECT_EQ(TransportManager::GetInstance(), TransportManager::GetInstance());
+  EXPECT_NE(TransportManager::Create(), TransportManager::GetInstance());
+}
+
+TEST(TransportManagerTest, CreateTransportIsIdempotent) {
+  auto manager = TransportManager::Create();
+  ASSERT_TRUE(manager->CreateTransport(71, "participant", "topic", 1024 * 1024, 64 * 1024,
+                                       TransportType::UDP));
+  ASSERT_TRUE(manager->CreateTransport(71, "participant", "topic", 1024 * 1024, 64 * 1024,
+                                       TransportType::UDP));
+  EXPECT_EQ(manager->OpenEndpoint(72, "topic", TransportType::UDP), nullptr);
+}
+
+TEST(TransportManagerTest, EndpointsPublishAndSubscribeOnOneTransport) {
+  auto manager = TransportManager::Create();
+  ASSERT_TRUE(manager->CreateTransport(71, "participant", "pose", 1024 * 1024, 64 * 1024,
+                                       TransportType::UDP));
+  ASSERT_TRUE(manager->Subscribe(71, "pose", TransportType::UDP));
+  ASSERT_TRUE(manager->Advertise(71, "pose", TransportType::UDP));
+
+  auto writer_endpoint = manager->OpenEndpoint(71, "pose", TransportType::UDP);
+  auto reader_endpoint = manager->OpenEndpoint(71, "pose", TransportType::UDP);
+  ASSERT_NE(writer_endpoint, nullptr);
+  ASSERT_NE(reader_endpoint, nullptr);
+  EXPECT_EQ(writer_endpoint->GetTopicName(), "pose");
+  EXPECT_EQ(writer_endpoint->GetTransport(), reader_endpoint->GetTransport());
+
+  const char sample[] = "pose-sample";
+  ASSERT_TRUE(writer_endpoint->Send(sample, sizeof(sample)));
+
+  char buffer[64] = {0};
+  size_t bytes_received = 0;
+  bool received = false;
+  auto start = std::chrono::steady_clock::now();
+  while (!received && std::chrono::steady_clock::now() - start < std::chrono::seconds(2)) {
+    received = reader_endpoint->Receive(buffer, sizeof(buffer), &bytes_received);
+    if (!received) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  ASSERT_TRUE(received);
+  EXPECT_EQ(bytes_received, sizeof(sample));
+  EXPECT_STREQ(buffer, sample);
+}
+
+TEST(TransportManagerTest, MarkedUdpEndpointsStillReachTheTopic) {
+  auto manager = TransportManager::Create();
+  ASSERT_TRUE(manager->CreateTransport(71, "participant", "control", 1024 * 1024, 64 * 1024,
+                                       TransportType::UDP));
+  ASSERT_TRUE(manager->Subscribe(71, "control", TransportType::UDP));
+  ASSERT_TRUE(manager->Advertise(71, "control", TransportType::UDP));
+
+  // Priorities up to 6 need no privileges
+  auto writer_endpoint = manager->OpenEndpoint(71, "control", TransportType::UDP);
+  auto reader_endpoint = manager->OpenEndpoint(71, "control", TransportType::UDP);
+  TransportPriorityQos qos;
+  qos.value = 6;
+  qos.dscp = 46;
+  ASSERT_TRUE(writer_endpoint->SetTransportPriority(qos));
+
+  const char sample[] = "control-sample";
+  ASSERT_TRUE(writer_endpoint->Send(sample, sizeof(sample)));
+
+  char buffer[64] = {0};
+  size_t bytes_received = 0;
+  bool received = false;
+  auto start = std::chrono::steady_clock::now();
+  while (!received && std::chrono::steady_clock::now() - start < std::chrono::seconds(2)) {
+    received = reader_endpoint->Receive(buffer, sizeof(buffer), &bytes_received);
+    if (!received) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  ASSERT_TRUE(received);
+  EXPECT_EQ(bytes_received, sizeof(sample));
+  EXPECT_STREQ(buffer, sample);
+}
+
+}  // namespace
+}  // namespace transport
+}  // namespace tiny_dds
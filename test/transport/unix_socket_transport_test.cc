@@ -0,0 +1,158 @@
+#include "src/transport/unix_socket_transport.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/tiny_dds/transport.h"
+#include "include/tiny_dds/transport_types.h"
+#include "include/tiny_dds/types.h"
+
+namespace tiny_dds {
+namespace transport {
+namespace {
+
+// Runs every test once in the abstract namespace and once on the filesystem
+class UnixSocketTransportTest : public ::testing::TestWithParam<bool> {
+ protected:
+  void SetUp() override {
+    writer_transport_ = UnixSocketTransport::Create(23, "writer_participant", GetParam());
+    reader_transport_ = UnixSocketTransport::Create(23, "reader_participant", GetParam());
+
+    ASSERT_TRUE(writer_transport_ != nullptr);
+    ASSERT_TRUE(reader_transport_ != nullptr);
+    ASSERT_TRUE(writer_transport_->Initialize());
+    ASSERT_TRUE(reader_transport_->Initialize());
+  }
+
+  void TearDown() override {
+    writer_transport_.reset();
+    reader_transport_.reset();
+  }
+
+  std::shared_ptr<UnixSocketTransport> writer_transport_;
+  std::shared_ptr<UnixSocketTransport> reader_transport_;
+};
+
+TEST_P(UnixSocketTransportTest, PreservesMessageBoundaries) {
+  ASSERT_TRUE(reader_transport_->Subscribe("status"));
+  ASSERT_TRUE(writer_transport_->Advertise("status"));
+
+  const char first[] = "first";
+  const char second[] = "second-message";
+  EXPECT_TRUE(writer_transport_->Send("status", first, sizeof(first)));
+  EXPECT_TRUE(writer_transport_->Send("status", second, sizeof(second)));
+
+  char buffer[256] = {0};
+  size_t bytes_received = 0;
+  ASSERT_TRUE(reader_transport_->Receive("status", buffer, sizeof(buffer), &bytes_received));
+  EXPECT_EQ(bytes_received, sizeof(first));
+  EXPECT_STREQ(buffer, first);
+
+  ASSERT_TRUE(reader_transport_->Receive("status", buffer, sizeof(buffer), &bytes_received));
+  EXPECT_EQ(bytes_received, sizeof(second));
+  EXPECT_STREQ(buffer, second);
+
+  EXPECT_FALSE(reader_transport_->Receive("status", buffer, sizeof(buffer), &bytes_received));
+}
+
+TEST_P(UnixSocketTransportTest, PassesLargeSamplesAsDescriptors) {
+  ASSERT_TRUE(reader_transport_->Subscribe("image"));
+  ASSERT_TRUE(writer_transport_->Advertise("image"));
+
+  std::vector<uint8_t> sample(8 * UnixSocketTransport::kInlinePayloadThreshold);
+  for (size_t i = 0; i < sample.size(); ++i) {
+    sample[i] = static_cast<uint8_t>(i * 7);
+  }
+  ASSERT_TRUE(writer_transport_->Send("image", sample.data(), sample.size()));
+
+  std::vector<uint8_t> buffer(sample.size());
+  size_t bytes_received = 0;
+  ASSERT_TRUE(reader_transport_->Receive("image", buffer.data(), buffer.size(), &bytes_received));
+  EXPECT_EQ(bytes_received, sample.size());
+  EXPECT_EQ(buffer, sample);
+}
+
+TEST_P(UnixSocketTransportTest, EverySubscriberReceivesTheSample) {
+  auto other_reader = UnixSocketTransport::Create(23, "other_reader_participant", GetParam());
+  ASSERT_TRUE(other_reader->Initialize());
+  ASSERT_TRUE(reader_transport_->Subscribe("fanout"));
+  ASSERT_TRUE(other_reader->Subscribe("fanout"));
+  ASSERT_TRUE(writer_transport_->Advertise("fanout"));
+
+  const char sample[] = "to-everyone";
+  ASSERT_TRUE(writer_transport_->Send("fanout", sample, sizeof(sample)));
+
+  // Each subscriber listens on its own address, so neither takes the other's
+  for (const auto& reader : {reader_transport_, other_reader}) {
+    char buffer[64] = {0};
+    size_t bytes_received = 0;
+    ASSERT_TRUE(reader->Receive("fanout", buffer, sizeof(buffer), &bytes_received));
+    EXPECT_EQ(bytes_received, sizeof(sample));
+    EXPECT_STREQ(buffer, sample);
+  }
+}
+
+TEST_P(UnixSocketTransportTest, StalledSubscriberDoesNotBlockReceive) {
+  // Listening also creates the socket directory of the domain
+  ASSERT_TRUE(writer_transport_->Subscribe("status"));
+
+  // A subscriber that listens in the domain but never accepts its connections
+  const bool abstract_namespace = GetParam();
+  const std::string name =
+      abstract_namespace ? "tiny_dds_23_stalled" : "/tmp/tiny_dds_23/stalled.sock";
+  int stalled_fd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+  ASSERT_GE(stalled_fd, 0);
+  struct sockaddr_un address {};
+  address.sun_family = AF_UNIX;
+  const size_t offset = abstract_namespace ? 1 : 0;
+  std::memcpy(address.sun_path + offset, name.data(), name.size());
+  const auto address_length = static_cast<socklen_t>(
+      offsetof(struct sockaddr_un, sun_path) + offset + name.size() + (abstract_namespace ? 0 : 1));
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  ASSERT_EQ(bind(stalled_fd, reinterpret_cast<struct sockaddr*>(&address), address_length), 0);
+  ASSERT_EQ(listen(stalled_fd, 1), 0);
+
+  ASSERT_TRUE(writer_transport_->Advertise("bulk"));
+
+  // Once the socket buffer is full a packet blocks until the send timeout
+  std::vector<uint8_t> sample(UnixSocketTransport::kInlinePayloadThreshold);
+  std::thread writer([&]() {
+    auto start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(200)) {
+      writer_transport_->Send("bulk", sample.data(), sample.size());
+    }
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<uint8_t> buffer(16);
+  size_t bytes_received = 0;
+  EXPECT_FALSE(writer_transport_->Receive("status", buffer.data(), buffer.size(), &bytes_received));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+
+  writer.join();
+  close(stalled_fd);
+  if (!abstract_namespace) {
+    unlink(name.c_str());
+  }
+}
+
+TEST_P(UnixSocketTransportTest, TransportTypeCheck) {
+  EXPECT_EQ(writer_transport_->GetType(), TransportType::UNIX_SOCKET);
+  EXPECT_EQ(StringToTransportType("UNIX_SOCKET"), TransportType::UNIX_SOCKET);
+}
+
+INSTANTIATE_TEST_SUITE_P(Namespaces, UnixSocketTransportTest, ::testing::Bool());
+
+}  // namespace
+}  // namespace transport
+}  // namespace tiny_dds
@@ -0,0 +1,190 @@
+#include "include/tiny_dds/typed_data.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "google/protobuf/descriptor.pb.h"
+#include "gtest/gtest.h"
+#include "include/tiny_dds/data_reader.h"
+#include "include/tiny_dds/data_writer.h"
+#include "include/tiny_dds/domain_participant.h"
+#include "include/tiny_dds/publisher.h"
+#include "include/tiny_dds/subscriber.h"
+#include "include/tiny_dds/topic.h"
+#include "include/tiny_dds/transport_types.h"
+#include "test/test_util.h"
+
+namespace tiny_dds {
+namespace {
+
+using google::protobuf::FieldDescriptorProto;
+
+struct Pose {
+  static constexpr char kTypeName[] = "test.Pose";
+
+  int32_t id;
+  double x;
+  double y;
+};
+
+struct Unnamed {
+  int32_t value;
+};
+
+}  // namespace
+
+template <>
+struct TopicType<Unnamed> {
+  static std::string Name() { return "test.Unnamed"; }
+};
+
+namespace {
+
+static_assert(kIsPlainType<Pose>);
+static_assert(kIsMessageType<FieldDescriptorProto>);
+static_assert(!kIsPlainType<std::string> && !kIsMessageType<std::string>);
+
+TEST(TypedDataTest, TypeNamesComeFromTheType) {
+  EXPECT_EQ(TopicType<FieldDescriptorProto>::Name(), "google.protobuf.FieldDescriptorProto");
+  EXPECT_EQ(TopicType<Pose>::Name(), "test.Pose");
+  EXPECT_EQ(TopicType<Unnamed>::Name(), "test.Unnamed");
+}
+
+TEST(TypedDataTest, RejectsTopicsOfAnotherType) {
+  auto participant = DomainParticipant::Create(191, "typed_mismatch");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  auto topic = participant->CreateTopic(TestTopicName(), TopicType<Pose>::Name());
+
+  EXPECT_EQ(TypedDataWriter<FieldDescriptorProto>::Create(
+                participant->CreatePublisher()->CreateDataWriter(topic)),
+            nullptr);
+  EXPECT_EQ(TypedDataReader<Unnamed>::Create(
+                participant->CreateSubscriber()->CreateDataReader(topic)),
+            nullptr);
+  EXPECT_NE(TypedDataReader<Pose>::Create(
+                participant->CreateSubscriber()->CreateDataReader(topic)),
+            nullptr);
+}
+
+TEST(TypedDataTest, PlainSamplesRoundTripAsTheirBytes) {
+  auto participant = DomainParticipant::Create(191, "typed_plain");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  auto topic = participant->CreateTopic(TestTopicName(), TopicType<Pose>::Name());
+  auto reader =
+      TypedDataReader<Pose>::Create(participant->CreateSubscriber()->CreateDataReader(topic));
+  auto writer =
+      TypedDataWriter<Pose>::Create(participant->CreatePublisher()->CreateDataWriter(topic));
+  ASSERT_NE(reader, nullptr);
+  ASSERT_NE(writer, nullptr);
+
+  ASSERT_TRUE(writer->Write(Pose{1, 1.5, -2.5}));
+  ASSERT_TRUE(writer->Write(std::make_shared<const Pose>(Pose{2, 3.0, 4.0})));
+
+  Pose pose{};
+  SampleInfo info;
+  ASSERT_TRUE(reader->Read(&pose, info));
+  EXPECT_EQ(pose.id, 1);
+  ASSERT_TRUE(reader->Take(&pose, info));
+  EXPECT_EQ(pose.id, 1);
+  EXPECT_EQ(pose.x, 1.5);
+  EXPECT_EQ(pose.y, -2.5);
+  ASSERT_TRUE(reader->Take(&pose, info, std::chrono::milliseconds(100)));
+  EXPECT_EQ(pose.id, 2);
+  EXPECT_EQ(info.sequence_number, 2);
+  EXPECT_FALSE(reader->Take(&pose, info));
+}
+
+TEST(TypedDataTest, MessagesRoundTripOverTheNetwork) {
+  auto publisher_participant = DomainParticipant::Create(191, "typed_publisher");
+  auto subscriber_participant = DomainParticipant::Create(191, "typed_subscriber");
+  const std::string type_name = TopicType<FieldDescriptorProto>::Name();
+  auto reader = TypedDataReader<FieldDescriptorProto>::Create(
+      subscriber_participant->CreateSubscriber()->CreateDataReader(
+          subscriber_participant->CreateTopic(TestTopicName(), type_name)));
+  auto writer = TypedDataWriter<FieldDescriptorProto>::Create(
+      publisher_participant->CreatePublisher()->CreateDataWriter(
+          publisher_participant->CreateTopic(TestTopicName(), type_name)));
+  ASSERT_NE(reader, nullptr);
+  ASSERT_NE(writer, nullptr);
+
+  // Later samples are smaller than earlier ones, in the same serialization buffer
+  const std::vector<std::string> names = {std::string(1000, 'a'), "b", ""};
+  for (size_t i = 0; i < names.size(); ++i) {
+    FieldDescriptorProto sample;
+    sample.set_name(names[i]);
+    sample.set_number(static_cast<int32_t>(i));
+    ASSERT_TRUE(writer->Write(sample));
+  }
+
+  FieldDescriptorProto sample;
+  SampleInfo info;
+  for (size_t i = 0; i < names.size(); ++i) {
+    ASSERT_TRUE(reader->Take(&sample, info, std::chrono::milliseconds(500)));
+    EXPECT_EQ(sample.name(), names[i]);
+    EXPECT_EQ(sample.number(), static_cast<int32_t>(i));
+  }
+}
+
+TEST(TypedDataTest, CallbacksReceiveDecodedSamples) {
+  auto participant = DomainParticipant::Create(191, "typed_callbacks");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  auto topic = participant->CreateTopic(TestTopicName(), TopicType<FieldDescriptorProto>::Name(),
+                                        {FieldDescriptorProto::kNameFieldNumber});
+  auto reader = TypedDataReader<FieldDescriptorProto>::Create(
+      participant->CreateSubscriber()->CreateDataReader(topic));
+  auto writer = TypedDataWriter<FieldDescriptorProto>::Create(
+      participant->CreatePublisher()->CreateDataWriter(topic));
+
+  // The reader keeps the callback, so it owns what it writes to
+  auto names = std::make_shared<std::vector<std::string>>();
+  reader->SetDataReceivedCallback(
+      [names](const FieldDescriptorProto& sample, const SampleInfo& /*info*/) {
+        names->push_back(sample.name());
+      });
+
+  FieldDescriptorProto sample;
+  sample.set_name("a");
+  ASSERT_TRUE(writer->Write(sample));
+  auto shared = std::make_shared<FieldDescriptorProto>();
+  shared->set_name("b");
+  ASSERT_TRUE(writer->Write(std::shared_ptr<const FieldDescriptorProto>(shared)));
+
+  EXPECT_EQ(*names, (std::vector<std::string>{"a", "b"}));
+}
+
+TEST(TypedDataTest, ReentrantCallbacksDecodeTheirOwnSamples) {
+  auto participant = DomainParticipant::Create(191, "typed_reentrant_callbacks");
+  ASSERT_TRUE(participant->SetTransportType(TransportType::LOCAL_ONLY));
+  participant->SetCallbackThreading(CallbackThreading::INLINE);
+  auto topic = participant->CreateTopic(TestTopicName(), TopicType<FieldDescriptorProto>::Name());
+  auto reader = TypedDataReader<FieldDescriptorProto>::Create(
+      participant->CreateSubscriber()->CreateDataReader(topic));
+  std::shared_ptr<TypedDataWriter<FieldDescriptorProto>> writer =
+      TypedDataWriter<FieldDescriptorProto>::Create(
+          participant->CreatePublisher()->CreateDataWriter(topic));
+
+  // The outer callback writes again, which runs the inner one on the same thread
+  auto names = std::make_shared<std::vector<std::string>>();
+  std::weak_ptr<TypedDataWriter<FieldDescriptorProto>> weak_writer = writer;
+  reader->SetDataReceivedCallback(
+      [names, weak_writer](const FieldDescriptorProto& sample, const SampleInfo& /*info*/) {
+        if (sample.name() == "outer") {
+          FieldDescriptorProto inner;
+          inner.set_name("inner");
+          weak_writer.lock()->Write(inner);
+        }
+        names->push_back(sample.name());
+      });
+
+  FieldDescriptorProto outer;
+  outer.set_name("outer");
+  ASSERT_TRUE(writer->Write(outer));
+
+  EXPECT_EQ(*names, (std::vector<std::string>{"inner", "outer"}));
+}
+
+}  // namespace
+}  // namespace tiny_dds
@@ -0,0 +1,168 @@
+#include <chrono>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/tiny_dds/data_reader.h"
+#include "include/tiny_dds/data_writer.h"
+#include "include/tiny_dds/domain_participant.h"
+#include "include/tiny_dds/publisher.h"
+#include "include/tiny_dds/subscriber.h"
+#include "include/tiny_dds/topic.h"
+#include "include/tiny_dds/transport_types.h"
+#include "include/tiny_dds/types.h"
+#include "include/tiny_dds/wait_set.h"
+#include "test/test_util.h"
+
+namespace tiny_dds {
+namespace {
+
+class WaitSetTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    participant_ = DomainParticipant::Create(101, "wait_set_participant");
+    ASSERT_NE(participant_, nullptr);
+    ASSERT_TRUE(participant_->SetTransportType(TransportType::LOCAL_ONLY));
+
+    publisher_ = participant_->CreatePublisher();
+    subscriber_ = participant_->CreateSubscriber();
+  }
+
+  // Creates a topic named after the test and a suffix
+  std::shared_ptr<Topic> CreateTopic(const std::string& suffix = "") {
+    return participant_->CreateTopic(TestTopicName(suffix), "test_type");
+  }
+
+  std::shared_ptr<DomainParticipant> participant_;
+  std::shared_ptr<Publisher> publisher_;
+  std::shared_ptr<Subscriber> subscriber_;
+};
+
+TEST_F(WaitSetTest, TakeWithTimeoutWakesOnWrite) {
+  auto topic = CreateTopic();
+  auto reader = subscriber_->CreateDataReader(topic);
+  auto writer = publisher_->CreateDataWriter(topic);
+
+  const char sample[] = "late sample";
+  std::thread writer_thread([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    writer->Write(sample, sizeof(sample));
+  });
+
+  char buffer[64] = {0};
+  SampleInfo info;
+  EXPECT_EQ(reader->Take(buffer, sizeof(buffer), info, std::chrono::seconds(5)), sizeof(sample));
+  EXPECT_TRUE(info.valid_data);
+  EXPECT_STREQ(buffer, sample);
+
+  writer_thread.join();
+}
+
+TEST_F(WaitSetTest, TakeWithTimeoutTimesOut) {
+  auto reader = subscriber_->CreateDataReader(CreateTopic());
+
+  char buffer[64];
+  SampleInfo info;
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(reader->Take(buffer, sizeof(buffer), info, std::chrono::milliseconds(20)), -1);
+  EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+}
+
+TEST_F(WaitSetTest, ServicesManyReadersFromOneThread) {
+  constexpr int kReaderCount = 200;
+
+  auto wait_set = WaitSet::Create();
+  std::vector<std::shared_ptr<DataWriter>> writers;
+  for (int i = 0; i < kReaderCount; ++i) {
+    auto topic = CreateTopic("_" + std::to_string(i));
+    auto reader = subscriber_->CreateDataReader(topic);
+    ASSERT_TRUE(wait_set->AttachCondition(reader->CreateReadCondition()));
+    writers.push_back(publisher_->CreateDataWriter(topic));
+  }
+  EXPECT_EQ(wait_set->GetConditions().size(), kReaderCount);
+
+  // One sample per topic, in reverse order, while the consumer is waiting
+  std::thread writer_thread([&]() {
+    for (int i = kReaderCount - 1; i >= 0; --i) {
+      writers[i]->Write(&i, sizeof(i));
+    }
+  });
+
+  std::set<int> received;
+  std::vector<std::shared_ptr<Condition>> active;
+  while (received.size() < kReaderCount &&
+         wait_set->Wait(active, std::chrono::seconds(5))) {
+    for (const auto& condition : active) {
+      auto reader = std::static_pointer_cast<ReadCondition>(condition)->GetDataReader();
+      int value = -1;
+      SampleInfo info;
+      while (reader->Take(&value, sizeof(value), info) == sizeof(value)) {
+        received.insert(value);
+      }
+    }
+  }
+  writer_thread.join();
+
+  EXPECT_EQ(received.size(), kReaderCount);
+}
+
+TEST_F(WaitSetTest, StatusConditionTracksDataAvailable) {
+  auto topic = CreateTopic();
+  auto reader = subscriber_->CreateDataReader(topic);
+  auto writer = publisher_->CreateDataWriter(topic);
+
+  auto status_condition = reader->GetStatusCondition();
+  EXPECT_EQ(status_condition, reader->GetStatusCondition());
+  EXPECT_EQ(status_condition->GetEnabledStatuses(), DATA_AVAILABLE_STATUS);
+
+  auto wait_set = WaitSet::Create();
+  ASSERT_TRUE(wait_set->AttachCondition(status_condition));
+  EXPECT_FALSE(wait_set->AttachCondition(status_condition));
+
+  std::vector<std::shared_ptr<Condition>> active;
+  EXPECT_FALSE(wait_set->Wait(active, std::chrono::milliseconds(1)));
+
+  const char sample[] = "sample";
+  ASSERT_TRUE(writer->Write(sample, sizeof(sample)));
+  ASSERT_TRUE(wait_set->Wait(active, std::chrono::seconds(1)));
+  ASSERT_EQ(active.size(), 1);
+  EXPECT_EQ(active[0], status_condition);
+
+  // Taking the sample clears the status
+  char buffer[64];
+  SampleInfo info;
+  ASSERT_EQ(reader->Take(buffer, sizeof(buffer), info), sizeof(sample));
+  EXPECT_FALSE(status_condition->GetTriggerValue());
+
+  // Disabled statuses do not trigger the condition
+  status_condition->SetEnabledStatuses(SUBSCRIPTION_MATCHED_STATUS);
+  ASSERT_TRUE(writer->Write(sample, sizeof(sample)));
+  EXPECT_FALSE(status_condition->GetTriggerValue());
+
+  EXPECT_TRUE(wait_set->DetachCondition(status_condition));
+  EXPECT_FALSE(wait_set->DetachCondition(status_condition));
+}
+
+TEST_F(WaitSetTest, GuardConditionWakesWaitingThread) {
+  auto guard = GuardCondition::Create();
+  auto wait_set = WaitSet::Create();
+  ASSERT_TRUE(wait_set->AttachCondition(guard));
+
+  std::thread trigger_thread([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    guard->SetTriggerValue(true);
+  });
+
+  std::vector<std::shared_ptr<Condition>> active;
+  EXPECT_TRUE(wait_set->Wait(active, std::chrono::seconds(5)));
+  ASSERT_EQ(active.size(), 1);
+  EXPECT_EQ(active[0], guard);
+
+  trigger_thread.join();
+}
+
+}  // namespace
+}  // namespace tiny_dds